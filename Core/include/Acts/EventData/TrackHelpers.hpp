@@ -0,0 +1,103 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/Track.hpp"
+
+#include <vector>
+
+namespace Acts {
+
+/// Append the tracks of one track container to another one
+///
+/// Track states which are shared between tracks, like the common states of
+/// the tracks found from one seed, are copied only once and stay shared. The
+/// appended tracks keep their order, i.e. without skipped tracks source track
+/// @c i becomes the destination track @c n+i where @c n is the size of the
+/// destination before.
+///
+/// @note Only the standard track columns are copied. Dynamic columns have to
+///       be copied by the caller.
+///
+/// @param source the track container to copy the tracks from
+/// @param destination the track container to append the tracks to
+/// @param select the predicate for the source tracks which are appended,
+///        the other tracks are skipped without changing the order
+template <typename source_track_container_t, typename source_traj_t,
+          template <typename> class source_holder_t,
+          typename track_container_t, typename traj_t,
+          template <typename> class holder_t, typename predicate_t>
+void appendTracks(const TrackContainer<source_track_container_t, source_traj_t,
+                                       source_holder_t>& source,
+                  TrackContainer<track_container_t, traj_t, holder_t>&
+                      destination,
+                  predicate_t&& select) {
+  using IndexType = MultiTrajectoryTraits::IndexType;
+  constexpr IndexType kInvalid = MultiTrajectoryTraits::kInvalid;
+
+  const auto& sourceStates = source.trackStateContainer();
+  auto& destinationStates = destination.trackStateContainer();
+
+  // index of the copy of each source track state
+  std::vector<IndexType> copies(sourceStates.size(), kInvalid);
+  std::vector<IndexType> newStates;
+
+  for (auto track : source) {
+    if (!select(track)) {
+      continue;
+    }
+
+    // collect the states which are not copied yet, going backwards from the
+    // tip until the first state which is shared with an earlier track
+    newStates.clear();
+    auto istate = track.tipIndex();
+    while (istate != kInvalid && copies[istate] == kInvalid) {
+      newStates.push_back(istate);
+      auto state = sourceStates.getTrackState(istate);
+      istate = state.hasPrevious() ? state.previous() : kInvalid;
+    }
+
+    auto iprevious = istate == kInvalid ? kInvalid : copies[istate];
+    for (auto it = newStates.rbegin(); it != newStates.rend(); ++it) {
+      auto state = sourceStates.getTrackState(*it);
+      auto mask = state.getMask();
+      iprevious = destinationStates.addTrackState(mask, iprevious);
+      destinationStates.getTrackState(iprevious).copyFrom(state, mask);
+      copies[*it] = iprevious;
+    }
+
+    auto copy = destination.getTrack(destination.addTrack());
+    copy.tipIndex() = iprevious;
+    copy.parameters() = track.parameters();
+    copy.covariance() = track.covariance();
+    if (track.hasReferenceSurface()) {
+      copy.setReferenceSurface(track.referenceSurface().getSharedPtr());
+    }
+    copy.nMeasurements() = track.nMeasurements();
+    copy.nHoles() = track.nHoles();
+  }
+}
+
+/// Append all tracks of one track container to another one
+///
+/// @param source the track container to copy the tracks from
+/// @param destination the track container to append the tracks to
+template <typename source_track_container_t, typename source_traj_t,
+          template <typename> class source_holder_t,
+          typename track_container_t, typename traj_t,
+          template <typename> class holder_t>
+void appendTracks(const TrackContainer<source_track_container_t, source_traj_t,
+                                       source_holder_t>& source,
+                  TrackContainer<track_container_t, traj_t, holder_t>&
+                      destination) {
+  appendTracks(source, destination, [](const auto&) { return true; });
+}
+
+}  // namespace Acts
@@ -12,7 +12,10 @@
 #include "Acts/EventData/MultiTrajectory.hpp"
 #include "Acts/EventData/TrackStatePropMask.hpp"
 #include "Acts/EventData/detail/DynamicColumn.hpp"
+#include "Acts/Utilities/MonotonicArena.hpp"
 
+#include <memory_resource>
+#include <optional>
 #include <unordered_map>
 
 #include <boost/histogram.hpp>
@@ -37,6 +40,9 @@ class VectorMultiTrajectoryBase {
 
     hist_t hist;
 
+    /// memory usage of the arena, if the trajectory is backed by one
+    std::optional<MonotonicArena::Statistics> arena;
+
     void toStream(std::ostream& os, size_t n = 1);
   };
 
@@ -120,7 +126,14 @@ class VectorMultiTrajectoryBase {
       }
     }
 
-    return Statistics{h};
+    std::optional<MonotonicArena::Statistics> arena;
+    if (const auto* resource = dynamic_cast<const MonotonicArena*>(
+            m_index.get_allocator().resource());
+        resource != nullptr) {
+      arena = resource->statistics();
+    }
+
+    return Statistics{h, arena};
   }
 
  protected:
@@ -145,13 +158,31 @@ class VectorMultiTrajectoryBase {
 
   VectorMultiTrajectoryBase() = default;
 
+  explicit VectorMultiTrajectoryBase(std::pmr::memory_resource* resource)
+      : m_index{resource},
+        m_previous{resource},
+        m_params{resource},
+        m_cov{resource},
+        m_meas{resource},
+        m_measOffset{resource},
+        m_measCov{resource},
+        m_measCovOffset{resource},
+        m_jac{resource},
+        m_sourceLinks{resource},
+        m_projectors{resource},
+        m_referenceSurfaces{resource} {}
+
+  // The copy is allocated from the default memory resource, independent of
+  // the resource of the original.
   VectorMultiTrajectoryBase(const VectorMultiTrajectoryBase& other)
       : m_index{other.m_index},
         m_previous{other.m_previous},
         m_params{other.m_params},
         m_cov{other.m_cov},
         m_meas{other.m_meas},
+        m_measOffset{other.m_measOffset},
         m_measCov{other.m_measCov},
+        m_measCovOffset{other.m_measCovOffset},
         m_jac{other.m_jac},
         m_sourceLinks{other.m_sourceLinks},
         m_projectors{other.m_projectors},
@@ -284,26 +315,27 @@ class VectorMultiTrajectoryBase {
   // END INTERFACE HELPER
 
   /// index to map track states to the corresponding
-  std::vector<IndexData> m_index;
-  std::vector<IndexType> m_previous;
-  std::vector<typename detail_lt::Types<eBoundSize>::Coefficients> m_params;
-  std::vector<typename detail_lt::Types<eBoundSize>::Covariance> m_cov;
+  std::pmr::vector<IndexData> m_index;
+  std::pmr::vector<IndexType> m_previous;
+  std::pmr::vector<typename detail_lt::Types<eBoundSize>::Coefficients>
+      m_params;
+  std::pmr::vector<typename detail_lt::Types<eBoundSize>::Covariance> m_cov;
 
-  std::vector<double> m_meas;
-  std::vector<MultiTrajectoryTraits::IndexType> m_measOffset;
-  std::vector<double> m_measCov;
-  std::vector<MultiTrajectoryTraits::IndexType> m_measCovOffset;
+  std::pmr::vector<double> m_meas;
+  std::pmr::vector<MultiTrajectoryTraits::IndexType> m_measOffset;
+  std::pmr::vector<double> m_measCov;
+  std::pmr::vector<MultiTrajectoryTraits::IndexType> m_measCovOffset;
 
-  std::vector<typename detail_lt::Types<eBoundSize>::Covariance> m_jac;
-  std::vector<std::optional<SourceLink>> m_sourceLinks;
-  std::vector<ProjectorBitset> m_projectors;
+  std::pmr::vector<typename detail_lt::Types<eBoundSize>::Covariance> m_jac;
+  std::pmr::vector<std::optional<SourceLink>> m_sourceLinks;
+  std::pmr::vector<ProjectorBitset> m_projectors;
 
   // owning vector of shared pointers to surfaces
   //
   // This might be problematic when appending a large number of surfaces
   // trackstates, because vector has to reallocated and thus copy. This might
   // be handled in a smart way by moving but not sure.
-  std::vector<std::shared_ptr<const Surface>> m_referenceSurfaces;
+  std::pmr::vector<std::shared_ptr<const Surface>> m_referenceSurfaces;
 
   std::unordered_map<HashedString, std::unique_ptr<detail::DynamicColumnBase>>
       m_dynamic;
@@ -315,6 +347,16 @@ class VectorMultiTrajectory;
 template <>
 struct IsReadOnlyMultiTrajectory<VectorMultiTrajectory> : std::false_type {};
 
+/// @brief MultiTrajectory backend storing the track states in vectors
+///
+/// The vectors allocate from a polymorphic memory resource, by default the
+/// global heap. Passing a MonotonicArena, which is reset and reused for every
+/// event, avoids most of the allocations when filling the trajectory. The
+/// arena can only be reset after the trajectory, and everything moved from
+/// it, has been destroyed. Copies always allocate from the default resource.
+///
+/// The trajectory shares the ownership of the reference surfaces, whose
+/// control blocks are allocated by the surfaces and not from the resource.
 class VectorMultiTrajectory final
     : public detail_vmt::VectorMultiTrajectoryBase,
       public MultiTrajectory<VectorMultiTrajectory> {
@@ -324,6 +366,12 @@ class VectorMultiTrajectory final
 
  public:
   VectorMultiTrajectory() = default;
+
+  /// Construct a trajectory allocating from a memory resource
+  /// @param resource The memory resource, has to outlive the trajectory
+  explicit VectorMultiTrajectory(std::pmr::memory_resource* resource)
+      : VectorMultiTrajectoryBase{resource} {}
+
   VectorMultiTrajectory(const VectorMultiTrajectory& other)
       : VectorMultiTrajectoryBase{other} {}
 
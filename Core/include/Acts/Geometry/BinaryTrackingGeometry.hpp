@@ -0,0 +1,109 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Acts {
+
+class TrackingGeometry;
+
+/// @brief Sections of a binary tracking geometry file
+///
+/// The first three sections are pools of plain values, which are referenced
+/// by offset and size from the records of the other sections. All other
+/// sections are tables of fixed size records, which reference each other by
+/// their position in the table.
+enum class BinaryTrackingGeometrySection : std::uint32_t {
+  /// double values: bound values, transforms, material, bin edges
+  Values = 0,
+  /// 64 bit indices into the record tables
+  Indices = 1,
+  /// characters of the volume names
+  Names = 2,
+  Surfaces = 3,
+  Materials = 4,
+  BinUtilities = 5,
+  BinningData = 6,
+  Axes = 7,
+  SurfaceArrays = 8,
+  Layers = 9,
+  BinnedArrays = 10,
+  Boundaries = 11,
+  Volumes = 12,
+};
+
+/// @brief Header of a binary tracking geometry file
+///
+/// The header is followed by the sections listed in
+/// BinaryTrackingGeometrySection, each of which starts at a cache line
+/// aligned offset from the start of the file.
+///
+/// The file is written in the native byte order, which is checked on reading
+/// with @c byteOrderMark.
+struct BinaryTrackingGeometryHeader {
+  static constexpr std::array<char, 8> kMagic = {'A', 'C', 'T', 'S',
+                                                 'T', 'G', 'E', 'O'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrderMark = 0x01020304;
+  static constexpr std::size_t kNSections = 13;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t byteOrderMark = kByteOrderMark;
+  /// offset of each section from the start of the file
+  std::array<std::uint64_t, kNSections> sectionOffset = {};
+  /// number of entries in each section
+  std::array<std::uint64_t, kNSections> sectionSize = {};
+  /// the world volume in the volume section
+  std::uint64_t worldVolume = 0;
+};
+
+/// @brief write a closed tracking geometry to a binary file
+///
+/// All volumes, layers, surfaces with their bounds and transforms, surface
+/// arrays, surface and volume material and the geometry identifiers are
+/// written. Surfaces that belong to a detector element are written with the
+/// transform in the given geometry context, and are read back as surfaces
+/// without a detector element.
+///
+/// @param path the output file
+/// @param gctx the geometry context for the surface transforms
+/// @param trackingGeometry the tracking geometry to be written
+///
+/// @throw std::invalid_argument if the geometry contains objects that can
+///        not be written, e.g. dense volumes or bounding volume hierarchies
+/// @throw std::runtime_error if the file can not be written
+void writeBinaryTrackingGeometry(const std::string& path,
+                                 const GeometryContext& gctx,
+                                 const TrackingGeometry& trackingGeometry);
+
+/// @brief read a tracking geometry from a binary file
+///
+/// The file is mapped into memory read-only and the geometry objects are
+/// created directly from the mapped records, without any parsing. The
+/// geometry is closed with the geometry identifiers stored in the file, and
+/// navigates identically to the tracking geometry it was written from.
+///
+/// @param path the binary tracking geometry file
+/// @param logger the logger used when closing the geometry
+///
+/// @throw std::runtime_error if the file can not be mapped or is not a
+///        valid binary tracking geometry
+std::unique_ptr<const TrackingGeometry> readBinaryTrackingGeometry(
+    const std::string& path, const Logger& logger = getDummyLogger());
+
+}  // namespace Acts
@@ -123,6 +123,22 @@ class BoundarySurfaceT {
   /// The Surface Representation of this
   virtual const Surface& surfaceRepresentation() const;
 
+  /// The single volume on the inside w.r.t. the normal vector, if attached
+  const volume_t* oppositeVolume() const { return m_oppositeVolume; }
+
+  /// The single volume on the outside w.r.t. the normal vector, if attached
+  const volume_t* alongVolume() const { return m_alongVolume; }
+
+  /// The volume array on the inside w.r.t. the normal vector, if attached
+  const VolumeArray* oppositeVolumeArray() const {
+    return m_oppositeVolumeArray.get();
+  }
+
+  /// The volume array on the outside w.r.t. the normal vector, if attached
+  const VolumeArray* alongVolumeArray() const {
+    return m_alongVolumeArray.get();
+  }
+
   /// Helper method: attach a Volume to this BoundarySurfaceT
   /// this is done during the geometry construction.
   ///
@@ -0,0 +1,223 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/Layer.hpp"
+#include "Acts/Geometry/TrackingVolume.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+namespace Acts {
+
+class TrackingGeometry;
+
+template <typename object_t>
+struct NavigationOptions;
+
+/// @brief Precomputed navigation candidates for a tracking geometry
+///
+/// The cache is built once per tracking geometry and replaces the candidate
+/// search of @c Layer::compatibleSurfaces and
+/// @c TrackingVolume::compatibleLayers by table lookups:
+///
+/// - for every layer of a volume and both walking directions, the ordered
+///   list of layers that need to be resolved is stored;
+/// - for every cell of a layer surface array, i.e. a bin or a subdivision of
+///   it, the accepted approach, sensitive and representing surfaces are
+///   stored once per direction bin.
+///   The direction bins are given by the sign of the change in phi and, for
+///   cylinder layers, in z, both of which are constant along a straight line.
+///   Sensitive surfaces lying entirely behind the cell for a given direction
+///   can never be intersected in front of the position and are removed.
+///
+/// Only the list of candidates is cached, the intersections are still
+/// computed for the actual position and direction such that the result is
+/// identical to the exhaustive search. Configurations that are not covered by
+/// the cache, e.g. positions outside the surface array binning or a different
+/// resolve prescription, are signalled to the caller which then has to fall
+/// back to the exhaustive search.
+class NavigationCache {
+ public:
+  struct Config {
+    /// Resolve the sensitive surfaces
+    bool resolveSensitive = true;
+    /// Resolve the material surfaces
+    bool resolveMaterial = true;
+    /// Resolve the passive surfaces
+    bool resolvePassive = false;
+    /// Minimal distance a sensitive surface has to lie behind a bin to be
+    /// removed from its candidates, must exceed the overstep limit in use
+    double pruningTolerance = 1 * UnitConstants::mm;
+    /// Number of cells per surface array bin and axis, finer cells allow to
+    /// remove the surfaces of the neighboring bins overlapping into the bin
+    std::size_t binSubdivisions = 3;
+  };
+
+  /// Size of the cache
+  struct Statistics {
+    /// number of layers with a surface grid
+    std::size_t layers = 0;
+    /// number of surface grid bins that are cached
+    std::size_t cachedBins = 0;
+    /// number of surface grid bins that fall back to the exhaustive search
+    std::size_t uncachedBins = 0;
+    /// total number of stored surface candidates
+    std::size_t surfaceCandidates = 0;
+    /// number of sensitive surface candidates removed by the direction bins
+    std::size_t prunedCandidates = 0;
+  };
+
+  using SurfaceCandidates =
+      boost::container::small_vector<SurfaceIntersection, 10>;
+  using LayerCandidates = boost::container::small_vector<LayerIntersection, 10>;
+
+  /// Constructor
+  ///
+  /// @param gctx The geometry context to build the cache in
+  /// @param tGeometry The tracking geometry to build the cache for
+  /// @param cfg The configuration, has to match the navigator one
+  /// @param _logger The logging instance
+  NavigationCache(const GeometryContext& gctx,
+                  const TrackingGeometry& tGeometry, const Config& cfg,
+                  std::unique_ptr<const Logger> _logger =
+                      getDefaultLogger("NavigationCache", Logging::INFO));
+
+  /// Cached version of @c Layer::compatibleSurfaces
+  ///
+  /// @param gctx The current geometry context
+  /// @param layer The layer to resolve the surfaces for
+  /// @param position The current position
+  /// @param direction The current direction
+  /// @param options The navigation options
+  /// @param [out] sIntersections The sorted surface intersections
+  ///
+  /// @return false if the request is not covered by the cache, in which case
+  ///         @p sIntersections is left untouched
+  bool compatibleSurfaces(const GeometryContext& gctx, const Layer& layer,
+                          const Vector3& position, const Vector3& direction,
+                          const NavigationOptions<Surface>& options,
+                          SurfaceCandidates& sIntersections) const;
+
+  /// Cached version of @c TrackingVolume::compatibleLayers
+  ///
+  /// @param gctx The current geometry context
+  /// @param volume The volume to resolve the layers for
+  /// @param position The current position
+  /// @param direction The current direction
+  /// @param options The navigation options
+  /// @param [out] lIntersections The sorted layer intersections
+  ///
+  /// @return false if the request is not covered by the cache, in which case
+  ///         @p lIntersections is left untouched
+  bool compatibleLayers(const GeometryContext& gctx,
+                        const TrackingVolume& volume, const Vector3& position,
+                        const Vector3& direction,
+                        const NavigationOptions<Layer>& options,
+                        LayerCandidates& lIntersections) const;
+
+  /// The configuration the cache was built with
+  const Config& config() const { return m_cfg; }
+
+  /// The size of the cache
+  const Statistics& statistics() const { return m_statistics; }
+
+ private:
+  /// Range of candidates in one of the flat candidate vectors
+  struct Range {
+    std::uint32_t begin = 0;
+    std::uint32_t end = 0;
+  };
+
+  /// One axis of a surface grid, mirrors the surface array axis
+  struct Axis {
+    bool equidistant = true;
+    double min = 0.;
+    double max = 0.;
+    double width = 0.;
+    std::vector<double> edges;
+
+    std::size_t nBins() const { return edges.size() - 1; }
+
+    /// @return the cell of @p value with @p subdivisions cells per bin or -1
+    ///         if it is outside the axis range
+    int cell(double value, std::size_t subdivisions) const;
+  };
+
+  struct SurfaceGrid {
+    /// The frame of the surface array
+    Transform3 transform = Transform3::Identity();
+    /// Cylinder layers are binned in (phi, z), discs in (r, phi)
+    bool cylinder = true;
+    /// Minimal radius of a position on a cylinder layer
+    double minRadius = 0.;
+    /// Number of cells per bin and axis
+    std::size_t subdivisions = 1;
+    Axis axis0;
+    Axis axis1;
+    /// Candidates for cell(cell0, cell1) * nDirections + direction
+    std::vector<Range> ranges;
+
+    std::size_t nDirections() const { return cylinder ? 4 : 2; }
+
+    std::size_t cell(std::size_t cell0, std::size_t cell1) const {
+      return cell0 * axis1.nBins() * subdivisions + cell1;
+    }
+  };
+
+  struct LayerEntry {
+    const Layer* layer = nullptr;
+    /// The index of the layer in the confined layer array of its volume
+    std::size_t index = 0;
+    /// Whether the layer needs resolving
+    bool resolve = false;
+    /// The resolvable layers following this one in both directions
+    Range next[2];
+    /// The surface grid, empty if the layer is not cached
+    SurfaceGrid grid;
+  };
+
+  struct VolumeEntry {
+    const TrackingVolume* volume = nullptr;
+    /// Indexed by the layer identifier
+    std::vector<LayerEntry> layers;
+  };
+
+  void buildVolume(const GeometryContext& gctx, const TrackingVolume& volume);
+
+  void buildSurfaceGrid(const GeometryContext& gctx, LayerEntry& entry);
+
+  const LayerEntry* layerEntry(const GeometryIdentifier& geoId) const;
+
+  bool matches(bool resolveSensitive, bool resolveMaterial,
+               bool resolvePassive) const {
+    return resolveSensitive == m_cfg.resolveSensitive &&
+           resolveMaterial == m_cfg.resolveMaterial &&
+           resolvePassive == m_cfg.resolvePassive;
+  }
+
+  const Logger& logger() const { return *m_logger; }
+
+  Config m_cfg;
+  Statistics m_statistics;
+  /// Indexed by the volume identifier
+  std::vector<VolumeEntry> m_volumes;
+  std::vector<const Surface*> m_surfaces;
+  std::vector<const Layer*> m_layers;
+  std::unique_ptr<const Logger> m_logger;
+};
+
+}  // namespace Acts
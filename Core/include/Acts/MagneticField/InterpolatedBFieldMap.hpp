@@ -12,11 +12,15 @@
 #include "Acts/MagneticField/MagneticFieldContext.hpp"
 #include "Acts/MagneticField/MagneticFieldError.hpp"
 #include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/MagneticField/detail/InterpolatedFieldGradient.hpp"
 #include "Acts/Utilities/Interpolation.hpp"
 #include "Acts/Utilities/Result.hpp"
 #include "Acts/Utilities/detail/Grid.hpp"
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <vector>
 
@@ -87,6 +91,9 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
     /// number of corner points defining the confining hyper-box
     static constexpr unsigned int N = 1 << DIM_POS;
 
+    /// corner field values, unaligned to keep the cell compact in the cache
+    using FieldMatrix = Eigen::Matrix<double, 3, N, Eigen::DontAlign>;
+
    public:
     /// @brief default constructor
     ///
@@ -102,8 +109,11 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
               std::array<double, DIM_POS> upperRight,
               std::array<Vector3, N> fieldValues)
         : m_lowerLeft(std::move(lowerLeft)),
-          m_upperRight(std::move(upperRight)),
-          m_fieldValues(std::move(fieldValues)) {}
+          m_upperRight(std::move(upperRight)) {
+      for (unsigned int i = 0; i < N; ++i) {
+        m_fieldValues.col(i) = fieldValues[i];
+      }
+    }
 
     /// @brief retrieve field at given position
     ///
@@ -112,10 +122,33 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
     ///
     /// @pre The given @c position must lie within the current field cell.
     Vector3 getField(const ActsVector<DIM_POS>& position) const {
-      // defined in Interpolation.hpp
-      return interpolate(position, m_lowerLeft, m_upperRight, m_fieldValues);
+      return m_fieldValues * weights(position);
+    }
+
+    /// @brief interpolation weights of the hyper box corners
+    ///
+    /// The multi-linear interpolation is the weighted sum of the corner
+    /// values, with the corners in the canonical order of Acts::interpolate.
+    ///
+    /// @param [in] position position in grid coordinates
+    /// @return weight of each corner, they sum up to one
+    ActsVector<N> weights(const ActsVector<DIM_POS>& position) const {
+      ActsVector<N> w = ActsVector<N>::Ones();
+      for (unsigned int d = 0; d < DIM_POS; ++d) {
+        const double t = (position[d] - m_lowerLeft[d]) /
+                         (m_upperRight[d] - m_lowerLeft[d]);
+        // the first dimension corresponds to the left most bit
+        const unsigned int bit = 1u << (DIM_POS - 1 - d);
+        for (unsigned int c = 0; c < N; ++c) {
+          w[c] *= (c & bit) ? t : 1. - t;
+        }
+      }
+      return w;
     }
 
+    /// @brief field values at the hyper box corners, one column per corner
+    const FieldMatrix& fieldValues() const { return m_fieldValues; }
+
     /// @brief check whether given 3D position is inside this field cell
     ///
     /// @param [in] position global 3D position
@@ -141,18 +174,37 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
     ///
     /// @note These values must be order according to the prescription detailed
     ///       in Acts::interpolate.
-    std::array<Vector3, N> m_fieldValues;
+    FieldMatrix m_fieldValues;
   };
 
   struct Cache {
+    /// Number of previously used cells which are kept in addition to the
+    /// current one, as many as fit into the buffer of the opaque field cache
+    /// next to the current cell and the bookkeeping members below. For a 3D
+    /// map this is a single cell, which keeps the cell on the other side of
+    /// a boundary crossed within a step.
+    static constexpr size_t kPreviousCells =
+        (MagneticFieldProvider::Cache::kBufferSize -
+         sizeof(std::optional<FieldCell>) - 2 * sizeof(size_t)) /
+        sizeof(std::optional<FieldCell>);
+    static_assert(kPreviousCells > 0,
+                  "Field cells are too large for the magnetic field cache");
+
     /// @brief Constructor with magnetic field context
     ///
     /// @param mctx the magnetic field context
     Cache(const MagneticFieldContext& mctx) { (void)mctx; }
 
+    /// The most recently used cell
     std::optional<FieldCell> fieldCell;
+    /// Previously used cells, checked before a new cell is created
+    std::array<std::optional<FieldCell>, kPreviousCells> previousCells;
+    /// Slot in @c previousCells to be replaced next
+    size_t nextSlot = 0;
     bool initialized = false;
   };
+  static_assert(sizeof(Cache) <= MagneticFieldProvider::Cache::kBufferSize,
+                "The field cache does not fit into the opaque field cache");
 
   /// @brief  Config structure for the interpolated B field map
   struct Config {
@@ -182,6 +234,15 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
     minBin.fill(1);
     m_lowerLeft = m_cfg.grid.lowerLeftBinEdge(minBin);
     m_upperRight = m_cfg.grid.lowerLeftBinEdge(m_cfg.grid.numLocalBins());
+
+    // the nodes are the lower edges of the bins [1, nBins]
+    const auto nBins = m_cfg.grid.numLocalBins();
+    m_gradientStep = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < DIM_POS; ++i) {
+      const double binWidth =
+          (m_upperRight[i] - m_lowerLeft[i]) / (nBins[i] - 1);
+      m_gradientStep = std::min(m_gradientStep, 1e-3 * binWidth);
+    }
   }
 
   /// @brief retrieve field cell for given position
@@ -299,33 +360,126 @@ class InterpolatedBFieldMap : public InterpolatedMagneticField {
                            MagneticFieldProvider::Cache& cache) const final {
     Cache& lcache = cache.get<Cache>();
     const auto gridPosition = m_cfg.transformPos(position);
-    if (!lcache.fieldCell || !(*lcache.fieldCell).isInside(gridPosition)) {
-      auto res = getFieldCell(position);
+    auto res = updateCache(lcache, position, gridPosition);
+    if (!res.ok()) {
+      return Result<Vector3>::failure(res.error());
+    }
+    return Result<Vector3>::success((*lcache.fieldCell).getField(gridPosition));
+  }
+
+  /// @brief retrieve the field at many positions
+  ///
+  /// This is equivalent to calling getField(const Vector3&,
+  /// MagneticFieldProvider::Cache&) for each position in turn. Consecutive
+  /// positions inside the same field cell are interpolated together as one
+  /// product of the corner field values with the matrix of their
+  /// interpolation weights, which Eigen evaluates with vector instructions.
+  ///
+  /// @param [in] positions global 3D positions
+  /// @param [out] fields magnetic field values, resized to @p positions
+  /// @param [in,out] cache Field provider specific cache object
+  /// @return error if a position is outside the field map, in which case
+  ///         only the fields before that position are valid
+  Result<void> getFieldBatch(const std::vector<Vector3>& positions,
+                             std::vector<Vector3>& fields,
+                             MagneticFieldProvider::Cache& cache) const {
+    /// maximum number of positions interpolated in one product
+    constexpr size_t kBlock = 8;
+    constexpr unsigned int nCorners = FieldCell::N;
+
+    Cache& lcache = cache.get<Cache>();
+    fields.resize(positions.size());
+
+    ActsMatrix<nCorners, kBlock> weights;
+    size_t begin = 0;
+    while (begin < positions.size()) {
+      auto gridPosition = m_cfg.transformPos(positions[begin]);
+      auto res = updateCache(lcache, positions[begin], gridPosition);
       if (!res.ok()) {
-        return Result<Vector3>::failure(res.error());
+        return res.error();
+      }
+      const FieldCell& cell = *lcache.fieldCell;
+
+      // collect the run of positions in the current cell
+      weights.col(0) = cell.weights(gridPosition);
+      size_t end = begin + 1;
+      for (; end < positions.size() && end - begin < kBlock; ++end) {
+        gridPosition = m_cfg.transformPos(positions[end]);
+        if (!cell.isInside(gridPosition)) {
+          break;
+        }
+        weights.col(end - begin) = cell.weights(gridPosition);
       }
-      lcache.fieldCell = *res;
+
+      const size_t nPoints = end - begin;
+      const Eigen::Matrix<double, 3, Eigen::Dynamic, 0, 3, kBlock> block =
+          cell.fieldValues() * weights.leftCols(nPoints);
+      for (size_t i = 0; i < nPoints; ++i) {
+        fields[begin + i] = block.col(i);
+      }
+      begin = end;
     }
-    return Result<Vector3>::success((*lcache.fieldCell).getField(gridPosition));
+    return Result<void>::success();
   }
 
   /// @copydoc MagneticFieldProvider::getFieldGradient(const Vector3&,ActsMatrix<3,3>&,MagneticFieldProvider::Cache&) const
   ///
-  /// @note currently the derivative is not calculated
-  /// @note Cache is not used currently
-  /// @todo return derivative
+  /// @note The gradient is evaluated with central differences of the
+  ///       interpolated field, with a step of a thousandth of the smallest
+  ///       bin width. One-sided differences are used at the map boundary.
   Result<Vector3> getFieldGradient(
       const Vector3& position, ActsMatrix<3, 3>& derivative,
       MagneticFieldProvider::Cache& cache) const final {
-    (void)derivative;
-    return getField(position, cache);
+    auto res = getField(position, cache);
+    if (!res.ok()) {
+      return res;
+    }
+    detail::interpolatedFieldGradient(*this, position, *res, m_gradientStep,
+                                      derivative);
+    return res;
   }
 
  private:
+  /// @brief make sure the current cell of the cache contains a position
+  ///
+  /// The current cell is kept if it contains the position, otherwise the
+  /// previously used cells are checked before a new cell is created. The
+  /// replaced current cell is kept as a previously used cell.
+  ///
+  /// @param [in,out] lcache the field cache
+  /// @param [in] position global 3D position
+  /// @param [in] gridPosition the position in grid coordinates
+  /// @return error if the position is outside the field map
+  Result<void> updateCache(Cache& lcache, const Vector3& position,
+                           const ActsVector<DIM_POS>& gridPosition) const {
+    if (lcache.fieldCell && (*lcache.fieldCell).isInside(gridPosition)) {
+      return Result<void>::success();
+    }
+    for (auto& cell : lcache.previousCells) {
+      if (cell && (*cell).isInside(gridPosition)) {
+        std::swap(cell, lcache.fieldCell);
+        return Result<void>::success();
+      }
+    }
+    auto res = getFieldCell(position);
+    if (!res.ok()) {
+      return res.error();
+    }
+    if (lcache.fieldCell) {
+      lcache.previousCells[lcache.nextSlot] = std::move(lcache.fieldCell);
+      lcache.nextSlot = (lcache.nextSlot + 1) % Cache::kPreviousCells;
+    }
+    lcache.fieldCell = *res;
+    return Result<void>::success();
+  }
+
   Config m_cfg;
 
   typename Grid::point_t m_lowerLeft;
   typename Grid::point_t m_upperRight;
+
+  /// step used for the numerical field gradient
+  double m_gradientStep = 0.;
 };
 
 }  // namespace Acts
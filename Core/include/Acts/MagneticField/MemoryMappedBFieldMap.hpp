@@ -0,0 +1,248 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/MagneticField/InterpolatedBFieldMap.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/detail/Axis.hpp"
+#include "Acts/Utilities/detail/Grid.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Storage precision of the field values in a binary field map file
+enum class BFieldMapStorage : std::uint32_t {
+  /// IEEE double precision, lossless with respect to the source map
+  Float64 = 0,
+  /// IEEE single precision
+  Float32 = 1,
+  /// IEEE half precision, in units of Tesla
+  Float16 = 2,
+  /// 16 bit fixed point, scaled to the largest field component of the map
+  Fixed16 = 3,
+};
+
+/// @brief Coordinate system of the grid of a binary field map file
+enum class BFieldMapCoordinates : std::uint32_t {
+  /// 3D cartesian grid with (Bx,By,Bz) field values
+  XYZ = 0,
+  /// 2D cylindrical grid with (Br,Bz) field values
+  RZ = 1,
+};
+
+/// @brief Header of a binary field map file
+///
+/// The header is followed at @c dataOffset bytes by the field values of all
+/// grid nodes, stored with the precision given by @c storage. The nodes are
+/// ordered with the last grid axis running fastest, and the components of
+/// each node are stored next to each other. A stored value multiplied by
+/// @c fieldScale gives the field in internal units.
+///
+/// The file is written in the native byte order, which is checked on reading
+/// with @c byteOrderMark.
+struct BinaryBFieldMapHeader {
+  static constexpr std::array<char, 8> kMagic = {'A', 'C', 'T', 'S',
+                                                 'B', 'F', 'M', '\0'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t byteOrderMark = kByteOrderMark;
+  std::uint32_t storage = 0;
+  std::uint32_t coordinates = 0;
+  /// number of grid axes, 2 for RZ and 3 for XYZ
+  std::uint32_t nDim = 0;
+  /// number of field components per node
+  std::uint32_t nComponents = 0;
+  /// number of grid nodes along each axis
+  std::array<std::uint64_t, 3> nNodes = {0, 0, 0};
+  /// position of the first node along each axis
+  std::array<double, 3> min = {0., 0., 0.};
+  /// position of the last node along each axis
+  std::array<double, 3> max = {0., 0., 0.};
+  /// conversion of the stored values to internal units
+  double fieldScale = 1.;
+  /// offset of the field values from the start of the file
+  std::uint64_t dataOffset = 0;
+};
+
+/// @ingroup MagneticField
+/// @brief interpolate the magnetic field from a memory-mapped binary field map
+///
+/// The field map file, as written by writeBinaryBFieldMap(), is mapped into
+/// memory read-only and shared, such that loading does not copy the field
+/// values and all processes using the same file share one copy of the pages.
+/// The field values are decoded from the reduced precision storage when a
+/// new grid cell is entered and are kept in the cache for the subsequent
+/// lookups in the same cell.
+///
+/// The interpolation domain, the grid nodes and the interpolation are the
+/// same as for the InterpolatedBFieldMap the file was written from.
+class MemoryMappedBFieldMap final : public InterpolatedMagneticField {
+ public:
+  /// @brief the decoded field values of the current grid cell
+  struct Cache {
+    /// @brief constructor with context
+    Cache(const MagneticFieldContext& /*mctx*/) {}
+
+    /// lower left corner of the cell in grid coordinates
+    std::array<double, 3> lowerLeft = {0., 0., 0.};
+    /// upper right corner of the cell in grid coordinates
+    std::array<double, 3> upperRight = {0., 0., 0.};
+    /// field values at the cell corners in grid coordinates, where the bits
+    /// of the corner index select the upper node of the axes
+    std::array<Vector3, 8> corners;
+    bool initialized = false;
+  };
+
+  /// @brief map a binary field map file
+  ///
+  /// @param path the binary field map file
+  /// @param scale global factor applied to the field values
+  ///
+  /// @throw std::runtime_error if the file can not be mapped or is not a
+  ///        valid binary field map
+  explicit MemoryMappedBFieldMap(const std::string& path, double scale = 1.);
+
+  MemoryMappedBFieldMap(const MemoryMappedBFieldMap&) = delete;
+  MemoryMappedBFieldMap& operator=(const MemoryMappedBFieldMap&) = delete;
+
+  ~MemoryMappedBFieldMap() override;
+
+  /// @brief the header of the mapped file
+  const BinaryBFieldMapHeader& header() const { return m_header; }
+
+  /// @brief the storage precision of the field values
+  BFieldMapStorage storage() const {
+    return static_cast<BFieldMapStorage>(m_header.storage);
+  }
+
+  /// @brief the coordinate system of the field map grid
+  BFieldMapCoordinates coordinates() const {
+    return static_cast<BFieldMapCoordinates>(m_header.coordinates);
+  }
+
+  /// @brief size of the mapped file in bytes
+  std::size_t mappedSize() const { return m_size; }
+
+  /// @copydoc InterpolatedMagneticField::getNBins() const
+  ///
+  /// @note In line with InterpolatedBFieldMap, this is the number of grid
+  ///       nodes along each axis.
+  std::vector<std::size_t> getNBins() const final;
+
+  /// @copydoc InterpolatedMagneticField::getMin() const
+  std::vector<double> getMin() const final;
+
+  /// @copydoc InterpolatedMagneticField::getMax() const
+  std::vector<double> getMax() const final;
+
+  /// @copydoc InterpolatedMagneticField::isInside(const Vector3&) const
+  bool isInside(const Vector3& position) const final;
+
+  /// @copydoc InterpolatedMagneticField::getFieldUnchecked(const Vector3&) const
+  Vector3 getFieldUnchecked(const Vector3& position) const final;
+
+  /// @brief retrieve field at given position
+  ///
+  /// @param [in] position global 3D position
+  /// @return magnetic field value at the given position
+  Result<Vector3> getField(const Vector3& position) const;
+
+  /// @copydoc MagneticFieldProvider::makeCache(const MagneticFieldContext&) const
+  MagneticFieldProvider::Cache makeCache(
+      const MagneticFieldContext& mctx) const final;
+
+  /// @copydoc MagneticFieldProvider::getField(const Vector3&,MagneticFieldProvider::Cache&) const
+  Result<Vector3> getField(const Vector3& position,
+                           MagneticFieldProvider::Cache& cache) const final;
+
+  /// @copydoc MagneticFieldProvider::getFieldGradient(const Vector3&,ActsMatrix<3,3>&,MagneticFieldProvider::Cache&) const
+  ///
+  /// @note As for InterpolatedBFieldMap, the gradient is evaluated with
+  ///       central differences of the interpolated field, with a step of a
+  ///       thousandth of the smallest bin width.
+  Result<Vector3> getFieldGradient(
+      const Vector3& position, ActsMatrix<3, 3>& derivative,
+      MagneticFieldProvider::Cache& cache) const final;
+
+ private:
+  /// @brief map the global position onto the grid
+  Vector3 gridPosition(const Vector3& position) const;
+
+  /// @brief check whether a grid position is inside the interpolation domain
+  bool isInsideLocal(const Vector3& gridPos) const;
+
+  /// @brief decode the field values of the cell containing a grid position
+  void fillCell(const Vector3& gridPos, Cache& cell) const;
+
+  /// @brief interpolate within a cell and transform to the global frame
+  Vector3 interpolate(const Cache& cell, const Vector3& gridPos,
+                      const Vector3& position) const;
+
+  /// @brief decode one stored field component
+  double value(std::size_t index) const;
+
+  BinaryBFieldMapHeader m_header;
+  double m_scale = 1.;
+  /// node spacing along each axis
+  std::array<double, 3> m_binWidth = {1., 1., 1.};
+  /// distance between successive nodes of each axis in stored values
+  std::array<std::size_t, 3> m_stride = {0, 0, 0};
+  /// step used for the numerical field gradient
+  double m_gradientStep = 0.;
+
+  void* m_mapping = nullptr;
+  std::size_t m_size = 0;
+  const unsigned char* m_data = nullptr;
+};
+
+/// @brief write a cylindrical field map to a binary field map file
+///
+/// @param path the output file
+/// @param bField the field map as created by fieldMapRZ()
+/// @param storage the precision of the stored field values
+///
+/// @throw std::invalid_argument if the field map does not use the standard
+///        (x,y,z) -> (r,z) position and (Br,Bz) -> (Bx,By,Bz) field transforms
+///        of fieldMapRZ(), which are the only ones the file format represents
+/// @throw std::runtime_error if the file can not be written
+void writeBinaryBFieldMap(
+    const std::string& path,
+    const InterpolatedBFieldMap<detail::Grid<
+        Vector2, detail::EquidistantAxis, detail::EquidistantAxis>>& bField,
+    BFieldMapStorage storage);
+
+/// @brief write a cartesian field map to a binary field map file
+///
+/// @param path the output file
+/// @param bField the field map as created by fieldMapXYZ()
+/// @param storage the precision of the stored field values
+///
+/// @throw std::invalid_argument if the field map does not use the identity
+///        position and field transforms of fieldMapXYZ(), which are the only
+///        ones the file format represents
+/// @throw std::runtime_error if the file can not be written
+void writeBinaryBFieldMap(
+    const std::string& path,
+    const InterpolatedBFieldMap<
+        detail::Grid<Vector3, detail::EquidistantAxis, detail::EquidistantAxis,
+                     detail::EquidistantAxis>>& bField,
+    BFieldMapStorage storage);
+
+}  // namespace Acts
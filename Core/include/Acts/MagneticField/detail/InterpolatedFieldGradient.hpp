@@ -0,0 +1,52 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+
+namespace Acts {
+namespace detail {
+
+/// Gradient of an interpolated field map from central differences
+///
+/// One-sided differences are used where a shifted position is outside of the
+/// interpolation domain, and the derivative along an axis is zero if both
+/// are outside.
+///
+/// @tparam field_t the field map, providing @c isInside and
+///         @c getFieldUnchecked for global positions
+/// @param field the field map
+/// @param position the global position, inside the interpolation domain
+/// @param fieldValue the field at @p position
+/// @param step the step of the differences
+/// @param [out] derivative the derivative of the field, where column @c j
+///        is the derivative along the global axis @c j
+template <typename field_t>
+void interpolatedFieldGradient(const field_t& field, const Vector3& position,
+                               const Vector3& fieldValue, double step,
+                               ActsMatrix<3, 3>& derivative) {
+  for (unsigned int j = 0; j < 3; ++j) {
+    Vector3 shift = Vector3::Zero();
+    shift[j] = step;
+    const Vector3 up = position + shift;
+    const Vector3 down = position - shift;
+    const bool upInside = field.isInside(up);
+    const bool downInside = field.isInside(down);
+    const Vector3 fieldUp = upInside ? field.getFieldUnchecked(up) : fieldValue;
+    const Vector3 fieldDown =
+        downInside ? field.getFieldUnchecked(down) : fieldValue;
+    const double width =
+        ((upInside ? 1. : 0.) + (downInside ? 1. : 0.)) * step;
+    derivative.col(j) = (width > 0.) ? Vector3((fieldUp - fieldDown) / width)
+                                     : Vector3::Zero();
+  }
+}
+
+}  // namespace detail
+}  // namespace Acts
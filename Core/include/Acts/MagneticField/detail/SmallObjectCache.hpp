@@ -19,6 +19,9 @@ namespace detail {
 /// Small opaque cache type which uses small buffer optimization
 class SmallObjectCache {
  public:
+  /// Size of the buffer the cached object is stored in
+  static constexpr std::size_t kBufferSize = 512;
+
   template <typename T, typename... Args>
   static SmallObjectCache make(Args&&... args) {
     SmallObjectCache cache{};
@@ -108,7 +111,7 @@ class SmallObjectCache {
     }
   };
 
-  alignas(std::max_align_t) std::array<char, 512> m_data{};
+  alignas(std::max_align_t) std::array<char, kBufferSize> m_data{};
   HandlerBase* m_handler{nullptr};
 };
 
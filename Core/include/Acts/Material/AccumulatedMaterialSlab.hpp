@@ -71,6 +71,17 @@ class AccumulatedMaterialSlab {
   /// unless explicitely requested.
   void trackAverage(bool useEmptyTrack = false);
 
+  /// Add the total average of another accumulation to this one.
+  ///
+  /// @param other Accumulated material, e.g. from a different thread or event
+  ///
+  /// The result is the same as if the tracks of both accumulations had been
+  /// added to a single one, up to rounding. Each track contributes equally,
+  /// i.e. the totals are weighted with their number of tracks. Only the
+  /// total stores are merged; the per-track stores are expected to be empty,
+  /// i.e. all tracks have been finished with `.trackAverage(...)`.
+  void merge(const AccumulatedMaterialSlab& other);
+
   /// Return the average material properties from all accumulated tracks.
   ///
   /// @returns Average material properties and the number of contributing tracks
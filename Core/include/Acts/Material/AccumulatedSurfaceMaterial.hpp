@@ -130,6 +130,14 @@ class AccumulatedSurfaceMaterial {
   /// @param emptyHit indicator if this is an empty assignment
   void trackAverage(const Vector3& gp, bool emptyHit = false);
 
+  /// Add the material accumulated by another instance bin by bin
+  ///
+  /// @param other is the accumulated material to be added, e.g. from a
+  ///        different thread or event, it needs the same binning
+  ///
+  /// @throws std::invalid_argument if the number of bins differs
+  void merge(const AccumulatedSurfaceMaterial& other);
+
   /// Total average creates SurfaceMaterial
   std::unique_ptr<const ISurfaceMaterial> totalAverage();
 
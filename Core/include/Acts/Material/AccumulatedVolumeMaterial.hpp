@@ -22,6 +22,11 @@ class AccumulatedVolumeMaterial {
   /// Add one entry with the given material properties.
   void accumulate(const MaterialSlab& mat);
 
+  /// Add all entries collected by another instance.
+  ///
+  /// @param other Accumulated material, e.g. from a different thread or event
+  void merge(const AccumulatedVolumeMaterial& other);
+
   /// Compute the average material collected so far.
   ///
   /// @returns Vacuum properties if no matter has been accumulated yet.
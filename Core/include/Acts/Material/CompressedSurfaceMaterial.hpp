@@ -0,0 +1,184 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Material/ISurfaceMaterial.hpp"
+#include "Acts/Material/MaterialSlab.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/BinningType.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace Acts {
+
+class BinnedSurfaceMaterial;
+
+/// @class CompressedSurfaceMaterial
+///
+/// It extends the @c ISurfaceMaterial base class and is the memory optimised
+/// counterpart of the BinnedSurfaceMaterial: the distinct MaterialSlab
+/// objects are stored once in a palette, and every bin only holds a 16 bit
+/// index into the palette.
+///
+/// Mapped material is rarely identical between bins. The palette can
+/// therefore be built with a relative precision, to which the material
+/// parameters and the thickness are rounded before they are compared.
+///
+/// The binning of the BinUtility is unpacked at construction into a flat
+/// lookup per dimension, such that a global lookup only needs a single
+/// transform and no indirect calls.
+class CompressedSurfaceMaterial : public ISurfaceMaterial {
+ public:
+  /// Index type of the palette entries
+  using PaletteIndex = std::uint16_t;
+
+  /// Default Constructor - deleted
+  CompressedSurfaceMaterial() = delete;
+
+  /// Explicit constructor from the full material matrix
+  ///
+  /// @param binUtility defines the binning structure on the surface (copied)
+  /// @param fullProperties is the matrix of properties as recorded
+  /// @param splitFactor is the pre/post splitting directive
+  /// @param mappingType is the type of surface mapping associated to the surface
+  /// @param precision is the relative precision of the palette, the
+  ///        material is only deduplicated if exactly equal for zero
+  ///
+  /// @throws std::invalid_argument if the matrix does not match the binning
+  ///         or if there are more distinct material slabs than indices
+  CompressedSurfaceMaterial(const BinUtility& binUtility,
+                            const MaterialSlabMatrix& fullProperties,
+                            double splitFactor = 0.,
+                            MappingType mappingType = MappingType::Default,
+                            float precision = 0.);
+
+  /// Explicit constructor from binned material
+  ///
+  /// @param bsm is the binned material to be compressed
+  /// @param precision is the relative precision of the palette
+  CompressedSurfaceMaterial(const BinnedSurfaceMaterial& bsm,
+                            float precision = 0.);
+
+  /// Copy Move Constructor
+  ///
+  /// @param csm is the source object to be copied
+  CompressedSurfaceMaterial(CompressedSurfaceMaterial&& csm) = default;
+
+  /// Copy Constructor
+  ///
+  /// @param csm is the source object to be copied
+  CompressedSurfaceMaterial(const CompressedSurfaceMaterial& csm) = default;
+
+  /// Assignment Move operator
+  CompressedSurfaceMaterial& operator=(CompressedSurfaceMaterial&& csm) =
+      default;
+
+  /// Assignment operator
+  CompressedSurfaceMaterial& operator=(const CompressedSurfaceMaterial& csm) =
+      default;
+
+  /// Destructor
+  ~CompressedSurfaceMaterial() override = default;
+
+  /// Scale operator
+  ///
+  /// @param scale is the scale factor for the full material
+  CompressedSurfaceMaterial& operator*=(double scale) final;
+
+  /// Check whether the distinct material slabs fit into the palette
+  ///
+  /// @param fullProperties is the matrix of properties as recorded
+  /// @param precision is the relative precision of the palette
+  ///
+  /// @return false if the constructor would throw for too many distinct
+  ///         material slabs, e.g. to keep binned material instead
+  static bool fitsPalette(const MaterialSlabMatrix& fullProperties,
+                          float precision = 0.);
+
+  /// Return the BinUtility
+  const BinUtility& binUtility() const { return m_binUtility; }
+
+  /// Return the distinct material slabs
+  const std::vector<MaterialSlab>& palette() const { return m_palette; }
+
+  /// Return the palette index of every bin, bin0 runs fastest
+  const std::vector<PaletteIndex>& indices() const { return m_indices; }
+
+  /// Expand into the full material slab matrix
+  MaterialSlabMatrix fullMaterial() const;
+
+  /// @copydoc ISurfaceMaterial::materialSlab(const Vector2&) const
+  const MaterialSlab& materialSlab(const Vector2& lp) const final;
+
+  /// @copydoc ISurfaceMaterial::materialSlab(const Vector3&) const
+  const MaterialSlab& materialSlab(const Vector3& gp) const final;
+
+  /// @copydoc ISurfaceMaterial::materialSlab(size_t, size_t) const
+  const MaterialSlab& materialSlab(size_t bin0, size_t bin1) const final {
+    return m_palette[m_indices[bin1 * m_bins0 + bin0]];
+  }
+
+  /// Output Method for std::ostream, to be overloaded by child classes
+  std::ostream& toStream(std::ostream& sl) const final;
+
+ private:
+  /// Binning of one dimension, unpacked from the BinningData
+  struct BinLookup {
+    /// The binned value
+    BinningValue value = binX;
+    /// Open or closed binning
+    BinningOption option = open;
+    /// The local coordinate which is binned
+    unsigned int localIndex = 0;
+    /// The number of bins, a single bin needs no search
+    size_t bins = 1;
+    /// Equidistant binning parameters
+    float min = 0.;
+    float max = 0.;
+    float step = 0.;
+    /// The bin boundaries, only filled for arbitrary binning
+    std::vector<float> boundaries;
+
+    /// The bin of a value, identical to the BinningData search
+    size_t search(float v) const;
+  };
+
+  /// Build the palette and the indices
+  void compress(const MaterialSlabMatrix& fullProperties, float precision);
+
+  /// The helper for the bin finding
+  BinUtility m_binUtility;
+
+  /// The inverse transform of the binning
+  Transform3 m_itransform = Transform3::Identity();
+
+  /// Whether the inverse transform can be skipped
+  bool m_identity = true;
+
+  /// Whether the fast lookup is available, i.e. there is no sub binning
+  bool m_fastLookup = true;
+
+  /// The lookup for the two dimensions
+  std::array<BinLookup, 2> m_lookup;
+
+  /// The number of bins in dimension 0
+  size_t m_bins0 = 1;
+
+  /// The distinct material slabs
+  std::vector<MaterialSlab> m_palette;
+
+  /// The palette index for every bin
+  std::vector<PaletteIndex> m_indices;
+};
+
+}  // namespace Acts
@@ -85,6 +85,9 @@ class ISurfaceMaterial {
   ///
   MappingType mappingType() const { return m_mappingType; }
 
+  /// Return the splitting ratio between pre/post update
+  double splitFactor() const { return m_splitFactor; }
+
   /// Return method for fully scaled material description of the Surface
   /// - from local coordinate on the surface
   ///
@@ -9,8 +9,11 @@
 #pragma once
 
 #include "Acts/Definitions/Algebra.hpp"
+#include "Acts/MagneticField/detail/SmallObjectCache.hpp"
 #include "Acts/Material/Material.hpp"
 
+#include <optional>
+
 namespace Acts {
 
 class Material;
@@ -22,15 +25,63 @@ class Material;
 /// Material associated with a Volume (homogenous, binned, interpolated)
 class IVolumeMaterial {
  public:
+  /// @brief Cache for consecutive material lookups, e.g. along a track
+  ///
+  /// The cache is filled by the material it is used with and is reset when
+  /// it is used with a different material, e.g. after a volume change. The
+  /// material specific data is stored inline, as for the magnetic field
+  /// cache, such that no lookup allocates. A copy of a cache is empty.
+  struct Cache {
+    Cache() = default;
+    Cache(const Cache& /*other*/) {}
+    Cache(Cache&& other) = default;
+    Cache& operator=(const Cache& /*other*/) {
+      reset();
+      return *this;
+    }
+    Cache& operator=(Cache&& other) {
+      // the move assignment of the data requires the same type on both sides
+      reset();
+      owner = other.owner;
+      if (other.data.has_value()) {
+        data.emplace(std::move(*other.data));
+      }
+      return *this;
+    }
+
+    /// Drop the data of the material which filled the cache
+    void reset() {
+      owner = nullptr;
+      data.reset();
+    }
+
+    /// The material which filled the cache
+    const IVolumeMaterial* owner = nullptr;
+    /// Material specific data, e.g. the current interpolation cell
+    std::optional<detail::SmallObjectCache> data;
+  };
+
   /// Virtual Destructor
   virtual ~IVolumeMaterial() = default;
 
   /// Access to actual material
   ///
   /// @param position is the request position for the material call
-  /// @todo interface to change including 'cell'
   virtual const Material material(const Vector3& position) const = 0;
 
+  /// Access to actual material, reusing the information of previous lookups
+  ///
+  /// Materials which are defined on a grid may return the interpolated
+  /// material here, instead of the binned one of material(const Vector3&).
+  ///
+  /// @param position is the request position for the material call
+  /// @param cache is the cache of the previous lookups
+  virtual Material cachedMaterial(const Vector3& position,
+                                  Cache& cache) const {
+    (void)cache;
+    return material(position);
+  }
+
   /// @brief output stream operator
   ///
   /// Prints information about this object to the output stream using the
@@ -38,6 +38,9 @@ struct MaterialMapper {
     /// Number of corner points defining the confining hyper-box
     static constexpr unsigned int N = 1 << DIM_POS;
 
+    /// Corner material values, unaligned to keep the cell compact in caches
+    using MaterialMatrix = Eigen::Matrix<double, 5, N, Eigen::DontAlign>;
+
     /// @brief Default constructor
     ///
     /// @param [in] transformPos   Mapping of global 3D coordinates onto grid
@@ -57,8 +60,14 @@ struct MaterialMapper {
         std::array<Material::ParametersVector, N> materialValues)
         : m_transformPos(std::move(transformPos)),
           m_lowerLeft(std::move(lowerLeft)),
-          m_upperRight(std::move(upperRight)),
-          m_materialValues(std::move(materialValues)) {}
+          m_upperRight(std::move(upperRight)) {
+      for (unsigned int d = 0; d < DIM_POS; ++d) {
+        m_invWidth[d] = 1. / (m_upperRight[d] - m_lowerLeft[d]);
+      }
+      for (unsigned int i = 0; i < N; ++i) {
+        m_materialValues.col(i) = materialValues[i].template cast<double>();
+      }
+    }
 
     /// @brief Retrieve material at given position
     ///
@@ -67,9 +76,40 @@ struct MaterialMapper {
     ///
     /// @pre The given @c position must lie within the current cell.
     Material getMaterial(const Vector3& position) const {
-      // defined in Interpolation.hpp
-      return Material(interpolate(m_transformPos(position), m_lowerLeft,
-                                  m_upperRight, m_materialValues));
+      return getMaterialLocal(m_transformPos(position));
+    }
+
+    /// @brief Retrieve material at given grid position
+    ///
+    /// @param [in] gridPosition Position in grid coordinates
+    /// @return Material at the given position
+    ///
+    /// @pre The given @c gridPosition must lie within the current cell.
+    Material getMaterialLocal(const ActsVector<DIM_POS>& gridPosition) const {
+      return Material(Material::ParametersVector(
+          (m_materialValues * weights(gridPosition)).template cast<float>()));
+    }
+
+    /// @brief Interpolation weights of the hyper box corners
+    ///
+    /// The multi-linear interpolation is the weighted sum of the corner
+    /// values, with the corners in the canonical order of Acts::interpolate.
+    ///
+    /// @param [in] gridPosition Position in grid coordinates
+    /// @return Weight of each corner, they sum up to one
+    ActsVector<N> weights(const ActsVector<DIM_POS>& gridPosition) const {
+      // built up as a tensor product, such that the first dimension ends up
+      // in the left most bit of the corner index
+      ActsVector<N> w;
+      w[0] = 1.;
+      for (unsigned int d = 0, n = 1; d < DIM_POS; ++d, n *= 2) {
+        const double t = (gridPosition[d] - m_lowerLeft[d]) * m_invWidth[d];
+        for (unsigned int j = n; j-- > 0;) {
+          w[2 * j + 1] = w[j] * t;
+          w[2 * j] = w[j] * (1. - t);
+        }
+      }
+      return w;
     }
 
     /// @brief Check whether given 3D position is inside this cell
@@ -78,10 +118,18 @@ struct MaterialMapper {
     /// @return @c true if position is inside the current cell,
     ///         otherwise @c false
     bool isInside(const Vector3& position) const {
-      const auto& gridCoordinates = m_transformPos(position);
+      return isInsideLocal(m_transformPos(position));
+    }
+
+    /// @brief Check whether given grid position is inside this cell
+    ///
+    /// @param [in] gridPosition Position in grid coordinates
+    /// @return @c true if position is inside the current cell,
+    ///         otherwise @c false
+    bool isInsideLocal(const ActsVector<DIM_POS>& gridPosition) const {
       for (unsigned int i = 0; i < DIM_POS; ++i) {
-        if (gridCoordinates[i] < m_lowerLeft.at(i) ||
-            gridCoordinates[i] >= m_upperRight.at(i)) {
+        if (gridPosition[i] < m_lowerLeft[i] ||
+            gridPosition[i] >= m_upperRight[i]) {
           return false;
         }
       }
@@ -98,11 +146,14 @@ struct MaterialMapper {
     /// Generalized upper-right corner of the confining hyper-box
     std::array<double, DIM_POS> m_upperRight;
 
+    /// Inverse extent of the confining hyper-box along each dimension
+    std::array<double, DIM_POS> m_invWidth{};
+
     /// @brief Material component vectors at the hyper-box corners
     ///
     /// @note These values must be order according to the prescription detailed
     ///       in Acts::interpolate.
-    std::array<Material::ParametersVector, N> m_materialValues;
+    MaterialMatrix m_materialValues;
   };
 
   /// @brief Default constructor
@@ -115,6 +166,14 @@ struct MaterialMapper {
       Grid_t grid)
       : m_transformPos(std::move(transformPos)), m_grid(std::move(grid)) {}
 
+  /// @brief Map a global position onto the grid
+  ///
+  /// @param [in] position Global 3D position
+  /// @return Position in grid coordinates
+  ActsVector<DIM_POS> gridPosition(const Vector3& position) const {
+    return m_transformPos(position);
+  }
+
   /// @brief Retrieve binned material at given position
   ///
   /// @param [in] position Global 3D position
@@ -282,11 +341,41 @@ class InterpolatedMaterialMap : public IVolumeMaterial {
   ///
   /// @return material at given position
   Material getMaterial(const Vector3& position, Cache& cache) const {
-    if (!cache.initialized || !(*cache.matCell).isInside(position)) {
+    const auto gridPosition = m_mapper.gridPosition(position);
+    if (!cache.initialized || !(*cache.matCell).isInsideLocal(gridPosition)) {
       cache.matCell = getMaterialCell(position);
       cache.initialized = true;
     }
-    return (*cache.matCell).getMaterial(position);
+    return (*cache.matCell).getMaterialLocal(gridPosition);
+  }
+
+  /// @brief Retrieve the interpolated material with a cache
+  ///
+  /// Consecutive lookups in the same grid cell reuse the cell and only
+  /// evaluate its interpolation weights. Outside of the grid the binned
+  /// material is returned.
+  ///
+  /// @param [in] position Global 3D position
+  /// @param [in,out] cache Cache object, holds the material cell
+  ///
+  /// @return material at given position
+  Material cachedMaterial(const Vector3& position,
+                          IVolumeMaterial::Cache& cache) const final {
+    if (cache.owner != this || !cache.data.has_value()) {
+      cache.reset();
+      cache.data.emplace(detail::SmallObjectCache::make<Cache>());
+      cache.owner = this;
+    }
+    Cache& lcache = cache.data->get<Cache>();
+    const auto gridPosition = m_mapper.gridPosition(position);
+    if (!lcache.initialized || !(*lcache.matCell).isInsideLocal(gridPosition)) {
+      if (!m_mapper.getGrid().isInside(gridPosition)) {
+        return m_mapper.material(position);
+      }
+      lcache.matCell = getMaterialCell(position);
+      lcache.initialized = true;
+    }
+    return (*lcache.matCell).getMaterialLocal(gridPosition);
   }
 
   /// @brief Retrieve material value & its "gradient"
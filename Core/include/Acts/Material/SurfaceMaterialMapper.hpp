@@ -153,6 +153,25 @@ class SurfaceMaterialMapper {
                     const MagneticFieldContext& mctx,
                     const TrackingGeometry& tGeometry) const;
 
+  /// @brief helper method that creates a cache from another one
+  ///
+  /// @param [in] prototype The state to be copied
+  ///
+  /// The created state has the material layout and the accumulated
+  /// surface material of the prototype, but none of its finalized maps. This
+  /// allows to map tracks into independent states, e.g. one per event or
+  /// per thread, which are combined with `mergeState(...)` afterwards.
+  State createState(const State& prototype) const;
+
+  /// @brief Method to add the material accumulated in another state
+  ///
+  /// @param mState The state to be extended
+  /// @param other The state to be added, created from the same geometry
+  ///
+  /// @note The result depends on the order of the merges up to rounding,
+  /// a fixed merge order is needed for reproducible maps
+  void mergeState(State& mState, const State& other) const;
+
   /// @brief Method to finalize the maps
   ///
   /// It calls the final run averaging and then transforms
@@ -0,0 +1,126 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Utilities/Ray.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Acts {
+
+class Surface;
+
+namespace Experimental {
+
+/// @brief A bounding volume hierarchy of surfaces for ray queries
+///
+/// The axis aligned bounding boxes of the surfaces are split recursively at
+/// the median of their centers along the axis of largest spread, until at
+/// most @c leafSize surfaces are left in a node.
+///
+/// The nodes are stored depth first in a single vector: the first child of a
+/// node directly follows it and every node holds the index to continue with
+/// if its box is missed. The traversal is hence a linear walk through the
+/// node vector that needs neither recursion nor a stack, and the surfaces of
+/// the leaves are stored contiguously in the same order.
+class SurfaceBoundingVolumeHierarchy {
+ public:
+  struct Config {
+    /// The maximum number of surfaces in a leaf node
+    std::size_t leafSize = 4;
+    /// The envelope added to the surface boxes in every direction
+    ActsScalar envelope = 1 * UnitConstants::mm;
+    /// The number of segments to approximate the surface bounds
+    unsigned int nSegments = 1;
+  };
+
+  /// A node of the flattened hierarchy
+  struct Node {
+    /// The minimum vertex of the node box
+    Vector3 min = Vector3(0., 0., 0.);
+    /// The maximum vertex of the node box
+    Vector3 max = Vector3(0., 0., 0.);
+    /// The node to continue with if the box is missed
+    std::uint32_t skip = 0;
+    /// The first surface of a leaf node
+    std::uint32_t first = 0;
+    /// The number of surfaces of a leaf node, zero for inner nodes
+    std::uint32_t count = 0;
+  };
+
+  /// Constructor
+  ///
+  /// @param gctx is the geometry context for the surface extents
+  /// @param surfaces are the surfaces to be put into the hierarchy
+  /// @param cfg is the configuration
+  ///
+  /// @note throws an exception if the leaf size is zero
+  SurfaceBoundingVolumeHierarchy(const GeometryContext& gctx,
+                                 const std::vector<const Surface*>& surfaces,
+                                 const Config& cfg) noexcept(false);
+
+  SurfaceBoundingVolumeHierarchy() = delete;
+
+  /// Visit all surfaces whose box is hit by the ray
+  ///
+  /// @tparam visitor_t is the type of the visitor, called with the surface
+  ///
+  /// @param ray is the ray, the box must not be entirely behind its origin
+  /// @param visitor is called once for every surface candidate
+  template <typename visitor_t>
+  void intersect(const Ray3D& ray, visitor_t&& visitor) const {
+    std::size_t index = 0;
+    while (index < m_nodes.size()) {
+      const Node& node = m_nodes[index];
+      if (not intersect(node, ray)) {
+        index = node.skip;
+        continue;
+      }
+      for (std::uint32_t is = node.first; is < node.first + node.count; ++is) {
+        visitor(m_surfaces[is]);
+      }
+      ++index;
+    }
+  }
+
+  /// Const access to the configuration
+  const Config& config() const { return m_cfg; }
+
+  /// Const access to the flattened nodes
+  const std::vector<Node>& nodes() const { return m_nodes; }
+
+  /// Const access to the surfaces, in the order of the leaves
+  const std::vector<const Surface*>& surfaces() const { return m_surfaces; }
+
+ private:
+  /// Slab test of a node box, boxes of zero width are accepted
+  ///
+  /// @param node is the node to be tested
+  /// @param ray is the ray to test against
+  static bool intersect(const Node& node, const Ray3D& ray) {
+    Ray3D::vertex_array_type t0s =
+        (node.min - ray.origin()).array() * ray.idir();
+    Ray3D::vertex_array_type t1s =
+        (node.max - ray.origin()).array() * ray.idir();
+    ActsScalar tmin = t0s.min(t1s).maxCoeff();
+    ActsScalar tmax = t0s.max(t1s).minCoeff();
+    return tmin <= tmax and tmax >= 0.;
+  }
+
+  Config m_cfg;
+  std::vector<Node> m_nodes;
+  std::vector<const Surface*> m_surfaces;
+};
+
+}  // namespace Experimental
+}  // namespace Acts
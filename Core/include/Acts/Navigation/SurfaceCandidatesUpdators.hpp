@@ -15,8 +15,10 @@
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/Navigation/NavigationState.hpp"
 #include "Acts/Navigation/NavigationStateUpdators.hpp"
+#include "Acts/Navigation/SurfaceBoundingVolumeHierarchy.hpp"
 #include "Acts/Surfaces/Surface.hpp"
 
+#include <algorithm>
 #include <tuple>
 
 namespace Acts {
@@ -162,6 +164,86 @@ inline static SurfaceCandidatesUpdator allPortalsAndSurfaces() {
   return nStateUpdator;
 }
 
+/// @brief An ordered list of portals and the surfaces from a bounding volume
+/// hierarchy, i.e. only the surfaces whose bounding box is hit by the
+/// straight line from the current position along the current direction
+///
+/// The hierarchy is queried again at every update, such that the surfaces
+/// follow the current direction of a curved track.
+struct BoundingVolumeHierarchyImpl : public INavigationDelegate {
+  /// The surface hierarchy of the volume
+  SurfaceBoundingVolumeHierarchy hierarchy;
+
+  /// Constructor from the surface hierarchy
+  ///
+  /// @param bvh is the surface hierarchy to be queried
+  BoundingVolumeHierarchyImpl(SurfaceBoundingVolumeHierarchy bvh)
+      : hierarchy(std::move(bvh)) {}
+
+  /// An ordered list of portals and surfaces provider
+  ///
+  /// @param gctx is the Geometry context of this call
+  /// @param nState is the navigation state to be updated
+  ///
+  /// @note the straight line starts at the overstep tolerance behind the
+  /// current position, such that surfaces that are still reachable within
+  /// the tolerance are not lost
+  inline void update(const GeometryContext& gctx,
+                     NavigationState& nState) const {
+    if (nState.currentVolume == nullptr) {
+      throw std::runtime_error(
+          "BoundingVolumeHierarchyImpl: no detector volume set to navigation "
+          "state.");
+    }
+    auto& candidates = nState.surfaceCandidates;
+    if (candidates.empty()) {
+      // A volume switch has happened, fill the internal portals if existing
+      for (const auto v : nState.currentVolume->volumes()) {
+        const auto& iPortals = v->portals();
+        PortalsFiller::fill(nState, iPortals);
+      }
+      const auto& portals = nState.currentVolume->portals();
+      PortalsFiller::fill(nState, portals);
+    } else {
+      // Keep the portals, the surfaces are queried again
+      candidates.erase(
+          std::remove_if(candidates.begin(), candidates.end(),
+                         [](const auto& c) { return c.surface != nullptr; }),
+          candidates.end());
+    }
+    // Only the surfaces along the ray
+    Ray3D ray(nState.position +
+                  std::min(nState.overstepTolerance, 0.) * nState.direction,
+              nState.direction);
+    hierarchy.intersect(ray, [&](const Surface* s) {
+      candidates.push_back(NavigationState::SurfaceCandidate{
+          ObjectIntersection<Surface>{}, s, nullptr,
+          nState.surfaceBoundaryCheck});
+    });
+    // Update internal candidates
+    updateCandidates(gctx, nState);
+  }
+};
+
+/// Generate a provider for all portals and the surfaces from a bounding
+/// volume hierarchy
+///
+/// @param gctx is the geometry context for building the hierarchy
+/// @param surfaces are the surfaces of the volume
+/// @param cfg is the configuration of the hierarchy
+///
+/// @return a connected navigationstate updator
+inline static SurfaceCandidatesUpdator boundingVolumeHierarchy(
+    const GeometryContext& gctx, const std::vector<const Surface*>& surfaces,
+    const SurfaceBoundingVolumeHierarchy::Config& cfg =
+        SurfaceBoundingVolumeHierarchy::Config{}) {
+  auto bvh = std::make_unique<const BoundingVolumeHierarchyImpl>(
+      SurfaceBoundingVolumeHierarchy(gctx, surfaces, cfg));
+  SurfaceCandidatesUpdator nStateUpdator;
+  nStateUpdator.connect<&BoundingVolumeHierarchyImpl::update>(std::move(bvh));
+  return nStateUpdator;
+}
+
 /// @brief This holds and extracts a collection of surfaces without much
 /// checking, this could be e.g. support surfaces for layer structures,
 /// e.g.
@@ -0,0 +1,288 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+// Workaround for building on clang+libstdc++
+#include "Acts/Utilities/detail/ReferenceWrapperAnyCompat.hpp"
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/Propagator/EigenStepperError.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/PropagatorError.hpp"
+#include "Acts/Propagator/detail/LaneRungeKutta.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Runge-Kutta-Nystroem stepper propagating a fixed number of tracks
+/// in lockstep
+///
+/// This stepper integrates the same equations of motion as the
+/// @c EigenStepper with the @c DefaultExtension, but keeps the state of
+/// @c N tracks (lanes) in structure-of-arrays form: every scalar quantity is
+/// an @c Eigen::Array with one entry per lane. The Runge-Kutta stages, the
+/// error estimate, the step size control and the transport Jacobian update
+/// are therefore evaluated for all lanes at once using Eigen's packet (SIMD)
+/// math. Only the magnetic field lookups are performed lane by lane.
+///
+/// Each lane has its own adaptive step size, path limit and step counter.
+/// Lanes that are idle, finished or failed are masked by giving them a zero
+/// step, which turns the update into the identity.
+///
+/// @note Only path-limited transport is supported, i.e. there is no
+///       navigation, no material interaction and no stepper extension.
+///
+/// @tparam N Number of lanes, should be a multiple of the SIMD width
+template <std::size_t N>
+class BatchedEigenStepper {
+ public:
+  static_assert(N > 0, "BatchedEigenStepper needs at least one lane");
+
+  /// Number of tracks propagated in lockstep
+  static constexpr std::size_t kLanes = N;
+
+  /// Jacobian, Covariance and State defintions
+  using Jacobian = BoundMatrix;
+  using Covariance = BoundSymMatrix;
+  using CurvilinearState =
+      std::tuple<CurvilinearTrackParameters, Jacobian, double>;
+
+  /// Result of the propagation of a single track
+  using PropagationResult = PropagatorResult<CurvilinearTrackParameters>;
+
+  /// The lockstep Runge-Kutta integration
+  using Kernel = detail::LaneRungeKutta<N>;
+  /// One scalar per lane
+  using Lanes = typename Kernel::Lanes;
+  /// One flag per lane
+  using LaneMask = typename Kernel::LaneMask;
+  /// One three-vector per lane, stored component-wise
+  using LaneVector3 = typename Kernel::LaneVector3;
+
+  /// Status of a single lane
+  enum class LaneStatus : int {
+    Idle = 0,    ///< no track loaded
+    Active = 1,  ///< track is being propagated
+    Done = 2,    ///< path limit reached
+    Failed = 3,  ///< propagation failed, see State::errors
+  };
+
+  /// @brief State for the lockstep propagation of up to @c N tracks
+  ///
+  /// It is provided thread local by the caller
+  struct State {
+    State() = delete;
+
+    /// Constructor with all lanes idle
+    ///
+    /// @param [in] gctx is the context object for the geometry
+    /// @param [in] fieldCaches are the magnetic field caches, one per lane
+    State(const GeometryContext& gctx,
+          std::vector<MagneticFieldProvider::Cache> fieldCaches)
+        : fieldCache(std::move(fieldCaches)), geoContext(gctx) {
+      status.fill(LaneStatus::Idle);
+      steps.fill(0u);
+      covTransport.fill(false);
+      cov.fill(Covariance::Zero());
+      jacobian.fill(Jacobian::Identity());
+      jacToGlobal.fill(BoundToFreeMatrix::Zero());
+      for (std::size_t i = 0; i < eFreeSize; ++i) {
+        for (std::size_t j = 0; j < eFreeSize; ++j) {
+          jacTransport[i * eFreeSize + j] =
+              Lanes::Constant(i == j ? 1. : 0.);
+        }
+      }
+    }
+
+    /// Global position per lane
+    LaneVector3 pos = {Lanes::Zero(), Lanes::Zero(), Lanes::Zero()};
+    /// Normalized momentum direction per lane
+    LaneVector3 dir = {Lanes::Zero(), Lanes::Zero(), Lanes::Zero()};
+    /// Time per lane
+    Lanes time = Lanes::Zero();
+    /// The charge (over) momentum per lane, as in the free parametrisation
+    Lanes qop = Lanes::Ones();
+    /// The charge per lane as the free vector can be 1/p or q/p
+    Lanes q = Lanes::Ones();
+    /// Navigation direction per lane, +1 or -1
+    Lanes navDir = Lanes::Ones();
+
+    /// Signed accumulated path length per lane
+    Lanes pathAccumulated = Lanes::Zero();
+    /// Absolute adaptive (accuracy) step size per lane
+    Lanes stepSize = Lanes::Constant(std::numeric_limits<double>::max());
+    /// Absolute maximum step size per lane
+    Lanes maxStepSize = Lanes::Constant(std::numeric_limits<double>::max());
+    /// Absolute path limit per lane (including loop protection)
+    Lanes pathLimit = Lanes::Constant(std::numeric_limits<double>::max());
+
+    /// Status, error and number of steps per lane
+    std::array<LaneStatus, N> status{};
+    std::array<std::error_code, N> errors{};
+    std::array<unsigned int, N> steps{};
+
+    /// Covariance transport flag per lane
+    std::array<bool, N> covTransport{};
+    /// Covariance matrix per lane
+    std::array<Covariance, N> cov;
+    /// The full jacobian since the last bound state per lane
+    std::array<Jacobian, N> jacobian;
+    /// Jacobian from local to the global frame per lane
+    std::array<BoundToFreeMatrix, N> jacToGlobal;
+
+    /// Pure transport jacobian from runge kutta integration, stored row-major
+    /// with one array of lanes per matrix element
+    std::array<Lanes, eFreeSize * eFreeSize> jacTransport;
+    /// The propagation derivative, one array of lanes per element
+    std::array<Lanes, eFreeSize> derivative = [] {
+      std::array<Lanes, eFreeSize> d;
+      d.fill(Lanes::Zero());
+      return d;
+    }();
+
+    /// The magnetic field cell caches, one per lane
+    std::vector<MagneticFieldProvider::Cache> fieldCache;
+
+    /// The geometry context
+    std::reference_wrapper<const GeometryContext> geoContext;
+
+    /// Storage of magnetic field and the sub steps during a RKN4 step
+    typename Kernel::StepData stepData;
+
+    /// Mask of the lanes that are currently propagated
+    LaneMask active() const {
+      LaneMask mask;
+      for (std::size_t l = 0; l < N; ++l) {
+        mask[l] = (status[l] == LaneStatus::Active);
+      }
+      return mask;
+    }
+  };
+
+  /// Constructor requires knowledge of the detector's magnetic field
+  explicit BatchedEigenStepper(
+      std::shared_ptr<const MagneticFieldProvider> bField);
+
+  /// Create a state with all lanes idle
+  ///
+  /// @param [in] gctx is the context object for the geometry
+  /// @param [in] mctx is the context object for the magnetic field
+  State makeState(std::reference_wrapper<const GeometryContext> gctx,
+                  std::reference_wrapper<const MagneticFieldContext> mctx) const;
+
+  /// Load a track into a lane of the state
+  ///
+  /// The lane is reset completely, it becomes active unless the path limit
+  /// is already reached at the start.
+  ///
+  /// @tparam parameters_t Type of the start parameters
+  ///
+  /// @param [in,out] state The batched stepping state
+  /// @param [in] lane The lane index to be (re-)used
+  /// @param [in] par The track parameters at start
+  /// @param [in] options The propagation options, for path/step limits
+  template <typename parameters_t>
+  void loadLane(State& state, std::size_t lane, const parameters_t& par,
+                const PropagatorPlainOptions& options) const;
+
+  /// Global particle position accessor for one lane
+  Vector3 position(const State& state, std::size_t lane) const {
+    return Vector3(state.pos[0][lane], state.pos[1][lane], state.pos[2][lane]);
+  }
+
+  /// Momentum direction accessor for one lane
+  Vector3 direction(const State& state, std::size_t lane) const {
+    return Vector3(state.dir[0][lane], state.dir[1][lane], state.dir[2][lane]);
+  }
+
+  /// Absolute momentum accessor for all lanes
+  Lanes momentum(const State& state) const {
+    return ((state.q == 0.).select(Lanes::Ones(), state.q) / state.qop).abs();
+  }
+
+  /// Create and return a curvilinear state for one lane
+  ///
+  /// @param [in] state The batched stepping state
+  /// @param [in] lane The lane to be presented as @c CurvilinearState
+  ///
+  /// @return A curvilinear state:
+  ///   - the curvilinear parameters at given position
+  ///   - the stepweise jacobian towards it (from last bound)
+  ///   - and the path length (from start - for ordering)
+  CurvilinearState curvilinearState(State& state, std::size_t lane) const;
+
+  /// Perform one Runge-Kutta step for all active lanes
+  ///
+  /// Every active lane advances by its own adaptive step size, limited by the
+  /// maximum step size and the remaining path. Lanes reaching the path limit
+  /// are marked as done, lanes that fail are marked as failed with the error
+  /// recorded in the state.
+  ///
+  /// @param [in,out] state The batched stepping state
+  /// @param [in] options The propagation options
+  void step(State& state, const PropagatorPlainOptions& options) const;
+
+  /// Propagate many tracks along a given path length
+  ///
+  /// The tracks are scheduled onto the lanes and finished lanes are refilled
+  /// with the next pending track, such that all lanes stay occupied as long
+  /// as possible. This is the batched equivalent of calling
+  /// @c Propagator::propagate without a target surface and without
+  /// navigation for each of the tracks.
+  ///
+  /// @tparam parameters_t Type of the start parameters
+  /// @tparam propagator_options_t Type of the propagator options
+  ///
+  /// @param [in] starts The start parameters of all tracks
+  /// @param [in] options Propagation options, action and abort lists must
+  ///                     be empty
+  ///
+  /// @return One propagation result per start parameter, in the same order
+  template <typename parameters_t, typename propagator_options_t>
+  std::vector<Result<PropagationResult>> propagate(
+      const std::vector<parameters_t>& starts,
+      const propagator_options_t& options) const;
+
+ private:
+  /// Look up the field for the given lanes, failed lookups deactivate lanes
+  ///
+  /// @param [in,out] state The batched stepping state
+  /// @param [in] pos The positions of the lanes
+  /// @param [out] field The field values, untouched for masked lanes
+  /// @param [in,out] lanes The lanes to look up, failed lanes are removed
+  void getField(State& state, const LaneVector3& pos, LaneVector3& field,
+                LaneMask& lanes) const;
+
+  /// Mark a lane as failed
+  void fail(State& state, std::size_t lane, std::error_code error) const {
+    state.status[lane] = LaneStatus::Failed;
+    state.errors[lane] = error;
+  }
+
+  /// Magnetic field inside of the detector
+  std::shared_ptr<const MagneticFieldProvider> m_bField;
+};
+
+}  // namespace Acts
+
+#include "Acts/Propagator/BatchedEigenStepper.ipp"
@@ -0,0 +1,365 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Propagator/detail/CovarianceEngine.hpp"
+
+#include <cmath>
+#include <optional>
+#include <type_traits>
+
+template <std::size_t N>
+Acts::BatchedEigenStepper<N>::BatchedEigenStepper(
+    std::shared_ptr<const MagneticFieldProvider> bField)
+    : m_bField(std::move(bField)) {}
+
+template <std::size_t N>
+auto Acts::BatchedEigenStepper<N>::makeState(
+    std::reference_wrapper<const GeometryContext> gctx,
+    std::reference_wrapper<const MagneticFieldContext> mctx) const -> State {
+  std::vector<MagneticFieldProvider::Cache> caches;
+  caches.reserve(N);
+  for (std::size_t l = 0; l < N; ++l) {
+    caches.push_back(m_bField->makeCache(mctx));
+  }
+  return State{gctx, std::move(caches)};
+}
+
+template <std::size_t N>
+template <typename parameters_t>
+void Acts::BatchedEigenStepper<N>::loadLane(
+    State& state, std::size_t lane, const parameters_t& par,
+    const PropagatorPlainOptions& options) const {
+  const GeometryContext& gctx = state.geoContext;
+  const Vector3 pos = par.position(gctx);
+  const Vector3 dir = par.unitDirection();
+  for (unsigned int i = 0; i < 3; ++i) {
+    state.pos[i][lane] = pos[i];
+    state.dir[i][lane] = dir[i];
+  }
+  state.time[lane] = par.time();
+  state.qop[lane] = par.parameters()[eBoundQOverP];
+  state.q[lane] = par.charge();
+  state.navDir[lane] = static_cast<double>(options.direction);
+
+  state.pathAccumulated[lane] = 0.;
+  state.stepSize[lane] = std::numeric_limits<double>::max();
+  state.maxStepSize[lane] = std::abs(options.maxStepSize);
+  state.pathLimit[lane] = std::abs(options.pathLimit);
+
+  state.status[lane] = LaneStatus::Active;
+  state.errors[lane] = std::error_code();
+  state.steps[lane] = 0u;
+
+  // Init the jacobian matrix if needed
+  state.covTransport[lane] = par.covariance().has_value();
+  if (state.covTransport[lane]) {
+    state.cov[lane] = *par.covariance();
+    state.jacToGlobal[lane] =
+        par.referenceSurface().boundToFreeJacobian(gctx, par.parameters());
+  } else {
+    state.cov[lane] = Covariance::Zero();
+    state.jacToGlobal[lane] = BoundToFreeMatrix::Zero();
+  }
+  state.jacobian[lane] = Jacobian::Identity();
+  for (std::size_t i = 0; i < eFreeSize; ++i) {
+    for (std::size_t j = 0; j < eFreeSize; ++j) {
+      state.jacTransport[i * eFreeSize + j][lane] = (i == j ? 1. : 0.);
+    }
+    state.derivative[i][lane] = 0.;
+  }
+
+  // Loop protection as in detail::setupLoopProtection, the transverse
+  // component at start is taken for the full helix path
+  if (options.loopProtection) {
+    auto fieldRes = m_bField->getField(pos, state.fieldCache[lane]);
+    if (!fieldRes.ok()) {
+      fail(state, lane, fieldRes.error());
+      return;
+    }
+    const double B = fieldRes->norm();
+    if (B != 0.) {
+      const double p = std::abs((par.charge() == 0. ? 1. : par.charge()) /
+                                state.qop[lane]);
+      const double loopLimit = options.loopFraction * 2 * M_PI * p / B;
+      state.pathLimit[lane] = std::min(state.pathLimit[lane], loopLimit);
+    }
+  }
+
+  if (state.pathLimit[lane] < std::abs(options.targetTolerance)) {
+    state.status[lane] = LaneStatus::Done;
+  }
+}
+
+template <std::size_t N>
+void Acts::BatchedEigenStepper<N>::getField(State& state,
+                                            const LaneVector3& pos,
+                                            LaneVector3& field,
+                                            LaneMask& lanes) const {
+  for (std::size_t l = 0; l < N; ++l) {
+    if (!lanes[l]) {
+      continue;
+    }
+    auto fieldRes = m_bField->getField(
+        Vector3(pos[0][l], pos[1][l], pos[2][l]), state.fieldCache[l]);
+    if (!fieldRes.ok()) {
+      fail(state, l, fieldRes.error());
+      lanes[l] = false;
+      continue;
+    }
+    for (unsigned int i = 0; i < 3; ++i) {
+      field[i][l] = (*fieldRes)[i];
+    }
+  }
+}
+
+template <std::size_t N>
+auto Acts::BatchedEigenStepper<N>::curvilinearState(State& state,
+                                                    std::size_t lane) const
+    -> CurvilinearState {
+  FreeVector pars;
+  pars.template segment<3>(eFreePos0) = position(state, lane);
+  pars.template segment<3>(eFreeDir0) = direction(state, lane);
+  pars[eFreeTime] = state.time[lane];
+  pars[eFreeQOverP] = state.qop[lane];
+
+  FreeMatrix jacTransport;
+  FreeVector derivative;
+  for (std::size_t i = 0; i < eFreeSize; ++i) {
+    for (std::size_t j = 0; j < eFreeSize; ++j) {
+      jacTransport(i, j) = state.jacTransport[i * eFreeSize + j][lane];
+    }
+    derivative[i] = state.derivative[i][lane];
+  }
+
+  return detail::curvilinearState(
+      state.cov[lane], state.jacobian[lane], jacTransport, derivative,
+      state.jacToGlobal[lane], pars, state.covTransport[lane],
+      state.pathAccumulated[lane]);
+}
+
+template <std::size_t N>
+void Acts::BatchedEigenStepper<N>::step(
+    State& state, const PropagatorPlainOptions& options) const {
+  auto& sd = state.stepData;
+
+  LaneMask stepping = state.active();
+  if (!stepping.any()) {
+    return;
+  }
+
+  const Lanes p = momentum(state);
+  const Lanes qop = state.q / p;
+  const LaneVector3& pos = state.pos;
+  const LaneVector3& dir = state.dir;
+
+  // First Runge-Kutta point (at current position)
+  getField(state, pos, sd.B_first, stepping);
+  Kernel::firstStage(dir, qop, sd);
+
+  // The step size is the minimum of the accuracy, the user and the aborter
+  // constraint, as for the ConstrainedStep of the single track steppers
+  const Lanes remaining = state.pathLimit - state.pathAccumulated.abs();
+  Lanes h = Lanes::Zero();
+  Lanes errorEstimate = Lanes::Zero();
+  std::array<std::size_t, N> nStepTrials{};
+
+  const auto laneField = [&](const LaneVector3& at, LaneVector3& field,
+                             LaneMask& lanes) {
+    getField(state, at, field, lanes);
+  };
+
+  // Select and adjust the appropriate Runge-Kutta step size as given
+  // ATL-SOFT-PUB-2009-001, lanes that are not yet accepted are pending
+  LaneMask pending = stepping;
+  while (pending.any()) {
+    const Lanes hTry = pending.select(
+        state.navDir *
+            state.stepSize.min(state.maxStepSize).min(remaining),
+        Lanes::Zero());
+    Lanes error;
+    const LaneMask accepted = Kernel::tryStep(
+        pos, dir, qop, hTry, options.tolerance, laneField, sd, pending, error);
+    h = accepted.select(hTry, h);
+    errorEstimate = accepted.select(error, errorEstimate);
+
+    pending = pending && !accepted;
+    if (!pending.any()) {
+      break;
+    }
+
+    state.stepSize = pending.select(
+        hTry.abs() * Kernel::stepSizeScaling(options.tolerance, 2. * error),
+        state.stepSize);
+
+    for (std::size_t l = 0; l < N; ++l) {
+      if (!pending[l]) {
+        continue;
+      }
+      // If step size becomes too small the particle remains at the initial
+      // place
+      if (state.stepSize[l] < std::abs(options.stepSizeCutOff)) {
+        fail(state, l, EigenStepperError::StepSizeStalled);
+        pending[l] = false;
+      } else if (nStepTrials[l] > options.maxRungeKuttaStepTrials) {
+        fail(state, l, EigenStepperError::StepSizeAdjustmentFailed);
+        pending[l] = false;
+      }
+      nStepTrials[l]++;
+    }
+  }
+
+  // Lanes which failed during the trials do not move
+  stepping = state.active();
+  h = stepping.select(h, Lanes::Zero());
+  const Lanes dtds = (1. + (options.mass / p).square()).sqrt();
+
+  // When doing error propagation, update the associated Jacobian matrix
+  bool anyCovTransport = false;
+  for (std::size_t l = 0; l < N; ++l) {
+    anyCovTransport = anyCovTransport || (stepping[l] && state.covTransport[l]);
+  }
+  if (anyCovTransport) {
+    const auto D = Kernel::transport(dir, qop, h, sd);
+    const Lanes dTdL = h * options.mass * options.mass * state.q / (p * dtds);
+
+    // Update the transport jacobian J = D * J, exploiting the block
+    // structure of D. The rows 4-6 are needed unchanged for the rows 0-3.
+    auto& J = state.jacTransport;
+    const auto el = [](std::size_t r, std::size_t c) {
+      return r * eFreeSize + c;
+    };
+    for (std::size_t c = 0; c < eFreeSize; ++c) {
+      const Lanes& J4 = J[el(4, c)];
+      const Lanes& J5 = J[el(5, c)];
+      const Lanes& J6 = J[el(6, c)];
+      const Lanes& J7 = J[el(7, c)];
+      std::array<Lanes, 7> updated;
+      for (unsigned int r = 0; r < 3; ++r) {
+        updated[r] = J[el(r, c)] + D.dFdT[r * 3] * J4 +
+                     D.dFdT[r * 3 + 1] * J5 + D.dFdT[r * 3 + 2] * J6 +
+                     D.dFdL[r] * J7;
+        updated[4 + r] = D.dGdT[r * 3] * J4 + D.dGdT[r * 3 + 1] * J5 +
+                         D.dGdT[r * 3 + 2] * J6 + D.dGdL[r] * J7;
+      }
+      updated[3] = J[el(3, c)] + dTdL * J7;
+      for (std::size_t r = 0; r < 7; ++r) {
+        J[el(r, c)] = stepping.select(updated[r], J[el(r, c)]);
+      }
+    }
+  }
+
+  // Update the track parameters according to the equations of motion
+  Kernel::advance(state.pos, state.dir, h, sd);
+  Lanes norm = Lanes::Zero();
+  for (unsigned int i = 0; i < 3; ++i) {
+    norm += state.dir[i].square();
+  }
+  norm = stepping.select(norm.sqrt(), Lanes::Ones());
+  for (unsigned int i = 0; i < 3; ++i) {
+    state.dir[i] /= norm;
+  }
+  state.time += h * dtds;
+
+  for (unsigned int i = 0; i < 3; ++i) {
+    state.derivative[eFreePos0 + i] =
+        stepping.select(state.dir[i], state.derivative[eFreePos0 + i]);
+    state.derivative[eFreeDir0 + i] =
+        stepping.select(sd.k4[i], state.derivative[eFreeDir0 + i]);
+  }
+  state.derivative[eFreeTime] =
+      stepping.select(dtds, state.derivative[eFreeTime]);
+
+  state.pathAccumulated += h;
+
+  // Release the step size of lanes for which the accuracy was limiting
+  const LaneMask accuracyLimited = stepping &&
+                                   (state.stepSize <= state.maxStepSize) &&
+                                   (state.stepSize <= remaining);
+  state.stepSize = accuracyLimited.select(
+      h.abs() * Kernel::stepSizeScaling(options.tolerance, errorEstimate),
+      state.stepSize);
+
+  // Check the path limit, the step counting is consistent with
+  // Propagator::propagate_impl
+  const Lanes distance = state.pathLimit - state.pathAccumulated.abs();
+  for (std::size_t l = 0; l < N; ++l) {
+    if (!stepping[l]) {
+      continue;
+    }
+    if (distance[l] < std::abs(options.targetTolerance)) {
+      state.status[l] = LaneStatus::Done;
+    } else if (++state.steps[l] >= options.maxSteps) {
+      fail(state, l, PropagatorError::StepCountLimitReached);
+    }
+  }
+}
+
+template <std::size_t N>
+template <typename parameters_t, typename propagator_options_t>
+auto Acts::BatchedEigenStepper<N>::propagate(
+    const std::vector<parameters_t>& starts,
+    const propagator_options_t& options) const
+    -> std::vector<Result<PropagationResult>> {
+  static_assert(std::is_same_v<typename propagator_options_t::action_list_type,
+                               ActionList<>>,
+                "Batched propagation does not support actors");
+  static_assert(std::is_same_v<typename propagator_options_t::aborter_list_type,
+                               AbortList<>>,
+                "Batched propagation does not support aborters");
+
+  std::vector<Result<PropagationResult>> results;
+  results.reserve(starts.size());
+  for (std::size_t i = 0; i < starts.size(); ++i) {
+    results.push_back(
+        Result<PropagationResult>::failure(PropagatorError::Failure));
+  }
+
+  State state = makeState(options.geoContext, options.magFieldContext);
+  std::array<std::size_t, N> trackIndex{};
+  std::size_t nextTrack = 0;
+
+  // Harvest finished lanes and load the next pending tracks into them
+  const auto refill = [&]() {
+    for (std::size_t l = 0; l < N; ++l) {
+      while (state.status[l] != LaneStatus::Active) {
+        if (state.status[l] == LaneStatus::Failed) {
+          results[trackIndex[l]] =
+              Result<PropagationResult>::failure(state.errors[l]);
+        } else if (state.status[l] == LaneStatus::Done) {
+          auto curvState = curvilinearState(state, l);
+          PropagationResult result;
+          result.endParameters =
+              std::get<CurvilinearTrackParameters>(curvState);
+          // Only fill the transport jacobian when covariance transport was
+          // done
+          if (state.covTransport[l]) {
+            result.transportJacobian = std::get<Jacobian>(curvState);
+          }
+          result.steps = state.steps[l];
+          result.pathLength = state.pathAccumulated[l];
+          results[trackIndex[l]] =
+              Result<PropagationResult>::success(std::move(result));
+        }
+        state.status[l] = LaneStatus::Idle;
+        if (nextTrack == starts.size()) {
+          break;
+        }
+        trackIndex[l] = nextTrack;
+        loadLane(state, l, starts[nextTrack++], options);
+      }
+    }
+  };
+
+  refill();
+  while (state.active().any()) {
+    step(state, options);
+    refill();
+  }
+
+  return results;
+}
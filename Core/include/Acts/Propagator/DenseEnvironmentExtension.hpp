@@ -46,6 +46,13 @@ struct DenseStepperPropagatorOptions
   /// Cut-off value for the momentum in SI units
   double momentumCutOff = 0.;
 
+  /// Number of points along the step at which the volume material is
+  /// evaluated and averaged, a single point uses the material at the start
+  ///
+  /// The points span the trial step size, which is larger than the accepted
+  /// step if the step size control reduces the step.
+  unsigned int stepMaterialSamples = 1;
+
   /// @brief Expand the Options with extended aborters
   ///
   /// @tparam extended_aborter_list_t Type of the new aborter list
@@ -77,6 +84,7 @@ struct DenseStepperPropagatorOptions
     eoptions.meanEnergyLoss = meanEnergyLoss;
     eoptions.includeGgradient = includeGgradient;
     eoptions.momentumCutOff = momentumCutOff;
+    eoptions.stepMaterialSamples = stepMaterialSamples;
     // And return the options
     return eoptions;
   }
@@ -25,10 +25,12 @@
 #include "Acts/Utilities/detail/gaussian_mixture_helpers.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <functional>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <sstream>
 #include <vector>
 
@@ -191,6 +193,7 @@ class MultiEigenStepperLoop
   /// .curvilinearState()
   FinalReductionMethod m_finalReductionMethod = FinalReductionMethod::eMean;
 
+ protected:
   /// Small vector type for speeding up some computations where we need to
   /// accumulate stuff of components. We think 16 is a reasonable amount here.
   template <typename T>
@@ -845,6 +848,21 @@ class MultiEigenStepperLoop
   /// algorithm, it can be modified by the stepper class during propagation.
   template <typename propagator_state_t>
   Result<double> step(propagator_state_t& state) const;
+
+ protected:
+  /// Perform a step of all components, with the bookkeeping common to all
+  /// multi-component steppers around it
+  ///
+  /// @param [in,out] state is the propagation state
+  /// @param [in] stepAll steps the components, it is called with an empty
+  ///             vector which has to be filled with one result per component,
+  ///             where components on a surface, which are not stepped, have
+  ///             no result
+  ///
+  /// @return the weighted path length of the successfully stepped components
+  template <typename propagator_state_t, typename component_stepper_t>
+  Result<double> stepComponents(propagator_state_t& state,
+                                component_stepper_t&& stepAll) const;
 };
 
 }  // namespace Acts
@@ -129,6 +129,35 @@ template <typename E, typename R, typename A>
 template <typename propagator_state_t>
 Result<double> MultiEigenStepperLoop<E, R, A>::step(
     propagator_state_t& state) const {
+  return stepComponents(
+      state, [&](SmallVector<std::optional<Result<double>>>& results) {
+        for (auto& component : state.stepping.components) {
+          // We must also propagate missed components for the case that all
+          // components miss the target and we need to re-target
+          if (component.status == Intersection3D::Status::onSurface) {
+            // We need to add these, so the propagation does not fail if we
+            // have only components on surfaces and failing states
+            results.emplace_back(std::nullopt);
+            continue;
+          }
+
+          using ThisSinglePropState =
+              SinglePropState<SingleState, decltype(state.navigation),
+                              decltype(state.options),
+                              decltype(state.geoContext)>;
+
+          ThisSinglePropState single_state(component.state, state.navigation,
+                                           state.options, state.geoContext);
+
+          results.emplace_back(SingleStepper::step(single_state));
+        }
+      });
+}
+
+template <typename E, typename R, typename A>
+template <typename propagator_state_t, typename component_stepper_t>
+Result<double> MultiEigenStepperLoop<E, R, A>::stepComponents(
+    propagator_state_t& state, component_stepper_t&& stepAll) const {
   State& stepping = state.stepping;
 
   // @TODO: This needs to be a real logger
@@ -177,33 +206,22 @@ Result<double> MultiEigenStepperLoop<E, R, A>::step(
     }
   }
 
-  // Loop over all components and collect results in vector, write some
+  // Step all components and collect results in vector, write some
   // summary information to a stringstream
   SmallVector<std::optional<Result<double>>> results;
+  stepAll(results);
+  assert(results.size() == stepping.components.size());
+
   double accumulatedPathLength = 0.0;
   std::size_t errorSteps = 0;
 
-  for (auto& component : stepping.components) {
-    // We must also propagate missed components for the case that all
-    // components miss the target and we need to re-target
-    if (component.status == Intersection3D::Status::onSurface) {
-      // We need to add these, so the propagation does not fail if we have only
-      // components on surfaces and failing states
-      results.emplace_back(std::nullopt);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    auto& component = stepping.components[i];
+    if (not results[i]) {
       continue;
     }
-
-    using ThisSinglePropState =
-        SinglePropState<SingleState, decltype(state.navigation),
-                        decltype(state.options), decltype(state.geoContext)>;
-
-    ThisSinglePropState single_state(component.state, state.navigation,
-                                     state.options, state.geoContext);
-
-    results.emplace_back(SingleStepper::step(single_state));
-
-    if (results.back()->ok()) {
-      accumulatedPathLength += component.weight * results.back()->value();
+    if (results[i]->ok()) {
+      accumulatedPathLength += component.weight * results[i]->value();
     } else {
       ++errorSteps;
       component.status = Intersection3D::Status::missed;
@@ -0,0 +1,225 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+// Workaround for building on clang+libstdc++
+#include "Acts/Utilities/detail/ReferenceWrapperAnyCompat.hpp"
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/EventData/detail/CorrectedTransformationFreeToBound.hpp"
+#include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/Propagator/ConstrainedStep.hpp"
+#include "Acts/Propagator/DefaultExtension.hpp"
+#include "Acts/Propagator/MultiEigenStepperLoop.hpp"
+#include "Acts/Propagator/StepperExtensionList.hpp"
+#include "Acts/Propagator/detail/LaneRungeKutta.hpp"
+#include "Acts/Surfaces/BoundaryCheck.hpp"
+#include "Acts/Utilities/Intersection.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace Acts {
+
+/// @brief Multi-component stepper which advances all components in lockstep
+///
+/// The component states are the same as for the @c MultiEigenStepperLoop,
+/// such that the accessors, the surface handling and the reduction of the
+/// mixture are shared with it. The Runge-Kutta step however is not done
+/// component by component: the components are gathered into lanes in
+/// structure-of-arrays form, where every scalar quantity is an
+/// @c Eigen::Array with one entry per component. The Runge-Kutta stages, the
+/// error estimates, the step size control and the transport matrices are then
+/// evaluated for all components at once using Eigen's packet (SIMD) math, as
+/// in the @c BatchedEigenStepper. Only the multiplication of the transport
+/// matrix onto the Jacobians is done per component.
+///
+/// The components of a mixture are close in space, therefore all magnetic
+/// field lookups of a step go through a single field cache, which mostly
+/// avoids the cell lookup for all but the first component.
+///
+/// Every component keeps its own constrained step size. Components on a
+/// surface are not stepped, failing components are masked for the rest of
+/// the step and are removed afterwards, as in the @c MultiEigenStepperLoop.
+///
+/// @note The lockstep integration is only available with the
+///       @c DefaultExtension. With other extensions the components are
+///       stepped one by one, as in the @c MultiEigenStepperLoop.
+///
+/// @tparam extensionlist_t See EigenStepper for details
+/// @tparam component_reducer_t How to map the multi-component state to a
+///         single component
+/// @tparam auctioneer_t See EigenStepper for details
+/// @tparam N Number of components stepped in lockstep, mixtures with more
+///         components are stepped in chunks of @c N. Small chunks waste less
+///         work on partially filled chunks.
+template <typename extensionlist_t = StepperExtensionList<DefaultExtension>,
+          typename component_reducer_t = WeightedComponentReducerLoop,
+          typename auctioneer_t = detail::VoidAuctioneer, std::size_t N = 4>
+class MultiEigenStepperVectorized
+    : public MultiEigenStepperLoop<extensionlist_t, component_reducer_t,
+                                   auctioneer_t> {
+  static_assert(N > 0, "MultiEigenStepperVectorized needs at least one lane");
+
+  using Base =
+      MultiEigenStepperLoop<extensionlist_t, component_reducer_t, auctioneer_t>;
+
+  template <typename T>
+  using SmallVector = typename Base::template SmallVector<T>;
+
+ public:
+  /// Number of components stepped in lockstep
+  static constexpr std::size_t kLanes = N;
+
+  using typename Base::BoundState;
+  using typename Base::CurvilinearState;
+  using typename Base::SingleState;
+  using typename Base::SingleStepper;
+  using typename Base::State;
+
+  /// The lockstep Runge-Kutta integration, shared with the
+  /// @c BatchedEigenStepper
+  using Kernel = detail::LaneRungeKutta<N>;
+  /// One scalar per component
+  using Lanes = typename Kernel::Lanes;
+  /// One flag per component
+  using LaneMask = typename Kernel::LaneMask;
+  /// One three-vector per component, stored coordinate-wise
+  using LaneVector3 = typename Kernel::LaneVector3;
+
+  /// Constructor from a magnetic field and the final reduction method
+  MultiEigenStepperVectorized(
+      std::shared_ptr<const MagneticFieldProvider> bField,
+      FinalReductionMethod finalReductionMethod = FinalReductionMethod::eMean)
+      : Base(std::move(bField), finalReductionMethod) {}
+
+  /// @name Accessors of the MultiEigenStepperLoop
+  ///
+  /// The stepper concept checks for the exact signatures of the member
+  /// functions, which inherited member functions do not have. They are
+  /// therefore redeclared here.
+  /// @{
+
+  std::size_t numberComponents(const State& state) const {
+    return Base::numberComponents(state);
+  }
+
+  void removeMissedComponents(State& state) const {
+    Base::removeMissedComponents(state);
+  }
+
+  void clearComponents(State& state) const { Base::clearComponents(state); }
+
+  void resetState(
+      State& state, const BoundVector& boundParams, const BoundSymMatrix& cov,
+      const Surface& surface,
+      const NavigationDirection navDir = NavigationDirection::Forward,
+      const double stepSize = std::numeric_limits<double>::max()) const {
+    Base::resetState(state, boundParams, cov, surface, navDir, stepSize);
+  }
+
+  Vector3 position(const State& state) const { return Base::position(state); }
+
+  Vector3 direction(const State& state) const {
+    return Base::direction(state);
+  }
+
+  double momentum(const State& state) const { return Base::momentum(state); }
+
+  double charge(const State& state) const { return Base::charge(state); }
+
+  double time(const State& state) const { return Base::time(state); }
+
+  double overstepLimit(const State& state) const {
+    return Base::overstepLimit(state);
+  }
+
+  Result<BoundState> boundState(
+      State& state, const Surface& surface, bool transportCov = true,
+      const FreeToBoundCorrection& freeToBoundCorrection =
+          FreeToBoundCorrection(false)) const {
+    return Base::boundState(state, surface, transportCov,
+                            freeToBoundCorrection);
+  }
+
+  CurvilinearState curvilinearState(State& state,
+                                    bool transportCov = true) const {
+    return Base::curvilinearState(state, transportCov);
+  }
+
+  void transportCovarianceToCurvilinear(State& state) const {
+    Base::transportCovarianceToCurvilinear(state);
+  }
+
+  void transportCovarianceToBound(
+      State& state, const Surface& surface,
+      const FreeToBoundCorrection& freeToBoundCorrection =
+          FreeToBoundCorrection(false)) const {
+    Base::transportCovarianceToBound(state, surface, freeToBoundCorrection);
+  }
+
+  Intersection3D::Status updateSurfaceStatus(
+      State& state, const Surface& surface, const BoundaryCheck& bcheck,
+      const Logger& logger = getDummyLogger()) const {
+    return Base::updateSurfaceStatus(state, surface, bcheck, logger);
+  }
+
+  void setStepSize(State& state, double stepSize,
+                   ConstrainedStep::Type stype = ConstrainedStep::actor,
+                   bool release = true) const {
+    Base::setStepSize(state, stepSize, stype, release);
+  }
+
+  double getStepSize(const State& state, ConstrainedStep::Type stype) const {
+    return Base::getStepSize(state, stype);
+  }
+
+  void releaseStepSize(State& state) const { Base::releaseStepSize(state); }
+
+  std::string outputStepSize(const State& state) const {
+    return Base::outputStepSize(state);
+  }
+
+  /// @}
+
+  /// Perform a Runge-Kutta track parameter propagation step for all
+  /// components
+  ///
+  /// @param [in,out] state is the propagation state associated with the track
+  /// parameters that are being propagated.
+  ///
+  /// The component states contain the desired step sizes. They can be
+  /// negative during backwards track propagation, and since we're using an
+  /// adaptive algorithm, they can be modified during the propagation.
+  template <typename propagator_state_t>
+  Result<double> step(propagator_state_t& state) const;
+
+ private:
+  /// Step up to @c N components in lockstep
+  ///
+  /// @param [in,out] state is the propagation state
+  /// @param [in] indices are the indices of the components in the lanes
+  /// @param [in] nLanes is the number of used lanes
+  /// @param [out] results receives the result of the stepped components
+  template <typename propagator_state_t>
+  void stepLanes(propagator_state_t& state,
+                 const std::array<std::size_t, N>& indices, std::size_t nLanes,
+                 SmallVector<std::optional<Result<double>>>& results) const;
+};
+
+}  // namespace Acts
+
+#include "Acts/Propagator/MultiEigenStepperVectorized.ipp"
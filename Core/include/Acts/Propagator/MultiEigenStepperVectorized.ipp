@@ -0,0 +1,254 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Propagator/ConstrainedStep.hpp"
+#include "Acts/Propagator/EigenStepperError.hpp"
+
+#include <cmath>
+#include <system_error>
+#include <type_traits>
+
+namespace Acts {
+
+template <typename E, typename R, typename A, std::size_t N>
+template <typename propagator_state_t>
+Result<double> MultiEigenStepperVectorized<E, R, A, N>::step(
+    propagator_state_t& state) const {
+  if constexpr (not std::is_same_v<E, StepperExtensionList<DefaultExtension>>) {
+    return Base::step(state);
+  } else {
+    return Base::stepComponents(
+        state, [&](SmallVector<std::optional<Result<double>>>& results) {
+          const auto& components = state.stepping.components;
+          // Components on a surface are not stepped and have no result
+          results.resize(components.size());
+
+          std::array<std::size_t, N> indices{};
+          std::size_t nLanes = 0;
+          for (std::size_t i = 0; i < components.size(); ++i) {
+            if (components[i].status == Intersection3D::Status::onSurface) {
+              continue;
+            }
+            indices[nLanes++] = i;
+            if (nLanes == N) {
+              stepLanes(state, indices, nLanes, results);
+              nLanes = 0;
+            }
+          }
+          if (nLanes > 0) {
+            stepLanes(state, indices, nLanes, results);
+          }
+        });
+  }
+}
+
+template <typename E, typename R, typename A, std::size_t N>
+template <typename propagator_state_t>
+void MultiEigenStepperVectorized<E, R, A, N>::stepLanes(
+    propagator_state_t& state, const std::array<std::size_t, N>& indices,
+    std::size_t nLanes,
+    SmallVector<std::optional<Result<double>>>& results) const {
+  auto& components = state.stepping.components;
+  const auto& options = state.options;
+
+  // All lookups share the field cache of the first component
+  auto& fieldCache = components.front().state.fieldCache;
+
+  // Gather the components into the lanes, unused lanes stay at zero and are
+  // masked for the whole step
+  LaneMask stepping = LaneMask::Constant(false);
+  LaneVector3 pos = {Lanes::Zero(), Lanes::Zero(), Lanes::Zero()};
+  LaneVector3 dir = pos;
+  Lanes qop = Lanes::Zero();
+  for (std::size_t l = 0; l < nLanes; ++l) {
+    const SingleState& single = components[indices[l]].state;
+    stepping[l] = true;
+    for (unsigned int i = 0; i < 3; ++i) {
+      pos[i][l] = single.pars[eFreePos0 + i];
+      dir[i][l] = single.pars[eFreeDir0 + i];
+    }
+    // as in the DefaultExtension
+    qop[l] = SingleStepper::charge(single) / SingleStepper::momentum(single);
+  }
+
+  // Lanes which fail are masked for the rest of the step
+  LaneMask pending = stepping;
+  const auto fail = [&](std::size_t l, std::error_code error) {
+    results[indices[l]] = Result<double>::failure(error);
+    stepping[l] = false;
+    pending[l] = false;
+  };
+
+  // Look up the field for the given lanes, failed lookups fail the lane
+  const auto getField = [&](const LaneVector3& at, LaneVector3& field,
+                            LaneMask& lanes) {
+    for (std::size_t l = 0; l < nLanes; ++l) {
+      if (not lanes[l]) {
+        continue;
+      }
+      auto fieldRes = SingleStepper::m_bField->getField(
+          Vector3(at[0][l], at[1][l], at[2][l]), fieldCache);
+      if (not fieldRes.ok()) {
+        fail(l, fieldRes.error());
+        lanes[l] = false;
+        continue;
+      }
+      for (unsigned int i = 0; i < 3; ++i) {
+        field[i][l] = (*fieldRes)[i];
+      }
+    }
+  };
+
+  // First Runge-Kutta point (at current position)
+  typename Kernel::StepData sd;
+  getField(pos, sd.B_first, stepping);
+  Kernel::firstStage(dir, qop, sd);
+
+  // Select and adjust the appropriate Runge-Kutta step size as given
+  // ATL-SOFT-PUB-2009-001, every lane with its own step size
+  Lanes h = Lanes::Zero();
+  Lanes errorEstimate = Lanes::Zero();
+  std::array<std::size_t, N> nStepTrials{};
+  while (pending.any()) {
+    Lanes hTry = Lanes::Zero();
+    for (std::size_t l = 0; l < nLanes; ++l) {
+      if (pending[l]) {
+        hTry[l] = components[indices[l]].state.stepSize.value();
+      }
+    }
+    Lanes error;
+    const LaneMask accepted = Kernel::tryStep(
+        pos, dir, qop, hTry, options.tolerance, getField, sd, pending, error);
+    h = accepted.select(hTry, h);
+    errorEstimate = accepted.select(error, errorEstimate);
+    pending = pending && !accepted;
+    if (not pending.any()) {
+      break;
+    }
+
+    const Lanes stepSizeScaling =
+        Kernel::stepSizeScaling(options.tolerance, 2. * error);
+    for (std::size_t l = 0; l < nLanes; ++l) {
+      if (not pending[l]) {
+        continue;
+      }
+      ConstrainedStep& stepSize = components[indices[l]].state.stepSize;
+      stepSize.scale(stepSizeScaling[l]);
+
+      // If step size becomes too small the particle remains at the initial
+      // place
+      if (std::abs(stepSize.value()) < std::abs(options.stepSizeCutOff)) {
+        // Not moving due to too low momentum needs an aborter
+        fail(l, EigenStepperError::StepSizeStalled);
+      } else if (nStepTrials[l] > options.maxRungeKuttaStepTrials) {
+        // Too many trials, have to abort
+        fail(l, EigenStepperError::StepSizeAdjustmentFailed);
+      }
+      nStepTrials[l]++;
+    }
+  }
+
+  // Lanes which failed during the trials do not move
+  h = stepping.select(h, Lanes::Zero());
+
+  // When doing error propagation, update the associated Jacobian matrices
+  LaneMask transport = LaneMask::Constant(false);
+  for (std::size_t l = 0; l < nLanes; ++l) {
+    transport[l] = stepping[l] && components[indices[l]].state.covTransport;
+  }
+  if (transport.any()) {
+    const auto D = Kernel::transport(dir, qop, h, sd);
+    Lanes dTdL = Lanes::Zero();
+    for (std::size_t l = 0; l < nLanes; ++l) {
+      const SingleState& single = components[indices[l]].state;
+      const double p = SingleStepper::momentum(single);
+      dTdL[l] = h[l] * options.mass * options.mass *
+                SingleStepper::charge(single) /
+                (p * std::hypot(1., options.mass / p));
+    }
+
+    // Update the transport jacobian J = D * J of every component, exploiting
+    // the block structure of D. The rows 4-7 are needed unchanged for the
+    // rows 0-3.
+    for (std::size_t l = 0; l < nLanes; ++l) {
+      if (not transport[l]) {
+        continue;
+      }
+      ActsMatrix<3, 4> dF, dG;
+      for (unsigned int r = 0; r < 3; ++r) {
+        for (unsigned int c = 0; c < 3; ++c) {
+          dF(r, c) = D.dFdT[r * 3 + c][l];
+          dG(r, c) = D.dGdT[r * 3 + c][l];
+        }
+        dF(r, 3) = D.dFdL[r][l];
+        dG(r, 3) = D.dGdL[r][l];
+      }
+
+      FreeMatrix& J = components[indices[l]].state.jacTransport;
+      const ActsMatrix<4, eFreeSize> J47 = J.template bottomRows<4>();
+      J.template topRows<3>() += dF * J47;
+      J.row(3) += dTdL[l] * J47.row(3);
+      J.template middleRows<3>(4) = dG * J47;
+    }
+  }
+
+  // Update the track parameters according to the equations of motion
+  LaneVector3 newPos = pos, newDir = dir;
+  Kernel::advance(newPos, newDir, h, sd);
+
+  const Lanes stepSizeScaling =
+      Kernel::stepSizeScaling(options.tolerance, errorEstimate);
+
+  // Scatter the lanes back into the component states
+  for (std::size_t l = 0; l < nLanes; ++l) {
+    if (not stepping[l]) {
+      continue;
+    }
+    SingleState& single = components[indices[l]].state;
+    for (unsigned int i = 0; i < 3; ++i) {
+      single.pars[eFreePos0 + i] = newPos[i][l];
+      single.pars[eFreeDir0 + i] = newDir[i][l];
+    }
+    (single.pars.template segment<3>(eFreeDir0)).normalize();
+
+    // This evaluation is based on dt/ds = 1/v = 1/(beta * c), see the
+    // DefaultExtension
+    const double dtds =
+        std::hypot(1., options.mass / SingleStepper::momentum(single));
+    single.pars[eFreeTime] += h[l] * dtds;
+
+    const auto lane = [l](const LaneVector3& v) {
+      return Vector3(v[0][l], v[1][l], v[2][l]);
+    };
+    auto& singleData = single.stepData;
+    singleData.B_first = lane(sd.B_first);
+    singleData.B_middle = lane(sd.B_middle);
+    singleData.B_last = lane(sd.B_last);
+    singleData.k1 = lane(sd.k1);
+    singleData.k2 = lane(sd.k2);
+    singleData.k3 = lane(sd.k3);
+    singleData.k4 = lane(sd.k4);
+    singleData.kQoP = {0., 0., 0., 0.};
+
+    if (single.covTransport) {
+      single.derivative.template head<3>() =
+          single.pars.template segment<3>(eFreeDir0);
+      single.derivative(3) = dtds;
+      single.derivative.template segment<3>(4) = singleData.k4;
+    }
+    single.pathAccumulated += h[l];
+    if (single.stepSize.currentType() == ConstrainedStep::Type::accuracy) {
+      single.stepSize.scale(stepSizeScaling[l]);
+    }
+    single.stepSize.nStepTrials = nStepTrials[l];
+
+    results[indices[l]] = Result<double>::success(h[l]);
+  }
+}
+
+}  // namespace Acts
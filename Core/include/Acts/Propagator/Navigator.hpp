@@ -12,6 +12,7 @@
 #include "Acts/Geometry/BoundarySurfaceT.hpp"
 #include "Acts/Geometry/GeometryIdentifier.hpp"
 #include "Acts/Geometry/Layer.hpp"
+#include "Acts/Geometry/NavigationCache.hpp"
 #include "Acts/Geometry/TrackingGeometry.hpp"
 #include "Acts/Geometry/TrackingVolume.hpp"
 #include "Acts/Propagator/ConstrainedStep.hpp"
@@ -19,9 +20,11 @@
 #include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/Logger.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <boost/algorithm/string.hpp>
@@ -163,6 +166,13 @@ class Navigator {
     /// Wether to perform boundary checks for layer resolving (improves
     /// navigation for bended tracks)
     BoundaryCheck boundaryCheckLayerResolving = true;
+
+    /// Optional precomputed layer and surface candidates, has to be built
+    /// for the tracking geometry and resolve flags of this navigator
+    std::shared_ptr<const NavigationCache> navigationCache{nullptr};
+    /// Run the exhaustive candidate search as well, report differences to
+    /// the cached candidates and continue with the exhaustive ones
+    bool validateNavigationCache = false;
   };
 
   /// Nested State struct
@@ -225,6 +235,11 @@ class Navigator {
     Stage navigationStage = Stage::undefined;
     /// Force intersection with boundaries
     bool forceIntersectBoundaries = false;
+    /// Number of times a candidate buffer outgrew its inline capacity and
+    /// was moved to heap storage. Allocations within the geometry queries
+    /// themselves, e.g. of the bounding volume hierarchy search, are not
+    /// counted.
+    std::size_t candidateBufferReallocations = 0;
 
     /// Reset state
     ///
@@ -255,8 +270,10 @@ class Navigator {
       // Get the compatible layers (including the current layer)
       NavigationOptions<Layer> navOpts(navDir, true, true, true, true, nullptr,
                                        nullptr);
+      const auto* storage = navLayers.data();
       navLayers =
           currentVolume->compatibleLayers(geoContext, pos, dir, navOpts);
+      countReallocation(*this, navLayers, storage);
 
       // Set the iterator to the first
       navLayerIter = navLayers.begin();
@@ -270,7 +287,17 @@ class Navigator {
   explicit Navigator(Config cfg,
                      std::shared_ptr<const Logger> _logger =
                          getDefaultLogger("Navigator", Logging::Level::INFO))
-      : m_cfg{std::move(cfg)}, m_logger{std::move(_logger)} {}
+      : m_cfg{std::move(cfg)}, m_logger{std::move(_logger)} {
+    if (m_cfg.navigationCache != nullptr) {
+      const auto& cacheCfg = m_cfg.navigationCache->config();
+      if (cacheCfg.resolveSensitive != m_cfg.resolveSensitive ||
+          cacheCfg.resolveMaterial != m_cfg.resolveMaterial ||
+          cacheCfg.resolvePassive != m_cfg.resolvePassive) {
+        throw std::invalid_argument(
+            "Navigator: navigation cache built for different resolve flags");
+      }
+    }
+  }
 
   /// @brief Navigator status call, will be called in two modes
   ///
@@ -797,10 +824,13 @@ class Navigator {
               protoNavSurfaces.front().intersection.pathLength > 1_um) {
             // we are not, go on
             // state.navigation.navSurfaces = std::move(protoNavSurfaces);
+            const auto* storage = state.navigation.navSurfaces.data();
             state.navigation.navSurfaces.clear();
             state.navigation.navSurfaces.insert(
                 state.navigation.navSurfaces.begin(), protoNavSurfaces.begin(),
                 protoNavSurfaces.end());
+            countReallocation(state.navigation,
+                              state.navigation.navSurfaces, storage);
 
             state.navigation.navSurfaceIter =
                 state.navigation.navSurfaces.begin();
@@ -943,10 +973,13 @@ class Navigator {
                    << stepper.direction(state.stepping).transpose());
 
       // Evaluate the boundary surfaces
+      const auto* storage = state.navigation.navBoundaries.data();
       state.navigation.navBoundaries =
           state.navigation.currentVolume->compatibleBoundaries(
               state.geoContext, stepper.position(state.stepping),
               stepper.direction(state.stepping), navOpts, logger());
+      countReallocation(state.navigation, state.navigation.navBoundaries,
+                        storage);
       // The number of boundary candidates
       if (logger().doPrint(Logging::VERBOSE)) {
         std::ostringstream os;
@@ -1139,9 +1172,29 @@ class Navigator {
                                 : stepper.overstepLimit(state.stepping);
 
     // get the surfaces
-    state.navigation.navSurfaces = navLayer->compatibleSurfaces(
-        state.geoContext, stepper.position(state.stepping),
-        stepper.direction(state.stepping), navOpts);
+    const Vector3 position = stepper.position(state.stepping);
+    const Vector3 direction = stepper.direction(state.stepping);
+    const auto* storage = state.navigation.navSurfaces.data();
+    if (m_cfg.navigationCache == nullptr ||
+        !m_cfg.navigationCache->compatibleSurfaces(
+            state.geoContext, *navLayer, position, direction, navOpts,
+            state.navigation.navSurfaces)) {
+      state.navigation.navSurfaces = navLayer->compatibleSurfaces(
+          state.geoContext, position, direction, navOpts);
+    } else if (m_cfg.validateNavigationCache) {
+      auto navSurfaces = navLayer->compatibleSurfaces(
+          state.geoContext, position, direction, navOpts);
+      if (!sameCandidates(navSurfaces, state.navigation.navSurfaces)) {
+        ACTS_WARNING(volInfo(state)
+                     << "Cached surface candidates on layer "
+                     << navLayer->geometryId() << " differ: "
+                     << state.navigation.navSurfaces.size() << " instead of "
+                     << navSurfaces.size() << " found.");
+        state.navigation.navSurfaces = std::move(navSurfaces);
+      }
+    }
+    countReallocation(state.navigation, state.navigation.navSurfaces,
+                      storage);
     // the number of layer candidates
     if (!state.navigation.navSurfaces.empty()) {
       if (logger().doPrint(Logging::VERBOSE)) {
@@ -1205,10 +1258,28 @@ class Navigator {
         stepper.getStepSize(state.stepping, ConstrainedStep::aborter);
     navOpts.overstepLimit = stepper.overstepLimit(state.stepping);
     // Request the compatible layers
-    state.navigation.navLayers =
-        state.navigation.currentVolume->compatibleLayers(
-            state.geoContext, stepper.position(state.stepping),
-            stepper.direction(state.stepping), navOpts);
+    const Vector3 position = stepper.position(state.stepping);
+    const Vector3 direction = stepper.direction(state.stepping);
+    const TrackingVolume& volume = *state.navigation.currentVolume;
+    const auto* storage = state.navigation.navLayers.data();
+    if (m_cfg.navigationCache == nullptr ||
+        !m_cfg.navigationCache->compatibleLayers(state.geoContext, volume,
+                                                 position, direction, navOpts,
+                                                 state.navigation.navLayers)) {
+      state.navigation.navLayers = volume.compatibleLayers(
+          state.geoContext, position, direction, navOpts);
+    } else if (m_cfg.validateNavigationCache) {
+      auto navLayers = volume.compatibleLayers(state.geoContext, position,
+                                               direction, navOpts);
+      if (!sameCandidates(navLayers, state.navigation.navLayers)) {
+        ACTS_WARNING(volInfo(state)
+                     << "Cached layer candidates differ: "
+                     << state.navigation.navLayers.size() << " instead of "
+                     << navLayers.size() << " found.");
+        state.navigation.navLayers = std::move(navLayers);
+      }
+    }
+    countReallocation(state.navigation, state.navigation.navLayers, storage);
 
     // Layer candidates have been found
     if (!state.navigation.navLayers.empty()) {
@@ -1309,6 +1380,34 @@ class Navigator {
            " | ";
   }
 
+  /// Compare the cached candidates to the exhaustively searched ones
+  template <typename candidates_t>
+  static bool sameCandidates(const candidates_t& exhaustive,
+                             const candidates_t& cached) {
+    return std::equal(exhaustive.begin(), exhaustive.end(), cached.begin(),
+                      cached.end(), [](const auto& a, const auto& b) {
+                        return a.object == b.object &&
+                               a.representation == b.representation &&
+                               a.intersection.pathLength ==
+                                   b.intersection.pathLength;
+                      });
+  }
+
+  /// Count a candidate buffer which moved to new heap storage during a fill
+  ///
+  /// @param [in,out] navState is the navigation state to count in
+  /// @param [in] candidates is the candidate buffer after the fill
+  /// @param [in] storage is the storage of the buffer before the fill
+  template <typename candidates_t>
+  static void countReallocation(
+      State& navState, const candidates_t& candidates,
+      const typename candidates_t::value_type* storage) {
+    if (candidates.data() != storage &&
+        candidates.capacity() > candidates_t::static_capacity) {
+      ++navState.candidateBufferReallocations;
+    }
+  }
+
   const Logger& logger() const { return *m_logger; }
 
   Config m_cfg;
@@ -26,6 +26,7 @@
 #include "Acts/Propagator/detail/VoidPropagatorComponents.hpp"
 #include "Acts/Utilities/Logger.hpp"
 #include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/TypeTraits.hpp"
 
 #include <cmath>
 #include <functional>
@@ -36,6 +37,12 @@
 
 namespace Acts {
 
+namespace detail {
+template <typename navigation_state_t>
+using candidate_allocations_t =
+    decltype(std::declval<navigation_state_t>().candidateAllocations);
+}  // namespace detail
+
 /// @brief Simple class holding result of propagation call
 ///
 /// @tparam parameters_t Type of final track parameters
@@ -57,6 +64,11 @@ struct PropagatorResult : private detail::Extendable<result_list...> {
 
   /// Signed distance over which the parameters were propagated
   double pathLength = 0.;
+
+  /// Number of times a navigation candidate buffer outgrew its inline
+  /// capacity, always zero for navigators without candidate buffers. This is
+  /// not the total number of heap allocations of the navigation.
+  std::size_t candidateBufferReallocations = 0;
 };
 
 /// @brief Class holding the trivial options in propagator options
@@ -64,6 +64,13 @@ auto Acts::Propagator<S, N>::propagate_impl(propagator_state_t& state,
     ACTS_VERBOSE("Propagation terminated without going into stepping loop.");
   }
 
+  // Report the allocations of the navigation candidate buffers
+  if constexpr (Concepts::exists<detail::candidate_allocations_t,
+                                 decltype(state.navigation)>) {
+    result.candidateBufferReallocations =
+        state.navigation.candidateBufferReallocations;
+  }
+
   // if we didn't terminate normally (via aborters) set navigation break.
   // this will trigger error output in the lines below
   if (!terminatedNormally) {
@@ -13,7 +13,9 @@
 
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Material/IVolumeMaterial.hpp"
 #include "Acts/Material/Interactions.hpp"
+#include "Acts/Material/detail/AverageMaterials.hpp"
 #include "Acts/Propagator/Propagator.hpp"
 #include "Acts/Utilities/Helpers.hpp"
 
@@ -42,6 +44,8 @@ struct GenericDenseEnvironmentExtension {
   /// Material that will be passed
   /// TODO : Might not be needed anymore
   Material material;
+  /// Cache of the volume material lookups, kept between the steps
+  IVolumeMaterial::Cache materialCache;
   /// Derivatives dLambda''dlambda at each sub-step point
   std::array<Scalar, 4> dLdl{};
   /// q/p at each sub-step
@@ -105,9 +109,7 @@ struct GenericDenseEnvironmentExtension {
     // i = 0 is used for setup and evaluation of k
     if (i == 0) {
       // Set up container for energy loss
-      auto volumeMaterial = state.navigation.currentVolume->volumeMaterial();
-      ThisVector3 position = stepper.position(state.stepping);
-      material = (volumeMaterial->material(position.template cast<double>()));
+      material = stepMaterial(state, stepper);
       initialMomentum = stepper.momentum(state.stepping);
       currentMomentum = initialMomentum;
       qop[0] = stepper.charge(state.stepping) / initialMomentum;
@@ -356,6 +358,47 @@ struct GenericDenseEnvironmentExtension {
     return true;
   }
 
+  /// @brief Evaluates the volume material of a step
+  ///
+  /// The material is taken at the start of the step, or averaged over
+  /// equidistant points along the straight line approximation of the step.
+  ///
+  /// @note The samples span the trial step size, the step size before the
+  /// adaptive step size control. The material enters the first Runge-Kutta
+  /// point, which is evaluated once for all the trials of a step. If the
+  /// step is reduced, the material of the accepted step is averaged with the
+  /// material up to the end of the trial step.
+  ///
+  /// @tparam propagator_state_t Type of the state of the propagator
+  /// @tparam stepper_t Type of the stepper
+  /// @param [in] state State of the propagator
+  /// @param [in] stepper Stepper of the propagation
+  /// @return The material of the step
+  template <typename propagator_state_t, typename stepper_t>
+  Material stepMaterial(const propagator_state_t& state,
+                        const stepper_t& stepper) {
+    const IVolumeMaterial& volumeMaterial =
+        *state.navigation.currentVolume->volumeMaterial();
+    ThisVector3 position = stepper.position(state.stepping);
+    const Vector3 start = position.template cast<double>();
+    const unsigned int nSamples = state.options.stepMaterialSamples;
+    if (nSamples < 2) {
+      return volumeMaterial.cachedMaterial(start, materialCache);
+    }
+    ThisVector3 direction = stepper.direction(state.stepping);
+    const Vector3 step =
+        direction.template cast<double>() * state.stepping.stepSize.value();
+    MaterialSlab slab(volumeMaterial.cachedMaterial(start, materialCache), 1.);
+    for (unsigned int i = 1; i < nSamples; ++i) {
+      const Vector3 sample = start + (double(i) / (nSamples - 1)) * step;
+      slab = combineSlabs(
+          slab,
+          MaterialSlab(volumeMaterial.cachedMaterial(sample, materialCache),
+                       1.));
+    }
+    return slab.material();
+  }
+
   /// @brief Initializer of all parameters related to a RKN4 step with energy
   /// loss of a particle in material
   ///
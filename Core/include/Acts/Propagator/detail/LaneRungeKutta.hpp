@@ -0,0 +1,282 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace Acts {
+namespace detail {
+
+/// @brief Runge-Kutta-Nystrom integration of several tracks in lockstep
+///
+/// The tracks are stored in structure-of-arrays form, where every scalar
+/// quantity is an @c Eigen::Array with one entry (lane) per track, such that
+/// the RKN4 stages, the error estimates and the transport matrices are
+/// evaluated with Eigen's packet (SIMD) math. The integration follows the
+/// @c EigenStepper with the @c DefaultExtension, i.e. without energy loss.
+/// The bookkeeping of the tracks and of their step sizes is left to the
+/// steppers.
+///
+/// Lanes which are not stepped are masked, the masked lanes of the step data
+/// are not modified.
+///
+/// @tparam N Number of lanes
+template <std::size_t N>
+struct LaneRungeKutta {
+  /// One scalar per lane
+  using Lanes = Eigen::Array<double, N, 1>;
+  /// One flag per lane
+  using LaneMask = Eigen::Array<bool, N, 1>;
+  /// One three-vector per lane, stored coordinate-wise
+  using LaneVector3 = std::array<Lanes, 3>;
+  /// One 3x3 matrix per lane, stored row-major
+  using LaneMatrix3 = std::array<Lanes, 9>;
+
+  /// @brief Storage of magnetic field and the sub steps during a RKN4 step
+  struct StepData {
+    /// Magnetic field evaulations
+    LaneVector3 B_first = {Lanes::Zero(), Lanes::Zero(), Lanes::Zero()};
+    LaneVector3 B_middle = B_first;
+    LaneVector3 B_last = B_first;
+    /// k_i of the RKN4 algorithm
+    LaneVector3 k1 = B_first;
+    LaneVector3 k2 = B_first;
+    LaneVector3 k3 = B_first;
+    LaneVector3 k4 = B_first;
+  };
+
+  /// @brief Non-trivial blocks of the transport matrix of a step
+  ///
+  /// The transport matrix D, calculated as in the DefaultExtension following
+  /// ATL-SOFT-PUB-2009-002, without the time row, which depends on the
+  /// momentum and the mass.
+  struct Transport {
+    /// Derivative of the position by the direction
+    LaneMatrix3 dFdT;
+    /// Derivative of the direction by the direction
+    LaneMatrix3 dGdT;
+    /// Derivative of the position by q/p
+    LaneVector3 dFdL;
+    /// Derivative of the direction by q/p
+    LaneVector3 dGdL;
+  };
+
+  /// Lane-wise cross product of two three-vectors
+  static LaneVector3 cross(const LaneVector3& a, const LaneVector3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+            a[0] * b[1] - a[1] * b[0]};
+  }
+
+  /// Evaluate the first Runge-Kutta point at the current position
+  ///
+  /// @param [in] dir The directions of the lanes
+  /// @param [in] qop The charge over momentum of the lanes
+  /// @param [in,out] sd The step data with the field at the current position
+  static void firstStage(const LaneVector3& dir, const Lanes& qop,
+                         StepData& sd) {
+    sd.k1 = cross(dir, sd.B_first);
+    for (auto& k : sd.k1) {
+      k *= qop;
+    }
+  }
+
+  /// Try a Runge-Kutta step for the pending lanes
+  ///
+  /// The field lookups are done through @p getField with the signature
+  /// `void(const LaneVector3& pos, LaneVector3& field, LaneMask& lanes)`,
+  /// which removes the lanes of failed lookups from @c lanes.
+  ///
+  /// @param [in] pos The positions of the lanes
+  /// @param [in] dir The directions of the lanes
+  /// @param [in] qop The charge over momentum of the lanes
+  /// @param [in] h The trial step sizes, zero for masked lanes
+  /// @param [in] tolerance The tolerance of the local integration error
+  /// @param [in] getField The field lookup of the lanes
+  /// @param [in,out] sd The step data, the field and the k_i of the accepted
+  ///        lanes are updated
+  /// @param [in,out] pending The lanes to try, lanes with failed lookups are
+  ///        removed
+  /// @param [out] error The local integration error estimates
+  /// @return The lanes for which the step is accepted
+  template <typename field_getter_t>
+  static LaneMask tryStep(const LaneVector3& pos, const LaneVector3& dir,
+                          const Lanes& qop, const Lanes& h, double tolerance,
+                          field_getter_t&& getField, StepData& sd,
+                          LaneMask& pending, Lanes& error) {
+    // State the square and half of the step size
+    const Lanes h2 = h * h;
+    const Lanes half_h = h * 0.5;
+
+    // Second Runge-Kutta point
+    LaneVector3 pos1, arg;
+    for (unsigned int i = 0; i < 3; ++i) {
+      pos1[i] = pos[i] + half_h * dir[i] + h2 * 0.125 * sd.k1[i];
+    }
+    LaneVector3 B_middle = sd.B_middle;
+    getField(pos1, B_middle, pending);
+
+    for (unsigned int i = 0; i < 3; ++i) {
+      arg[i] = dir[i] + half_h * sd.k1[i];
+    }
+    LaneVector3 k2 = cross(arg, B_middle);
+
+    // Third Runge-Kutta point
+    for (unsigned int i = 0; i < 3; ++i) {
+      k2[i] *= qop;
+      arg[i] = dir[i] + half_h * k2[i];
+    }
+    LaneVector3 k3 = cross(arg, B_middle);
+
+    // Last Runge-Kutta point
+    LaneVector3 pos2;
+    for (unsigned int i = 0; i < 3; ++i) {
+      k3[i] *= qop;
+      pos2[i] = pos[i] + h * dir[i] + h2 * 0.5 * k3[i];
+    }
+    LaneVector3 B_last = sd.B_last;
+    getField(pos2, B_last, pending);
+    for (unsigned int i = 0; i < 3; ++i) {
+      arg[i] = dir[i] + h * k3[i];
+    }
+    LaneVector3 k4 = cross(arg, B_last);
+
+    // Compute and check the local integration error estimate
+    error = Lanes::Zero();
+    for (unsigned int i = 0; i < 3; ++i) {
+      k4[i] *= qop;
+      error += (sd.k1[i] - k2[i] - k3[i] + k4[i]).abs();
+    }
+    error = (h2 * error).max(1e-20);
+
+    const LaneMask accepted = pending && (error <= tolerance);
+    for (unsigned int i = 0; i < 3; ++i) {
+      sd.B_middle[i] = accepted.select(B_middle[i], sd.B_middle[i]);
+      sd.B_last[i] = accepted.select(B_last[i], sd.B_last[i]);
+      sd.k2[i] = accepted.select(k2[i], sd.k2[i]);
+      sd.k3[i] = accepted.select(k3[i], sd.k3[i]);
+      sd.k4[i] = accepted.select(k4[i], sd.k4[i]);
+    }
+    return accepted;
+  }
+
+  /// The scaling of the step size for a given error estimate, as in the
+  /// EigenStepper
+  ///
+  /// @param [in] tolerance The tolerance of the local integration error
+  /// @param [in] error The error estimates, or twice the error estimates of
+  ///        rejected steps
+  static Lanes stepSizeScaling(double tolerance, const Lanes& error) {
+    return (tolerance / error.abs())
+        .template cast<float>()
+        .sqrt()
+        .sqrt()
+        .max(0.25f)
+        .min(4.0f)
+        .template cast<double>();
+  }
+
+  /// Evaluate the transport matrix of the accepted step
+  ///
+  /// @param [in] dir The directions of the lanes at the start of the step
+  /// @param [in] qop The charge over momentum of the lanes
+  /// @param [in] h The accepted step sizes
+  /// @param [in] sd The step data of the accepted step
+  /// @return The blocks of the transport matrix
+  static Transport transport(const LaneVector3& dir, const Lanes& qop,
+                             const Lanes& h, const StepData& sd) {
+    const Lanes h2 = h * h;
+    const Lanes half_h = h * 0.5;
+
+    LaneMatrix3 dk1dT, dk2dT, dk3dT, dk4dT;
+    LaneVector3 dk1dL, dk2dL, dk3dL, dk4dL, arg;
+
+    // For the case without energy loss
+    dk1dL = cross(dir, sd.B_first);
+    for (unsigned int i = 0; i < 3; ++i) {
+      arg[i] = dir[i] + half_h * sd.k1[i];
+    }
+    dk2dL = cross(arg, sd.B_middle);
+    LaneVector3 corr = cross(dk1dL, sd.B_middle);
+    for (unsigned int i = 0; i < 3; ++i) {
+      dk2dL[i] += qop * half_h * corr[i];
+      arg[i] = dir[i] + half_h * sd.k2[i];
+    }
+    dk3dL = cross(arg, sd.B_middle);
+    corr = cross(dk2dL, sd.B_middle);
+    for (unsigned int i = 0; i < 3; ++i) {
+      dk3dL[i] += qop * half_h * corr[i];
+      arg[i] = dir[i] + h * sd.k3[i];
+    }
+    dk4dL = cross(arg, sd.B_last);
+    corr = cross(dk3dL, sd.B_last);
+    for (unsigned int i = 0; i < 3; ++i) {
+      dk4dL[i] += qop * h * corr[i];
+    }
+
+    const LaneVector3& B1 = sd.B_first;
+    dk1dT = {Lanes::Zero(), qop * B1[2], -qop * B1[1],  //
+             -qop * B1[2],  Lanes::Zero(), qop * B1[0],  //
+             qop * B1[1],   -qop * B1[0],  Lanes::Zero()};
+
+    // dk_{i+1}dT = qop * ((Id + f * dk_{i}dT) x B), column-wise cross product
+    const auto nextdkdT = [&](const LaneMatrix3& prev, const Lanes& f,
+                              const LaneVector3& B, LaneMatrix3& next) {
+      for (unsigned int c = 0; c < 3; ++c) {
+        LaneVector3 column;
+        for (unsigned int r = 0; r < 3; ++r) {
+          column[r] = f * prev[r * 3 + c];
+        }
+        column[c] += 1.;
+        const LaneVector3 crossed = cross(column, B);
+        for (unsigned int r = 0; r < 3; ++r) {
+          next[r * 3 + c] = qop * crossed[r];
+        }
+      }
+    };
+    nextdkdT(dk1dT, half_h, sd.B_middle, dk2dT);
+    nextdkdT(dk2dT, half_h, sd.B_middle, dk3dT);
+    nextdkdT(dk3dT, h, sd.B_last, dk4dT);
+
+    Transport D;
+    for (unsigned int r = 0; r < 3; ++r) {
+      for (unsigned int c = 0; c < 3; ++c) {
+        const unsigned int i = r * 3 + c;
+        const double id = (r == c ? 1. : 0.);
+        D.dFdT[i] = h * (id + h / 6. * (dk1dT[i] + dk2dT[i] + dk3dT[i]));
+        D.dGdT[i] = id + h / 6. * (dk1dT[i] + 2. * (dk2dT[i] + dk3dT[i]) +
+                                   dk4dT[i]);
+      }
+      D.dFdL[r] = h2 / 6. * (dk1dL[r] + dk2dL[r] + dk3dL[r]);
+      D.dGdL[r] = h / 6. * (dk1dL[r] + 2. * (dk2dL[r] + dk3dL[r]) + dk4dL[r]);
+    }
+    return D;
+  }
+
+  /// Update the positions and the directions according to the equations of
+  /// motion, the directions are not normalized
+  ///
+  /// @param [in,out] pos The positions of the lanes
+  /// @param [in,out] dir The directions of the lanes
+  /// @param [in] h The accepted step sizes, zero for masked lanes
+  /// @param [in] sd The step data of the accepted step
+  static void advance(LaneVector3& pos, LaneVector3& dir, const Lanes& h,
+                      const StepData& sd) {
+    const Lanes h2 = h * h;
+    for (unsigned int i = 0; i < 3; ++i) {
+      pos[i] += h * dir[i] + h2 / 6. * (sd.k1[i] + sd.k2[i] + sd.k3[i]);
+      dir[i] += h / 6. * (sd.k1[i] + 2. * (sd.k2[i] + sd.k3[i]) + sd.k4[i]);
+    }
+  }
+};
+
+}  // namespace detail
+}  // namespace Acts
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Acts/Definitions/Algebra.hpp"
 #include "Acts/Definitions/Units.hpp"
 #include "Acts/Geometry/Extent.hpp"
 #include "Acts/Seeding/CandidatesForMiddleSp.hpp"
@@ -16,6 +17,7 @@
 #include "Acts/Seeding/SeedFilter.hpp"
 #include "Acts/Seeding/SeedFinderConfig.hpp"
 #include "Acts/Seeding/SeedFinderUtils.hpp"
+#include "Acts/Seeding/SpacePointSoA.hpp"
 
 #include <array>
 #include <list>
@@ -55,6 +57,12 @@ class SeedFinder {
     // managing seed candidates for SpM
     CandidatesForMiddleSp<InternalSpacePoint<external_spacepoint_t>>
         candidates_collector;
+
+    // contiguous copies of the bottom and top space points of the group
+    SpacePointSoA<external_spacepoint_t> bottomSPData;
+    SpacePointSoA<external_spacepoint_t> topSPData;
+    // top space point parameters and triplet quantities for SpM
+    TripletCandidatesSoA tripletData;
   };
 
   /// The only constructor. Requires a config object.
@@ -111,9 +119,13 @@ class SeedFinder {
       sp_range_t middleSPs, sp_range_t topSPs) const;
 
  private:
-  template <typename sp_range_t, typename out_range_t>
+  /// Select the space points forming a compatible doublet with the middle
+  /// space point. The doublet slopes are evaluated for all space points at
+  /// once on the contiguous coordinate arrays.
+  template <typename out_range_t>
   void getCompatibleDoublets(
-      const Acts::SeedFinderOptions& options, sp_range_t& otherSPs,
+      const Acts::SeedFinderOptions& options,
+      SpacePointSoA<external_spacepoint_t>& otherSPs,
       const InternalSpacePoint<external_spacepoint_t>& mediumSP,
       out_range_t& outVec, const float& deltaRMinSP, const float& deltaRMaxSP,
       bool isBottom) const;
@@ -123,6 +135,35 @@ class SeedFinder {
                         SeedFilterState& seedFilterState,
                         SeedingState& state) const;
 
+  /// Outcome of the cuts on the helix of a triplet candidate
+  enum class TripletCut { Accepted, Rejected, RejectedByScattering };
+
+  /// Apply the cuts on the helix of a triplet candidate, i.e. on the helix
+  /// diameter, the scattering for the estimated pT and the impact parameter,
+  /// and store the candidate in the state if it passes them.
+  ///
+  /// @param options The seed finder options
+  /// @param spT The top space point of the candidate
+  /// @param A The slope of the circle in the U/V plane
+  /// @param B The intercept of the circle in the U/V plane
+  /// @param rM The transverse radius of the middle space point
+  /// @param cotThetaAvg2 The squared average cotTheta of the two segments
+  /// @param deltaCotTheta2 The squared cotTheta difference of the segments
+  /// @param error2 The squared uncertainty of the cotTheta difference
+  /// @param iSinTheta2 The inverse squared sinTheta of the bottom segment
+  /// @param state The seeding state to store the candidate in
+  TripletCut acceptTriplet(const Acts::SeedFinderOptions& options,
+                           InternalSpacePoint<external_spacepoint_t>* spT,
+                           float A, float B, float rM, float cotThetaAvg2,
+                           float deltaCotTheta2, float error2,
+                           float iSinTheta2, SeedingState& state) const;
+
+  /// Evaluate the quantities of the first triplet cut for the top space
+  /// points in [@p t0, @p t1) and one bottom space point
+  void computeTripletQuantities(TripletCandidatesSoA& data, std::size_t t0,
+                                std::size_t t1, const LinCircle& lb,
+                                float varianceRM, float varianceZM) const;
+
  private:
   Acts::SeedFinderConfig<external_spacepoint_t> m_config;
 };
@@ -6,6 +6,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <type_traits>
@@ -55,6 +56,11 @@ void SeedFinder<external_spacepoint_t, platform_t>::createSeedsForGroup(
   state.candidates_collector.setMaxElements(max_num_seeds_per_spm,
                                             max_num_quality_seeds_per_spm);
 
+  // the bottom and top space points of the group are copied to contiguous
+  // arrays once for all middle space points, if any middle space point passes
+  // the radial selection
+  bool spDataFilled = false;
+
   for (auto spM : middleSPs) {
     float rM = spM->radius();
     float zM = spM->z();
@@ -100,7 +106,13 @@ void SeedFinder<external_spacepoint_t, platform_t>::createSeedsForGroup(
       }
     }
 
-    getCompatibleDoublets(options, topSPs, *spM, state.compatTopSP,
+    if (not spDataFilled) {
+      state.bottomSPData.assign(bottomSPs);
+      state.topSPData.assign(topSPs);
+      spDataFilled = true;
+    }
+
+    getCompatibleDoublets(options, state.topSPData, *spM, state.compatTopSP,
                           m_config.deltaRMinTopSP, m_config.deltaRMaxTopSP,
                           false);
 
@@ -128,8 +140,8 @@ void SeedFinder<external_spacepoint_t, platform_t>::createSeedsForGroup(
       }
     }
 
-    getCompatibleDoublets(options, bottomSPs, *spM, state.compatBottomSP,
-                          m_config.deltaRMinBottomSP,
+    getCompatibleDoublets(options, state.bottomSPData, *spM,
+                          state.compatBottomSP, m_config.deltaRMinBottomSP,
                           m_config.deltaRMaxBottomSP, true);
 
     // no bottom SP found -> try next spM
@@ -147,9 +159,10 @@ void SeedFinder<external_spacepoint_t, platform_t>::createSeedsForGroup(
 }
 
 template <typename external_spacepoint_t, typename platform_t>
-template <typename sp_range_t, typename out_range_t>
+template <typename out_range_t>
 void SeedFinder<external_spacepoint_t, platform_t>::getCompatibleDoublets(
-    const Acts::SeedFinderOptions& options, sp_range_t& otherSPs,
+    const Acts::SeedFinderOptions& options,
+    SpacePointSoA<external_spacepoint_t>& otherSPs,
     const InternalSpacePoint<external_spacepoint_t>& mediumSP,
     out_range_t& outVec, const float& deltaRMinSP, const float& deltaRMaxSP,
     bool isBottom) const {
@@ -164,9 +177,33 @@ void SeedFinder<external_spacepoint_t, platform_t>::getCompatibleDoublets(
   const float ratio_xM_rM = xM / rM;
   const float ratio_yM_rM = yM / rM;
 
-  for (auto otherSP : otherSPs) {
-    const float rO = otherSP->radius();
-    float deltaR = sign * (rO - rM);
+  using Array = Eigen::Array<float, Eigen::Dynamic, 1>;
+
+  const std::size_t numOtherSP = otherSPs.size();
+  otherSPs.cotTheta.resize(numOtherSP);
+  otherSPs.zOrigin.resize(numOtherSP);
+  Eigen::Map<const Array> rO(otherSPs.r.data(), numOtherSP);
+  Eigen::Map<const Array> zO(otherSPs.z.data(), numOtherSP);
+  Eigen::Map<Array> cotTheta(otherSPs.cotTheta.data(), numOtherSP);
+  Eigen::Map<Array> zOrigin(otherSPs.zOrigin.data(), numOtherSP);
+
+  // The divisions are evaluated for all space points at once with explicit
+  // vectorisation, the cuts are applied in the usual order below. Only the
+  // space points passing the deltaR and deltaZ cuts are divided by their
+  // deltaR, the others by one, such that a space point at the radius of the
+  // middle one does not raise a floating point exception.
+  const auto deltaRs = static_cast<float>(sign) * (rO - rM);
+  const auto deltaZs = static_cast<float>(sign) * (zO - zM);
+  const auto passesDeltaCuts =
+      deltaRs >= deltaRMinSP && deltaRs <= deltaRMaxSP &&
+      deltaZs <= m_config.deltaZMax && deltaZs >= -m_config.deltaZMax;
+  // ratio Z/R (forward angle) of space point duplet
+  cotTheta = deltaZs / passesDeltaCuts.select(deltaRs, 1.f);
+  // duplet origin on z axis
+  zOrigin = zM - rM * cotTheta;
+
+  for (std::size_t i = 0; i < numOtherSP; ++i) {
+    float deltaR = sign * (otherSPs.r[i] - rM);
 
     // if r-distance is too small, try next SP in bin
     if (deltaR < deltaRMinSP) {
@@ -178,34 +215,33 @@ void SeedFinder<external_spacepoint_t, platform_t>::getCompatibleDoublets(
       continue;
     }
 
-    const float zO = otherSP->z();
-    float deltaZ = sign * (zO - zM);
+    float deltaZ = sign * (otherSPs.z[i] - zM);
     if (deltaZ > m_config.deltaZMax or deltaZ < -m_config.deltaZMax) {
       continue;
     }
 
-    // ratio Z/R (forward angle) of space point duplet
-    float cotTheta = deltaZ / deltaR;
-    if (cotTheta > m_config.cotThetaMax or cotTheta < -m_config.cotThetaMax) {
+    if (cotTheta[i] > m_config.cotThetaMax or
+        cotTheta[i] < -m_config.cotThetaMax) {
       continue;
     }
 
     // check if duplet origin on z axis within collision region
-    float zOrigin = zM - rM * cotTheta;
-    if (zOrigin < m_config.collisionRegionMin ||
-        zOrigin > m_config.collisionRegionMax) {
+    if (zOrigin[i] < m_config.collisionRegionMin ||
+        zOrigin[i] > m_config.collisionRegionMax) {
       continue;
     }
 
+    auto otherSP = otherSPs.sp[i];
+
     if (not m_config.interactionPointCut) {
       outVec.push_back(otherSP);
       continue;
     }
 
-    const float xVal =
-        (otherSP->x() - xM) * ratio_xM_rM + (otherSP->y() - yM) * ratio_yM_rM;
-    const float yVal =
-        (otherSP->y() - yM) * ratio_xM_rM - (otherSP->x() - xM) * ratio_yM_rM;
+    const float xVal = (otherSPs.x[i] - xM) * ratio_xM_rM +
+                       (otherSPs.y[i] - yM) * ratio_yM_rM;
+    const float yVal = (otherSPs.y[i] - yM) * ratio_xM_rM -
+                       (otherSPs.x[i] - xM) * ratio_yM_rM;
 
     if (std::abs(rM * yVal) <= sign * m_config.impactMax * xVal) {
       outVec.push_back(otherSP);
@@ -264,6 +300,20 @@ void SeedFinder<external_spacepoint_t, platform_t>::filterCandidates(
   auto sorted_tops =
       transformCoordinates(state.compatTopSP, spM, false, state.linCircleTop);
 
+  // Without skipping top SPs, all top SPs are compared to every bottom SP.
+  // The first cut, which rejects most of the combinations, is then evaluated
+  // on contiguous arrays of the top SP parameters in cotTheta order. This is
+  // explicitly disabled for the detailed double measurement info, whose cuts
+  // use the positions transformed for every triplet and are only done by the
+  // scalar loop. Both loops share the cuts on the helix of the triplet.
+  const bool vectorisedTriplets =
+      not m_config.useDetailedDoubleMeasurementInfo and
+      not m_config.skipPreviousTopSP;
+  TripletCandidatesSoA& tripletData = state.tripletData;
+  if (vectorisedTriplets) {
+    tripletData.assign(state.linCircleTop, sorted_tops);
+  }
+
   // Reserve enough space, in case current capacity is too little
   state.topSpVec.reserve(numTopSP);
   state.curvatures.reserve(numTopSP);
@@ -319,224 +369,208 @@ void SeedFinder<external_spacepoint_t, platform_t>::filterCandidates(
       rotationTermsUVtoXY[1] = spM.y() * sinTheta / spM.radius();
     }
 
-    for (size_t index_t = t0; index_t < numTopSP; index_t++) {
-      const std::size_t& t = sorted_tops[index_t];
+    if (vectorisedTriplets) {
+      computeTripletQuantities(tripletData, t0, numTopSP, lb, varianceRM,
+                               varianceZM);
 
-      auto lt = state.linCircleTop[t];
+      for (size_t index_t = t0; index_t < numTopSP; index_t++) {
+        const float cotThetaAvg2 = tripletData.cotThetaAvg2[index_t];
+        // the geometric average requires the same sign of cotTheta
+        if (not m_config.arithmeticAverageCotTheta and cotThetaAvg2 <= 0) {
+          continue;
+        }
 
-      float cotThetaT = lt.cotTheta;
-      float rMxy = 0.;
-      float ub = 0.;
-      float vb = 0.;
-      float ut = 0.;
-      float vt = 0.;
+        // Apply a cut on the compatibility between the r-z slope of the two
+        // seed segments, see below
+        const float error2 = tripletData.error2[index_t];
+        const float deltaCotTheta2 = tripletData.deltaCotTheta2[index_t];
+        if (deltaCotTheta2 > (error2 + scatteringInRegion2)) {
+          continue;
+        }
 
-      if (m_config.useDetailedDoubleMeasurementInfo) {
+        const float dU = tripletData.U[index_t] - Ub;
         // protects against division by 0
-        float dU = lt.U - Ub;
         if (dU == 0.) {
           continue;
         }
         // A and B are evaluated as a function of the circumference parameters
         // x_0 and y_0
-        float A0 = (lt.V - Vb) / dU;
-
-        // position of Middle SP converted from UV to XY assuming cotTheta
-        // evaluated from the Bottom and Middle SPs double
-        double positionMiddle[3] = {
-            rotationTermsUVtoXY[0] - rotationTermsUVtoXY[1] * A0,
-            rotationTermsUVtoXY[0] * A0 + rotationTermsUVtoXY[1],
-            cosTheta * std::sqrt(1 + A0 * A0)};
-
-        double rMTransf[3];
-        if (!xyzCoordinateCheck(m_config, &spM, positionMiddle, rMTransf)) {
-          continue;
-        }
-
-        // coordinate transformation and checks for bottom spacepoint
-        float B0 = 2. * (Vb - A0 * Ub);
-        float Cb = 1. - B0 * lb.y;
-        float Sb = A0 + B0 * lb.x;
-        double positionBottom[3] = {
-            rotationTermsUVtoXY[0] * Cb - rotationTermsUVtoXY[1] * Sb,
-            rotationTermsUVtoXY[0] * Sb + rotationTermsUVtoXY[1] * Cb,
-            cosTheta * std::sqrt(1 + A0 * A0)};
-
-        auto spB = state.compatBottomSP[b];
-        double rBTransf[3];
-        if (!xyzCoordinateCheck(m_config, spB, positionBottom, rBTransf)) {
-          continue;
+        const float A = (tripletData.V[index_t] - Vb) / dU;
+        const float B = Vb - A * Ub;
+        acceptTriplet(options, state.compatTopSP[sorted_tops[index_t]], A, B,
+                      rM, cotThetaAvg2, deltaCotTheta2, error2, iSinTheta2,
+                      state);
+      }  // loop on tops
+    } else {
+      for (size_t index_t = t0; index_t < numTopSP; index_t++) {
+        const std::size_t& t = sorted_tops[index_t];
+
+        auto lt = state.linCircleTop[t];
+
+        float cotThetaT = lt.cotTheta;
+        float rMxy = 0.;
+        float ub = 0.;
+        float vb = 0.;
+        float ut = 0.;
+        float vt = 0.;
+
+        if (m_config.useDetailedDoubleMeasurementInfo) {
+          // protects against division by 0
+          float dU = lt.U - Ub;
+          if (dU == 0.) {
+            continue;
+          }
+          // A and B are evaluated as a function of the circumference parameters
+          // x_0 and y_0
+          float A0 = (lt.V - Vb) / dU;
+
+          // position of Middle SP converted from UV to XY assuming cotTheta
+          // evaluated from the Bottom and Middle SPs double
+          double positionMiddle[3] = {
+              rotationTermsUVtoXY[0] - rotationTermsUVtoXY[1] * A0,
+              rotationTermsUVtoXY[0] * A0 + rotationTermsUVtoXY[1],
+              cosTheta * std::sqrt(1 + A0 * A0)};
+
+          double rMTransf[3];
+          if (!xyzCoordinateCheck(m_config, &spM, positionMiddle, rMTransf)) {
+            continue;
+          }
+
+          // coordinate transformation and checks for bottom spacepoint
+          float B0 = 2. * (Vb - A0 * Ub);
+          float Cb = 1. - B0 * lb.y;
+          float Sb = A0 + B0 * lb.x;
+          double positionBottom[3] = {
+              rotationTermsUVtoXY[0] * Cb - rotationTermsUVtoXY[1] * Sb,
+              rotationTermsUVtoXY[0] * Sb + rotationTermsUVtoXY[1] * Cb,
+              cosTheta * std::sqrt(1 + A0 * A0)};
+
+          auto spB = state.compatBottomSP[b];
+          double rBTransf[3];
+          if (!xyzCoordinateCheck(m_config, spB, positionBottom, rBTransf)) {
+            continue;
+          }
+
+          // coordinate transformation and checks for top spacepoint
+          float Ct = 1. - B0 * lt.y;
+          float St = A0 + B0 * lt.x;
+          double positionTop[3] = {
+              rotationTermsUVtoXY[0] * Ct - rotationTermsUVtoXY[1] * St,
+              rotationTermsUVtoXY[0] * St + rotationTermsUVtoXY[1] * Ct,
+              cosTheta * std::sqrt(1 + A0 * A0)};
+
+          auto spT = state.compatTopSP[t];
+          double rTTransf[3];
+          if (!xyzCoordinateCheck(m_config, spT, positionTop, rTTransf)) {
+            continue;
+          }
+
+          // bottom and top coordinates in the spM reference frame
+          float xB = rBTransf[0] - rMTransf[0];
+          float yB = rBTransf[1] - rMTransf[1];
+          float zB = rBTransf[2] - rMTransf[2];
+          float xT = rTTransf[0] - rMTransf[0];
+          float yT = rTTransf[1] - rMTransf[1];
+          float zT = rTTransf[2] - rMTransf[2];
+
+          float iDeltaRB2 = 1. / (xB * xB + yB * yB);
+          float iDeltaRT2 = 1. / (xT * xT + yT * yT);
+
+          cotThetaB = -zB * std::sqrt(iDeltaRB2);
+          cotThetaT = zT * std::sqrt(iDeltaRT2);
+
+          rMxy = std::sqrt(rMTransf[0] * rMTransf[0] +
+                           rMTransf[1] * rMTransf[1]);
+          float Ax = rMTransf[0] / rMxy;
+          float Ay = rMTransf[1] / rMxy;
+
+          ub = (xB * Ax + yB * Ay) * iDeltaRB2;
+          vb = (yB * Ax - xB * Ay) * iDeltaRB2;
+          ut = (xT * Ax + yT * Ay) * iDeltaRT2;
+          vt = (yT * Ax - xT * Ay) * iDeltaRT2;
         }
 
-        // coordinate transformation and checks for top spacepoint
-        float Ct = 1. - B0 * lt.y;
-        float St = A0 + B0 * lt.x;
-        double positionTop[3] = {
-            rotationTermsUVtoXY[0] * Ct - rotationTermsUVtoXY[1] * St,
-            rotationTermsUVtoXY[0] * St + rotationTermsUVtoXY[1] * Ct,
-            cosTheta * std::sqrt(1 + A0 * A0)};
-
-        auto spT = state.compatTopSP[t];
-        double rTTransf[3];
-        if (!xyzCoordinateCheck(m_config, spT, positionTop, rTTransf)) {
+        // use geometric average
+        float cotThetaAvg2 = cotThetaB * cotThetaT;
+        if (m_config.arithmeticAverageCotTheta) {
+          // use arithmetic average
+          float averageCotTheta = 0.5 * (cotThetaB + cotThetaT);
+          cotThetaAvg2 = averageCotTheta * averageCotTheta;
+        } else if (cotThetaAvg2 <= 0) {
           continue;
         }
 
-        // bottom and top coordinates in the spM reference frame
-        float xB = rBTransf[0] - rMTransf[0];
-        float yB = rBTransf[1] - rMTransf[1];
-        float zB = rBTransf[2] - rMTransf[2];
-        float xT = rTTransf[0] - rMTransf[0];
-        float yT = rTTransf[1] - rMTransf[1];
-        float zT = rTTransf[2] - rMTransf[2];
-
-        float iDeltaRB2 = 1. / (xB * xB + yB * yB);
-        float iDeltaRT2 = 1. / (xT * xT + yT * yT);
-
-        cotThetaB = -zB * std::sqrt(iDeltaRB2);
-        cotThetaT = zT * std::sqrt(iDeltaRT2);
-
-        rMxy = std::sqrt(rMTransf[0] * rMTransf[0] + rMTransf[1] * rMTransf[1]);
-        float Ax = rMTransf[0] / rMxy;
-        float Ay = rMTransf[1] / rMxy;
-
-        ub = (xB * Ax + yB * Ay) * iDeltaRB2;
-        vb = (yB * Ax - xB * Ay) * iDeltaRB2;
-        ut = (xT * Ax + yT * Ay) * iDeltaRT2;
-        vt = (yT * Ax - xT * Ay) * iDeltaRT2;
-      }
-
-      // use geometric average
-      float cotThetaAvg2 = cotThetaB * cotThetaT;
-      if (m_config.arithmeticAverageCotTheta) {
-        // use arithmetic average
-        float averageCotTheta = 0.5 * (cotThetaB + cotThetaT);
-        cotThetaAvg2 = averageCotTheta * averageCotTheta;
-      } else if (cotThetaAvg2 <= 0) {
-        continue;
-      }
-
-      // add errors of spB-spM and spM-spT pairs and add the correlation term
-      // for errors on spM
-      float error2 =
-          lt.Er + ErB +
-          2 * (cotThetaAvg2 * varianceRM + varianceZM) * iDeltaRB * lt.iDeltaR;
-
-      float deltaCotTheta = cotThetaB - cotThetaT;
-      float deltaCotTheta2 = deltaCotTheta * deltaCotTheta;
-      // Apply a cut on the compatibility between the r-z slope of the two
-      // seed segments. This is done by comparing the squared difference
-      // between slopes, and comparing to the squared uncertainty in this
-      // difference - we keep a seed if the difference is compatible within
-      // the assumed uncertainties. The uncertainties get contribution from
-      // the  space-point-related squared error (error2) and a scattering term
-      // calculated assuming the minimum pt we expect to reconstruct
-      // (scatteringInRegion2). This assumes gaussian error propagation which
-      // allows just adding the two errors if they are uncorrelated (which is
-      // fair for scattering and measurement uncertainties)
-      if (deltaCotTheta2 > (error2 + scatteringInRegion2)) {
-        // skip top SPs based on cotTheta sorting when producing triplets
-        if (not m_config.skipPreviousTopSP) {
+        // add errors of spB-spM and spM-spT pairs and add the correlation term
+        // for errors on spM
+        float error2 = lt.Er + ErB +
+                       2 * (cotThetaAvg2 * varianceRM + varianceZM) *
+                           iDeltaRB * lt.iDeltaR;
+
+        float deltaCotTheta = cotThetaB - cotThetaT;
+        float deltaCotTheta2 = deltaCotTheta * deltaCotTheta;
+        // Apply a cut on the compatibility between the r-z slope of the two
+        // seed segments. This is done by comparing the squared difference
+        // between slopes, and comparing to the squared uncertainty in this
+        // difference - we keep a seed if the difference is compatible within
+        // the assumed uncertainties. The uncertainties get contribution from
+        // the  space-point-related squared error (error2) and a scattering term
+        // calculated assuming the minimum pt we expect to reconstruct
+        // (scatteringInRegion2). This assumes gaussian error propagation which
+        // allows just adding the two errors if they are uncorrelated (which is
+        // fair for scattering and measurement uncertainties)
+        if (deltaCotTheta2 > (error2 + scatteringInRegion2)) {
+          // skip top SPs based on cotTheta sorting when producing triplets
+          if (not m_config.skipPreviousTopSP) {
+            continue;
+          }
+          // break if cotTheta from bottom SP < cotTheta from top SP because
+          // the SP are sorted by cotTheta
+          if (cotThetaB - cotThetaT < 0) {
+            break;
+          }
+          t0 = index_t + 1;
           continue;
         }
-        // break if cotTheta from bottom SP < cotTheta from top SP because
-        // the SP are sorted by cotTheta
-        if (cotThetaB - cotThetaT < 0) {
-          break;
-        }
-        t0 = index_t + 1;
-        continue;
-      }
 
-      float dU = 0;
-      float A = 0;
-      float S2 = 0;
-      float B = 0;
-      float B2 = 0;
-
-      if (m_config.useDetailedDoubleMeasurementInfo) {
-        dU = ut - ub;
-        // protects against division by 0
-        if (dU == 0.) {
-          continue;
-        }
-        A = (vt - vb) / dU;
-        S2 = 1. + A * A;
-        B = vb - A * ub;
-        B2 = B * B;
-      } else {
-        dU = lt.U - Ub;
-        // protects against division by 0
-        if (dU == 0.) {
-          continue;
+        float dU = 0;
+        float A = 0;
+        float B = 0;
+
+        if (m_config.useDetailedDoubleMeasurementInfo) {
+          dU = ut - ub;
+          // protects against division by 0
+          if (dU == 0.) {
+            continue;
+          }
+          A = (vt - vb) / dU;
+          B = vb - A * ub;
+        } else {
+          dU = lt.U - Ub;
+          // protects against division by 0
+          if (dU == 0.) {
+            continue;
+          }
+          // A and B are evaluated as a function of the circumference parameters
+          // x_0 and y_0
+          A = (lt.V - Vb) / dU;
+          B = Vb - A * Ub;
         }
-        // A and B are evaluated as a function of the circumference parameters
-        // x_0 and y_0
-        A = (lt.V - Vb) / dU;
-        S2 = 1. + A * A;
-        B = Vb - A * Ub;
-        B2 = B * B;
-      }
-
-      // sqrt(S2)/B = 2 * helixradius
-      // calculated radius must not be smaller than minimum radius
-
-      if (S2 < B2 * options.minHelixDiameter2) {
-        continue;
-      }
 
-      // refinement of the cut on the compatibility between the r-z slope of
-      // the two seed segments using a scattering term scaled by the actual
-      // measured pT (p2scatterSigma)
-      float iHelixDiameter2 = B2 / S2;
-      // calculate scattering for p(T) calculated from seed curvature
-      float pT2scatterSigma = iHelixDiameter2 * options.sigmapT2perRadius;
-      // if pT > maxPtScattering, calculate allowed scattering angle using
-      // maxPtScattering instead of pt.
-      float pT = options.pTPerHelixRadius * std::sqrt(S2 / B2) / 2.;
-      if (pT > m_config.maxPtScattering) {
-        float pTscatterSigma = (m_config.highland / m_config.maxPtScattering) *
-                               m_config.sigmaScattering;
-        pT2scatterSigma = pTscatterSigma * pTscatterSigma;
-      }
-      // convert p(T) to p scaling by sin^2(theta) AND scale by 1/sin^4(theta)
-      // from rad to deltaCotTheta
-      float p2scatterSigma = pT2scatterSigma * iSinTheta2;
-      // if deltaTheta larger than allowed scattering for calculated pT, skip
-      if (deltaCotTheta2 > (error2 + p2scatterSigma)) {
-        if (not m_config.skipPreviousTopSP) {
-          continue;
+        // the impact parameter of detailed double measurements uses the
+        // transformed middle space point
+        const auto cut = acceptTriplet(
+            options, state.compatTopSP[t], A, B,
+            m_config.useDetailedDoubleMeasurementInfo ? rMxy : rM, cotThetaAvg2,
+            deltaCotTheta2, error2, iSinTheta2, state);
+        if (cut == TripletCut::RejectedByScattering and
+            m_config.skipPreviousTopSP) {
+          if (cotThetaB - cotThetaT < 0) {
+            break;
+          }
+          t0 = index_t;
         }
-        if (cotThetaB - cotThetaT < 0) {
-          break;
-        }
-        t0 = index_t;
-        continue;
-      }
-      // A and B allow calculation of impact params in U/V plane with linear
-      // function
-      // (in contrast to having to solve a quadratic function in x/y plane)
-      float Im = m_config.useDetailedDoubleMeasurementInfo
-                     ? std::abs((A - B * rMxy) * rMxy)
-                     : std::abs((A - B * rM) * rM);
-
-      if (Im > m_config.impactMax) {
-        continue;
-      }
-
-      state.topSpVec.push_back(state.compatTopSP[t]);
-      // inverse diameter is signed depending if the curvature is
-      // positive/negative in phi
-      state.curvatures.push_back(B / std::sqrt(S2));
-      state.impactParameters.push_back(Im);
-
-      // evaluate eta and pT of the seed
-      float cotThetaAvg = std::sqrt(cotThetaAvg2);
-      float theta = std::atan(1. / cotThetaAvg);
-      float eta = -std::log(std::tan(0.5 * theta));
-      state.etaVec.push_back(eta);
-      state.ptVec.push_back(pT);
-    }  // loop on tops
+      }  // loop on tops
+    }
 
     if (state.topSpVec.empty()) {
       continue;
@@ -548,6 +582,100 @@ void SeedFinder<external_spacepoint_t, platform_t>::filterCandidates(
   }  // loop on bottoms
 }
 
+template <typename external_spacepoint_t, typename platform_t>
+typename SeedFinder<external_spacepoint_t, platform_t>::TripletCut
+SeedFinder<external_spacepoint_t, platform_t>::acceptTriplet(
+    const Acts::SeedFinderOptions& options,
+    InternalSpacePoint<external_spacepoint_t>* spT, float A, float B, float rM,
+    float cotThetaAvg2, float deltaCotTheta2, float error2, float iSinTheta2,
+    SeedingState& state) const {
+  const float S2 = 1. + A * A;
+  const float B2 = B * B;
+
+  // sqrt(S2)/B = 2 * helixradius
+  // calculated radius must not be smaller than minimum radius
+  if (S2 < B2 * options.minHelixDiameter2) {
+    return TripletCut::Rejected;
+  }
+
+  // refinement of the cut on the compatibility between the r-z slope of
+  // the two seed segments using a scattering term scaled by the actual
+  // measured pT (p2scatterSigma)
+  float iHelixDiameter2 = B2 / S2;
+  // calculate scattering for p(T) calculated from seed curvature
+  float pT2scatterSigma = iHelixDiameter2 * options.sigmapT2perRadius;
+  // if pT > maxPtScattering, calculate allowed scattering angle using
+  // maxPtScattering instead of pt.
+  float pT = options.pTPerHelixRadius * std::sqrt(S2 / B2) / 2.;
+  if (pT > m_config.maxPtScattering) {
+    float pTscatterSigma = (m_config.highland / m_config.maxPtScattering) *
+                           m_config.sigmaScattering;
+    pT2scatterSigma = pTscatterSigma * pTscatterSigma;
+  }
+  // convert p(T) to p scaling by sin^2(theta) AND scale by 1/sin^4(theta)
+  // from rad to deltaCotTheta
+  float p2scatterSigma = pT2scatterSigma * iSinTheta2;
+  // if deltaTheta larger than allowed scattering for calculated pT, skip
+  if (deltaCotTheta2 > (error2 + p2scatterSigma)) {
+    return TripletCut::RejectedByScattering;
+  }
+
+  // A and B allow calculation of impact params in U/V plane with linear
+  // function
+  // (in contrast to having to solve a quadratic function in x/y plane)
+  float Im = std::abs((A - B * rM) * rM);
+  if (Im > m_config.impactMax) {
+    return TripletCut::Rejected;
+  }
+
+  state.topSpVec.push_back(spT);
+  // inverse diameter is signed depending if the curvature is
+  // positive/negative in phi
+  state.curvatures.push_back(B / std::sqrt(S2));
+  state.impactParameters.push_back(Im);
+
+  // evaluate eta and pT of the seed
+  float cotThetaAvg = std::sqrt(cotThetaAvg2);
+  float theta = std::atan(1. / cotThetaAvg);
+  float eta = -std::log(std::tan(0.5 * theta));
+  state.etaVec.push_back(eta);
+  state.ptVec.push_back(pT);
+  return TripletCut::Accepted;
+}
+
+template <typename external_spacepoint_t, typename platform_t>
+void SeedFinder<external_spacepoint_t, platform_t>::computeTripletQuantities(
+    TripletCandidatesSoA& data, std::size_t t0, std::size_t t1,
+    const LinCircle& lb, float varianceRM, float varianceZM) const {
+  using Array = Eigen::Array<float, Eigen::Dynamic, 1>;
+
+  const Eigen::Index n = t1 - t0;
+  const float cotThetaB = lb.cotTheta;
+
+  Eigen::Map<const Array> cotThetaT(data.cotTheta.data() + t0, n);
+  Eigen::Map<const Array> iDeltaRT(data.iDeltaR.data() + t0, n);
+  Eigen::Map<const Array> ErT(data.Er.data() + t0, n);
+  Eigen::Map<Array> cotThetaAvg2(data.cotThetaAvg2.data() + t0, n);
+  Eigen::Map<Array> error2(data.error2.data() + t0, n);
+  Eigen::Map<Array> deltaCotTheta2(data.deltaCotTheta2.data() + t0, n);
+
+  // The operations are exactly those of the scalar triplet cuts, evaluated
+  // with explicit vectorisation
+  if (m_config.arithmeticAverageCotTheta) {
+    // use arithmetic average
+    cotThetaAvg2 = (0.5f * (cotThetaB + cotThetaT)).square();
+  } else {
+    // use geometric average
+    cotThetaAvg2 = cotThetaB * cotThetaT;
+  }
+  // add errors of spB-spM and spM-spT pairs and add the correlation term for
+  // errors on spM
+  error2 = (ErT + lb.Er) +
+           2.f * (cotThetaAvg2 * varianceRM + varianceZM) * lb.iDeltaR *
+               iDeltaRT;
+  deltaCotTheta2 = (cotThetaB - cotThetaT).square();
+}
+
 template <typename external_spacepoint_t, typename platform_t>
 template <typename sp_range_t>
 std::vector<Seed<external_spacepoint_t>>
@@ -0,0 +1,110 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Seeding/InternalSpacePoint.hpp"
+#include "Acts/Seeding/SeedFinderUtils.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Structure-of-arrays copy of a set of space points
+///
+/// The coordinates are stored in contiguous arrays such that the doublet
+/// compatibility can be evaluated for many space points at once. The space
+/// point pointers are kept in the same order to produce the output.
+template <typename external_spacepoint_t>
+struct SpacePointSoA {
+  std::vector<InternalSpacePoint<external_spacepoint_t>*> sp;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> r;
+
+  // doublet quantities with respect to the current middle space point
+  std::vector<float> cotTheta;
+  std::vector<float> zOrigin;
+
+  std::size_t size() const { return sp.size(); }
+
+  void clear() {
+    sp.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+    r.clear();
+  }
+
+  void push_back(InternalSpacePoint<external_spacepoint_t>* point) {
+    sp.push_back(point);
+    x.push_back(point->x());
+    y.push_back(point->y());
+    z.push_back(point->z());
+    r.push_back(point->radius());
+  }
+
+  /// @brief replace the content with the space points of a range
+  ///
+  /// @tparam sp_range_t range of space point pointers
+  /// @param range the space points to copy
+  template <typename sp_range_t>
+  void assign(sp_range_t& range) {
+    clear();
+    for (auto point : range) {
+      push_back(point);
+    }
+  }
+};
+
+/// @brief Structure-of-arrays buffers for the triplet search of one middle
+/// space point
+///
+/// The linear circle parameters of the compatible top space points are stored
+/// in contiguous arrays in the order of increasing cotTheta. For each bottom
+/// space point, the quantities of the first triplet compatibility cut, which
+/// rejects most of the candidates, are evaluated for all top space points at
+/// once.
+struct TripletCandidatesSoA {
+  // linear circle parameters of the top space points
+  std::vector<float> cotTheta;
+  std::vector<float> iDeltaR;
+  std::vector<float> Er;
+  std::vector<float> U;
+  std::vector<float> V;
+
+  // triplet quantities for the current bottom space point
+  std::vector<float> cotThetaAvg2;
+  std::vector<float> error2;
+  std::vector<float> deltaCotTheta2;
+
+  /// @brief fill the top space point parameters
+  ///
+  /// @param linCircles the linear circles of the top space points
+  /// @param sorted the indices of @p linCircles in the order to store
+  void assign(const std::vector<LinCircle>& linCircles,
+              const std::vector<std::size_t>& sorted) {
+    const std::size_t n = sorted.size();
+    for (auto* vec : {&cotTheta, &iDeltaR, &Er, &U, &V, &cotThetaAvg2,
+                      &error2, &deltaCotTheta2}) {
+      vec->resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      const LinCircle& lt = linCircles[sorted[i]];
+      cotTheta[i] = lt.cotTheta;
+      iDeltaR[i] = lt.iDeltaR;
+      Er[i] = lt.Er;
+      U[i] = lt.U;
+      V[i] = lt.V;
+    }
+  }
+};
+
+}  // namespace Acts
@@ -11,8 +11,10 @@
 #include "Acts/Definitions/TrackParametrization.hpp"
 #include "Acts/Surfaces/detail/VerticesHelper.hpp"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstddef>
 #include <iterator>
 #include <vector>
 
@@ -80,6 +82,49 @@ class BoundaryCheck {
   bool isInside(const Vector2& point, const Vector2& lowerLeft,
                 const Vector2& upperRight) const;
 
+  /// Check if many points are inside the same polygon.
+  ///
+  /// @param points   Test points
+  /// @param vertices Forward iterable container of convex polygon vertices,
+  ///                 see `isInside(const Vector2&, const Vector2Container&)`
+  /// @param [out] inside Result for each point, resized to @p points
+  ///
+  /// This is equivalent to calling `isInside(point, vertices)` for each point.
+  /// The polygon edge tests are evaluated for blocks of points at once, which
+  /// the compiler vectorizes. Only the points outside of the polygon are
+  /// checked against the tolerance one by one.
+  template <typename Vector2Container>
+  void isInside(const std::vector<Vector2>& points,
+                const Vector2Container& vertices,
+                std::vector<bool>& inside) const;
+
+  /// Check if many points are inside the same box aligned with the local axes.
+  ///
+  /// @param points Test points
+  /// @param lowerLeft Minimal vertex of the box
+  /// @param upperRight Maximal vertex of the box
+  /// @param [out] inside Result for each point, resized to @p points
+  ///
+  /// This is equivalent to calling `isInside(point, lowerLeft, upperRight)`
+  /// for each point, with the box test evaluated for blocks of points.
+  void isInside(const std::vector<Vector2>& points, const Vector2& lowerLeft,
+                const Vector2& upperRight, std::vector<bool>& inside) const;
+
+  /// Check if one point is inside many boxes aligned with the local axes.
+  ///
+  /// @param point Test point
+  /// @param lowerLefts Minimal vertices of the boxes
+  /// @param upperRights Maximal vertices of the boxes
+  /// @param [out] inside Result for each box, resized to @p lowerLefts
+  ///
+  /// This is equivalent to calling `isInside(point, lowerLeft, upperRight)`
+  /// for each box, with the box test evaluated for blocks of boxes. It can
+  /// be used to pre-select the bounds with a common local frame by their
+  /// bounding boxes.
+  void isInside(const Vector2& point, const std::vector<Vector2>& lowerLefts,
+                const std::vector<Vector2>& upperRights,
+                std::vector<bool>& inside) const;
+
   /// Calculate the signed, weighted, closest distance to a polygonal boundary.
   ///
   /// @param point Test point
@@ -128,9 +173,38 @@ class BoundaryCheck {
   ///          for the tolerance based check.
   BoundaryCheck transformed(const ActsMatrix<2, 2>& jacobian) const;
 
+  /// Number of points or boxes evaluated together in the batched checks
+  static constexpr std::size_t kBlockSize = 8;
+
   /// Check if the distance vector is within the absolute or relative limits.
   bool isTolerated(const Vector2& delta) const;
 
+  /// Check if a point outside of the polygon is within a non-zero tolerance.
+  ///
+  /// The bounding box of the polygon and the smallest eigenvalue of the weight
+  /// matrix are passed in, so that they can be shared between many points.
+  template <typename Vector2Container>
+  bool isToleratedOutside(const Vector2& point,
+                          const Vector2Container& vertices,
+                          const Vector2& lowerLeft, const Vector2& upperRight,
+                          double minWeight) const;
+
+  /// Compute the bounding box of the polygon.
+  template <typename Vector2Container>
+  static void computeBoundingBox(const Vector2Container& vertices,
+                                 Vector2& lowerLeft, Vector2& upperRight);
+
+  /// Smallest eigenvalue of the weight matrix, reduced by a small margin
+  /// for the rounding.
+  double minWeightEigenvalue() const;
+
+  /// Check if a point is too far away from the box to be within tolerance.
+  ///
+  /// This does not need the closest point on the box, and is used to reject
+  /// points before the closest point on a polygon is searched for.
+  bool isFarOutside(const Vector2& point, const Vector2& lowerLeft,
+                    const Vector2& upperRight, double minWeight) const;
+
   /// Compute vector norm based on the covariance.
   double squaredNorm(const Vector2& x) const;
 
@@ -222,17 +296,41 @@ inline bool Acts::BoundaryCheck::isInside(
     //
     // This allows us to avoid the expensive computeClosestPointOnPolygon
     // computation in this simple case.
-    //
-    // TODO: When tolerance is not 0, we could also avoid this computation in
-    //       some cases by testing against a bounding box of the polygon, padded
-    //       on each side with our tolerance. Check if this optimization is
-    //       worthwhile in some production workflows, and if so implement it.
     return false;
   } else {
-    // We are outside of the polygon, but there is a tolerance. Must find what
-    // the closest point on the polygon is and check if it's within tolerance.
-    auto closestPoint = computeClosestPointOnPolygon(point, vertices);
-    return isTolerated(closestPoint - point);
+    Vector2 lowerLeft;
+    Vector2 upperRight;
+    computeBoundingBox(vertices, lowerLeft, upperRight);
+    return isToleratedOutside(point, vertices, lowerLeft, upperRight,
+                              minWeightEigenvalue());
+  }
+}
+
+template <typename Vector2Container>
+inline bool Acts::BoundaryCheck::isToleratedOutside(
+    const Vector2& point, const Vector2Container& vertices,
+    const Vector2& lowerLeft, const Vector2& upperRight,
+    double minWeight) const {
+  // Points far outside of the bounding box of the polygon can not be within
+  // tolerance, which avoids the closest point search for most of them.
+  if (isFarOutside(point, lowerLeft, upperRight, minWeight)) {
+    return false;
+  }
+  // We are outside of the polygon, but there is a tolerance. Must find what
+  // the closest point on the polygon is and check if it's within tolerance.
+  auto closestPoint = computeClosestPointOnPolygon(point, vertices);
+  return isTolerated(closestPoint - point);
+}
+
+template <typename Vector2Container>
+inline void Acts::BoundaryCheck::computeBoundingBox(
+    const Vector2Container& vertices, Vector2& lowerLeft,
+    Vector2& upperRight) {
+  lowerLeft = *std::begin(vertices);
+  upperRight = lowerLeft;
+  for (const auto& vertex : vertices) {
+    lowerLeft = lowerLeft.cwiseMin(Vector2(vertex));
+    upperRight = upperRight.cwiseMax(Vector2(vertex));
   }
 }
 
@@ -250,6 +348,16 @@ inline bool Acts::BoundaryCheck::isInside(const Vector2& point,
           computeEuclideanClosestPointOnRectangle(point, lowerLeft, upperRight);
 
     } else /* Type::eChi2 */ {
+      if (isFarOutside(point, lowerLeft, upperRight, minWeightEigenvalue())) {
+        return false;
+      }
+      // The Euclidean closest point is not the closest one in the metric of
+      // the covariance, but already accepts most of the tolerated points.
+      closestPoint =
+          computeEuclideanClosestPointOnRectangle(point, lowerLeft, upperRight);
+      if (isTolerated(closestPoint - point)) {
+        return true;
+      }
       // need to calculate by projection and squarednorm
       Vector2 vertices[] = {{lowerLeft[0], lowerLeft[1]},
                             {upperRight[0], lowerLeft[1]},
@@ -262,6 +370,140 @@ inline bool Acts::BoundaryCheck::isInside(const Vector2& point,
   }
 }
 
+template <typename Vector2Container>
+inline void Acts::BoundaryCheck::isInside(const std::vector<Vector2>& points,
+                                          const Vector2Container& vertices,
+                                          std::vector<bool>& inside) const {
+  using Block = Eigen::Array<ActsScalar, 1, kBlockSize>;
+  using Points = Eigen::Map<const Eigen::Array<ActsScalar, 2, Eigen::Dynamic>>;
+
+  inside.assign(points.size(), true);
+  if (m_type == Type::eNone or points.empty()) {
+    return;
+  }
+
+  // Same edge test as detail::VerticesHelper::isInsidePolygon, for a block
+  // of points: the sign of the cross product of the edge and the vector from
+  // the first edge vertex to the point, which has to be the same for all edges
+  const Points coordinates(points.front().data(), 2, points.size());
+  using Mask = Eigen::Array<bool, 1, kBlockSize>;
+  auto lineSide = [](const Block& x, const Block& y, const Vector2& ll0,
+                     const Vector2& ll1) -> Mask {
+    const Vector2 normal = ll1 - ll0;
+    const Block cross = normal[0] * (y - ll0[1]) - normal[1] * (x - ll0[0]);
+    return cross.unaryExpr([](ActsScalar c) { return std::signbit(c); });
+  };
+
+  std::size_t begin = 0;
+  for (; begin + kBlockSize <= points.size(); begin += kBlockSize) {
+    const Block x = coordinates.row(0).template segment<kBlockSize>(begin);
+    const Block y = coordinates.row(1).template segment<kBlockSize>(begin);
+
+    auto iv = std::begin(vertices);
+    Vector2 l0 = *iv;
+    Vector2 l1 = *(++iv);
+    const Mask reference = lineSide(x, y, l0, l1);
+    Mask sameSide = Mask::Constant(true);
+    for (++iv; iv != std::end(vertices); ++iv) {
+      l0 = l1;
+      l1 = *iv;
+      sameSide = sameSide && (lineSide(x, y, l0, l1) == reference);
+    }
+    sameSide = sameSide &&
+               (lineSide(x, y, l1, *std::begin(vertices)) == reference);
+
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+      inside[begin + i] = sameSide[i];
+    }
+  }
+  // the remaining points use the single point edge test
+  for (; begin < points.size(); ++begin) {
+    inside[begin] =
+        detail::VerticesHelper::isInsidePolygon(points[begin], vertices);
+  }
+
+  // Outside of the polygon, only a non-zero tolerance can accept the point.
+  // The quantities needed for the rejection of points far away are shared.
+  if (m_tolerance == Vector2(0., 0.)) {
+    return;
+  }
+  Vector2 lowerLeft;
+  Vector2 upperRight;
+  computeBoundingBox(vertices, lowerLeft, upperRight);
+  const double minWeight = minWeightEigenvalue();
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (not inside[i]) {
+      inside[i] = isToleratedOutside(points[i], vertices, lowerLeft,
+                                     upperRight, minWeight);
+    }
+  }
+}
+
+inline void Acts::BoundaryCheck::isInside(const std::vector<Vector2>& points,
+                                          const Vector2& lowerLeft,
+                                          const Vector2& upperRight,
+                                          std::vector<bool>& inside) const {
+  using Points = Eigen::Map<const Eigen::Array<ActsScalar, 2, Eigen::Dynamic>>;
+
+  inside.assign(points.size(), true);
+  if (m_type == Type::eNone or points.empty()) {
+    return;
+  }
+
+  const Points coordinates(points.front().data(), 2, points.size());
+  std::size_t begin = 0;
+  for (; begin + kBlockSize <= points.size(); begin += kBlockSize) {
+    const auto block = coordinates.template middleCols<kBlockSize>(begin);
+    const auto inBox =
+        ((block.row(0) >= lowerLeft[0]) && (block.row(0) < upperRight[0]) &&
+         (block.row(1) >= lowerLeft[1]) && (block.row(1) < upperRight[1]))
+            .eval();
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+      if (not inBox[i]) {
+        inside[begin + i] = isInside(points[begin + i], lowerLeft, upperRight);
+      }
+    }
+  }
+  // the remaining points are checked one by one
+  for (; begin < points.size(); ++begin) {
+    inside[begin] = isInside(points[begin], lowerLeft, upperRight);
+  }
+}
+
+inline void Acts::BoundaryCheck::isInside(
+    const Vector2& point, const std::vector<Vector2>& lowerLefts,
+    const std::vector<Vector2>& upperRights, std::vector<bool>& inside) const {
+  using Boxes = Eigen::Map<const Eigen::Array<ActsScalar, 2, Eigen::Dynamic>>;
+
+  const std::size_t nBoxes = std::min(lowerLefts.size(), upperRights.size());
+  inside.assign(nBoxes, true);
+  if (m_type == Type::eNone or nBoxes == 0) {
+    return;
+  }
+
+  const Boxes lower(lowerLefts.front().data(), 2, nBoxes);
+  const Boxes upper(upperRights.front().data(), 2, nBoxes);
+  std::size_t begin = 0;
+  for (; begin + kBlockSize <= nBoxes; begin += kBlockSize) {
+    const auto ll = lower.template middleCols<kBlockSize>(begin);
+    const auto ur = upper.template middleCols<kBlockSize>(begin);
+    const auto inBox =
+        ((ll.row(0) <= point[0]) && (ur.row(0) > point[0]) &&
+         (ll.row(1) <= point[1]) && (ur.row(1) > point[1]))
+            .eval();
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+      if (not inBox[i]) {
+        inside[begin + i] =
+            isInside(point, lowerLefts[begin + i], upperRights[begin + i]);
+      }
+    }
+  }
+  // the remaining boxes are checked one by one
+  for (; begin < nBoxes; ++begin) {
+    inside[begin] = isInside(point, lowerLefts[begin], upperRights[begin]);
+  }
+}
+
 template <typename Vector2Container>
 inline double Acts::BoundaryCheck::distance(
     const Acts::Vector2& point, const Vector2Container& vertices) const {
@@ -305,6 +547,33 @@ inline bool Acts::BoundaryCheck::isTolerated(const Vector2& delta) const {
   }
 }
 
+inline double Acts::BoundaryCheck::minWeightEigenvalue() const {
+  // The smallest eigenvalue is computed from the determinant and the largest
+  // eigenvalue to avoid the cancellation.
+  const double halfTrace = 0.5 * (m_weight(0, 0) + m_weight(1, 1));
+  const double halfDiff = 0.5 * (m_weight(0, 0) - m_weight(1, 1));
+  const double offDiagonal = 0.5 * (m_weight(0, 1) + m_weight(1, 0));
+  const double maxEigen =
+      halfTrace + std::sqrt(halfDiff * halfDiff + offDiagonal * offDiagonal);
+  return (1. - 1e-6) * m_weight.determinant() / maxEigen;
+}
+
+inline bool Acts::BoundaryCheck::isFarOutside(const Vector2& point,
+                                              const Vector2& lowerLeft,
+                                              const Vector2& upperRight,
+                                              double minWeight) const {
+  // the distance to the box in each coordinate is a lower bound of the
+  // distance to any point inside the box
+  const Vector2 delta =
+      (lowerLeft - point).cwiseMax(point - upperRight).cwiseMax(0.);
+  if (m_type == Type::eAbsolute) {
+    return (delta[0] > m_tolerance[0]) || (delta[1] > m_tolerance[1]);
+  }
+  // The squared Mahalanobis distance is at least the squared Euclidean
+  // distance scaled with the smallest eigenvalue of the weight matrix
+  return minWeight * delta.squaredNorm() >= 2 * m_tolerance[0];
+}
+
 inline double Acts::BoundaryCheck::squaredNorm(const Vector2& x) const {
   return (x.transpose() * m_weight * x).value();
 }
@@ -104,6 +104,15 @@ class ConvexPolygonBounds : public ConvexPolygonBoundsBase {
   bool inside(const Vector2& lposition,
               const BoundaryCheck& bcheck) const final;
 
+  /// Return whether local 2D points lie inside of the bounds defined by this
+  /// object.
+  /// @param lpositions The local positions to check
+  /// @param bcheck The `BoundaryCheck` object handling tolerances.
+  /// @param [out] result Whether each of the points is inside
+  void insideBatch(const std::vector<Vector2>& lpositions,
+                   const BoundaryCheck& bcheck,
+                   std::vector<bool>& result) const final;
+
   /// Return the vertices
   ///
   /// @param lseg the number of segments used to approximate
@@ -159,6 +168,15 @@ class ConvexPolygonBounds<PolygonDynamic> : public ConvexPolygonBoundsBase {
   bool inside(const Vector2& lposition,
               const BoundaryCheck& bcheck) const final;
 
+  /// Return whether local 2D points lie inside of the bounds defined by this
+  /// object.
+  /// @param lpositions The local positions to check
+  /// @param bcheck The `BoundaryCheck` object handling tolerances.
+  /// @param [out] result Whether each of the points is inside
+  void insideBatch(const std::vector<Vector2>& lpositions,
+                   const BoundaryCheck& bcheck,
+                   std::vector<bool>& result) const final;
+
   /// Return the vertices
   ///
   /// @param lseg the number of segments used to approximate
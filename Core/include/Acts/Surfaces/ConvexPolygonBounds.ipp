@@ -104,6 +104,13 @@ bool Acts::ConvexPolygonBounds<N>::inside(
   return bcheck.isInside(lposition, m_vertices);
 }
 
+template <int N>
+void Acts::ConvexPolygonBounds<N>::insideBatch(
+    const std::vector<Acts::Vector2>& lpositions,
+    const Acts::BoundaryCheck& bcheck, std::vector<bool>& result) const {
+  bcheck.isInside(lpositions, m_vertices, result);
+}
+
 template <int N>
 std::vector<Acts::Vector2> Acts::ConvexPolygonBounds<N>::vertices(
     unsigned int /*lseg*/) const {
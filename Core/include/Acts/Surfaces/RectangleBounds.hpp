@@ -77,6 +77,15 @@ class RectangleBounds : public PlanarBounds {
   bool inside(const Vector2& lposition,
               const BoundaryCheck& bcheck) const final;
 
+  /// Inside check for many local positions at once
+  ///
+  /// @param lpositions Local positions (assumed to be in right surface frame)
+  /// @param bcheck boundary check directive
+  /// @param [out] result inside indicator for each position
+  void insideBatch(const std::vector<Vector2>& lpositions,
+                   const BoundaryCheck& bcheck,
+                   std::vector<bool>& result) const final;
+
   /// Return the vertices
   ///
   /// @param lseg the number of segments used to approximate
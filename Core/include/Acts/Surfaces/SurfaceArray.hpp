@@ -10,12 +10,14 @@
 #include "Acts/Definitions/Algebra.hpp"
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Surfaces/detail/FlatSurfaceGrid.hpp"
 #include "Acts/Utilities/BinningType.hpp"
 #include "Acts/Utilities/IAxis.hpp"
 #include "Acts/Utilities/detail/Axis.hpp"
 #include "Acts/Utilities/detail/Grid.hpp"
 
 #include <iostream>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -31,6 +33,8 @@ using SurfaceVector = std::vector<const Surface*>;
 /// externally and passed to @c SurfaceArray on construction.
 class SurfaceArray {
  public:
+  using SurfaceRange = detail::SurfaceRange;
+
   /// @brief Base interface for all surface lookups.
   struct ISurfaceGridLookup {
     /// @brief Fill provided surfaces into the contained @c Grid.
@@ -492,6 +496,28 @@ class SurfaceArray {
     return p_gridLookup->neighbors(position);
   }
 
+  /// @brief Get all surfaces in bin at @p position and its neighbors as range
+  /// @param position The position to lookup as nominal
+  /// @return Range of the same surfaces as returned by @c neighbors
+  /// @note Cylinder (phi, z) and disc (r, phi) grids are looked up in a flat
+  ///       copy of the neighbor map, which does not need a virtual call
+  SurfaceRange neighborRange(const Vector3& position) const {
+    if (m_cylinderGrid) {
+      return m_cylinderGrid->neighbors(position);
+    }
+    if (m_discGrid) {
+      return m_discGrid->neighbors(position);
+    }
+    const SurfaceVector& surfaces = p_gridLookup->neighbors(position);
+    return SurfaceRange(surfaces.data(), surfaces.data() + surfaces.size());
+  }
+
+  /// @brief Check if the neighbor lookup uses a flat grid
+  /// @return true for cylinder (phi, z) and disc (r, phi) grids
+  bool hasFlatLookup() const {
+    return m_cylinderGrid.has_value() or m_discGrid.has_value();
+  }
+
   /// @brief Get the size of the underlying grid structure including
   /// under/overflow bins
   /// @return the size
@@ -500,7 +526,9 @@ class SurfaceArray {
   /// @brief Get the center of the bin identified by global bin index @p bin
   /// @param bin the global bin index
   /// @return Center position of the bin in global coordinates
-  Vector3 getBinCenter(size_t bin) { return p_gridLookup->getBinCenter(bin); }
+  Vector3 getBinCenter(size_t bin) const {
+    return p_gridLookup->getBinCenter(bin);
+  }
 
   /// @brief Get all surfaces attached to this @c SurfaceArray
   /// @return Reference to @c SurfaceVector containing all surfaces
@@ -546,6 +574,9 @@ class SurfaceArray {
   // this is only used to keep info on transform applied
   // by l2g and g2l
   Transform3 m_transform;
+  // flat copies of the neighbor map for the common layer binnings
+  std::optional<detail::FlatSurfaceGrid<binPhi, binZ>> m_cylinderGrid;
+  std::optional<detail::FlatSurfaceGrid<binR, binPhi>> m_discGrid;
 };
 
 }  // namespace Acts
@@ -0,0 +1,134 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Surfaces/BoundaryCheck.hpp"
+#include "Acts/Surfaces/CylinderSurface.hpp"
+#include "Acts/Surfaces/DiscSurface.hpp"
+#include "Acts/Surfaces/LineSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace Acts {
+
+/// @class SurfaceBatchIntersector
+///
+/// Straight line intersection of one track with many surfaces of the same
+/// type, as e.g. the sensitive surfaces of a layer.
+///
+/// The placements of the surfaces are cached at construction as structure of
+/// arrays, i.e. one contiguous column per coordinate of the center and of
+/// the local axes. The path lengths to all surfaces are then computed at
+/// once with Eigen array expressions, which the compiler vectorizes. Only the
+/// surfaces which are reached go through the boundary check.
+///
+/// The intersections are the same as the ones of `Surface::intersect` for
+/// each of the surfaces, up to rounding.
+///
+/// @tparam surface_t The surface type, one of PlaneSurface, DiscSurface,
+///         CylinderSurface or LineSurface (including the derived straw and
+///         perigee surfaces)
+template <typename surface_t>
+class SurfaceBatchIntersector {
+  static_assert(std::is_base_of_v<PlaneSurface, surface_t> or
+                    std::is_base_of_v<DiscSurface, surface_t> or
+                    std::is_base_of_v<CylinderSurface, surface_t> or
+                    std::is_base_of_v<LineSurface, surface_t>,
+                "Batched intersection is not implemented for this surface");
+
+ public:
+  /// Constructor
+  ///
+  /// @param gctx The geometry context the placements are cached for
+  /// @param surfaces The surfaces to be intersected
+  SurfaceBatchIntersector(const GeometryContext& gctx,
+                          std::vector<const surface_t*> surfaces);
+
+  /// Intersect a straight line with all surfaces
+  ///
+  /// @param position The position to start from
+  /// @param direction The direction at start
+  /// @param bcheck The boundary check
+  /// @param [out] intersections The reachable intersections, i.e. the ones
+  ///        which are neither missed nor unreachable, sorted by their path
+  ///        length. The vector is cleared first, so it can be reused.
+  void intersect(const Vector3& position, const Vector3& direction,
+                 const BoundaryCheck& bcheck,
+                 std::vector<SurfaceIntersection>& intersections) const;
+
+  /// Intersect a straight line with all surfaces
+  ///
+  /// @param position The position to start from
+  /// @param direction The direction at start
+  /// @param bcheck The boundary check
+  ///
+  /// @return The reachable intersections sorted by their path length
+  std::vector<SurfaceIntersection> intersect(const Vector3& position,
+                                             const Vector3& direction,
+                                             const BoundaryCheck& bcheck) const;
+
+  /// The surfaces, in the order they were given
+  const std::vector<const surface_t*>& surfaces() const { return m_surfaces; }
+
+ private:
+  /// Column of one quantity for all surfaces
+  using Column = Eigen::Array<ActsScalar, Eigen::Dynamic, 1>;
+
+  /// Columns of the placements: center, then the local x, y and z axes
+  enum PlacementColumn : unsigned int {
+    eCenter = 0,
+    eAxisX = 3,
+    eAxisY = 6,
+    eAxisZ = 9,
+    eSize = 12
+  };
+
+  /// Planar surfaces: set the intersections for the given path lengths
+  void planarIntersections(const Vector3& position, const Vector3& direction,
+                           const BoundaryCheck& bcheck,
+                           std::vector<SurfaceIntersection>& intersections)
+      const;
+
+  /// Cylinder surfaces: set the intersections from the quadratic equation
+  void cylinderIntersections(const Vector3& position, const Vector3& direction,
+                             const BoundaryCheck& bcheck,
+                             std::vector<SurfaceIntersection>& intersections)
+      const;
+
+  /// Line surfaces: set the intersections at the points of closest approach
+  void lineIntersections(const Vector3& position, const Vector3& direction,
+                         const BoundaryCheck& bcheck,
+                         std::vector<SurfaceIntersection>& intersections) const;
+
+  /// Vector of a placement column group for one surface
+  Vector3 placement(size_t isurface, unsigned int column) const {
+    return m_placements.row(isurface)
+        .template segment<3>(column)
+        .transpose()
+        .matrix();
+  }
+
+  GeometryContext m_gctx;
+  std::vector<const surface_t*> m_surfaces;
+  /// Placements in structure of arrays layout, one row per surface
+  Eigen::Array<ActsScalar, Eigen::Dynamic, eSize> m_placements;
+  /// Radii of cylinder surfaces
+  Column m_radii;
+  /// Disc or line bounds of the surfaces, nullptr if they are unbounded
+  std::vector<const SurfaceBounds*> m_bounds;
+};
+
+}  // namespace Acts
+
+#include "Acts/Surfaces/SurfaceBatchIntersector.ipp"
@@ -0,0 +1,269 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Surfaces/CylinderBounds.hpp"
+#include "Acts/Surfaces/DiscBounds.hpp"
+#include "Acts/Surfaces/LineBounds.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+template <typename surface_t>
+Acts::SurfaceBatchIntersector<surface_t>::SurfaceBatchIntersector(
+    const GeometryContext& gctx, std::vector<const surface_t*> surfaces)
+    : m_gctx(gctx),
+      m_surfaces(std::move(surfaces)),
+      m_placements(m_surfaces.size(), eSize),
+      m_radii(Column::Zero(m_surfaces.size())),
+      m_bounds(m_surfaces.size(), nullptr) {
+  for (size_t is = 0; is < m_surfaces.size(); ++is) {
+    const surface_t& surface = *m_surfaces[is];
+    const auto& tMatrix = surface.transform(m_gctx).matrix();
+    m_placements.row(is).template segment<3>(eCenter) =
+        tMatrix.template block<3, 1>(0, 3).transpose().array();
+    m_placements.row(is).template segment<3>(eAxisX) =
+        tMatrix.template block<3, 1>(0, 0).transpose().array();
+    m_placements.row(is).template segment<3>(eAxisY) =
+        tMatrix.template block<3, 1>(0, 1).transpose().array();
+    m_placements.row(is).template segment<3>(eAxisZ) =
+        tMatrix.template block<3, 1>(0, 2).transpose().array();
+    if constexpr (std::is_base_of_v<CylinderSurface, surface_t>) {
+      m_radii[is] = surface.bounds().get(CylinderBounds::eR);
+    } else if constexpr (std::is_base_of_v<DiscSurface, surface_t>) {
+      m_bounds[is] = dynamic_cast<const DiscBounds*>(&surface.bounds());
+    } else if constexpr (std::is_base_of_v<LineSurface, surface_t>) {
+      if (surface.bounds().type() == SurfaceBounds::eLine) {
+        m_bounds[is] = &surface.bounds();
+      }
+    }
+  }
+}
+
+template <typename surface_t>
+void Acts::SurfaceBatchIntersector<surface_t>::intersect(
+    const Vector3& position, const Vector3& direction,
+    const BoundaryCheck& bcheck,
+    std::vector<SurfaceIntersection>& intersections) const {
+  intersections.clear();
+  if (m_surfaces.empty()) {
+    return;
+  }
+  if constexpr (std::is_base_of_v<CylinderSurface, surface_t>) {
+    cylinderIntersections(position, direction, bcheck, intersections);
+  } else if constexpr (std::is_base_of_v<LineSurface, surface_t>) {
+    lineIntersections(position, direction, bcheck, intersections);
+  } else {
+    planarIntersections(position, direction, bcheck, intersections);
+  }
+  // All intersections are reachable, so the ordering is by path length only
+  std::sort(intersections.begin(), intersections.end(),
+            [](const SurfaceIntersection& a, const SurfaceIntersection& b) {
+              return a.intersection.pathLength < b.intersection.pathLength;
+            });
+}
+
+template <typename surface_t>
+std::vector<Acts::SurfaceIntersection>
+Acts::SurfaceBatchIntersector<surface_t>::intersect(
+    const Vector3& position, const Vector3& direction,
+    const BoundaryCheck& bcheck) const {
+  std::vector<SurfaceIntersection> intersections;
+  intersections.reserve(m_surfaces.size());
+  intersect(position, direction, bcheck, intersections);
+  return intersections;
+}
+
+template <typename surface_t>
+void Acts::SurfaceBatchIntersector<surface_t>::planarIntersections(
+    const Vector3& position, const Vector3& direction,
+    const BoundaryCheck& bcheck,
+    std::vector<SurfaceIntersection>& intersections) const {
+  // Same maths as PlanarHelper::intersect, for all surfaces at once
+  const auto nx = m_placements.col(eAxisZ);
+  const auto ny = m_placements.col(eAxisZ + 1);
+  const auto nz = m_placements.col(eAxisZ + 2);
+  const Column denominators =
+      direction[0] * nx + direction[1] * ny + direction[2] * nz;
+  const Column paths = ((m_placements.col(eCenter) - position[0]) * nx +
+                        (m_placements.col(eCenter + 1) - position[1]) * ny +
+                        (m_placements.col(eCenter + 2) - position[2]) * nz) /
+                       denominators;
+
+  for (size_t is = 0; is < m_surfaces.size(); ++is) {
+    if (denominators[is] == 0.) {
+      continue;
+    }
+    const ActsScalar path = paths[is];
+    const Vector3 solution = position + path * direction;
+    if (bcheck) {
+      // Built-in local to global for speed reasons
+      const Vector3 vecLocal = solution - placement(is, eCenter);
+      const Vector2 lcartesian(vecLocal.dot(placement(is, eAxisX)),
+                               vecLocal.dot(placement(is, eAxisY)));
+      if constexpr (std::is_base_of_v<DiscSurface, surface_t>) {
+        const auto* dBounds = static_cast<const DiscBounds*>(m_bounds[is]);
+        if (dBounds != nullptr) {
+          if (bcheck.type() == BoundaryCheck::Type::eAbsolute and
+              dBounds->coversFullAzimuth()) {
+            double tolerance =
+                s_onSurfaceTolerance + bcheck.tolerance()[eBoundLoc0];
+            if (not dBounds->insideRadialBounds(
+                    VectorHelpers::perp(lcartesian), tolerance)) {
+              continue;
+            }
+          } else if (not m_surfaces[is]->insideBounds(
+                         m_surfaces[is]->localCartesianToPolar(lcartesian),
+                         bcheck)) {
+            continue;
+          }
+        }
+      } else if (not m_surfaces[is]->insideBounds(lcartesian, bcheck)) {
+        continue;
+      }
+    }
+    Intersection3D::Status status =
+        std::abs(path) < std::abs(s_onSurfaceTolerance)
+            ? Intersection3D::Status::onSurface
+            : Intersection3D::Status::reachable;
+    intersections.emplace_back(Intersection3D(solution, path, status),
+                               m_surfaces[is]);
+  }
+}
+
+template <typename surface_t>
+void Acts::SurfaceBatchIntersector<surface_t>::cylinderIntersections(
+    const Vector3& position, const Vector3& direction,
+    const BoundaryCheck& bcheck,
+    std::vector<SurfaceIntersection>& intersections) const {
+  // Same maths as CylinderSurface::intersectionSolver, for all surfaces
+  const auto ax = m_placements.col(eAxisZ);
+  const auto ay = m_placements.col(eAxisZ + 1);
+  const auto az = m_placements.col(eAxisZ + 2);
+  const Column pcx = position[0] - m_placements.col(eCenter);
+  const Column pcy = position[1] - m_placements.col(eCenter + 1);
+  const Column pcz = position[2] - m_placements.col(eCenter + 2);
+  const Column pcXcdx = pcy * az - pcz * ay;
+  const Column pcXcdy = pcz * ax - pcx * az;
+  const Column pcXcdz = pcx * ay - pcy * ax;
+  const Column ldXcdx = direction[1] * az - direction[2] * ay;
+  const Column ldXcdy = direction[2] * ax - direction[0] * az;
+  const Column ldXcdz = direction[0] * ay - direction[1] * ax;
+  const Column a = ldXcdx.square() + ldXcdy.square() + ldXcdz.square();
+  const Column b = 2. * (ldXcdx * pcXcdx + ldXcdy * pcXcdy + ldXcdz * pcXcdz);
+  const Column c = pcXcdx.square() + pcXcdy.square() + pcXcdz.square() -
+                   m_radii.square();
+  // Same solution as detail::RealQuadraticEquation
+  const Column discriminant = b.square() - 4. * a * c;
+  const Column root = discriminant.max(0.).sqrt();
+  const Column q = -0.5 * (b + (b > 0.).select(root, -root));
+  const Column firsts = q / a;
+  const Column seconds = c / q;
+
+  for (size_t is = 0; is < m_surfaces.size(); ++is) {
+    if (not(discriminant[is] >= 0.)) {
+      continue;
+    }
+    const surface_t& surface = *m_surfaces[is];
+    auto makeIntersection = [&](ActsScalar path) -> Intersection3D {
+      const Vector3 solution = position + path * direction;
+      Intersection3D::Status status =
+          std::abs(path) < std::abs(s_onSurfaceTolerance)
+              ? Intersection3D::Status::onSurface
+              : Intersection3D::Status::reachable;
+      // Same boundary check as CylinderSurface::intersect
+      if (bcheck) {
+        const auto& cBounds = surface.bounds();
+        if (cBounds.coversFullAzimuth() and
+            bcheck.type() == BoundaryCheck::Type::eAbsolute) {
+          const Vector3 vecLocal = solution - placement(is, eCenter);
+          double cZ = vecLocal.dot(placement(is, eAxisZ));
+          double tolerance =
+              s_onSurfaceTolerance + bcheck.tolerance()[eBoundLoc1];
+          double hZ = cBounds.get(CylinderBounds::eHalfLengthZ) + tolerance;
+          if (std::abs(cZ) >= std::abs(hZ)) {
+            status = Intersection3D::Status::missed;
+          }
+        } else if (not surface.isOnSurface(m_gctx, solution, direction,
+                                           bcheck)) {
+          status = Intersection3D::Status::missed;
+        }
+      }
+      return Intersection3D(solution, path, status);
+    };
+
+    Intersection3D first = makeIntersection(firsts[is]);
+    SurfaceIntersection cIntersection(first, &surface);
+    if (discriminant[is] != 0.) {
+      Intersection3D second = makeIntersection(seconds[is]);
+      // Same choice of the solutions as CylinderSurface::intersect
+      bool check1 = first.status != Intersection3D::Status::missed or
+                    second.status == Intersection3D::Status::missed;
+      if ((check1 and
+           (std::abs(first.pathLength) < std::abs(second.pathLength))) or
+          second.status == Intersection3D::Status::missed) {
+        cIntersection.alternative = second;
+      } else {
+        cIntersection.alternative = first;
+        cIntersection.intersection = second;
+      }
+    }
+    if (cIntersection.intersection.status != Intersection3D::Status::missed) {
+      intersections.push_back(cIntersection);
+    }
+  }
+}
+
+template <typename surface_t>
+void Acts::SurfaceBatchIntersector<surface_t>::lineIntersections(
+    const Vector3& position, const Vector3& direction,
+    const BoundaryCheck& bcheck,
+    std::vector<SurfaceIntersection>& intersections) const {
+  // Same maths as LineSurface::intersect, for all surfaces at once
+  const auto ebx = m_placements.col(eAxisZ);
+  const auto eby = m_placements.col(eAxisZ + 1);
+  const auto ebz = m_placements.col(eAxisZ + 2);
+  const Column mabx = m_placements.col(eCenter) - position[0];
+  const Column maby = m_placements.col(eCenter + 1) - position[1];
+  const Column mabz = m_placements.col(eCenter + 2) - position[2];
+  const Column eaTeb = direction[0] * ebx + direction[1] * eby +
+                       direction[2] * ebz;
+  const Column denominators = 1. - eaTeb.square();
+  const Column mabTea =
+      mabx * direction[0] + maby * direction[1] + mabz * direction[2];
+  const Column mabTeb = mabx * ebx + maby * eby + mabz * ebz;
+  const Column paths = (mabTea - mabTeb * eaTeb) / denominators;
+
+  for (size_t is = 0; is < m_surfaces.size(); ++is) {
+    if (std::abs(denominators[is]) <= std::abs(s_onSurfaceTolerance)) {
+      continue;
+    }
+    const ActsScalar u = paths[is];
+    const Vector3 result = position + u * direction;
+    const auto* lBounds = static_cast<const LineBounds*>(m_bounds[is]);
+    if (bcheck and lBounds != nullptr) {
+      // At closest approach: check inside R or and inside Z
+      const Vector3 eb = placement(is, eAxisZ);
+      const Vector3 vecLocal = result - placement(is, eCenter);
+      double cZ = vecLocal.dot(eb);
+      double hZ = lBounds->get(LineBounds::eHalfLengthZ) + s_onSurfaceTolerance;
+      if ((std::abs(cZ) > std::abs(hZ)) or
+          ((vecLocal - cZ * eb).norm() >
+           lBounds->get(LineBounds::eR) + s_onSurfaceTolerance)) {
+        continue;
+      }
+    }
+    Intersection3D::Status status =
+        std::abs(u) < std::abs(s_onSurfaceTolerance)
+            ? Intersection3D::Status::onSurface
+            : Intersection3D::Status::reachable;
+    intersections.emplace_back(Intersection3D(result, u, status),
+                               m_surfaces[is]);
+  }
+}
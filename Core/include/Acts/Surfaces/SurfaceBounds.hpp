@@ -10,7 +10,9 @@
 #include "Acts/Definitions/Algebra.hpp"
 #include "Acts/Surfaces/BoundaryCheck.hpp"
 
+#include <cstddef>
 #include <ostream>
+#include <vector>
 
 namespace Acts {
 
@@ -68,6 +70,25 @@ class SurfaceBounds {
   virtual bool inside(const Vector2& lposition,
                       const BoundaryCheck& bcheck) const = 0;
 
+  /// Inside check for many local positions at once
+  ///
+  /// This is equivalent to calling inside() for each position. Bounds with
+  /// a polygonal shape check the positions in blocks with the batched
+  /// BoundaryCheck methods.
+  ///
+  /// @param lpositions Local positions (assumed to be in right surface frame)
+  /// @param bcheck boundary check directive
+  /// @param [out] result inside indicator for each position, resized to
+  ///        @p lpositions
+  virtual void insideBatch(const std::vector<Vector2>& lpositions,
+                           const BoundaryCheck& bcheck,
+                           std::vector<bool>& result) const {
+    result.resize(lpositions.size());
+    for (std::size_t i = 0; i < lpositions.size(); ++i) {
+      result[i] = inside(lpositions[i], bcheck);
+    }
+  }
+
   /// Output Method for std::ostream, to be overloaded by child classes
   ///
   /// @param os is the outstream in which the string dump is done
@@ -108,6 +108,18 @@ class TrapezoidBounds : public PlanarBounds {
   bool inside(const Vector2& lposition,
               const BoundaryCheck& bcheck) const final;
 
+  /// Inside check for many local positions at once
+  ///
+  /// The positions inside of the trapezoid are found for all of them at
+  /// once, only the others go through the checks of inside().
+  ///
+  /// @param lpositions Local positions (assumed to be in right surface frame)
+  /// @param bcheck boundary check directive
+  /// @param [out] result inside indicator for each position
+  void insideBatch(const std::vector<Vector2>& lpositions,
+                   const BoundaryCheck& bcheck,
+                   std::vector<bool>& result) const final;
+
   /// Return the vertices
   ///
   /// @param lseg the number of segments used to approximate
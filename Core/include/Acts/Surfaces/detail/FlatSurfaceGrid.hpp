@@ -0,0 +1,189 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Utilities/BinningType.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/IAxis.hpp"
+#include "Acts/Utilities/detail/AxisFwd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Acts {
+
+class Surface;
+
+namespace detail {
+
+/// @brief A contiguous range of surface pointers, e.g. a bin content
+class SurfaceRange {
+ public:
+  using const_iterator = const Surface* const*;
+
+  SurfaceRange() = default;
+
+  /// Constructor from a begin and end pointer
+  SurfaceRange(const_iterator first, const_iterator last)
+      : m_begin(first), m_end(last) {}
+
+  const_iterator begin() const { return m_begin; }
+  const_iterator end() const { return m_end; }
+  std::size_t size() const { return static_cast<std::size_t>(m_end - m_begin); }
+  bool empty() const { return m_begin == m_end; }
+  const Surface* operator[](std::size_t i) const { return m_begin[i]; }
+
+ private:
+  const_iterator m_begin = nullptr;
+  const_iterator m_end = nullptr;
+};
+
+/// @brief Bin lookup along one axis of a flat surface grid
+///
+/// Reproduces @c detail::Axis::getBin for all axis and boundary types, such
+/// that the flat grid and the original grid agree bin by bin.
+class FlatSurfaceGridAxis {
+ public:
+  /// Constructor from the original axis
+  ///
+  /// @param axis is the axis to be mirrored
+  explicit FlatSurfaceGridAxis(const IAxis& axis)
+      : m_boundaryType(axis.getBoundaryType()),
+        m_equidistant(axis.isEquidistant()),
+        m_min(axis.getMin()),
+        m_width((axis.getMax() - axis.getMin()) / axis.getNBins()),
+        m_nBins(static_cast<int>(axis.getNBins())),
+        m_edges(axis.isEquidistant() ? std::vector<ActsScalar>{}
+                                     : axis.getBinEdges()) {}
+
+  /// @return the bin of @p x including under- and overflow bins
+  std::size_t getBin(ActsScalar x) const {
+    int bin = m_equidistant
+                  ? static_cast<int>(std::floor((x - m_min) / m_width) + 1)
+                  : static_cast<int>(std::distance(
+                        m_edges.begin(),
+                        std::upper_bound(m_edges.begin(), m_edges.end(), x)));
+    switch (m_boundaryType) {
+      case AxisBoundaryType::Open:
+        return std::max(std::min(bin, m_nBins + 1), 0);
+      case AxisBoundaryType::Bound:
+        return std::max(std::min(bin, m_nBins), 1);
+      default:
+        return 1 + (m_nBins + ((bin - 1) % m_nBins)) % m_nBins;
+    }
+  }
+
+  /// @return the number of bins without under- and overflow bins
+  std::size_t getNBins() const { return m_nBins; }
+
+  /// @return the lower edge of @p bin, which has to be a regular bin
+  ActsScalar lowerEdge(std::size_t bin) const {
+    return m_equidistant ? m_min + (bin - 1) * m_width : m_edges[bin - 1];
+  }
+
+  /// @return the upper edge of @p bin, which has to be a regular bin
+  ActsScalar upperEdge(std::size_t bin) const {
+    return m_equidistant ? m_min + bin * m_width : m_edges[bin];
+  }
+
+ private:
+  AxisBoundaryType m_boundaryType;
+  bool m_equidistant;
+  ActsScalar m_min;
+  ActsScalar m_width;
+  int m_nBins;
+  std::vector<ActsScalar> m_edges;
+};
+
+/// @brief Flat neighbor lookup of a two-dimensional surface grid
+///
+/// The neighbor surfaces of all bins are stored in a single vector, with the
+/// range of each bin given by a per-bin offset (compressed sparse row). The
+/// local coordinates are computed from the grid transform with the binning
+/// values known at compile time, so that a lookup needs neither a virtual nor
+/// a type-erased function call.
+///
+/// @tparam bValue0 is the binning value of the first axis
+/// @tparam bValue1 is the binning value of the second axis
+template <BinningValue bValue0, BinningValue bValue1>
+class FlatSurfaceGrid {
+  static_assert((bValue0 == binPhi and bValue1 == binZ) or
+                    (bValue0 == binR and bValue1 == binPhi),
+                "Only cylinder (phi, z) and disc (r, phi) grids supported.");
+
+ public:
+  /// Constructor
+  ///
+  /// @param transform is the global to grid frame transform
+  /// @param axis0 is the first axis
+  /// @param axis1 is the second axis
+  FlatSurfaceGrid(const Transform3& transform, FlatSurfaceGridAxis axis0,
+                  FlatSurfaceGridAxis axis1)
+      : m_transform(transform),
+        m_axis0(std::move(axis0)),
+        m_axis1(std::move(axis1)),
+        m_offsets(1u, 0u) {}
+
+  /// Append the neighbors of the next global bin
+  ///
+  /// @param neighbors are the neighbor surfaces of the bin
+  void push_back(const std::vector<const Surface*>& neighbors) {
+    m_surfaces.insert(m_surfaces.end(), neighbors.begin(), neighbors.end());
+    m_offsets.push_back(static_cast<std::uint32_t>(m_surfaces.size()));
+  }
+
+  /// @return the total number of bins including under- and overflow bins
+  std::size_t size() const {
+    return (m_axis0.getNBins() + 2) * (m_axis1.getNBins() + 2);
+  }
+
+  /// @return the global bin of a global @p position
+  std::size_t globalBin(const Vector3& position) const {
+    Vector3 local = m_transform * position;
+    return m_axis0.getBin(cast<bValue0>(local)) * (m_axis1.getNBins() + 2) +
+           m_axis1.getBin(cast<bValue1>(local));
+  }
+
+  /// @return the neighbor surfaces of the bin at a global @p position
+  SurfaceRange neighbors(const Vector3& position) const {
+    std::size_t bin = globalBin(position);
+    return SurfaceRange(m_surfaces.data() + m_offsets[bin],
+                        m_surfaces.data() + m_offsets[bin + 1]);
+  }
+
+  /// @return the first axis
+  const FlatSurfaceGridAxis& axis0() const { return m_axis0; }
+
+  /// @return the second axis
+  const FlatSurfaceGridAxis& axis1() const { return m_axis1; }
+
+ private:
+  template <BinningValue bValue>
+  static ActsScalar cast(const Vector3& local) {
+    if constexpr (bValue == binPhi) {
+      return VectorHelpers::phi(local);
+    } else if constexpr (bValue == binZ) {
+      return local.z();
+    } else {
+      return VectorHelpers::perp(local);
+    }
+  }
+
+  Transform3 m_transform;
+  FlatSurfaceGridAxis m_axis0;
+  FlatSurfaceGridAxis m_axis1;
+  std::vector<std::uint32_t> m_offsets;
+  std::vector<const Surface*> m_surfaces;
+};
+
+}  // namespace detail
+}  // namespace Acts
@@ -0,0 +1,151 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/TrackFitting/KalmanFitterError.hpp"
+#include "Acts/TrackFitting/detail/BatchedLaneAlgebra.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+
+namespace Acts {
+
+/// Kalman smoothing step based on the gain matrix formalism for many
+/// independent tracks at once.
+///
+/// Other than the @c GainMatrixSmoother, this implements a single smoothing
+/// step: it smooths one track state of every track, given the already
+/// smoothed following track state in forward direction. A full trajectory is
+/// smoothed by calling it for the track states in backward order.
+///
+/// The track states are stored in structure-of-arrays form, as for the
+/// @c BatchedGainMatrixUpdater, and the covariance algebra is vectorized
+/// across the tracks. The results agree with the @c GainMatrixSmoother up to
+/// rounding.
+class BatchedGainMatrixSmoother {
+ public:
+  /// Number of track states processed together
+  static constexpr std::size_t kChunkSize = 16;
+
+  /// Pairs of a track state and its following track state
+  ///
+  /// Matrix element (i, j) is stored in column i * cols + j.
+  struct States {
+    using ParameterColumns =
+        Eigen::Array<ActsScalar, Eigen::Dynamic, eBoundSize>;
+    using MatrixColumns =
+        Eigen::Array<ActsScalar, Eigen::Dynamic, eBoundSize * eBoundSize>;
+
+    /// Resize the inputs and outputs for @p n track states
+    void resize(std::size_t n) {
+      for (auto* parameters :
+           {&filtered, &nextPredicted, &nextSmoothed, &smoothed}) {
+        parameters->resize(n, eBoundSize);
+      }
+      for (auto* matrix :
+           {&filteredCovariance, &nextPredictedCovariance,
+            &nextSmoothedCovariance, &nextJacobian, &smoothedCovariance}) {
+        matrix->resize(n, eBoundSize * eBoundSize);
+      }
+      ok.resize(n);
+    }
+
+    /// Number of track states
+    std::size_t size() const { return filtered.rows(); }
+
+    /// Copy the inputs of the track state @p i from track state proxies
+    ///
+    /// @param i The index of the track state in the batch
+    /// @param trackState The filtered track state to be smoothed
+    /// @param nextTrackState The following, already smoothed track state
+    template <typename track_state_t, typename next_track_state_t>
+    void setTrackStates(std::size_t i, const track_state_t& trackState,
+                        const next_track_state_t& nextTrackState) {
+      detail::storeElements(filtered, i, trackState.filtered().transpose());
+      detail::storeElements(filteredCovariance, i,
+                            trackState.filteredCovariance());
+      detail::storeElements(nextPredicted, i,
+                            nextTrackState.predicted().transpose());
+      detail::storeElements(nextPredictedCovariance, i,
+                            nextTrackState.predictedCovariance());
+      detail::storeElements(nextSmoothed, i,
+                            nextTrackState.smoothed().transpose());
+      detail::storeElements(nextSmoothedCovariance, i,
+                            nextTrackState.smoothedCovariance());
+      detail::storeElements(nextJacobian, i, nextTrackState.jacobian());
+    }
+
+    /// Copy the outputs of the track state @p i to a track state proxy
+    ///
+    /// @param i The index of the track state in the batch
+    /// @param trackState The track state with allocated smoothed parameters
+    template <typename track_state_t>
+    void writeSmoothed(std::size_t i, track_state_t trackState) const {
+      trackState.smoothed() = detail::loadElements<BoundVector>(smoothed, i);
+      trackState.smoothedCovariance() =
+          detail::loadElements<BoundSymMatrix>(smoothedCovariance, i);
+    }
+
+    /// @name Inputs
+    /// @{
+
+    /// Filtered parameters of the track state
+    ParameterColumns filtered;
+    /// Filtered covariance of the track state
+    MatrixColumns filteredCovariance;
+    /// Predicted parameters of the following track state
+    ParameterColumns nextPredicted;
+    /// Predicted covariance of the following track state
+    MatrixColumns nextPredictedCovariance;
+    /// Smoothed parameters of the following track state
+    ParameterColumns nextSmoothed;
+    /// Smoothed covariance of the following track state
+    MatrixColumns nextSmoothedCovariance;
+    /// Jacobian from the track state to the following track state, which is
+    /// stored in the following track state
+    MatrixColumns nextJacobian;
+
+    /// @}
+
+    /// @name Outputs
+    /// @{
+
+    /// Smoothed parameters
+    ParameterColumns smoothed;
+    /// Smoothed covariance
+    MatrixColumns smoothedCovariance;
+    /// Whether the smoothing of the track state succeeded. The outputs of
+    /// failed track states are meaningless.
+    Eigen::Array<bool, Eigen::Dynamic, 1> ok;
+
+    /// @}
+  };
+
+  /// Run the smoothing step for all track states of a batch
+  ///
+  /// @param[in,out] states The track states, resized with @c States::resize
+  /// @param[in] logger Where to write logging information to
+  ///
+  /// @return An error if the smoothing failed for any track state, which are
+  ///         marked in @c States::ok. The other track states are smoothed
+  ///         nevertheless.
+  ///
+  /// @note The gain matrix is computed with a Cholesky decomposition, track
+  ///       states where the predicted covariance of the following track
+  ///       state is not positive definite are marked as failed.
+  Result<void> operator()(States& states,
+                          const Logger& logger = getDummyLogger()) const;
+};
+
+}  // namespace Acts
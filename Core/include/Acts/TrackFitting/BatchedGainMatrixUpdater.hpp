@@ -0,0 +1,155 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Common.hpp"
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/TrackFitting/KalmanFitterError.hpp"
+#include "Acts/TrackFitting/detail/BatchedLaneAlgebra.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace Acts {
+
+/// Kalman update step using the gain matrix formalism for many independent
+/// track states at once.
+///
+/// The track states are stored in structure-of-arrays form: every element of
+/// the parameter vectors and the covariance matrices is a column with one
+/// entry per track state. All track states of a batch have the same
+/// measurement dimension, while the measured bound parameters may differ from
+/// state to state. The update is evaluated for chunks of track states with
+/// Eigen array expressions, i.e. the covariance algebra is vectorized across
+/// the track states instead of within one small matrix.
+///
+/// The results agree with the @c GainMatrixUpdater up to rounding.
+class BatchedGainMatrixUpdater {
+ public:
+  /// Number of track states processed together
+  static constexpr std::size_t kChunkSize = 16;
+
+  /// Track states with @c kMeasurementSize dimensional measurements
+  ///
+  /// Matrix element (i, j) is stored in column i * cols + j.
+  template <std::size_t kMeasurementSize>
+  struct States {
+    template <typename T, std::size_t kCols>
+    using Columns = Eigen::Array<T, Eigen::Dynamic, kCols>;
+
+    /// Resize the inputs and outputs for @p n track states
+    void resize(std::size_t n) {
+      predicted.resize(n, eBoundSize);
+      predictedCovariance.resize(n, eBoundSize * eBoundSize);
+      calibrated.resize(n, kMeasurementSize);
+      calibratedCovariance.resize(n, kMeasurementSize * kMeasurementSize);
+      indices.resize(n, kMeasurementSize);
+      filtered.resize(n, eBoundSize);
+      filteredCovariance.resize(n, eBoundSize * eBoundSize);
+      chi2.resize(n);
+      ok.resize(n);
+    }
+
+    /// Number of track states
+    std::size_t size() const { return predicted.rows(); }
+
+    /// Copy the inputs of the track state @p i from a track state proxy
+    ///
+    /// @param i The index of the track state in the batch
+    /// @param trackState The predicted and calibrated track state
+    template <typename track_state_t>
+    void setTrackState(std::size_t i, const track_state_t& trackState) {
+      assert(trackState.calibratedSize() == kMeasurementSize);
+      detail::storeElements(predicted, i, trackState.predicted().transpose());
+      detail::storeElements(predictedCovariance, i,
+                            trackState.predictedCovariance());
+      detail::storeElements(
+          calibrated, i,
+          trackState.template calibrated<kMeasurementSize>().transpose());
+      detail::storeElements(
+          calibratedCovariance, i,
+          trackState.template calibratedCovariance<kMeasurementSize>());
+      const auto projector = trackState.projector();
+      for (std::size_t r = 0; r < kMeasurementSize; ++r) {
+        Eigen::Index index = 0;
+        projector.row(r).maxCoeff(&index);
+        indices(i, r) = static_cast<std::uint8_t>(index);
+      }
+    }
+
+    /// Copy the outputs of the track state @p i to a track state proxy
+    ///
+    /// @param i The index of the track state in the batch
+    /// @param trackState The track state with allocated filtered parameters
+    template <typename track_state_t>
+    void writeFiltered(std::size_t i, track_state_t trackState) const {
+      trackState.filtered() = detail::loadElements<BoundVector>(filtered, i);
+      trackState.filteredCovariance() =
+          detail::loadElements<BoundSymMatrix>(filteredCovariance, i);
+      trackState.chi2() = chi2(i);
+    }
+
+    /// @name Inputs
+    /// @{
+
+    /// Predicted parameters
+    Columns<ActsScalar, eBoundSize> predicted;
+    /// Predicted covariance, the matrices have to be symmetric
+    Columns<ActsScalar, eBoundSize * eBoundSize> predictedCovariance;
+    /// Measured parameters
+    Columns<ActsScalar, kMeasurementSize> calibrated;
+    /// Measurement covariance, the matrices have to be symmetric
+    Columns<ActsScalar, kMeasurementSize * kMeasurementSize>
+        calibratedCovariance;
+    /// Bound parameter index of every measured parameter, i.e. the projector
+    Columns<std::uint8_t, kMeasurementSize> indices;
+
+    /// @}
+
+    /// @name Outputs
+    /// @{
+
+    /// Filtered parameters
+    Columns<ActsScalar, eBoundSize> filtered;
+    /// Filtered covariance
+    Columns<ActsScalar, eBoundSize * eBoundSize> filteredCovariance;
+    /// Chi2 of the filtered parameters
+    Eigen::Array<ActsScalar, Eigen::Dynamic, 1> chi2;
+    /// Whether the update of the track state succeeded. The outputs of
+    /// failed track states are meaningless.
+    Eigen::Array<bool, Eigen::Dynamic, 1> ok;
+
+    /// @}
+  };
+
+  /// Run the Kalman update step for all track states of a batch
+  ///
+  /// @param[in,out] states The track states, resized with @c States::resize
+  /// @param[in] direction The navigation direction
+  /// @param[in] logger Where to write logging information to
+  ///
+  /// @return An error if the update failed for any track state, which are
+  ///         marked in @c States::ok. The other track states are updated
+  ///         nevertheless.
+  ///
+  /// @note The gain matrix is computed with a Cholesky decomposition, track
+  ///       states where the residual covariance is not positive definite are
+  ///       marked as failed.
+  template <std::size_t kMeasurementSize>
+  Result<void> operator()(
+      States<kMeasurementSize>& states,
+      NavigationDirection direction = NavigationDirection::Forward,
+      const Logger& logger = getDummyLogger()) const;
+};
+
+}  // namespace Acts
@@ -20,6 +20,18 @@
 namespace Acts {
 namespace Experimental {
 
+/// Available methods to reduce the number of components after the material
+/// convolution in the GSF
+enum class MixtureReductionMethod {
+  /// Merge the closest components in Kullback-Leibler distance
+  eKLDistance,
+  /// Keep the components with the largest weights
+  eMaxWeight,
+  /// Keep at most `maxComponentsBeforeMerge` components with the largest
+  /// weights, then merge in Kullback-Leibler distance
+  eMaxWeightKLDistance
+};
+
 /// The extensions needed for the GSF
 template <typename traj_t>
 struct GsfExtensions {
@@ -68,6 +80,11 @@ struct GsfOptions {
 
   std::size_t maxComponents = 4;
 
+  MixtureReductionMethod mixtureReductionMethod =
+      MixtureReductionMethod::eKLDistance;
+
+  std::size_t maxComponentsBeforeMerge = 24;
+
   double weightCutoff = 1.e-4;
 
   bool abortOnError = true;
@@ -0,0 +1,167 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/EventData/Track.hpp"
+#include "Acts/EventData/TrackHelpers.hpp"
+#include "Acts/EventData/VectorMultiTrajectory.hpp"
+#include "Acts/EventData/VectorTrackContainer.hpp"
+#include "Acts/Utilities/MonotonicArena.hpp"
+#include "Acts/Utilities/TaskExecutor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Acts {
+
+/// Fit many independent tracks, e.g. all proto tracks of an event, in
+/// parallel.
+///
+/// The inputs are split into consecutive ranges, which are fitted as
+/// independent tasks by a @c TaskExecutor into scratch track containers.
+/// The tracks of the tasks are then appended to the output container in the
+/// order of the tasks, such that the output is the same as for a sequential
+/// fit, independent of the number of tasks and of the scheduling. The fit
+/// itself is a user supplied function, which allows to reuse fitter options
+/// for all tracks and to use any fitter.
+///
+/// The scratch containers are cached between calls. Their track states are
+/// allocated from a @c MonotonicArena, which is reset once the tracks have
+/// been appended, such that the fits do not allocate in the steady state.
+/// The caches are taken from a pool, which makes @c refit safe to be called
+/// concurrently, e.g. for different events.
+///
+/// @tparam holder_t the holder of the track container backends, either
+///         @c detail_tc::RefHolder or @c std::shared_ptr
+template <template <typename> class holder_t = detail_tc::RefHolder>
+class TrackRefitter {
+ public:
+  using TrackContainer =
+      Acts::TrackContainer<VectorTrackContainer, VectorMultiTrajectory,
+                           holder_t>;
+
+  struct Config {
+    /// Number of consecutive input ranges which are fitted as separate tasks
+    std::size_t numTasks = 1;
+    /// Run the tasks, sequentially in the calling thread if not set
+    TaskExecutor executor;
+  };
+
+  /// @param config the refitter configuration
+  explicit TrackRefitter(Config config) : m_cfg(std::move(config)) {
+    if (m_cfg.numTasks == 0) {
+      throw std::invalid_argument("Need at least one refit task");
+    }
+    if (not m_cfg.executor) {
+      m_cfg.executor = SequentialTaskExecutor{};
+    }
+  }
+
+  /// Fit a number of tracks and append them to a track container
+  ///
+  /// The fit function is called as `fit(input, tracks)` for every input
+  /// index in [0, nInputs) and adds the track(s) of this input to the given
+  /// scratch container. Its return value is ignored. It has to be thread
+  /// safe if the executor runs tasks concurrently.
+  ///
+  /// @note Only the standard track columns are copied to @p tracks.
+  ///
+  /// @param nInputs the number of inputs
+  /// @param fit the fit function
+  /// @param tracks the container the tracks are appended to in input order
+  template <typename fit_t>
+  void refit(std::size_t nInputs, fit_t&& fit, TrackContainer& tracks) const {
+    const std::size_t nTasks = std::min(m_cfg.numTasks, nInputs);
+    if (nTasks == 0) {
+      return;
+    }
+
+    std::vector<std::unique_ptr<Cache>> caches;
+    caches.reserve(nTasks);
+    for (std::size_t task = 0; task < nTasks; ++task) {
+      caches.push_back(acquireCache());
+    }
+
+    m_cfg.executor(nTasks, [&](std::size_t task) {
+      TrackContainer& tracksOfTask = *caches[task]->tracks;
+      for (std::size_t input = nInputs * task / nTasks;
+           input < nInputs * (task + 1) / nTasks; ++input) {
+        fit(input, tracksOfTask);
+      }
+    });
+
+    for (auto& cache : caches) {
+      appendTracks(*cache->tracks, tracks);
+      releaseCache(std::move(cache));
+    }
+  }
+
+  /// Get readonly access to the config parameters
+  const Config& config() const { return m_cfg; }
+
+ private:
+  /// Scratch containers of one task
+  struct Cache {
+    MonotonicArena arena;
+    std::shared_ptr<VectorTrackContainer> trackContainer;
+    std::shared_ptr<VectorMultiTrajectory> trackStateContainer;
+    std::unique_ptr<TrackContainer> tracks;
+
+    /// Create empty containers, invalidating the previous ones
+    void reset() {
+      // the track states have to be gone before the arena is reset
+      tracks.reset();
+      trackStateContainer.reset();
+      arena.reset();
+      trackContainer = std::make_shared<VectorTrackContainer>();
+      trackStateContainer = std::make_shared<VectorMultiTrajectory>(&arena);
+      if constexpr (detail_tc::is_same_template<holder_t,
+                                                std::shared_ptr>::value) {
+        tracks = std::make_unique<TrackContainer>(trackContainer,
+                                                  trackStateContainer);
+      } else {
+        tracks = std::make_unique<TrackContainer>(*trackContainer,
+                                                  *trackStateContainer);
+      }
+    }
+  };
+
+  std::unique_ptr<Cache> acquireCache() const {
+    std::unique_ptr<Cache> cache;
+    {
+      std::lock_guard<std::mutex> lock(m_cacheMutex);
+      if (not m_caches.empty()) {
+        cache = std::move(m_caches.back());
+        m_caches.pop_back();
+      }
+    }
+    if (not cache) {
+      cache = std::make_unique<Cache>();
+    }
+    cache->reset();
+    return cache;
+  }
+
+  void releaseCache(std::unique_ptr<Cache> cache) const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_caches.push_back(std::move(cache));
+  }
+
+  Config m_cfg;
+
+  mutable std::mutex m_cacheMutex;
+  mutable std::vector<std::unique_ptr<Cache>> m_caches;
+};
+
+}  // namespace Acts
@@ -0,0 +1,153 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "Acts/Definitions/Algebra.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace Acts {
+namespace detail {
+
+/// One scalar per track state of a chunk
+template <std::size_t N>
+using Lanes = Eigen::Array<ActsScalar, N, 1>;
+
+/// One flag per track state of a chunk
+template <std::size_t N>
+using LaneMask = Eigen::Array<bool, N, 1>;
+
+/// One vector of size @c M per track state of a chunk, stored element-wise
+template <std::size_t N, std::size_t M>
+using LaneVector = std::array<Lanes<N>, M>;
+
+/// One @c MxM matrix per track state of a chunk, stored element-wise with
+/// element (i, j) at index i * M + j
+template <std::size_t N, std::size_t M>
+using LaneMatrix = std::array<Lanes<N>, M * M>;
+
+/// Store a matrix into row @p i of a structure-of-arrays, where element
+/// (r, c) of the matrix goes into column r * cols + c.
+template <typename array_t, typename matrix_t>
+void storeElements(array_t& array, std::size_t i,
+                   const Eigen::MatrixBase<matrix_t>& matrix) {
+  for (Eigen::Index r = 0; r < matrix.rows(); ++r) {
+    for (Eigen::Index c = 0; c < matrix.cols(); ++c) {
+      array(i, r * matrix.cols() + c) = matrix(r, c);
+    }
+  }
+}
+
+/// Load a matrix from row @p i of a structure-of-arrays, see
+/// @c storeElements for the layout.
+template <typename matrix_t, typename array_t>
+matrix_t loadElements(const array_t& array, std::size_t i) {
+  matrix_t matrix;
+  for (Eigen::Index r = 0; r < matrix.rows(); ++r) {
+    for (Eigen::Index c = 0; c < matrix.cols(); ++c) {
+      matrix(r, c) = array(i, r * matrix.cols() + c);
+    }
+  }
+  return matrix;
+}
+
+/// Load @p size entries of a column starting at @p begin into lanes. Unused
+/// lanes repeat the last entry, such that they stay numerically harmless.
+template <std::size_t N, typename column_t>
+Lanes<N> loadLanes(const column_t& column, std::size_t begin,
+                   std::size_t size) {
+  Lanes<N> lanes;
+  if (size == N) {
+    lanes = column.template segment<N>(begin);
+  } else {
+    lanes.head(size) = column.segment(begin, size);
+    lanes.tail(N - size).setConstant(column(begin + size - 1));
+  }
+  return lanes;
+}
+
+/// Store the first @p size lanes into a column starting at @p begin
+template <std::size_t N, typename column_t>
+void storeLanes(const Lanes<N>& lanes, column_t&& column, std::size_t begin,
+                std::size_t size) {
+  column.segment(begin, size) = lanes.head(size);
+}
+
+/// Load a symmetric matrix from the columns of a structure-of-arrays. Only
+/// the upper triangle is read.
+template <std::size_t N, std::size_t M, typename array_t>
+LaneMatrix<N, M> loadSymmetricLanes(const array_t& array, std::size_t begin,
+                                    std::size_t size) {
+  LaneMatrix<N, M> matrix;
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = i; j < M; ++j) {
+      matrix[i * M + j] = loadLanes<N>(array.col(i * M + j), begin, size);
+      matrix[j * M + i] = matrix[i * M + j];
+    }
+  }
+  return matrix;
+}
+
+/// Lane-wise Cholesky decomposition A = L L^T of symmetric matrices
+///
+/// @param a The matrices to decompose, only the lower triangle is used
+/// @param l Receives the lower triangle of L, the upper triangle is untouched
+/// @param invDiag Receives the inverse diagonal of L
+///
+/// @return The lanes where the matrix is positive definite. The other lanes
+///         contain non-finite values.
+template <std::size_t N, std::size_t M>
+LaneMask<N> choleskyLanes(const LaneMatrix<N, M>& a, LaneMatrix<N, M>& l,
+                          LaneVector<N, M>& invDiag) {
+  LaneMask<N> ok = LaneMask<N>::Constant(true);
+  for (std::size_t j = 0; j < M; ++j) {
+    Lanes<N> d = a[j * M + j];
+    for (std::size_t k = 0; k < j; ++k) {
+      d -= l[j * M + k].square();
+    }
+    // also catches NaN
+    ok = ok && (d > 0);
+    l[j * M + j] = d.sqrt();
+    invDiag[j] = l[j * M + j].inverse();
+    for (std::size_t i = j + 1; i < M; ++i) {
+      Lanes<N> s = a[i * M + j];
+      for (std::size_t k = 0; k < j; ++k) {
+        s -= l[i * M + k] * l[j * M + k];
+      }
+      l[i * M + j] = s * invDiag[j];
+    }
+  }
+  return ok;
+}
+
+/// Lane-wise solution of A x = b in place, using the Cholesky decomposition
+/// from @c choleskyLanes
+template <std::size_t N, std::size_t M>
+void choleskySolveLanes(const LaneMatrix<N, M>& l,
+                        const LaneVector<N, M>& invDiag,
+                        LaneVector<N, M>& b) {
+  // forward substitution L y = b
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t k = 0; k < i; ++k) {
+      b[i] -= l[i * M + k] * b[k];
+    }
+    b[i] *= invDiag[i];
+  }
+  // backward substitution L^T x = y
+  for (std::size_t i = M; i-- > 0;) {
+    for (std::size_t k = i + 1; k < M; ++k) {
+      b[i] -= l[k * M + i] * b[k];
+    }
+    b[i] *= invDiag[i];
+  }
+}
+
+}  // namespace detail
+}  // namespace Acts
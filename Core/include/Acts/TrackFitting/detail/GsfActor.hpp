@@ -88,6 +88,14 @@ struct GsfActor {
     /// When to discard components
     double weightCutoff = 1.0e-4;
 
+    /// How to reduce the number of components after the convolution
+    Experimental::MixtureReductionMethod mixtureReductionMethod =
+        Experimental::MixtureReductionMethod::eKLDistance;
+
+    /// Number of components kept before the merging, for
+    /// MixtureReductionMethod::eMaxWeightKLDistance
+    std::size_t maxComponentsBeforeMerge = 24;
+
     /// When this option is enabled, material information on all surfaces is
     /// ignored. This disables the component convolution as well as the handling
     /// of energy. This may be useful for debugging.
@@ -452,6 +460,18 @@ struct GsfActor {
     const auto final_cmp_number = std::min(
         static_cast<std::size_t>(stepper.maxComponents), m_cfg.maxComponents);
 
+    using Method = Experimental::MixtureReductionMethod;
+    if (m_cfg.mixtureReductionMethod != Method::eKLDistance) {
+      auto weightProj = [](auto& a) -> double& {
+        return std::get<0>(a).weight;
+      };
+      const auto maxCmps =
+          m_cfg.mixtureReductionMethod == Method::eMaxWeight
+              ? final_cmp_number
+              : std::max(final_cmp_number, m_cfg.maxComponentsBeforeMerge);
+      detail::reduceWithMaxWeight(cmps, maxCmps, weightProj);
+    }
+
     auto proj = [](auto& a) -> decltype(auto) { return std::get<0>(a); };
 
     // We must differ between surface types, since there can be different
@@ -777,6 +797,8 @@ struct GsfActor {
     m_cfg.abortOnError = options.abortOnError;
     m_cfg.disableAllMaterialHandling = options.disableAllMaterialHandling;
     m_cfg.weightCutoff = options.weightCutoff;
+    m_cfg.mixtureReductionMethod = options.mixtureReductionMethod;
+    m_cfg.maxComponentsBeforeMerge = options.maxComponentsBeforeMerge;
   }
 };
 
@@ -13,8 +13,10 @@
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/Utilities/Logger.hpp"
 
+#include <algorithm>
 #include <map>
 #include <numeric>
+#include <vector>
 
 namespace Acts {
 
@@ -65,6 +67,20 @@ void normalizeWeights(component_range_t &cmps, const projector_t &proj) {
   }
 }
 
+/// Keep only the maxCmps components with the largest weights
+/// @note The weights are not renormalized!
+template <typename component_t, typename projector_t>
+void reduceWithMaxWeight(std::vector<component_t> &cmps, std::size_t maxCmps,
+                         const projector_t &proj) {
+  if (cmps.size() <= maxCmps) {
+    return;
+  }
+
+  std::nth_element(cmps.begin(), cmps.begin() + maxCmps, cmps.end(),
+                   [&](auto &a, auto &b) { return proj(a) > proj(b); });
+  cmps.erase(cmps.begin() + maxCmps, cmps.end());
+}
+
 // A class that prints information about the state on construction and
 // destruction, it also contains some assertions in the constructor and
 // destructor. It can be removed without change of behaviour, since it only
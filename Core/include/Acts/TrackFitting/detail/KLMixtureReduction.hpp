@@ -15,6 +15,11 @@
 
 #include "GsfUtils.hpp"
 
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace Acts {
 
 namespace detail {
@@ -68,27 +73,71 @@ auto mergeComponents(const component_t &a, const component_t &b,
 }
 
 /// @brief Class representing a symmetric distance matrix
+///
+/// Only the lower triangle is stored, row by row. In addition the minimum of
+/// every row is cached, so finding the closest pair is linear in the number
+/// of components. When the distances of a component are recomputed or masked,
+/// only the rows whose minimum is affected are scanned again. The distances
+/// of a component to all others are evaluated at once from the cached q/p
+/// values and variances.
 class SymmetricKLDistanceMatrix {
   using Array = Eigen::Array<ActsScalar, Eigen::Dynamic, 1>;
   using Mask = Eigen::Array<bool, Eigen::Dynamic, 1>;
 
+  constexpr static ActsScalar s_maxDistance =
+      std::numeric_limits<ActsScalar>::max();
+
   Array m_distances;
   Mask m_mask;
-  std::vector<std::pair<std::size_t, std::size_t>> m_mapToPair;
+  Array m_qop;
+  Array m_var;
+  Array m_rowMin;
+  std::vector<std::size_t> m_rowMinIndex;
   std::size_t m_numberComponents;
 
-  template <typename array_t, typename setter_t>
-  void setAssociated(std::size_t n, array_t &array, setter_t &&setter) {
-    const auto indexConst = (n - 1) * n / 2;
+  static std::size_t rowOffset(std::size_t i) { return (i - 1) * i / 2; }
 
-    // Rows
-    for (auto i = 0ul; i < n; ++i) {
-      array[indexConst + i] = setter(n, i);
-    }
+  template <typename component_t, typename projector_t>
+  void setComponent(std::size_t n, const component_t &cmp,
+                    const projector_t &proj) {
+    m_qop[n] = proj(cmp).boundPars[eBoundQOverP];
+    m_var[n] = proj(cmp).boundCov(eBoundQOverP, eBoundQOverP);
+
+    throw_assert(m_var[n] > 0.0, "q/p variance should be positive, but is: "
+                                     << m_var[n] << " (qop: " << m_qop[n]
+                                     << ")");
+    throw_assert(std::isfinite(m_var[n]), "");
+  }
 
-    // Columns
-    for (auto i = n + 1; i < m_numberComponents; ++i) {
-      array[(i - 1) * i / 2 + n] = setter(n, i);
+  /// Distances of the component n to the components [begin, begin + size),
+  /// see computeSymmetricKlDivergence
+  Array distancesTo(std::size_t n, std::size_t begin, std::size_t size) const {
+    const auto qop = m_qop.segment(begin, size);
+    const Array invVar = m_var.segment(begin, size).inverse();
+    const ActsScalar invVarN = 1 / m_var[n];
+
+    return m_var[n] * invVar + m_var.segment(begin, size) * invVarN +
+           (qop - m_qop[n]).square() * (invVar + invVarN);
+  }
+
+  /// Find the minimum of the unmasked distances in row i
+  void updateRowMin(std::size_t i) {
+    Eigen::Index j = 0;
+    m_rowMin[i] = m_mask.segment(rowOffset(i), i)
+                      .select(m_distances.segment(rowOffset(i), i),
+                              s_maxDistance)
+                      .minCoeff(&j);
+    m_rowMinIndex[i] = j;
+  }
+
+  /// Update the minimum of row i > n after the distance (i, n) changed
+  void updateRowMin(std::size_t i, std::size_t n) {
+    const auto d = m_distances[rowOffset(i) + n];
+    if (d < m_rowMin[i] || (d == m_rowMin[i] && n < m_rowMinIndex[i])) {
+      m_rowMin[i] = d;
+      m_rowMinIndex[i] = n;
+    } else if (m_rowMinIndex[i] == n) {
+      updateRowMin(i);
     }
   }
 
@@ -98,15 +147,17 @@ class SymmetricKLDistanceMatrix {
                             const projector_t &proj)
       : m_distances(Array::Zero(cmps.size() * (cmps.size() - 1) / 2)),
         m_mask(Mask::Ones(cmps.size() * (cmps.size() - 1) / 2)),
-        m_mapToPair(m_distances.size()),
+        m_qop(cmps.size()),
+        m_var(cmps.size()),
+        m_rowMin(Array::Constant(cmps.size(), s_maxDistance)),
+        m_rowMinIndex(cmps.size(), 0),
         m_numberComponents(cmps.size()) {
+    for (auto i = 0ul; i < m_numberComponents; ++i) {
+      setComponent(i, cmps[i], proj);
+    }
     for (auto i = 1ul; i < m_numberComponents; ++i) {
-      const auto indexConst = (i - 1) * i / 2;
-      for (auto j = 0ul; j < i; ++j) {
-        m_mapToPair.at(indexConst + j) = {i, j};
-        m_distances[indexConst + j] =
-            computeSymmetricKlDivergence(cmps[i], cmps[j], proj);
-      }
+      m_distances.segment(rowOffset(i), i) = distancesTo(i, 0, i);
+      updateRowMin(i);
     }
   }
 
@@ -120,28 +171,49 @@ class SymmetricKLDistanceMatrix {
                                     const projector_t &proj) {
     assert(cmps.size() == m_numberComponents && "size mismatch");
 
-    setAssociated(n, m_distances, [&](std::size_t i, std::size_t j) {
-      return computeSymmetricKlDivergence(cmps[i], cmps[j], proj);
-    });
-  }
+    setComponent(n, cmps[n], proj);
 
-  void maskAssociatedDistances(std::size_t n) {
-    setAssociated(n, m_mask, [&](std::size_t, std::size_t) { return false; });
+    // Row
+    if (n > 0) {
+      m_distances.segment(rowOffset(n), n) = distancesTo(n, 0, n);
+      updateRowMin(n);
+    }
+
+    // Column
+    if (n + 1 < m_numberComponents) {
+      const Array column =
+          distancesTo(n, n + 1, m_numberComponents - (n + 1));
+      for (auto i = n + 1; i < m_numberComponents; ++i) {
+        const auto k = rowOffset(i) + n;
+        m_distances[k] = column[i - (n + 1)];
+        if (m_mask[k]) {
+          updateRowMin(i, n);
+        }
+      }
+    }
   }
 
-  auto minDistancePair() const {
-    ActsScalar min = std::numeric_limits<ActsScalar>::max();
-    std::size_t idx = 0;
+  void maskAssociatedDistances(std::size_t n) {
+    // Row
+    if (n > 0) {
+      m_mask.segment(rowOffset(n), n).setConstant(false);
+      m_rowMin[n] = s_maxDistance;
+    }
 
-    for (auto i = 0l; i < m_distances.size(); ++i) {
-      if (auto new_min = std::min(min, m_distances[i]);
-          m_mask[i] && new_min < min) {
-        min = new_min;
-        idx = i;
+    // Column
+    for (auto i = n + 1; i < m_numberComponents; ++i) {
+      m_mask[rowOffset(i) + n] = false;
+      if (m_rowMinIndex[i] == n) {
+        updateRowMin(i);
       }
     }
+  }
+
+  std::pair<std::size_t, std::size_t> minDistancePair() const {
+    Eigen::Index i = 0;
+    m_rowMin.tail(m_numberComponents - 1).minCoeff(&i);
 
-    return m_mapToPair.at(idx);
+    return {i + 1, m_rowMinIndex[i + 1]};
   }
 
   friend std::ostream &operator<<(std::ostream &os,
@@ -205,10 +277,6 @@ void reduceWithKLDistance(std::vector<component_t> &cmpCache,
   }
 
   // Remove all components which are labled with weight -1
-  std::sort(cmpCache.begin(), cmpCache.end(),
-            [&](const auto &a, const auto &b) {
-              return proj(a).weight < proj(b).weight;
-            });
   cmpCache.erase(
       std::remove_if(cmpCache.begin(), cmpCache.end(),
                      [&](const auto &a) { return proj(a).weight == -1.0; }),
@@ -0,0 +1,105 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Acts {
+
+/// @brief Monotonic memory resource that can be reset and reused
+///
+/// Allocations are served by bumping a pointer in blocks obtained from the
+/// upstream resource, deallocations are no-ops. All memory is given back at
+/// once by calling @c reset, which is meant to happen once per event after
+/// all containers using the arena have been destroyed.
+///
+/// On reset, the blocks used during the last cycle are merged into a single
+/// block large enough to hold the peak usage seen so far, such that after a
+/// few events no upstream allocations happen anymore.
+///
+/// @note The arena is not thread-safe, use one instance per thread.
+class MonotonicArena final : public std::pmr::memory_resource {
+ public:
+  /// Memory usage of the arena
+  struct Statistics {
+    /// bytes handed out since the last reset, including alignment padding
+    std::size_t bytes = 0;
+    /// largest number of bytes handed out within one cycle
+    std::size_t peakBytes = 0;
+    /// total size of the blocks owned by the arena
+    std::size_t capacity = 0;
+    /// number of allocations from the upstream resource since the last reset
+    std::size_t upstreamAllocations = 0;
+  };
+
+  /// @param initialSize size of the first block in bytes
+  /// @param upstream resource to obtain the blocks from
+  explicit MonotonicArena(
+      std::size_t initialSize = 0,
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  ~MonotonicArena() override;
+
+  /// Release all allocations and prepare the arena for the next cycle
+  ///
+  /// @warning Memory handed out before is invalidated, containers using the
+  ///          arena have to be destroyed before.
+  void reset();
+
+  /// Bytes handed out since the last reset
+  std::size_t bytes() const { return m_bytes; }
+
+  /// Largest number of bytes handed out within one cycle
+  std::size_t peakBytes() const { return m_peakBytes; }
+
+  /// Total size of the blocks owned by the arena
+  std::size_t capacity() const { return m_capacity; }
+
+  /// Current memory usage of the arena
+  Statistics statistics() const;
+
+ private:
+  struct Block {
+    std::byte* data = nullptr;
+    std::size_t size = 0;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  void do_deallocate(void* /*p*/, std::size_t /*bytes*/,
+                     std::size_t /*alignment*/) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  /// Add a block of at least @p size bytes and make it the current one
+  void addBlock(std::size_t size);
+
+  /// Give all blocks back to the upstream resource
+  void releaseBlocks();
+
+  std::pmr::memory_resource* m_upstream;
+  std::vector<Block> m_blocks;
+  /// offset of the next free byte in the last block
+  std::size_t m_offset = 0;
+
+  std::size_t m_bytes = 0;
+  std::size_t m_peakBytes = 0;
+  std::size_t m_capacity = 0;
+  std::size_t m_upstreamAllocations = 0;
+};
+
+}  // namespace Acts
@@ -0,0 +1,96 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Acts {
+
+/// Function running a number of independent tasks
+///
+/// It is called with the number of tasks and a function which has to be
+/// invoked exactly once for every task index in [0, nTasks). The tasks can
+/// run concurrently, the call returns when all of them are done. This allows
+/// to plug the thread pool of a framework into Core algorithms.
+using TaskExecutor = std::function<void(
+    std::size_t nTasks, const std::function<void(std::size_t)>& task)>;
+
+/// Run the tasks one after the other in the calling thread
+struct SequentialTaskExecutor {
+  void operator()(std::size_t nTasks,
+                  const std::function<void(std::size_t)>& task) const {
+    for (std::size_t i = 0; i < nTasks; ++i) {
+      task(i);
+    }
+  }
+};
+
+/// Run the tasks on a number of threads
+///
+/// The threads take the next pending task from a shared counter, such that
+/// threads which finish early take over the remaining tasks. This balances
+/// tasks of very different duration without any locking. The calling thread
+/// works on the tasks as well. The first exception thrown by a task is
+/// rethrown after all threads have finished.
+class ThreadTaskExecutor {
+ public:
+  /// @param numThreads the number of threads including the calling thread
+  explicit ThreadTaskExecutor(
+      std::size_t numThreads = std::thread::hardware_concurrency())
+      : m_numThreads{std::max<std::size_t>(numThreads, 1)} {}
+
+  void operator()(std::size_t nTasks,
+                  const std::function<void(std::size_t)>& task) const {
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto work = [&]() {
+      for (std::size_t i = next++; i < nTasks; i = next++) {
+        try {
+          task(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(exceptionMutex);
+          if (not exception) {
+            exception = std::current_exception();
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    const std::size_t nThreads = std::min(m_numThreads, nTasks);
+    for (std::size_t i = 1; i < nThreads; ++i) {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  /// The number of threads including the calling thread
+  std::size_t numThreads() const { return m_numThreads; }
+
+ private:
+  std::size_t m_numThreads;
+};
+
+}  // namespace Acts
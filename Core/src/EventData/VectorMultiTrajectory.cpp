@@ -220,6 +220,14 @@ void detail_vmt::VectorMultiTrajectoryBase::Statistics::toStream(
     }
     p("total", total / 1024 / 1024, "M");
   }
+
+  if (arena) {
+    os << "arena:" << std::endl;
+    p("bytes", static_cast<double>(arena->bytes) / 1024 / 1024, "M");
+    p("peakBytes", static_cast<double>(arena->peakBytes) / 1024 / 1024, "M");
+    p("capacity", static_cast<double>(arena->capacity) / 1024 / 1024, "M");
+    p("upstreamAllocations", arena->upstreamAllocations);
+  }
 }
 
 }  // namespace Acts
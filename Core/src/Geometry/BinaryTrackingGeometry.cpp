@@ -0,0 +1,1615 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Geometry/BinaryTrackingGeometry.hpp"
+
+#include "Acts/Geometry/BoundarySurfaceFace.hpp"
+#include "Acts/Geometry/ConeLayer.hpp"
+#include "Acts/Geometry/ConeVolumeBounds.hpp"
+#include "Acts/Geometry/CuboidVolumeBounds.hpp"
+#include "Acts/Geometry/CutoutCylinderVolumeBounds.hpp"
+#include "Acts/Geometry/CylinderLayer.hpp"
+#include "Acts/Geometry/CylinderVolumeBounds.hpp"
+#include "Acts/Geometry/DiscLayer.hpp"
+#include "Acts/Geometry/GenericApproachDescriptor.hpp"
+#include "Acts/Geometry/GenericCuboidVolumeBounds.hpp"
+#include "Acts/Geometry/GeometryIdentifier.hpp"
+#include "Acts/Geometry/NavigationLayer.hpp"
+#include "Acts/Geometry/PlaneLayer.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Geometry/TrackingVolume.hpp"
+#include "Acts/Geometry/TrapezoidVolumeBounds.hpp"
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
+#include "Acts/Material/HomogeneousVolumeMaterial.hpp"
+#include "Acts/Material/ProtoSurfaceMaterial.hpp"
+#include "Acts/Material/ProtoVolumeMaterial.hpp"
+#include "Acts/Surfaces/AnnulusBounds.hpp"
+#include "Acts/Surfaces/ConeSurface.hpp"
+#include "Acts/Surfaces/ConvexPolygonBounds.hpp"
+#include "Acts/Surfaces/CylinderSurface.hpp"
+#include "Acts/Surfaces/DiamondBounds.hpp"
+#include "Acts/Surfaces/DiscSurface.hpp"
+#include "Acts/Surfaces/DiscTrapezoidBounds.hpp"
+#include "Acts/Surfaces/EllipseBounds.hpp"
+#include "Acts/Surfaces/LineBounds.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/RadialBounds.hpp"
+#include "Acts/Surfaces/RectangleBounds.hpp"
+#include "Acts/Surfaces/StrawSurface.hpp"
+#include "Acts/Surfaces/SurfaceArray.hpp"
+#include "Acts/Surfaces/TrapezoidBounds.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/BinnedArrayXD.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/detail/Axis.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using Section = Acts::BinaryTrackingGeometrySection;
+using Header = Acts::BinaryTrackingGeometryHeader;
+using BoundarySurface = Acts::BoundarySurfaceT<Acts::TrackingVolume>;
+
+/// Marker for an absent object
+constexpr std::uint64_t kNone = std::numeric_limits<std::uint64_t>::max();
+
+/// Contiguous entries of one of the pool sections
+struct Range {
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+};
+
+struct SurfaceRecord {
+  std::uint64_t geometryId = 0;
+  std::uint32_t type = 0;
+  std::uint32_t boundsType = 0;
+  /// bound values in the value pool
+  Range bounds;
+  /// 4x4 transform matrix in the value pool
+  std::uint64_t transform = 0;
+  std::uint64_t material = kNone;
+  /// the layer represented by this surface
+  std::uint64_t layer = kNone;
+};
+
+enum class MaterialType : std::uint32_t {
+  HomogeneousSurface = 0,
+  BinnedSurface = 1,
+  ProtoSurface = 2,
+  HomogeneousVolume = 3,
+  ProtoVolume = 4,
+};
+
+struct MaterialRecord {
+  std::uint32_t type = 0;
+  std::int32_t mappingType = 0;
+  double splitFactor = 0.;
+  std::uint64_t binUtility = kNone;
+  /// dimensions of the slab matrix
+  std::uint64_t nRows = 0;
+  std::uint64_t nColumns = 0;
+  /// material parameters and thickness of all slabs in the value pool
+  Range slabs;
+};
+
+struct BinUtilityRecord {
+  std::uint64_t transform = 0;
+  Range binningData;
+};
+
+struct BinningDataRecord {
+  std::uint32_t type = 0;
+  std::uint32_t option = 0;
+  std::uint32_t value = 0;
+  /// created with the zero dimensional constructor
+  std::uint32_t zeroDimensional = 0;
+  std::uint64_t bins = 0;
+  double min = 0.;
+  double max = 0.;
+  /// boundaries of an arbitrary binning in the value pool
+  Range boundaries;
+};
+
+struct AxisRecord {
+  std::uint32_t equidistant = 0;
+  std::uint32_t boundaryType = 0;
+  std::uint64_t nBins = 0;
+  double min = 0.;
+  double max = 0.;
+  /// bin edges of a variable axis in the value pool
+  Range edges;
+};
+
+struct SurfaceArrayRecord {
+  std::uint32_t binningValue0 = 0;
+  std::uint32_t binningValue1 = 0;
+  std::uint64_t transform = 0;
+  /// the fixed local coordinate of the grid surface
+  double reference = 0.;
+  /// two axis records, none for a single element array
+  Range axes;
+  /// all surfaces of the array in the index pool
+  Range surfaces;
+  /// start of each bin in the bin contents, one more than there are bins
+  Range binOffsets;
+  Range binContents;
+};
+
+enum class LayerShape : std::uint32_t {
+  Cylinder = 0,
+  Disc = 1,
+  Plane = 2,
+  Cone = 3,
+  Navigation = 4,
+};
+
+struct LayerRecord {
+  std::uint32_t shape = 0;
+  std::int32_t layerType = 0;
+  double thickness = 0.;
+  std::uint64_t surface = 0;
+  std::uint64_t surfaceArray = kNone;
+  std::uint32_t hasApproachDescriptor = 0;
+  std::uint32_t reserved = 0;
+  Range approachSurfaces;
+};
+
+struct BinnedArrayRecord {
+  std::uint64_t binUtility = kNone;
+  /// dimensions of the object grid, outermost first
+  std::array<std::uint64_t, 3> gridSize = {1, 1, 1};
+  /// layers or volumes in the index pool, in the order of the array
+  Range objects;
+  /// position of each grid entry in the objects, kNone if empty
+  Range grid;
+};
+
+struct BoundaryRecord {
+  std::uint64_t surface = 0;
+  std::uint64_t oppositeVolume = kNone;
+  std::uint64_t alongVolume = kNone;
+  std::uint64_t oppositeVolumeArray = kNone;
+  std::uint64_t alongVolumeArray = kNone;
+};
+
+struct VolumeRecord {
+  std::uint64_t geometryId = 0;
+  std::uint32_t boundsType = 0;
+  std::uint32_t reserved = 0;
+  Range bounds;
+  std::uint64_t transform = 0;
+  Range name;
+  std::uint64_t material = kNone;
+  std::uint64_t layers = kNone;
+  std::uint64_t volumes = kNone;
+  /// one boundary per face in the index pool
+  Range boundaries;
+};
+
+/// Size of the entries of each section
+constexpr std::array<std::size_t, Header::kNSections> kEntrySize = {
+    sizeof(double),           sizeof(std::uint64_t),
+    sizeof(char),             sizeof(SurfaceRecord),
+    sizeof(MaterialRecord),   sizeof(BinUtilityRecord),
+    sizeof(BinningDataRecord), sizeof(AxisRecord),
+    sizeof(SurfaceArrayRecord), sizeof(LayerRecord),
+    sizeof(BinnedArrayRecord), sizeof(BoundaryRecord),
+    sizeof(VolumeRecord)};
+
+constexpr std::size_t kTransformSize = 16;
+constexpr std::size_t kSlabSize = 6;
+
+/// The local grid coordinates used by the SurfaceArrayCreator
+bool isCylinderGrid(Acts::BinningValue bValue0, Acts::BinningValue bValue1) {
+  return bValue0 == Acts::binPhi and bValue1 == Acts::binZ;
+}
+
+bool isDiscGrid(Acts::BinningValue bValue0, Acts::BinningValue bValue1) {
+  return bValue0 == Acts::binR and bValue1 == Acts::binPhi;
+}
+
+/// Surface and bounds type combinations that can be written
+bool isSupported(Acts::Surface::SurfaceType type,
+                 Acts::SurfaceBounds::BoundsType bounds) {
+  using Bounds = Acts::SurfaceBounds;
+  switch (type) {
+    case Acts::Surface::Cone:
+      return bounds == Bounds::eCone;
+    case Acts::Surface::Cylinder:
+      return bounds == Bounds::eCylinder;
+    case Acts::Surface::Disc:
+      return bounds == Bounds::eDisc or bounds == Bounds::eDiscTrapezoid or
+             bounds == Bounds::eAnnulus or bounds == Bounds::eBoundless;
+    case Acts::Surface::Perigee:
+      return bounds == Bounds::eBoundless;
+    case Acts::Surface::Plane:
+      return bounds == Bounds::eRectangle or bounds == Bounds::eTrapezoid or
+             bounds == Bounds::eDiamond or bounds == Bounds::eEllipse or
+             bounds == Bounds::eConvexPolygon or bounds == Bounds::eBoundless;
+    case Acts::Surface::Straw:
+      return bounds == Bounds::eLine or bounds == Bounds::eBoundless;
+    default:
+      return false;
+  }
+}
+
+/// Collects the records of a tracking geometry
+class Writer {
+ public:
+  explicit Writer(const Acts::GeometryContext& gctx) : m_gctx(gctx) {}
+
+  /// Add the volume tree below @p world, including all boundaries
+  void add(const Acts::TrackingVolume& world) {
+    m_world = volume(world);
+    // the boundaries may point to any volume of the tree
+    for (std::size_t iv = 0; iv < m_volumeObjects.size(); ++iv) {
+      std::vector<std::uint64_t> boundaries;
+      for (const auto& bs : m_volumeObjects[iv]->boundarySurfaces()) {
+        boundaries.push_back(boundary(*bs));
+      }
+      m_volumes[iv].boundaries = indices(boundaries);
+    }
+  }
+
+  void write(const std::string& path) const {
+    Header header;
+    header.worldVolume = m_world;
+    const std::array<std::pair<const char*, std::size_t>, Header::kNSections>
+        sections = {bytes(m_values),       bytes(m_indices),
+                    bytes(m_names),        bytes(m_surfaces),
+                    bytes(m_materials),    bytes(m_binUtilities),
+                    bytes(m_binningData),  bytes(m_axes),
+                    bytes(m_surfaceArrays), bytes(m_layers),
+                    bytes(m_binnedArrays), bytes(m_boundaries),
+                    bytes(m_volumes)};
+    // align the sections to a cache line
+    std::uint64_t offset = sizeof(header);
+    for (std::size_t is = 0; is < sections.size(); ++is) {
+      offset = (offset + 63) / 64 * 64;
+      header.sectionOffset[is] = offset;
+      header.sectionSize[is] = sections[is].second / kEntrySize[is];
+      offset += sections[is].second;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (not out) {
+      throw std::runtime_error("Could not open binary tracking geometry '" +
+                               path + "'");
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t position = sizeof(header);
+    const std::vector<char> padding(64, 0);
+    for (std::size_t is = 0; is < sections.size(); ++is) {
+      out.write(padding.data(), header.sectionOffset[is] - position);
+      out.write(sections[is].first, sections[is].second);
+      position = header.sectionOffset[is] + sections[is].second;
+    }
+    if (not out) {
+      throw std::runtime_error("Could not write binary tracking geometry '" +
+                               path + "'");
+    }
+  }
+
+ private:
+  template <typename entry_t>
+  static std::pair<const char*, std::size_t> bytes(
+      const std::vector<entry_t>& entries) {
+    return {reinterpret_cast<const char*>(entries.data()),
+            entries.size() * sizeof(entry_t)};
+  }
+
+  template <typename container_t>
+  Range values(const container_t& container) {
+    Range range{m_values.size(), container.size()};
+    m_values.insert(m_values.end(), container.begin(), container.end());
+    return range;
+  }
+
+  Range indices(const std::vector<std::uint64_t>& container) {
+    Range range{m_indices.size(), container.size()};
+    m_indices.insert(m_indices.end(), container.begin(), container.end());
+    return range;
+  }
+
+  std::uint64_t transform(const Acts::Transform3& transform) {
+    const double* data = transform.matrix().data();
+    return values(std::vector<double>(data, data + kTransformSize)).offset;
+  }
+
+  std::uint64_t surface(const Acts::Surface& surface,
+                        std::uint64_t layer = kNone) {
+    if (auto it = m_surfaceIndex.find(&surface); it != m_surfaceIndex.end()) {
+      return it->second;
+    }
+    const auto& bounds = surface.bounds();
+    if (not isSupported(surface.type(), bounds.type())) {
+      throw std::invalid_argument(
+          "Surface " + std::to_string(surface.geometryId().value()) +
+          " has an unsupported surface or bounds type");
+    }
+    SurfaceRecord record;
+    record.geometryId = surface.geometryId().value();
+    record.type = surface.type();
+    record.boundsType = bounds.type();
+    record.bounds = values(bounds.values());
+    record.transform = transform(surface.transform(m_gctx));
+    if (surface.surfaceMaterial() != nullptr) {
+      record.material = surfaceMaterial(*surface.surfaceMaterial());
+    }
+    record.layer = layer;
+    std::uint64_t index = m_surfaces.size();
+    m_surfaces.push_back(record);
+    m_surfaceIndex.emplace(&surface, index);
+    return index;
+  }
+
+  Range slabs(const std::vector<Acts::MaterialSlab>& slabs) {
+    std::vector<double> slabValues;
+    for (const auto& slab : slabs) {
+      auto parameters = slab.material().parameters();
+      slabValues.insert(slabValues.end(), parameters.begin(), parameters.end());
+      slabValues.push_back(slab.thickness());
+    }
+    return values(slabValues);
+  }
+
+  std::uint64_t surfaceMaterial(const Acts::ISurfaceMaterial& material) {
+    if (auto it = m_materialIndex.find(&material);
+        it != m_materialIndex.end()) {
+      return it->second;
+    }
+    MaterialRecord record;
+    record.mappingType = material.mappingType();
+    record.splitFactor = material.factor(Acts::NavigationDirection::Backward,
+                                         Acts::MaterialUpdateStage::PreUpdate);
+    if (const auto* homogeneous =
+            dynamic_cast<const Acts::HomogeneousSurfaceMaterial*>(&material);
+        homogeneous != nullptr) {
+      record.type =
+          static_cast<std::uint32_t>(MaterialType::HomogeneousSurface);
+      record.nRows = 1;
+      record.nColumns = 1;
+      record.slabs = slabs({homogeneous->materialSlab(Acts::Vector2(0., 0.))});
+    } else if (const auto* binned =
+                   dynamic_cast<const Acts::BinnedSurfaceMaterial*>(&material);
+               binned != nullptr) {
+      record.type = static_cast<std::uint32_t>(MaterialType::BinnedSurface);
+      record.binUtility = binUtility(binned->binUtility());
+      const auto& matrix = binned->fullMaterial();
+      std::vector<Acts::MaterialSlab> all;
+      record.nRows = matrix.size();
+      record.nColumns = matrix.empty() ? 0 : matrix.front().size();
+      for (const auto& row : matrix) {
+        if (row.size() != record.nColumns) {
+          throw std::invalid_argument("Binned surface material with rows of "
+                                      "different length");
+        }
+        all.insert(all.end(), row.begin(), row.end());
+      }
+      record.slabs = slabs(all);
+    } else if (const auto* proto =
+                   dynamic_cast<const Acts::ProtoSurfaceMaterial*>(&material);
+               proto != nullptr) {
+      record.type = static_cast<std::uint32_t>(MaterialType::ProtoSurface);
+      record.binUtility = binUtility(proto->binUtility());
+    } else {
+      throw std::invalid_argument("Unsupported surface material type");
+    }
+    std::uint64_t index = m_materials.size();
+    m_materials.push_back(record);
+    m_materialIndex.emplace(&material, index);
+    return index;
+  }
+
+  std::uint64_t volumeMaterial(const Acts::IVolumeMaterial& material) {
+    if (auto it = m_materialIndex.find(&material);
+        it != m_materialIndex.end()) {
+      return it->second;
+    }
+    MaterialRecord record;
+    if (const auto* homogeneous =
+            dynamic_cast<const Acts::HomogeneousVolumeMaterial*>(&material);
+        homogeneous != nullptr) {
+      record.type = static_cast<std::uint32_t>(MaterialType::HomogeneousVolume);
+      record.nRows = 1;
+      record.nColumns = 1;
+      record.slabs = slabs({Acts::MaterialSlab(
+          homogeneous->material(Acts::Vector3::Zero()), 0.)});
+    } else if (const auto* proto =
+                   dynamic_cast<const Acts::ProtoVolumeMaterial*>(&material);
+               proto != nullptr) {
+      record.type = static_cast<std::uint32_t>(MaterialType::ProtoVolume);
+      record.binUtility = binUtility(proto->binUtility());
+    } else {
+      throw std::invalid_argument("Unsupported volume material type");
+    }
+    std::uint64_t index = m_materials.size();
+    m_materials.push_back(record);
+    m_materialIndex.emplace(&material, index);
+    return index;
+  }
+
+  std::uint64_t binUtility(const Acts::BinUtility& binUtility) {
+    BinUtilityRecord record;
+    record.transform = transform(binUtility.transform());
+    record.binningData.offset = m_binningData.size();
+    for (const auto& data : binUtility.binningData()) {
+      if (data.subBinningData) {
+        throw std::invalid_argument("Sub binning is not supported");
+      }
+      const auto& boundaries = data.boundaries();
+      BinningDataRecord dRecord;
+      dRecord.type = data.type;
+      dRecord.option = data.option;
+      dRecord.value = data.binvalue;
+      dRecord.zeroDimensional =
+          (data.type == Acts::equidistant and data.option == Acts::open and
+           data.bins() == 1 and boundaries.size() == 2 and
+           boundaries[1] == data.max);
+      dRecord.bins = data.bins();
+      dRecord.min = data.min;
+      dRecord.max = data.max;
+      if (data.type == Acts::arbitrary) {
+        dRecord.boundaries = values(boundaries);
+      }
+      m_binningData.push_back(dRecord);
+    }
+    record.binningData.size = binUtility.binningData().size();
+    std::uint64_t index = m_binUtilities.size();
+    m_binUtilities.push_back(record);
+    return index;
+  }
+
+  std::uint64_t surfaceArray(const Acts::SurfaceArray& surfaceArray) {
+    SurfaceArrayRecord record;
+    record.transform = transform(surfaceArray.transform());
+    std::vector<std::uint64_t> surfaces;
+    for (const auto* s : surfaceArray.surfaces()) {
+      surfaces.push_back(surface(*s));
+    }
+    record.surfaces = indices(surfaces);
+
+    auto axes = surfaceArray.getAxes();
+    if (not axes.empty()) {
+      auto bValues = surfaceArray.binningValues();
+      if (axes.size() != 2 or bValues.size() != 2) {
+        throw std::invalid_argument(
+            "Only single element and two-dimensional surface arrays with "
+            "binning values are supported");
+      }
+      record.binningValue0 = bValues[0];
+      record.binningValue1 = bValues[1];
+      record.axes.offset = m_axes.size();
+      record.axes.size = axes.size();
+      for (const auto* axis : axes) {
+        AxisRecord aRecord;
+        aRecord.equidistant = axis->isEquidistant();
+        aRecord.boundaryType = static_cast<std::uint32_t>(
+            axis->getBoundaryType());
+        aRecord.nBins = axis->getNBins();
+        aRecord.min = axis->getMin();
+        aRecord.max = axis->getMax();
+        if (not axis->isEquidistant()) {
+          aRecord.edges = values(axis->getBinEdges());
+        }
+        m_axes.push_back(aRecord);
+      }
+
+      std::vector<std::uint64_t> offsets;
+      std::vector<std::uint64_t> contents;
+      for (std::size_t bin = 0; bin < surfaceArray.size(); ++bin) {
+        offsets.push_back(contents.size());
+        for (const auto* s : surfaceArray.at(bin)) {
+          contents.push_back(surface(*s));
+        }
+        if (record.reference == 0. and surfaceArray.isValidBin(bin)) {
+          Acts::Vector3 center =
+              surfaceArray.transform() * surfaceArray.getBinCenter(bin);
+          record.reference = isCylinderGrid(bValues[0], bValues[1])
+                                 ? Acts::VectorHelpers::perp(center)
+                                 : center.z();
+        }
+      }
+      offsets.push_back(contents.size());
+      record.binOffsets = indices(offsets);
+      record.binContents = indices(contents);
+    }
+    std::uint64_t index = m_surfaceArrays.size();
+    m_surfaceArrays.push_back(record);
+    return index;
+  }
+
+  std::uint64_t layer(const Acts::Layer& layer) {
+    if (auto it = m_layerIndex.find(&layer); it != m_layerIndex.end()) {
+      return it->second;
+    }
+    std::uint64_t index = m_layers.size();
+    m_layers.emplace_back();
+    m_layerIndex.emplace(&layer, index);
+
+    LayerRecord record;
+    record.layerType = layer.layerType();
+    record.thickness = layer.thickness();
+    const Acts::Surface& representation = layer.surfaceRepresentation();
+    if (dynamic_cast<const Acts::NavigationLayer*>(&layer) != nullptr) {
+      record.shape = static_cast<std::uint32_t>(LayerShape::Navigation);
+      record.surface = surface(representation);
+    } else {
+      if (dynamic_cast<const Acts::CylinderLayer*>(&layer) != nullptr) {
+        record.shape = static_cast<std::uint32_t>(LayerShape::Cylinder);
+      } else if (dynamic_cast<const Acts::DiscLayer*>(&layer) != nullptr) {
+        record.shape = static_cast<std::uint32_t>(LayerShape::Disc);
+      } else if (dynamic_cast<const Acts::PlaneLayer*>(&layer) != nullptr) {
+        record.shape = static_cast<std::uint32_t>(LayerShape::Plane);
+      } else if (dynamic_cast<const Acts::ConeLayer*>(&layer) != nullptr) {
+        record.shape = static_cast<std::uint32_t>(LayerShape::Cone);
+      } else {
+        throw std::invalid_argument("Unsupported layer type");
+      }
+      record.surface = surface(representation, index);
+    }
+    if (layer.surfaceArray() != nullptr) {
+      record.surfaceArray = surfaceArray(*layer.surfaceArray());
+    }
+    if (const auto* ad = layer.approachDescriptor(); ad != nullptr) {
+      record.hasApproachDescriptor = 1;
+      std::vector<std::uint64_t> approachSurfaces;
+      for (const auto* s : ad->containedSurfaces()) {
+        approachSurfaces.push_back(surface(*s));
+      }
+      record.approachSurfaces = indices(approachSurfaces);
+    }
+    m_layers[index] = record;
+    return index;
+  }
+
+  template <typename object_t, typename index_f>
+  std::uint64_t binnedArray(const Acts::BinnedArray<object_t>& array,
+                            index_f&& objectIndex) {
+    BinnedArrayRecord record;
+    if (array.binUtility() != nullptr) {
+      record.binUtility = binUtility(*array.binUtility());
+    }
+    const auto& arrayObjects = array.arrayObjects();
+    std::vector<std::uint64_t> objects;
+    for (const auto& object : arrayObjects) {
+      objects.push_back(objectIndex(*object));
+    }
+    const auto& grid = array.objectGrid();
+    record.gridSize = {grid.size(), grid.at(0).size(), grid.at(0).at(0).size()};
+    std::vector<std::uint64_t> entries;
+    for (const auto& grid1 : grid) {
+      for (const auto& grid0 : grid1) {
+        if (grid1.size() != record.gridSize[1] or
+            grid0.size() != record.gridSize[2]) {
+          throw std::invalid_argument("Binned array with irregular grid");
+        }
+        for (const auto& object : grid0) {
+          auto it =
+              std::find(arrayObjects.begin(), arrayObjects.end(), object);
+          if (object != nullptr and it == arrayObjects.end()) {
+            throw std::invalid_argument(
+                "Binned array with objects outside of the array");
+          }
+          entries.push_back(object == nullptr
+                                ? kNone
+                                : std::distance(arrayObjects.begin(), it));
+        }
+      }
+    }
+    record.objects = indices(objects);
+    record.grid = indices(entries);
+    std::uint64_t index = m_binnedArrays.size();
+    m_binnedArrays.push_back(record);
+    return index;
+  }
+
+  std::uint64_t volumeArray(const Acts::TrackingVolumeArray& array) {
+    if (auto it = m_volumeArrayIndex.find(&array);
+        it != m_volumeArrayIndex.end()) {
+      return it->second;
+    }
+    std::uint64_t index = binnedArray(
+        array, [this](const Acts::TrackingVolume& v) { return volume(v); });
+    m_volumeArrayIndex.emplace(&array, index);
+    return index;
+  }
+
+  std::uint64_t volume(const Acts::TrackingVolume& tVolume) {
+    if (auto it = m_volumeIndex.find(&tVolume); it != m_volumeIndex.end()) {
+      return it->second;
+    }
+    if (tVolume.hasBoundingVolumeHierarchy() or
+        not tVolume.denseVolumes().empty()) {
+      throw std::invalid_argument(
+          "Volume '" + tVolume.volumeName() +
+          "' with dense volumes or a bounding volume hierarchy is not "
+          "supported");
+    }
+    const auto& bounds = tVolume.volumeBounds();
+    if (bounds.type() == Acts::VolumeBounds::eOther) {
+      throw std::invalid_argument("Volume '" + tVolume.volumeName() +
+                                  "' has unsupported bounds");
+    }
+    std::uint64_t index = m_volumes.size();
+    m_volumes.emplace_back();
+    m_volumeObjects.push_back(&tVolume);
+    m_volumeIndex.emplace(&tVolume, index);
+
+    VolumeRecord record;
+    record.geometryId = tVolume.geometryId().value();
+    record.boundsType = bounds.type();
+    record.bounds = values(bounds.values());
+    record.transform = transform(tVolume.transform());
+    const std::string& name = tVolume.volumeName();
+    record.name = {m_names.size(), name.size()};
+    m_names.insert(m_names.end(), name.begin(), name.end());
+    if (tVolume.volumeMaterial() != nullptr) {
+      record.material = volumeMaterial(*tVolume.volumeMaterial());
+    }
+    if (tVolume.confinedLayers() != nullptr) {
+      record.layers = binnedArray(
+          *tVolume.confinedLayers(),
+          [this](const Acts::Layer& l) { return layer(l); });
+    }
+    if (tVolume.confinedVolumes() != nullptr) {
+      record.volumes = volumeArray(*tVolume.confinedVolumes());
+    }
+    m_volumes[index] = record;
+    return index;
+  }
+
+  std::uint64_t volumeIndex(const Acts::TrackingVolume* tVolume) const {
+    if (tVolume == nullptr) {
+      return kNone;
+    }
+    auto it = m_volumeIndex.find(tVolume);
+    if (it == m_volumeIndex.end()) {
+      throw std::invalid_argument(
+          "Boundary surface attached to a volume outside of the geometry");
+    }
+    return it->second;
+  }
+
+  std::uint64_t boundary(const BoundarySurface& boundary) {
+    if (auto it = m_boundaryIndex.find(&boundary);
+        it != m_boundaryIndex.end()) {
+      return it->second;
+    }
+    BoundaryRecord record;
+    record.surface = surface(boundary.surfaceRepresentation());
+    record.oppositeVolume = volumeIndex(boundary.oppositeVolume());
+    record.alongVolume = volumeIndex(boundary.alongVolume());
+    if (boundary.oppositeVolumeArray() != nullptr) {
+      record.oppositeVolumeArray = volumeArray(*boundary.oppositeVolumeArray());
+    }
+    if (boundary.alongVolumeArray() != nullptr) {
+      record.alongVolumeArray = volumeArray(*boundary.alongVolumeArray());
+    }
+    std::uint64_t index = m_boundaries.size();
+    m_boundaries.push_back(record);
+    m_boundaryIndex.emplace(&boundary, index);
+    return index;
+  }
+
+  const Acts::GeometryContext& m_gctx;
+  std::uint64_t m_world = 0;
+
+  std::vector<double> m_values;
+  std::vector<std::uint64_t> m_indices;
+  std::vector<char> m_names;
+  std::vector<SurfaceRecord> m_surfaces;
+  std::vector<MaterialRecord> m_materials;
+  std::vector<BinUtilityRecord> m_binUtilities;
+  std::vector<BinningDataRecord> m_binningData;
+  std::vector<AxisRecord> m_axes;
+  std::vector<SurfaceArrayRecord> m_surfaceArrays;
+  std::vector<LayerRecord> m_layers;
+  std::vector<BinnedArrayRecord> m_binnedArrays;
+  std::vector<BoundaryRecord> m_boundaries;
+  std::vector<VolumeRecord> m_volumes;
+
+  std::vector<const Acts::TrackingVolume*> m_volumeObjects;
+  std::unordered_map<const void*, std::uint64_t> m_surfaceIndex;
+  std::unordered_map<const void*, std::uint64_t> m_materialIndex;
+  std::unordered_map<const void*, std::uint64_t> m_layerIndex;
+  std::unordered_map<const void*, std::uint64_t> m_volumeArrayIndex;
+  std::unordered_map<const void*, std::uint64_t> m_volumeIndex;
+  std::unordered_map<const void*, std::uint64_t> m_boundaryIndex;
+};
+
+/// Restores the sensitive surface identifiers stored in the file
+struct StoredIdentifierHook final : public Acts::GeometryIdentifierHook {
+  std::unordered_map<const Acts::Surface*, Acts::GeometryIdentifier>
+      identifiers;
+
+  Acts::GeometryIdentifier decorateIdentifier(
+      Acts::GeometryIdentifier identifier,
+      const Acts::Surface& surface) const final {
+    auto it = identifiers.find(&surface);
+    return it != identifiers.end() ? it->second : identifier;
+  }
+};
+
+/// Call @p func with the grid axis described by @p record
+template <typename func_t>
+auto withAxis(const AxisRecord& record, std::vector<Acts::ActsScalar> edges,
+              func_t&& func) {
+  using Acts::detail::Axis;
+  using Acts::detail::AxisBoundaryType;
+  using Acts::detail::AxisType;
+  auto bType = static_cast<AxisBoundaryType>(record.boundaryType);
+  if (record.equidistant != 0u) {
+    if (bType == AxisBoundaryType::Open) {
+      return func(Axis<AxisType::Equidistant, AxisBoundaryType::Open>(
+          record.min, record.max, record.nBins));
+    } else if (bType == AxisBoundaryType::Bound) {
+      return func(Axis<AxisType::Equidistant, AxisBoundaryType::Bound>(
+          record.min, record.max, record.nBins));
+    }
+    return func(Axis<AxisType::Equidistant, AxisBoundaryType::Closed>(
+        record.min, record.max, record.nBins));
+  }
+  if (bType == AxisBoundaryType::Open) {
+    return func(
+        Axis<AxisType::Variable, AxisBoundaryType::Open>(std::move(edges)));
+  } else if (bType == AxisBoundaryType::Bound) {
+    return func(
+        Axis<AxisType::Variable, AxisBoundaryType::Bound>(std::move(edges)));
+  }
+  return func(
+      Axis<AxisType::Variable, AxisBoundaryType::Closed>(std::move(edges)));
+}
+
+/// Read-only mapping of a file, which is unmapped on destruction
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Could not open binary tracking geometry '" +
+                               path + "': " + std::strerror(errno));
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 ||
+        static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+      ::close(fd);
+      throw std::runtime_error("Binary tracking geometry '" + path +
+                               "' is too small");
+    }
+    m_size = status.st_size;
+    m_mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_mapping == MAP_FAILED) {
+      m_mapping = nullptr;
+      throw std::runtime_error("Could not map binary tracking geometry '" +
+                               path + "': " + std::strerror(errno));
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (m_mapping != nullptr) {
+      ::munmap(m_mapping, m_size);
+    }
+  }
+
+  const unsigned char* data() const {
+    return static_cast<const unsigned char*>(m_mapping);
+  }
+  std::size_t size() const { return m_size; }
+
+ private:
+  void* m_mapping = nullptr;
+  std::size_t m_size = 0;
+};
+
+/// Creates the geometry objects from the mapped records
+class Reader {
+ public:
+  Reader(std::string path, const MappedFile& file)
+      : m_path(std::move(path)), m_data(file.data()) {
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    // validate the header before any record is accessed
+    if (m_header.magic != Header::kMagic) {
+      fail("wrong file type");
+    }
+    if (m_header.byteOrderMark != Header::kByteOrderMark) {
+      fail("written with a different byte order");
+    }
+    if (m_header.version != Header::kVersion) {
+      fail("unsupported version " + std::to_string(m_header.version));
+    }
+    for (std::size_t is = 0; is < Header::kNSections; ++is) {
+      const std::uint64_t offset = m_header.sectionOffset[is];
+      if (offset < sizeof(m_header) or offset > file.size() or
+          m_header.sectionSize[is] > (file.size() - offset) / kEntrySize[is]) {
+        fail("truncated or corrupted section table");
+      }
+    }
+    m_surfaces.resize(size(Section::Surfaces));
+    m_surfaceMaterials.resize(size(Section::Materials));
+    m_volumeMaterials.resize(size(Section::Materials));
+    m_layers.resize(size(Section::Layers));
+    m_layerInProgress.resize(size(Section::Layers), false);
+    m_volumeArrays.resize(size(Section::BinnedArrays));
+    m_boundaries.resize(size(Section::Boundaries));
+    m_volumes.resize(size(Section::Volumes));
+    m_volumeInProgress.resize(size(Section::Volumes), false);
+  }
+
+  std::unique_ptr<const Acts::TrackingGeometry> trackingGeometry(
+      const Acts::Logger& logger) {
+    try {
+      auto world = volume(m_header.worldVolume);
+      for (std::size_t iv = 0; iv < m_volumes.size(); ++iv) {
+        if (m_volumes[iv] == nullptr) {
+          fail("volume " + std::to_string(iv) + " is not in the volume tree");
+        }
+      }
+      // the boundaries of all volumes are set after the volume tree is built
+      for (std::size_t iv = 0; iv < m_volumes.size(); ++iv) {
+        auto record = this->record<VolumeRecord>(Section::Volumes, iv);
+        auto boundaryIndices = indices(record.boundaries);
+        if (boundaryIndices.size() !=
+            m_volumes[iv]->boundarySurfaces().size()) {
+          fail("wrong number of boundaries of volume " + std::to_string(iv));
+        }
+        for (std::size_t ib = 0; ib < boundaryIndices.size(); ++ib) {
+          m_volumes[iv]->updateBoundarySurface(
+              static_cast<Acts::BoundarySurfaceFace>(ib),
+              boundary(boundaryIndices[ib]), false);
+        }
+      }
+
+      StoredIdentifierHook hook;
+      for (std::size_t is = 0; is < m_surfaces.size(); ++is) {
+        if (m_surfaces[is] == nullptr) {
+          fail("surface " + std::to_string(is) + " is not in the geometry");
+        }
+        hook.identifiers.emplace(
+            m_surfaces[is].get(),
+            Acts::GeometryIdentifier(
+                record<SurfaceRecord>(Section::Surfaces, is).geometryId));
+      }
+      auto geometry = std::make_unique<const Acts::TrackingGeometry>(
+          world, nullptr, hook, logger);
+
+      // the closure has to reproduce all stored identifiers
+      for (std::size_t is = 0; is < m_surfaces.size(); ++is) {
+        if (m_surfaces[is]->geometryId().value() !=
+            record<SurfaceRecord>(Section::Surfaces, is).geometryId) {
+          fail("geometry identifier mismatch of surface " +
+               std::to_string(is));
+        }
+      }
+      for (std::size_t iv = 0; iv < m_volumes.size(); ++iv) {
+        if (m_volumes[iv]->geometryId().value() !=
+            record<VolumeRecord>(Section::Volumes, iv).geometryId) {
+          fail("geometry identifier mismatch of volume " + std::to_string(iv));
+        }
+      }
+      ACTS_DEBUG("Read " << m_volumes.size() << " volumes, " << m_layers.size()
+                         << " layers and " << m_surfaces.size()
+                         << " surfaces from '" << m_path << "'");
+      return geometry;
+    } catch (const std::logic_error& e) {
+      // invalid values are rejected by the geometry object constructors
+      fail(e.what());
+    }
+  }
+
+ private:
+  [[noreturn]] void fail(const std::string& reason) const {
+    throw std::runtime_error("Invalid binary tracking geometry '" + m_path +
+                             "': " + reason);
+  }
+
+  std::uint64_t size(Section section) const {
+    return m_header.sectionSize[static_cast<std::size_t>(section)];
+  }
+
+  void checkRange(Section section, const Range& range) const {
+    if (range.offset > size(section) or
+        range.size > size(section) - range.offset) {
+      fail("invalid range");
+    }
+  }
+
+  template <typename record_t>
+  record_t record(Section section, std::uint64_t index) const {
+    if (index >= size(section)) {
+      fail("invalid record index");
+    }
+    record_t record;
+    std::memcpy(&record,
+                m_data + m_header.sectionOffset[static_cast<std::size_t>(
+                             section)] +
+                    index * sizeof(record_t),
+                sizeof(record_t));
+    return record;
+  }
+
+  template <typename entry_t>
+  std::vector<entry_t> pool(Section section, const Range& range) const {
+    checkRange(section, range);
+    std::vector<entry_t> entries(range.size);
+    std::memcpy(entries.data(),
+                m_data +
+                    m_header.sectionOffset[static_cast<std::size_t>(section)] +
+                    range.offset * sizeof(entry_t),
+                range.size * sizeof(entry_t));
+    return entries;
+  }
+
+  std::vector<double> values(const Range& range) const {
+    return pool<double>(Section::Values, range);
+  }
+
+  std::vector<std::uint64_t> indices(const Range& range) const {
+    return pool<std::uint64_t>(Section::Indices, range);
+  }
+
+  Acts::Transform3 transform(std::uint64_t offset) const {
+    auto matrix = values({offset, kTransformSize});
+    Acts::Transform3 transform;
+    transform.matrix() =
+        Eigen::Map<const Acts::ActsMatrix<4, 4>>(matrix.data());
+    return transform;
+  }
+
+  template <typename bounds_t>
+  std::shared_ptr<const bounds_t> bounds(
+      const std::vector<double>& values) const {
+    if (values.size() != bounds_t::eSize) {
+      fail("wrong number of bound values");
+    }
+    std::array<double, bounds_t::eSize> array{};
+    std::copy(values.begin(), values.end(), array.begin());
+    return std::make_shared<const bounds_t>(array);
+  }
+
+  std::shared_ptr<const Acts::PlanarBounds> planarBounds(
+      std::uint32_t type, const std::vector<double>& values) const {
+    switch (type) {
+      case Acts::SurfaceBounds::eRectangle:
+        return bounds<Acts::RectangleBounds>(values);
+      case Acts::SurfaceBounds::eTrapezoid:
+        return bounds<Acts::TrapezoidBounds>(values);
+      case Acts::SurfaceBounds::eDiamond:
+        return bounds<Acts::DiamondBounds>(values);
+      case Acts::SurfaceBounds::eEllipse:
+        return bounds<Acts::EllipseBounds>(values);
+      case Acts::SurfaceBounds::eConvexPolygon: {
+        if (values.size() < 6 or values.size() % 2 != 0) {
+          fail("wrong number of polygon vertices");
+        }
+        std::vector<Acts::Vector2> vertices;
+        for (std::size_t iv = 0; iv < values.size(); iv += 2) {
+          vertices.emplace_back(values[iv], values[iv + 1]);
+        }
+        return std::make_shared<
+            const Acts::ConvexPolygonBounds<Acts::PolygonDynamic>>(vertices);
+      }
+      case Acts::SurfaceBounds::eBoundless:
+        return nullptr;
+      default:
+        fail("invalid bounds of a plane surface");
+    }
+  }
+
+  std::shared_ptr<const Acts::DiscBounds> discBounds(
+      std::uint32_t type, const std::vector<double>& values) const {
+    switch (type) {
+      case Acts::SurfaceBounds::eDisc:
+        return bounds<Acts::RadialBounds>(values);
+      case Acts::SurfaceBounds::eDiscTrapezoid:
+        return bounds<Acts::DiscTrapezoidBounds>(values);
+      case Acts::SurfaceBounds::eAnnulus:
+        return bounds<Acts::AnnulusBounds>(values);
+      case Acts::SurfaceBounds::eBoundless:
+        return nullptr;
+      default:
+        fail("invalid bounds of a disc surface");
+    }
+  }
+
+  std::shared_ptr<const Acts::VolumeBounds> volumeBounds(
+      std::uint32_t type, const std::vector<double>& values) const {
+    switch (type) {
+      case Acts::VolumeBounds::eCone:
+        return bounds<Acts::ConeVolumeBounds>(values);
+      case Acts::VolumeBounds::eCuboid:
+        return bounds<Acts::CuboidVolumeBounds>(values);
+      case Acts::VolumeBounds::eCutoutCylinder:
+        return bounds<Acts::CutoutCylinderVolumeBounds>(values);
+      case Acts::VolumeBounds::eCylinder:
+        return bounds<Acts::CylinderVolumeBounds>(values);
+      case Acts::VolumeBounds::eGenericCuboid:
+        return bounds<Acts::GenericCuboidVolumeBounds>(values);
+      case Acts::VolumeBounds::eTrapezoid:
+        return bounds<Acts::TrapezoidVolumeBounds>(values);
+      default:
+        fail("invalid volume bounds");
+    }
+  }
+
+  std::shared_ptr<Acts::Surface> makeSurface(
+      const SurfaceRecord& record) const {
+    auto sTransform = transform(record.transform);
+    auto sValues = values(record.bounds);
+    const bool boundless = record.boundsType == Acts::SurfaceBounds::eBoundless;
+    switch (record.type) {
+      case Acts::Surface::Cone:
+        return Acts::Surface::makeShared<Acts::ConeSurface>(
+            sTransform, bounds<Acts::ConeBounds>(sValues));
+      case Acts::Surface::Cylinder:
+        return Acts::Surface::makeShared<Acts::CylinderSurface>(
+            sTransform, bounds<Acts::CylinderBounds>(sValues));
+      case Acts::Surface::Disc:
+        return Acts::Surface::makeShared<Acts::DiscSurface>(
+            sTransform, discBounds(record.boundsType, sValues));
+      case Acts::Surface::Perigee:
+        return Acts::Surface::makeShared<Acts::PerigeeSurface>(sTransform);
+      case Acts::Surface::Plane:
+        return Acts::Surface::makeShared<Acts::PlaneSurface>(
+            sTransform, planarBounds(record.boundsType, sValues));
+      case Acts::Surface::Straw:
+        return Acts::Surface::makeShared<Acts::StrawSurface>(
+            sTransform,
+            boundless ? nullptr : bounds<Acts::LineBounds>(sValues));
+      default:
+        fail("invalid surface type");
+    }
+  }
+
+  std::shared_ptr<const Acts::Surface> surface(std::uint64_t index) {
+    if (index >= m_surfaces.size()) {
+      fail("invalid surface index");
+    }
+    if (m_surfaces[index] != nullptr) {
+      return m_surfaces[index];
+    }
+    auto sRecord = record<SurfaceRecord>(Section::Surfaces, index);
+    if (sRecord.layer != kNone) {
+      // the surface is created with its layer
+      layer(sRecord.layer);
+      if (m_surfaces[index] == nullptr) {
+        fail("inconsistent layer surface " + std::to_string(index));
+      }
+      return m_surfaces[index];
+    }
+    auto created = makeSurface(sRecord);
+    if (sRecord.material != kNone) {
+      created->assignSurfaceMaterial(surfaceMaterial(sRecord.material));
+    }
+    m_surfaces[index] = created;
+    return created;
+  }
+
+  Acts::BinningData binningData(const BinningDataRecord& record) const {
+    if (record.type > Acts::arbitrary or record.option > Acts::closed or
+        record.value >= Acts::binValues) {
+      fail("invalid binning data");
+    }
+    auto bValue = static_cast<Acts::BinningValue>(record.value);
+    auto bOption = static_cast<Acts::BinningOption>(record.option);
+    if (record.zeroDimensional != 0u) {
+      return Acts::BinningData(bValue, record.min, record.max);
+    }
+    if (record.type == Acts::equidistant) {
+      if (record.bins == 0) {
+        fail("invalid binning data");
+      }
+      return Acts::BinningData(bOption, bValue, record.bins, record.min,
+                               record.max);
+    }
+    auto boundaries = values(record.boundaries);
+    if (boundaries.size() < 2) {
+      fail("invalid binning data");
+    }
+    return Acts::BinningData(
+        bOption, bValue,
+        std::vector<float>(boundaries.begin(), boundaries.end()));
+  }
+
+  Acts::BinUtility binUtility(std::uint64_t index) const {
+    auto bRecord = record<BinUtilityRecord>(Section::BinUtilities, index);
+    checkRange(Section::BinningData, bRecord.binningData);
+    if (bRecord.binningData.size > 3) {
+      fail("invalid bin utility");
+    }
+    Acts::BinUtility bUtility(transform(bRecord.transform));
+    for (std::uint64_t id = 0; id < bRecord.binningData.size; ++id) {
+      bUtility += Acts::BinUtility(binningData(record<BinningDataRecord>(
+          Section::BinningData, bRecord.binningData.offset + id)));
+    }
+    return bUtility;
+  }
+
+  Acts::MaterialSlabMatrix slabs(const MaterialRecord& record) const {
+    auto slabValues = values(record.slabs);
+    if (record.nRows > slabValues.size() or
+        record.nColumns > slabValues.size() or
+        slabValues.size() != record.nRows * record.nColumns * kSlabSize) {
+      fail("wrong number of material values");
+    }
+    Acts::MaterialSlabMatrix matrix;
+    auto value = slabValues.begin();
+    for (std::uint64_t ir = 0; ir < record.nRows; ++ir) {
+      Acts::MaterialSlabVector row;
+      for (std::uint64_t ic = 0; ic < record.nColumns; ++ic) {
+        Acts::Material::ParametersVector parameters;
+        std::copy(value, value + 5, parameters.begin());
+        row.emplace_back(Acts::Material(parameters), value[5]);
+        value += kSlabSize;
+      }
+      matrix.push_back(std::move(row));
+    }
+    return matrix;
+  }
+
+  std::shared_ptr<const Acts::ISurfaceMaterial> surfaceMaterial(
+      std::uint64_t index) {
+    if (index >= m_surfaceMaterials.size()) {
+      fail("invalid material index");
+    }
+    if (m_surfaceMaterials[index] != nullptr) {
+      return m_surfaceMaterials[index];
+    }
+    auto mRecord = record<MaterialRecord>(Section::Materials, index);
+    auto mappingType = static_cast<Acts::MappingType>(mRecord.mappingType);
+    std::shared_ptr<const Acts::ISurfaceMaterial> material;
+    switch (static_cast<MaterialType>(mRecord.type)) {
+      case MaterialType::HomogeneousSurface: {
+        auto matrix = slabs(mRecord);
+        if (matrix.size() != 1 or matrix.front().size() != 1) {
+          fail("invalid homogeneous material");
+        }
+        material = std::make_shared<const Acts::HomogeneousSurfaceMaterial>(
+            matrix.front().front(), mRecord.splitFactor, mappingType);
+        break;
+      }
+      case MaterialType::BinnedSurface:
+        material = std::make_shared<const Acts::BinnedSurfaceMaterial>(
+            binUtility(mRecord.binUtility), slabs(mRecord),
+            mRecord.splitFactor, mappingType);
+        break;
+      case MaterialType::ProtoSurface:
+        material = std::make_shared<const Acts::ProtoSurfaceMaterial>(
+            binUtility(mRecord.binUtility), mappingType);
+        break;
+      default:
+        fail("invalid surface material");
+    }
+    m_surfaceMaterials[index] = material;
+    return material;
+  }
+
+  std::shared_ptr<const Acts::IVolumeMaterial> volumeMaterial(
+      std::uint64_t index) {
+    if (index >= m_volumeMaterials.size()) {
+      fail("invalid material index");
+    }
+    if (m_volumeMaterials[index] != nullptr) {
+      return m_volumeMaterials[index];
+    }
+    auto mRecord = record<MaterialRecord>(Section::Materials, index);
+    std::shared_ptr<const Acts::IVolumeMaterial> material;
+    switch (static_cast<MaterialType>(mRecord.type)) {
+      case MaterialType::HomogeneousVolume: {
+        auto matrix = slabs(mRecord);
+        if (matrix.size() != 1 or matrix.front().size() != 1) {
+          fail("invalid homogeneous material");
+        }
+        material = std::make_shared<const Acts::HomogeneousVolumeMaterial>(
+            matrix.front().front().material());
+        break;
+      }
+      case MaterialType::ProtoVolume:
+        material = std::make_shared<const Acts::ProtoVolumeMaterial>(
+            binUtility(mRecord.binUtility));
+        break;
+      default:
+        fail("invalid volume material");
+    }
+    m_volumeMaterials[index] = material;
+    return material;
+  }
+
+  std::unique_ptr<Acts::SurfaceArray> surfaceArray(std::uint64_t index) {
+    auto aRecord = record<SurfaceArrayRecord>(Section::SurfaceArrays, index);
+    std::vector<std::shared_ptr<const Acts::Surface>> surfaces;
+    for (auto is : indices(aRecord.surfaces)) {
+      surfaces.push_back(surface(is));
+    }
+    if (aRecord.axes.size == 0) {
+      if (surfaces.size() != 1) {
+        fail("invalid single element surface array");
+      }
+      return std::make_unique<Acts::SurfaceArray>(surfaces.front());
+    }
+
+    checkRange(Section::Axes, aRecord.axes);
+    if (aRecord.axes.size != 2 or aRecord.binningValue0 >= Acts::binValues or
+        aRecord.binningValue1 >= Acts::binValues) {
+      fail("invalid surface array");
+    }
+    std::array<AxisRecord, 2> axes = {
+        record<AxisRecord>(Section::Axes, aRecord.axes.offset),
+        record<AxisRecord>(Section::Axes, aRecord.axes.offset + 1)};
+    std::array<std::vector<Acts::ActsScalar>, 2> edges;
+    for (std::size_t ia = 0; ia < 2; ++ia) {
+      const auto& axis = axes[ia];
+      edges[ia] = values(axis.edges);
+      if (axis.boundaryType > static_cast<std::uint32_t>(
+                                  Acts::detail::AxisBoundaryType::Closed) or
+          axis.nBins == 0 or
+          (axis.equidistant != 0u ? not(axis.max > axis.min)
+                                  : (edges[ia].size() != axis.nBins + 1 or
+                                     not std::is_sorted(edges[ia].begin(),
+                                                        edges[ia].end())))) {
+        fail("invalid surface array axis");
+      }
+    }
+
+    // the local coordinates of the SurfaceArrayCreator
+    auto bValue0 = static_cast<Acts::BinningValue>(aRecord.binningValue0);
+    auto bValue1 = static_cast<Acts::BinningValue>(aRecord.binningValue1);
+    const Acts::Transform3 gTransform = transform(aRecord.transform);
+    const Acts::Transform3 iTransform = gTransform.inverse();
+    const double reference = aRecord.reference;
+    std::function<Acts::Vector2(const Acts::Vector3&)> globalToLocal;
+    std::function<Acts::Vector3(const Acts::Vector2&)> localToGlobal;
+    if (isCylinderGrid(bValue0, bValue1)) {
+      globalToLocal = [gTransform](const Acts::Vector3& pos) {
+        Acts::Vector3 loc = gTransform * pos;
+        return Acts::Vector2(Acts::VectorHelpers::phi(loc), loc.z());
+      };
+      localToGlobal = [iTransform, reference](const Acts::Vector2& loc) {
+        return iTransform * Acts::Vector3(reference * std::cos(loc[0]),
+                                          reference * std::sin(loc[0]),
+                                          loc[1]);
+      };
+    } else if (isDiscGrid(bValue0, bValue1)) {
+      globalToLocal = [gTransform](const Acts::Vector3& pos) {
+        Acts::Vector3 loc = gTransform * pos;
+        return Acts::Vector2(Acts::VectorHelpers::perp(loc),
+                             Acts::VectorHelpers::phi(loc));
+      };
+      localToGlobal = [iTransform, reference](const Acts::Vector2& loc) {
+        return iTransform * Acts::Vector3(loc[0] * std::cos(loc[1]),
+                                          loc[0] * std::sin(loc[1]),
+                                          reference);
+      };
+    } else {
+      globalToLocal = [gTransform](const Acts::Vector3& pos) {
+        Acts::Vector3 loc = gTransform * pos;
+        return Acts::Vector2(loc.x(), loc.y());
+      };
+      localToGlobal = [iTransform, reference](const Acts::Vector2& loc) {
+        return iTransform * Acts::Vector3(loc.x(), loc.y(), reference);
+      };
+    }
+
+    using ISGL = Acts::SurfaceArray::ISurfaceGridLookup;
+    std::unique_ptr<ISGL> lookup = withAxis(
+        axes[0], edges[0], [&](auto axis0) -> std::unique_ptr<ISGL> {
+          return withAxis(
+              axes[1], edges[1], [&](auto axis1) -> std::unique_ptr<ISGL> {
+                using SGL =
+                    Acts::SurfaceArray::SurfaceGridLookup<decltype(axis0),
+                                                          decltype(axis1)>;
+                return std::make_unique<SGL>(
+                    globalToLocal, localToGlobal,
+                    std::make_tuple(std::move(axis0), std::move(axis1)),
+                    std::vector<Acts::BinningValue>{bValue0, bValue1});
+              });
+        });
+
+    auto offsets = indices(aRecord.binOffsets);
+    auto contents = indices(aRecord.binContents);
+    if (offsets.size() != lookup->size() + 1 or offsets.front() != 0 or
+        offsets.back() != contents.size() or
+        not std::is_sorted(offsets.begin(), offsets.end())) {
+      fail("invalid surface array bins");
+    }
+    for (std::size_t bin = 0; bin < lookup->size(); ++bin) {
+      auto& binContent = lookup->lookup(bin);
+      for (auto ic = offsets[bin]; ic < offsets[bin + 1]; ++ic) {
+        binContent.push_back(surface(contents[ic]).get());
+      }
+    }
+    // populates the neighbor map from the bin contents
+    lookup->fill(Acts::GeometryContext(), {});
+    return std::make_unique<Acts::SurfaceArray>(
+        std::move(lookup), std::move(surfaces), gTransform);
+  }
+
+  Acts::LayerPtr layer(std::uint64_t index) {
+    if (index >= m_layers.size()) {
+      fail("invalid layer index");
+    }
+    if (m_layers[index] != nullptr) {
+      return m_layers[index];
+    }
+    if (m_layerInProgress[index]) {
+      fail("cyclic reference of layer " + std::to_string(index));
+    }
+    m_layerInProgress[index] = true;
+
+    auto lRecord = record<LayerRecord>(Section::Layers, index);
+    auto sRecord = record<SurfaceRecord>(Section::Surfaces, lRecord.surface);
+    auto shape = static_cast<LayerShape>(lRecord.shape);
+    if ((shape == LayerShape::Navigation) != (sRecord.layer == kNone) or
+        (shape != LayerShape::Navigation and sRecord.layer != index)) {
+      fail("inconsistent surface of layer " + std::to_string(index));
+    }
+    if (lRecord.layerType < Acts::navigation or
+        lRecord.layerType > Acts::active) {
+      fail("invalid layer type");
+    }
+    auto layerType = static_cast<Acts::LayerType>(lRecord.layerType);
+
+    if (shape == LayerShape::Navigation) {
+      auto created = Acts::NavigationLayer::create(surface(lRecord.surface),
+                                                   lRecord.thickness);
+      m_layers[index] = created;
+      return created;
+    }
+
+    std::unique_ptr<Acts::SurfaceArray> sArray = nullptr;
+    if (lRecord.surfaceArray != kNone) {
+      sArray = surfaceArray(lRecord.surfaceArray);
+    }
+    std::unique_ptr<Acts::ApproachDescriptor> ad = nullptr;
+    if (lRecord.hasApproachDescriptor != 0u) {
+      std::vector<std::shared_ptr<const Acts::Surface>> approachSurfaces;
+      for (auto is : indices(lRecord.approachSurfaces)) {
+        approachSurfaces.push_back(surface(is));
+      }
+      ad = std::make_unique<Acts::GenericApproachDescriptor>(
+          std::move(approachSurfaces));
+    }
+    auto lTransform = transform(sRecord.transform);
+    auto lValues = values(sRecord.bounds);
+    Acts::MutableLayerPtr created;
+    switch (shape) {
+      case LayerShape::Cylinder:
+        if (sRecord.type != Acts::Surface::Cylinder) {
+          fail("invalid cylinder layer");
+        }
+        created = Acts::CylinderLayer::create(
+            lTransform, bounds<Acts::CylinderBounds>(lValues),
+            std::move(sArray), lRecord.thickness, std::move(ad), layerType);
+        break;
+      case LayerShape::Disc: {
+        auto dBounds = sRecord.type == Acts::Surface::Disc
+                           ? discBounds(sRecord.boundsType, lValues)
+                           : nullptr;
+        if (dBounds == nullptr) {
+          fail("invalid disc layer");
+        }
+        created = Acts::DiscLayer::create(lTransform, dBounds,
+                                          std::move(sArray), lRecord.thickness,
+                                          std::move(ad), layerType);
+        break;
+      }
+      case LayerShape::Plane: {
+        auto pBounds = sRecord.type == Acts::Surface::Plane
+                           ? planarBounds(sRecord.boundsType, lValues)
+                           : nullptr;
+        if (pBounds == nullptr) {
+          fail("invalid plane layer");
+        }
+        created = Acts::PlaneLayer::create(lTransform, pBounds,
+                                           std::move(sArray), lRecord.thickness,
+                                           std::move(ad), layerType);
+        break;
+      }
+      case LayerShape::Cone:
+        if (sRecord.type != Acts::Surface::Cone) {
+          fail("invalid cone layer");
+        }
+        created = Acts::ConeLayer::create(
+            lTransform, bounds<Acts::ConeBounds>(lValues), std::move(sArray),
+            lRecord.thickness, std::move(ad), layerType);
+        break;
+      default:
+        fail("invalid layer shape");
+    }
+    // the layer is its own surface representation
+    auto& representation =
+        const_cast<Acts::Surface&>(created->surfaceRepresentation());
+    if (sRecord.material != kNone) {
+      representation.assignSurfaceMaterial(surfaceMaterial(sRecord.material));
+    }
+    m_surfaces[lRecord.surface] =
+        std::shared_ptr<const Acts::Surface>(created, &representation);
+    m_layers[index] = created;
+    return created;
+  }
+
+  template <typename object_t, typename object_f>
+  std::unique_ptr<Acts::BinnedArrayXD<object_t>> binnedArray(
+      std::uint64_t index, object_f&& object) {
+    auto bRecord = record<BinnedArrayRecord>(Section::BinnedArrays, index);
+    std::vector<object_t> objects;
+    for (auto io : indices(bRecord.objects)) {
+      objects.push_back(object(io));
+    }
+    if (bRecord.binUtility == kNone) {
+      if (objects.size() != 1) {
+        fail("invalid single object binned array");
+      }
+      return std::make_unique<Acts::BinnedArrayXD<object_t>>(objects.front());
+    }
+    auto bUtility = std::make_unique<const Acts::BinUtility>(
+        binUtility(bRecord.binUtility));
+    const auto& gridSize = bRecord.gridSize;
+    auto entries = indices(bRecord.grid);
+    if (gridSize[0] != bUtility->bins(2) or gridSize[1] != bUtility->bins(1) or
+        gridSize[2] != bUtility->bins(0) or
+        entries.size() != gridSize[0] * gridSize[1] * gridSize[2]) {
+      fail("inconsistent binned array grid");
+    }
+    std::vector<std::vector<std::vector<object_t>>> grid(
+        gridSize[0], std::vector<std::vector<object_t>>(
+                         gridSize[1], std::vector<object_t>(gridSize[2])));
+    auto entry = entries.begin();
+    for (auto& grid1 : grid) {
+      for (auto& grid0 : grid1) {
+        for (auto& gridObject : grid0) {
+          if (*entry != kNone) {
+            if (*entry >= objects.size()) {
+              fail("invalid binned array entry");
+            }
+            gridObject = objects[*entry];
+          }
+          ++entry;
+        }
+      }
+    }
+    return std::make_unique<Acts::BinnedArrayXD<object_t>>(
+        grid, std::move(objects), std::move(bUtility));
+  }
+
+  std::shared_ptr<const Acts::TrackingVolumeArray> volumeArray(
+      std::uint64_t index) {
+    if (index >= m_volumeArrays.size()) {
+      fail("invalid binned array index");
+    }
+    if (m_volumeArrays[index] == nullptr) {
+      m_volumeArrays[index] = binnedArray<Acts::TrackingVolumePtr>(
+          index, [this](std::uint64_t iv) { return volume(iv); });
+    }
+    return m_volumeArrays[index];
+  }
+
+  Acts::MutableTrackingVolumePtr volume(std::uint64_t index) {
+    if (index >= m_volumes.size()) {
+      fail("invalid volume index");
+    }
+    if (m_volumes[index] != nullptr) {
+      return m_volumes[index];
+    }
+    if (m_volumeInProgress[index]) {
+      fail("cyclic reference of volume " + std::to_string(index));
+    }
+    m_volumeInProgress[index] = true;
+
+    auto vRecord = record<VolumeRecord>(Section::Volumes, index);
+    auto name = pool<char>(Section::Names, vRecord.name);
+    std::shared_ptr<const Acts::IVolumeMaterial> material = nullptr;
+    if (vRecord.material != kNone) {
+      material = volumeMaterial(vRecord.material);
+    }
+    std::unique_ptr<const Acts::LayerArray> layers = nullptr;
+    if (vRecord.layers != kNone) {
+      layers = binnedArray<Acts::LayerPtr>(
+          vRecord.layers, [this](std::uint64_t il) { return layer(il); });
+    }
+    std::shared_ptr<const Acts::TrackingVolumeArray> volumes = nullptr;
+    if (vRecord.volumes != kNone) {
+      volumes = volumeArray(vRecord.volumes);
+    }
+    auto created = Acts::TrackingVolume::create(
+        transform(vRecord.transform),
+        volumeBounds(vRecord.boundsType, values(vRecord.bounds)),
+        std::move(material), std::move(layers), std::move(volumes), {},
+        std::string(name.begin(), name.end()));
+    m_volumes[index] = created;
+    return created;
+  }
+
+  const Acts::TrackingVolume* attachedVolume(std::uint64_t index) const {
+    if (index == kNone) {
+      return nullptr;
+    }
+    if (index >= m_volumes.size()) {
+      fail("invalid volume index");
+    }
+    return m_volumes[index].get();
+  }
+
+  std::shared_ptr<const BoundarySurface> boundary(std::uint64_t index) {
+    if (index >= m_boundaries.size()) {
+      fail("invalid boundary index");
+    }
+    if (m_boundaries[index] != nullptr) {
+      return m_boundaries[index];
+    }
+    auto bRecord = record<BoundaryRecord>(Section::Boundaries, index);
+    auto created = std::make_shared<BoundarySurface>(
+        surface(bRecord.surface), attachedVolume(bRecord.oppositeVolume),
+        attachedVolume(bRecord.alongVolume));
+    if (bRecord.oppositeVolumeArray != kNone) {
+      created->attachVolumeArray(volumeArray(bRecord.oppositeVolumeArray),
+                                 Acts::NavigationDirection::Backward);
+    }
+    if (bRecord.alongVolumeArray != kNone) {
+      created->attachVolumeArray(volumeArray(bRecord.alongVolumeArray),
+                                 Acts::NavigationDirection::Forward);
+    }
+    m_boundaries[index] = created;
+    return created;
+  }
+
+  std::string m_path;
+  const unsigned char* m_data = nullptr;
+  Header m_header;
+
+  std::vector<std::shared_ptr<const Acts::Surface>> m_surfaces;
+  std::vector<std::shared_ptr<const Acts::ISurfaceMaterial>>
+      m_surfaceMaterials;
+  std::vector<std::shared_ptr<const Acts::IVolumeMaterial>> m_volumeMaterials;
+  std::vector<Acts::LayerPtr> m_layers;
+  std::vector<bool> m_layerInProgress;
+  std::vector<std::shared_ptr<const Acts::TrackingVolumeArray>> m_volumeArrays;
+  std::vector<std::shared_ptr<const BoundarySurface>> m_boundaries;
+  std::vector<Acts::MutableTrackingVolumePtr> m_volumes;
+  std::vector<bool> m_volumeInProgress;
+};
+
+}  // namespace
+
+void Acts::writeBinaryTrackingGeometry(
+    const std::string& path, const GeometryContext& gctx,
+    const TrackingGeometry& trackingGeometry) {
+  Writer writer(gctx);
+  writer.add(*trackingGeometry.highestTrackingVolume());
+  writer.write(path);
+}
+
+std::unique_ptr<const Acts::TrackingGeometry>
+Acts::readBinaryTrackingGeometry(const std::string& path,
+                                 const Logger& logger) {
+  MappedFile file(path);
+  Reader reader(path, file);
+  return reader.trackingGeometry(logger);
+}
@@ -114,9 +114,6 @@ Acts::Layer::compatibleSurfaces(
     return sIntersections;
   }
 
-  // reserve a few bins
-  sIntersections.reserve(20);
-
   // (0) End surface check
   // @todo: - we might be able to skip this by use of options.pathLimit
   // check if you have to stop at the endSurface
@@ -214,8 +211,7 @@ Acts::Layer::compatibleSurfaces(
   if (m_surfaceArray && (options.resolveMaterial || options.resolvePassive ||
                          options.resolveSensitive)) {
     // get the canditates
-    const std::vector<const Surface*>& sensitiveSurfaces =
-        m_surfaceArray->neighbors(position);
+    auto sensitiveSurfaces = m_surfaceArray->neighborRange(position);
     // loop through and veto
     // - if the approach surface is the parameter surface
     // - if the surface is not compatible with the type(s) that are collected
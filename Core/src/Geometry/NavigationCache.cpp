@@ -0,0 +1,588 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Geometry/NavigationCache.hpp"
+
+#include "Acts/Geometry/ApproachDescriptor.hpp"
+#include "Acts/Geometry/Polyhedron.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Surfaces/SurfaceArray.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Intersection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+constexpr std::uint32_t s_uncached = std::numeric_limits<std::uint32_t>::max();
+
+/// Wrap an angle difference into [-pi, pi)
+double wrapPhi(double phi) {
+  return phi - 2 * M_PI * std::floor((phi + M_PI) / (2 * M_PI));
+}
+
+/// Extent of a surface in the frame of a surface array
+struct SurfaceExtent {
+  double phiMin = 0.;
+  double phiLength = 2 * M_PI;
+  double zMin = 0.;
+  double zMax = 0.;
+};
+
+SurfaceExtent surfaceExtent(const Acts::GeometryContext& gctx,
+                            const Acts::Surface& surface,
+                            const Acts::Transform3& transform) {
+  using Acts::VectorHelpers::phi;
+
+  SurfaceExtent extent;
+  extent.zMin = std::numeric_limits<double>::max();
+  extent.zMax = std::numeric_limits<double>::lowest();
+
+  // curved boundaries are approximated by the segments, the pruning
+  // tolerance has to cover the sagitta
+  auto polyhedron = surface.polyhedronRepresentation(gctx, 72);
+  std::vector<double> phis;
+  phis.reserve(polyhedron.vertices.size());
+  for (const auto& vertex : polyhedron.vertices) {
+    Acts::Vector3 local = transform * vertex;
+    phis.push_back(phi(local));
+    extent.zMin = std::min(extent.zMin, local.z());
+    extent.zMax = std::max(extent.zMax, local.z());
+  }
+  if (phis.empty()) {
+    extent.zMin = std::numeric_limits<double>::lowest();
+    extent.zMax = std::numeric_limits<double>::max();
+    return extent;
+  }
+
+  // the phi range is the complement of the largest gap between the vertices
+  std::sort(phis.begin(), phis.end());
+  double maxGap = phis.front() + 2 * M_PI - phis.back();
+  extent.phiMin = phis.front();
+  for (std::size_t i = 1; i < phis.size(); ++i) {
+    double gap = phis[i] - phis[i - 1];
+    if (gap > maxGap) {
+      maxGap = gap;
+      extent.phiMin = phis[i];
+    }
+  }
+  extent.phiLength = 2 * M_PI - maxGap;
+  return extent;
+}
+
+}  // namespace
+
+int Acts::NavigationCache::Axis::cell(double value,
+                                     std::size_t subdivisions) const {
+  if (!(value >= min && value < max)) {
+    return -1;
+  }
+  // same bin search as the surface array axes
+  std::ptrdiff_t bin = 0;
+  double fraction = 0.;
+  if (equidistant) {
+    double position = (value - min) / width;
+    bin = static_cast<std::ptrdiff_t>(std::floor(position));
+    fraction = position - bin;
+  } else {
+    bin = std::distance(edges.begin(),
+                        std::upper_bound(edges.begin(), edges.end(), value)) -
+          1;
+  }
+  if (bin < 0 || bin >= static_cast<std::ptrdiff_t>(nBins())) {
+    return -1;
+  }
+  if (!equidistant) {
+    fraction = (value - edges[bin]) / (edges[bin + 1] - edges[bin]);
+  }
+  auto sub = static_cast<std::ptrdiff_t>(fraction * subdivisions);
+  sub = std::clamp<std::ptrdiff_t>(sub, 0, subdivisions - 1);
+  return static_cast<int>(bin * subdivisions + sub);
+}
+
+Acts::NavigationCache::NavigationCache(const GeometryContext& gctx,
+                                       const TrackingGeometry& tGeometry,
+                                       const Config& cfg,
+                                       std::unique_ptr<const Logger> _logger)
+    : m_cfg(cfg), m_logger(std::move(_logger)) {
+  if (m_cfg.pruningTolerance <= 0.) {
+    throw std::invalid_argument(
+        "NavigationCache: the pruning tolerance has to be positive");
+  }
+  const TrackingVolume* world = tGeometry.highestTrackingVolume();
+  if (world != nullptr) {
+    buildVolume(gctx, *world);
+  }
+  if (m_surfaces.size() >= s_uncached || m_layers.size() >= s_uncached) {
+    throw std::runtime_error("NavigationCache: too many candidates");
+  }
+
+  ACTS_DEBUG("Navigation cache built for "
+             << m_statistics.layers << " layers with "
+             << m_statistics.cachedBins << " cached and "
+             << m_statistics.uncachedBins << " uncached surface bins");
+  ACTS_DEBUG("- " << m_statistics.surfaceCandidates
+                  << " surface candidates stored, "
+                  << m_statistics.prunedCandidates
+                  << " removed by the direction bins");
+}
+
+void Acts::NavigationCache::buildVolume(const GeometryContext& gctx,
+                                        const TrackingVolume& volume) {
+  if (auto confinedVolumes = volume.confinedVolumes()) {
+    for (const auto& cVolume : confinedVolumes->arrayObjects()) {
+      buildVolume(gctx, *cVolume);
+    }
+  }
+  const LayerArray* confinedLayers = volume.confinedLayers();
+  if (confinedLayers == nullptr) {
+    return;
+  }
+
+  const auto volumeId = volume.geometryId().volume();
+  if (m_volumes.size() <= volumeId) {
+    m_volumes.resize(volumeId + 1);
+  }
+  VolumeEntry& vEntry = m_volumes[volumeId];
+  vEntry.volume = &volume;
+
+  // the layers are interlinked in the order of the layer array objects
+  const auto& layers = confinedLayers->arrayObjects();
+  std::size_t maxLayerId = 0;
+  for (const auto& layer : layers) {
+    maxLayerId = std::max<std::size_t>(maxLayerId, layer->geometryId().layer());
+  }
+  vEntry.layers.resize(maxLayerId + 1);
+
+  for (std::size_t il = 0; il < layers.size(); ++il) {
+    LayerEntry& entry = vEntry.layers[layers[il]->geometryId().layer()];
+    if (entry.layer != nullptr) {
+      ACTS_WARNING("Layer identifier " << layers[il]->geometryId()
+                                       << " is not unique, not cached.");
+      entry.layer = nullptr;
+      continue;
+    }
+    entry.layer = layers[il].get();
+    entry.index = il;
+    entry.resolve = entry.layer->resolve(
+        m_cfg.resolveSensitive, m_cfg.resolveMaterial, m_cfg.resolvePassive);
+  }
+
+  for (const auto& layer : layers) {
+    LayerEntry& entry = vEntry.layers[layer->geometryId().layer()];
+    if (entry.layer != layer.get()) {
+      continue;
+    }
+    // the layers met when walking backward (0) and forward (1)
+    for (int dir = 0; dir < 2; ++dir) {
+      const std::ptrdiff_t step = (dir == 0) ? -1 : 1;
+      entry.next[dir].begin = m_layers.size();
+      for (std::ptrdiff_t il = static_cast<std::ptrdiff_t>(entry.index) + step;
+           il >= 0 && il < static_cast<std::ptrdiff_t>(layers.size());
+           il += step) {
+        const Layer& nLayer = *layers[il];
+        if (nLayer.resolve(m_cfg.resolveSensitive, m_cfg.resolveMaterial,
+                           m_cfg.resolvePassive)) {
+          m_layers.push_back(&nLayer);
+        }
+      }
+      entry.next[dir].end = m_layers.size();
+    }
+    buildSurfaceGrid(gctx, entry);
+  }
+}
+
+void Acts::NavigationCache::buildSurfaceGrid(const GeometryContext& gctx,
+                                             LayerEntry& entry) {
+  using VectorHelpers::perp;
+
+  const Layer& layer = *entry.layer;
+  const SurfaceArray* surfaceArray = layer.surfaceArray();
+  const ApproachDescriptor* approachDescriptor = layer.approachDescriptor();
+  // the exhaustive search returns nothing for these, no need to cache
+  if (surfaceArray == nullptr || approachDescriptor == nullptr) {
+    return;
+  }
+  const auto axes = surfaceArray->getAxes();
+  const Surface& layerSurface = layer.surfaceRepresentation();
+  if (axes.size() != 2 || (layerSurface.type() != Surface::Cylinder &&
+                           layerSurface.type() != Surface::Disc)) {
+    ACTS_VERBOSE("Layer " << layer.geometryId()
+                          << " has no 2D cylinder or disc binning, not cached.");
+    return;
+  }
+
+  SurfaceGrid grid;
+  grid.transform = surfaceArray->transform();
+  grid.cylinder = (layerSurface.type() == Surface::Cylinder);
+  grid.subdivisions = std::max<std::size_t>(m_cfg.binSubdivisions, 1);
+  for (auto [iAxis, axis] : {std::make_pair(axes[0], &grid.axis0),
+                             std::make_pair(axes[1], &grid.axis1)}) {
+    axis->equidistant = iAxis->isEquidistant();
+    axis->min = iAxis->getMin();
+    axis->max = iAxis->getMax();
+    axis->width = (axis->max - axis->min) / iAxis->getNBins();
+    for (auto edge : iAxis->getBinEdges()) {
+      axis->edges.push_back(edge);
+    }
+  }
+  const Transform3 itransform = grid.transform.inverse();
+  // the position has to be in the layer to prune in phi
+  double radius = 1.;
+  if (grid.cylinder) {
+    radius =
+        perp(grid.transform * layerSurface.binningPosition(gctx, binR));
+    grid.minRadius = radius - layer.thickness();
+  }
+
+  auto acceptSurface = [&](const Surface& sf, bool sensitive) {
+    if (sensitive && m_cfg.resolveSensitive) {
+      return true;
+    }
+    if (m_cfg.resolveMaterial && sf.surfaceMaterial() != nullptr) {
+      return true;
+    }
+    return m_cfg.resolvePassive;
+  };
+
+  // the approach and layer surfaces are never pruned
+  std::vector<const Surface*> alwaysSurfaces;
+  if (m_cfg.resolveMaterial || m_cfg.resolvePassive) {
+    for (const auto* aSurface : approachDescriptor->containedSurfaces()) {
+      if (acceptSurface(*aSurface, false)) {
+        alwaysSurfaces.push_back(aSurface);
+      }
+    }
+  }
+  if (acceptSurface(layerSurface, false)) {
+    alwaysSurfaces.push_back(&layerSurface);
+  }
+
+  std::unordered_map<const Surface*, SurfaceExtent> extents;
+  std::unordered_set<const SurfaceVector*> seenBins;
+  const std::size_t nSub = grid.subdivisions;
+  const std::size_t nBins0 = grid.axis0.nBins();
+  const std::size_t nBins1 = grid.axis1.nBins();
+  const std::size_t nDirections = grid.nDirections();
+  grid.ranges.resize(nBins0 * nBins1 * nSub * nSub * nDirections);
+  std::size_t cachedBins = 0;
+  std::vector<const Surface*> candidates;
+
+  for (std::size_t i0 = 0; i0 < nBins0; ++i0) {
+    const double low0 = grid.axis0.edges[i0];
+    const double high0 = grid.axis0.edges[i0 + 1];
+    for (std::size_t i1 = 0; i1 < nBins1; ++i1) {
+      const double low1 = grid.axis1.edges[i1];
+      const double high1 = grid.axis1.edges[i1 + 1];
+
+      // the bin is only cached if the surface array sees exactly one bin
+      // for all the positions in it
+      const SurfaceVector* neighbors = nullptr;
+      bool consistent = true;
+      for (double f0 : {0.05, 0.5, 0.95}) {
+        for (double f1 : {0.05, 0.5, 0.95}) {
+          double v0 = low0 + f0 * (high0 - low0);
+          double v1 = low1 + f1 * (high1 - low1);
+          Vector3 local = grid.cylinder
+                              ? Vector3(radius * std::cos(v0),
+                                        radius * std::sin(v0), v1)
+                              : Vector3(v0 * std::cos(v1), v0 * std::sin(v1),
+                                        0.);
+          const SurfaceVector* sampled =
+              &surfaceArray->neighbors(itransform * local);
+          consistent = consistent && (neighbors == nullptr ||
+                                      neighbors == sampled);
+          neighbors = sampled;
+        }
+      }
+      consistent = consistent && seenBins.insert(neighbors).second;
+      if (consistent) {
+        ++cachedBins;
+      } else {
+        ++m_statistics.uncachedBins;
+      }
+
+      // the cells of the bin share the neighbors but prune separately
+      for (std::size_t s0 = 0; s0 < nSub; ++s0) {
+        const double cLow0 = low0 + s0 * (high0 - low0) / nSub;
+        const double cHigh0 = low0 + (s0 + 1) * (high0 - low0) / nSub;
+        for (std::size_t s1 = 0; s1 < nSub; ++s1) {
+          const double cLow1 = low1 + s1 * (high1 - low1) / nSub;
+          const double cHigh1 = low1 + (s1 + 1) * (high1 - low1) / nSub;
+          Range* ranges =
+              &grid.ranges[grid.cell(i0 * nSub + s0, i1 * nSub + s1) *
+                           nDirections];
+          if (!consistent) {
+            for (std::size_t d = 0; d < nDirections; ++d) {
+              ranges[d].begin = s_uncached;
+              ranges[d].end = s_uncached;
+            }
+            continue;
+          }
+
+          const double phiLow = grid.cylinder ? cLow0 : cLow1;
+          const double phiHigh = grid.cylinder ? cHigh0 : cHigh1;
+          const double minRadius = grid.cylinder ? grid.minRadius : cLow0;
+          // minimal angle for a point behind to be beyond the tolerance
+          const double tolPhi =
+              (minRadius > m_cfg.pruningTolerance)
+                  ? std::asin(m_cfg.pruningTolerance / minRadius)
+                  : std::numeric_limits<double>::max();
+
+          for (std::size_t d = 0; d < nDirections; ++d) {
+            const bool phiIncreasing = (d & 1) == 0;
+            const bool zIncreasing = (d & 2) == 0;
+            auto behind = [&](const SurfaceExtent& ext) {
+              // phi is monotonic along a straight line and covers less
+              // than pi
+              double delta =
+                  phiIncreasing
+                      ? wrapPhi(phiLow - ext.phiMin - ext.phiLength)
+                      : wrapPhi(ext.phiMin - phiHigh);
+              if (delta >= tolPhi && delta + ext.phiLength +
+                                             (phiHigh - phiLow) <=
+                                         M_PI - tolPhi) {
+                return true;
+              }
+              if (!grid.cylinder) {
+                return false;
+              }
+              return zIncreasing ? ext.zMax <= cLow1 - m_cfg.pruningTolerance
+                                 : ext.zMin >= cHigh1 + m_cfg.pruningTolerance;
+            };
+
+            candidates = alwaysSurfaces;
+            if (m_cfg.resolveMaterial || m_cfg.resolvePassive ||
+                m_cfg.resolveSensitive) {
+              for (const auto* sSurface : *neighbors) {
+                if (!acceptSurface(*sSurface, true)) {
+                  continue;
+                }
+                if (std::find(alwaysSurfaces.begin(), alwaysSurfaces.end(),
+                              sSurface) == alwaysSurfaces.end()) {
+                  auto it = extents.find(sSurface);
+                  if (it == extents.end()) {
+                    it = extents
+                             .emplace(sSurface,
+                                      surfaceExtent(gctx, *sSurface,
+                                                    grid.transform))
+                             .first;
+                  }
+                  if (behind(it->second)) {
+                    ++m_statistics.prunedCandidates;
+                    continue;
+                  }
+                }
+                candidates.push_back(sSurface);
+              }
+            }
+            // same order as the exhaustive search before sorting by path
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(
+                std::unique(candidates.begin(), candidates.end()),
+                candidates.end());
+
+            ranges[d].begin = m_surfaces.size();
+            m_surfaces.insert(m_surfaces.end(), candidates.begin(),
+                              candidates.end());
+            ranges[d].end = m_surfaces.size();
+            m_statistics.surfaceCandidates += candidates.size();
+          }
+        }
+      }
+    }
+  }
+
+  if (cachedBins == 0) {
+    ACTS_VERBOSE("Layer " << layer.geometryId()
+                          << " does not match the surface array binning.");
+    return;
+  }
+  m_statistics.cachedBins += cachedBins;
+  ++m_statistics.layers;
+  entry.grid = std::move(grid);
+}
+
+const Acts::NavigationCache::LayerEntry* Acts::NavigationCache::layerEntry(
+    const GeometryIdentifier& geoId) const {
+  const auto volumeId = geoId.volume();
+  if (volumeId >= m_volumes.size()) {
+    return nullptr;
+  }
+  const auto& layers = m_volumes[volumeId].layers;
+  const auto layerId = geoId.layer();
+  if (layerId >= layers.size() || layers[layerId].layer == nullptr) {
+    return nullptr;
+  }
+  return &layers[layerId];
+}
+
+bool Acts::NavigationCache::compatibleSurfaces(
+    const GeometryContext& gctx, const Layer& layer, const Vector3& position,
+    const Vector3& direction, const NavigationOptions<Surface>& options,
+    SurfaceCandidates& sIntersections) const {
+  using VectorHelpers::perp;
+  using VectorHelpers::phi;
+
+  // the pruning relies on bounded intersections beyond the overstep limit
+  if (!matches(options.resolveSensitive, options.resolveMaterial,
+               options.resolvePassive) ||
+      !options.boundaryCheck || !options.externalSurfaces.empty() ||
+      -options.overstepLimit >= m_cfg.pruningTolerance) {
+    return false;
+  }
+  const LayerEntry* entry = layerEntry(layer.geometryId());
+  if (entry == nullptr || entry->layer != &layer || entry->grid.ranges.empty()) {
+    return false;
+  }
+
+  // look up the cell
+  const SurfaceGrid& grid = entry->grid;
+  const Vector3 lPosition = grid.transform * position;
+  const Vector3 lDirection =
+      grid.transform.linear() * (options.navDir * direction);
+  int cell0 = -1;
+  int cell1 = -1;
+  if (grid.cylinder) {
+    if (perp(lPosition) < grid.minRadius) {
+      return false;
+    }
+    cell0 = grid.axis0.cell(phi(lPosition), grid.subdivisions);
+    cell1 = grid.axis1.cell(lPosition.z(), grid.subdivisions);
+  } else {
+    cell0 = grid.axis0.cell(perp(lPosition), grid.subdivisions);
+    cell1 = grid.axis1.cell(phi(lPosition), grid.subdivisions);
+  }
+  if (cell0 < 0 || cell1 < 0) {
+    return false;
+  }
+  std::size_t dirBin =
+      (lPosition.x() * lDirection.y() - lPosition.y() * lDirection.x() < 0.)
+          ? 1
+          : 0;
+  if (grid.cylinder && lDirection.z() < 0.) {
+    dirBin += 2;
+  }
+  const Range& range =
+      grid.ranges[grid.cell(cell0, cell1) * grid.nDirections() + dirBin];
+  if (range.begin == s_uncached) {
+    return false;
+  }
+
+  // the path limit as in the exhaustive search
+  double pathLimit = options.pathLimit;
+  double overstepLimit = options.overstepLimit;
+  sIntersections.clear();
+  if (options.endObject != nullptr) {
+    SurfaceIntersection endInter = options.endObject->intersect(
+        gctx, position, options.navDir * direction, BoundaryCheck(true));
+    if (endInter) {
+      pathLimit = endInter.intersection.pathLength;
+    } else {
+      return true;
+    }
+  } else {
+    double pCorrection = layer.surfaceRepresentation().pathCorrection(
+        gctx, position, direction);
+    pathLimit = 1.5 * layer.thickness() * pCorrection * options.navDir;
+  }
+
+  for (std::uint32_t ic = range.begin; ic < range.end; ++ic) {
+    const Surface& sf = *m_surfaces[ic];
+    if (options.startObject == &sf || options.endObject == &sf) {
+      continue;
+    }
+    SurfaceIntersection sfi = sf.intersect(
+        gctx, position, options.navDir * direction, options.boundaryCheck);
+    if (sfi && detail::checkIntersection(sfi.intersection, pathLimit,
+                                         overstepLimit, s_onSurfaceTolerance)) {
+      sfi.intersection.pathLength *= options.navDir;
+      sIntersections.push_back(sfi);
+    }
+  }
+
+  if (options.navDir == NavigationDirection::Forward) {
+    std::sort(sIntersections.begin(), sIntersections.end());
+  } else {
+    std::sort(sIntersections.begin(), sIntersections.end(), std::greater<>());
+  }
+  return true;
+}
+
+bool Acts::NavigationCache::compatibleLayers(
+    const GeometryContext& gctx, const TrackingVolume& volume,
+    const Vector3& position, const Vector3& direction,
+    const NavigationOptions<Layer>& options,
+    LayerCandidates& lIntersections) const {
+  // the walk stops at the end layer which is not part of the tables
+  if (!matches(options.resolveSensitive, options.resolveMaterial,
+               options.resolvePassive) ||
+      options.endObject != nullptr) {
+    return false;
+  }
+  const auto volumeId = volume.geometryId().volume();
+  if (volumeId >= m_volumes.size() || m_volumes[volumeId].volume != &volume) {
+    return false;
+  }
+
+  const Layer* startLayer = options.startObject != nullptr
+                                ? options.startObject
+                                : volume.associatedLayer(gctx, position);
+  const LayerEntry* entry = nullptr;
+  if (startLayer != nullptr) {
+    entry = layerEntry(startLayer->geometryId());
+    if (entry == nullptr || entry->layer != startLayer) {
+      return false;
+    }
+  }
+
+  lIntersections.clear();
+  if (entry == nullptr) {
+    return true;
+  }
+
+  auto testLayer = [&](const Layer& tLayer) {
+    auto atIntersection =
+        tLayer.surfaceOnApproach(gctx, position, direction, options);
+    auto path = atIntersection.intersection.pathLength;
+    bool withinLimit = std::abs(path) <= std::abs(options.pathLimit);
+    if (atIntersection &&
+        (atIntersection.object != options.targetSurface) && withinLimit) {
+      lIntersections.push_back(LayerIntersection(
+          atIntersection.intersection, &tLayer, atIntersection.object));
+    }
+  };
+
+  if (startLayer != options.startObject && entry->resolve) {
+    testLayer(*startLayer);
+  }
+  const BinUtility* binUtility = volume.confinedLayers()->binUtility();
+  if (binUtility != nullptr) {
+    const Range& range =
+        entry->next[binUtility->nextDirection(
+                        position, options.navDir * direction) < 0
+                        ? 0
+                        : 1];
+    for (std::uint32_t il = range.begin; il < range.end; ++il) {
+      testLayer(*m_layers[il]);
+    }
+  }
+
+  if (options.navDir == NavigationDirection::Forward) {
+    std::sort(lIntersections.begin(), lIntersections.end());
+  } else {
+    std::sort(lIntersections.begin(), lIntersections.end(), std::greater<>());
+  }
+  return true;
+}
@@ -572,10 +572,9 @@ Acts::TrackingVolume::compatibleBoundaries(
   processBoundaries(bSurfaces);
 
   // Process potential boundaries of contained volumes
-  auto confinedDenseVolumes = denseVolumes();
-  ACTS_VERBOSE("Volume reports " << confinedDenseVolumes.size()
+  ACTS_VERBOSE("Volume reports " << m_confinedDenseVolumes.size()
                                  << " confined dense volumes");
-  for (const auto& dv : confinedDenseVolumes) {
+  for (const auto& dv : m_confinedDenseVolumes) {
     auto& bSurfacesConfined = dv->boundarySurfaces();
     ACTS_VERBOSE(" -> " << bSurfacesConfined.size() << " boundary surfaces");
     processBoundaries(bSurfacesConfined);
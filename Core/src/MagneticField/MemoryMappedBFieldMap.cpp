@@ -0,0 +1,584 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/MagneticField/MemoryMappedBFieldMap.hpp"
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/MagneticField/MagneticFieldError.hpp"
+#include "Acts/MagneticField/detail/InterpolatedFieldGradient.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// Convert to IEEE half precision with round-to-nearest-even
+std::uint16_t floatToHalf(float value) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const std::uint32_t sign = (bits >> 16) & 0x8000u;
+  const std::uint32_t absBits = bits & 0x7fffffffu;
+
+  if (absBits >= 0x7f800000u) {
+    // infinity or nan, keep nan a quiet nan
+    return sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u);
+  }
+  if (absBits >= 0x477ff000u) {
+    // rounds to a value beyond the largest half
+    return sign | 0x7c00u;
+  }
+  if (absBits < 0x38800000u) {
+    // subnormal half or zero
+    if (absBits < 0x33000000u) {
+      return sign;
+    }
+    const std::uint32_t exponent = absBits >> 23;
+    const std::uint32_t mantissa = (absBits & 0x7fffffu) | 0x800000u;
+    const std::uint32_t shift = 126 - exponent;
+    std::uint32_t half = mantissa >> shift;
+    const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const std::uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1u) != 0)) {
+      ++half;
+    }
+    return sign | half;
+  }
+  // rebias the exponent and round the mantissa from 23 to 10 bits, a carry
+  // into the exponent gives the correctly rounded result
+  std::uint32_t half = (absBits - 0x38000000u) >> 13;
+  const std::uint32_t remainder = absBits & 0x1fffu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0)) {
+    ++half;
+  }
+  return sign | half;
+}
+
+/// Convert from IEEE half precision
+float halfToFloat(std::uint16_t half) {
+  const std::uint32_t sign = (half & 0x8000u) << 16;
+  const std::uint32_t exponent = (half >> 10) & 0x1fu;
+  const std::uint32_t mantissa = half & 0x3ffu;
+  if (exponent == 0) {
+    // zero or subnormal, exactly representable in single precision
+    const float value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -value : value;
+  }
+  std::uint32_t bits = sign | (mantissa << 13);
+  if (exponent == 0x1fu) {
+    bits |= 0x7f800000u;
+  } else {
+    bits |= (exponent + 112) << 23;
+  }
+  float value = 0;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::size_t storageSize(Acts::BFieldMapStorage storage) {
+  switch (storage) {
+    case Acts::BFieldMapStorage::Float64:
+      return sizeof(double);
+    case Acts::BFieldMapStorage::Float32:
+      return sizeof(float);
+    case Acts::BFieldMapStorage::Float16:
+    case Acts::BFieldMapStorage::Fixed16:
+      return sizeof(std::uint16_t);
+  }
+  throw std::invalid_argument("Unknown binary field map storage");
+}
+
+/// Write the header and the node values given in internal units
+void writeNodes(const std::string& path, Acts::BinaryBFieldMapHeader header,
+                const std::vector<double>& values) {
+  using Acts::BFieldMapStorage;
+  const auto storage = static_cast<BFieldMapStorage>(header.storage);
+
+  if (storage == BFieldMapStorage::Fixed16) {
+    double maxAbs = 0.;
+    for (double v : values) {
+      maxAbs = std::max(maxAbs, std::abs(v));
+    }
+    header.fieldScale =
+        maxAbs > 0. ? maxAbs / std::numeric_limits<std::int16_t>::max() : 1.;
+  } else {
+    header.fieldScale = Acts::UnitConstants::T;
+  }
+  // align the values to a cache line
+  header.dataOffset = (sizeof(header) + 63) / 64 * 64;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Could not open binary field map '" + path +
+                             "' for writing");
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  const std::vector<char> padding(header.dataOffset - sizeof(header), 0);
+  out.write(padding.data(), padding.size());
+
+  std::vector<unsigned char> data(values.size() * storageSize(storage));
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const double v = values[i] / header.fieldScale;
+    unsigned char* dst = data.data() + i * storageSize(storage);
+    switch (storage) {
+      case BFieldMapStorage::Float64: {
+        std::memcpy(dst, &v, sizeof(v));
+        break;
+      }
+      case BFieldMapStorage::Float32: {
+        const float f = static_cast<float>(v);
+        std::memcpy(dst, &f, sizeof(f));
+        break;
+      }
+      case BFieldMapStorage::Float16: {
+        const std::uint16_t h = floatToHalf(static_cast<float>(v));
+        std::memcpy(dst, &h, sizeof(h));
+        break;
+      }
+      case BFieldMapStorage::Fixed16: {
+        const auto s = static_cast<std::int16_t>(std::lround(v));
+        std::memcpy(dst, &s, sizeof(s));
+        break;
+      }
+    }
+  }
+  out.write(reinterpret_cast<const char*>(data.data()), data.size());
+  if (!out) {
+    throw std::runtime_error("Could not write binary field map '" + path +
+                             "'");
+  }
+}
+
+/// The field at a global position for the standard transforms of the grid
+/// coordinates, which are the ones the memory-mapped field map applies
+template <typename grid_t>
+Acts::Vector3 standardField(const grid_t& grid, const Acts::Vector3& position) {
+  using Acts::VectorHelpers::perp;
+  if constexpr (grid_t::DIM == 2) {
+    const Acts::Vector2 field =
+        grid.interpolate(Acts::Vector2(perp(position), position.z()));
+    const double r = perp(position);
+    double cosPhi = 1.;
+    double sinPhi = 0.;
+    if (r > std::numeric_limits<double>::min()) {
+      cosPhi = position.x() / r;
+      sinPhi = position.y() / r;
+    }
+    return Acts::Vector3(field[0] * cosPhi, field[0] * sinPhi, field[1]);
+  } else {
+    return grid.interpolate(position);
+  }
+}
+
+/// Check that a field map uses the standard transforms of its coordinate
+/// system, as the transforms themselves can not be stored in the file
+///
+/// The transforms are compared at positions spread over the interpolation
+/// domain, and at their mirror images, which catches e.g. maps of one
+/// octant or half which are mirrored by their transforms.
+template <typename field_t>
+void checkTransforms(const field_t& bField,
+                     Acts::BFieldMapCoordinates coordinates,
+                     const std::array<double, 3>& lowerLeft,
+                     const std::array<double, 3>& upperRight) {
+  const auto& grid = bField.getGrid();
+  constexpr std::size_t DIM = field_t::Grid::DIM;
+  const bool isRZ = coordinates == Acts::BFieldMapCoordinates::RZ;
+
+  auto isInsideStandard = [&](const Acts::Vector3& position) {
+    const Acts::Vector3 gridPos =
+        isRZ ? Acts::Vector3(Acts::VectorHelpers::perp(position),
+                             position.z(), 0.)
+             : position;
+    for (std::size_t i = 0; i < DIM; ++i) {
+      if (gridPos[i] < lowerLeft[i] || gridPos[i] >= upperRight[i]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const std::array<double, 3> fractions = {0.13, 0.49, 0.86};
+  const std::array<double, 3> phis = {0.4, 2.5, -2.};
+  for (double f0 : fractions) {
+    for (double f1 : fractions) {
+      for (std::size_t k = 0; k < fractions.size(); ++k) {
+        Acts::Vector3 local;
+        for (std::size_t i = 0; i < DIM; ++i) {
+          const double f = i == 0 ? f0 : (i == 1 ? f1 : fractions[k]);
+          local[i] = lowerLeft[i] + f * (upperRight[i] - lowerLeft[i]);
+        }
+        const Acts::Vector3 position =
+            isRZ ? Acts::Vector3(local[0] * std::cos(phis[k]),
+                                 local[0] * std::sin(phis[k]), local[1])
+                 : local;
+        const std::array<Acts::Vector3, 2> probes = {position, -position};
+        for (const Acts::Vector3& probe : probes) {
+          const bool inside = isInsideStandard(probe);
+          bool consistent = bField.isInside(probe) == inside;
+          if (consistent && inside) {
+            const Acts::Vector3 expected = standardField(grid, probe);
+            consistent =
+                (bField.getFieldUnchecked(probe) - expected).norm() <=
+                1e-9 * std::max(expected.norm(), Acts::UnitConstants::T);
+          }
+          if (!consistent) {
+            throw std::invalid_argument(
+                "Binary field maps only support the standard transforms of "
+                "the field map coordinates");
+          }
+        }
+      }
+    }
+  }
+}
+
+/// Collect the header and node values of an interpolated field map grid
+template <typename field_t>
+void writeGrid(const std::string& path, const field_t& bField,
+               Acts::BFieldMapCoordinates coordinates,
+               Acts::BFieldMapStorage storage) {
+  using grid_t = typename field_t::Grid;
+  const grid_t& grid = bField.getGrid();
+  constexpr std::size_t DIM = grid_t::DIM;
+  using value_t = typename grid_t::value_type;
+  constexpr std::size_t nComponents = value_t::RowsAtCompileTime;
+
+  Acts::BinaryBFieldMapHeader header;
+  header.storage = static_cast<std::uint32_t>(storage);
+  header.coordinates = static_cast<std::uint32_t>(coordinates);
+  header.nDim = DIM;
+  header.nComponents = nComponents;
+
+  // the interpolation domain spans from the lower edge of the first to the
+  // lower edge of the last bin, whose lower edges are the grid nodes
+  const auto nBins = grid.numLocalBins();
+  typename grid_t::index_t first{};
+  first.fill(1);
+  const auto lowerLeft = grid.lowerLeftBinEdge(first);
+  const auto upperRight = grid.lowerLeftBinEdge(nBins);
+  std::size_t nNodes = 1;
+  for (std::size_t i = 0; i < DIM; ++i) {
+    header.nNodes[i] = nBins[i];
+    header.min[i] = lowerLeft[i];
+    header.max[i] = upperRight[i];
+    nNodes *= nBins[i];
+  }
+  checkTransforms(bField, coordinates, header.min, header.max);
+
+  std::vector<double> values;
+  values.reserve(nNodes * nComponents);
+  typename grid_t::index_t index = first;
+  for (std::size_t n = 0; n < nNodes; ++n) {
+    const value_t& field = grid.atLocalBins(index);
+    for (std::size_t c = 0; c < nComponents; ++c) {
+      values.push_back(field[c]);
+    }
+    // advance the index with the last axis running fastest
+    for (std::size_t i = DIM; i-- > 0;) {
+      if (++index[i] <= nBins[i]) {
+        break;
+      }
+      index[i] = 1;
+    }
+  }
+  writeNodes(path, header, values);
+}
+
+}  // namespace
+
+Acts::MemoryMappedBFieldMap::MemoryMappedBFieldMap(const std::string& path,
+                                                   double scale)
+    : m_scale(scale) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open binary field map '" + path +
+                             "': " + std::strerror(errno));
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < sizeof(m_header)) {
+    ::close(fd);
+    throw std::runtime_error("Binary field map '" + path + "' is too small");
+  }
+  m_size = status.st_size;
+  m_mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (m_mapping == MAP_FAILED) {
+    m_mapping = nullptr;
+    throw std::runtime_error("Could not map binary field map '" + path +
+                             "': " + std::strerror(errno));
+  }
+  std::memcpy(&m_header, m_mapping, sizeof(m_header));
+
+  // validate the header before any value is accessed
+  auto fail = [&](const std::string& reason) {
+    ::munmap(m_mapping, m_size);
+    m_mapping = nullptr;
+    throw std::runtime_error("Invalid binary field map '" + path +
+                             "': " + reason);
+  };
+  if (m_header.magic != BinaryBFieldMapHeader::kMagic) {
+    fail("wrong file type");
+  }
+  if (m_header.byteOrderMark != BinaryBFieldMapHeader::kByteOrderMark) {
+    fail("written with a different byte order");
+  }
+  if (m_header.version != BinaryBFieldMapHeader::kVersion) {
+    fail("unsupported version " + std::to_string(m_header.version));
+  }
+  if (m_header.storage >
+      static_cast<std::uint32_t>(BFieldMapStorage::Fixed16)) {
+    fail("unknown storage");
+  }
+  const bool isRZ = coordinates() == BFieldMapCoordinates::RZ;
+  if (m_header.coordinates >
+          static_cast<std::uint32_t>(BFieldMapCoordinates::RZ) ||
+      m_header.nDim != (isRZ ? 2u : 3u) ||
+      m_header.nComponents != (isRZ ? 2u : 3u)) {
+    fail("inconsistent coordinates");
+  }
+  std::size_t nValues = m_header.nComponents;
+  for (std::size_t i = 0; i < m_header.nDim; ++i) {
+    if (m_header.nNodes[i] < 2 || !(m_header.max[i] > m_header.min[i])) {
+      fail("degenerate axis " + std::to_string(i));
+    }
+    nValues *= m_header.nNodes[i];
+  }
+  if (m_header.dataOffset < sizeof(m_header) ||
+      m_size < m_header.dataOffset + nValues * storageSize(storage())) {
+    fail("truncated field values");
+  }
+
+  m_data = static_cast<const unsigned char*>(m_mapping) + m_header.dataOffset;
+  std::size_t stride = m_header.nComponents;
+  m_gradientStep = std::numeric_limits<double>::max();
+  for (std::size_t i = m_header.nDim; i-- > 0;) {
+    m_binWidth[i] =
+        (m_header.max[i] - m_header.min[i]) / (m_header.nNodes[i] - 1);
+    m_stride[i] = stride;
+    stride *= m_header.nNodes[i];
+    m_gradientStep = std::min(m_gradientStep, 1e-3 * m_binWidth[i]);
+  }
+}
+
+Acts::MemoryMappedBFieldMap::~MemoryMappedBFieldMap() {
+  if (m_mapping != nullptr) {
+    ::munmap(m_mapping, m_size);
+  }
+}
+
+std::vector<std::size_t> Acts::MemoryMappedBFieldMap::getNBins() const {
+  return std::vector<std::size_t>(m_header.nNodes.begin(),
+                                  m_header.nNodes.begin() + m_header.nDim);
+}
+
+std::vector<double> Acts::MemoryMappedBFieldMap::getMin() const {
+  return std::vector<double>(m_header.min.begin(),
+                             m_header.min.begin() + m_header.nDim);
+}
+
+std::vector<double> Acts::MemoryMappedBFieldMap::getMax() const {
+  return std::vector<double>(m_header.max.begin(),
+                             m_header.max.begin() + m_header.nDim);
+}
+
+bool Acts::MemoryMappedBFieldMap::isInside(const Vector3& position) const {
+  return isInsideLocal(gridPosition(position));
+}
+
+Acts::Vector3 Acts::MemoryMappedBFieldMap::getFieldUnchecked(
+    const Vector3& position) const {
+  const Vector3 gridPos = gridPosition(position);
+  Cache cell{MagneticFieldContext{}};
+  fillCell(gridPos, cell);
+  return interpolate(cell, gridPos, position);
+}
+
+Acts::Result<Acts::Vector3> Acts::MemoryMappedBFieldMap::getField(
+    const Vector3& position) const {
+  const Vector3 gridPos = gridPosition(position);
+  if (!isInsideLocal(gridPos)) {
+    return Result<Vector3>::failure(MagneticFieldError::OutOfBounds);
+  }
+  Cache cell{MagneticFieldContext{}};
+  fillCell(gridPos, cell);
+  return Result<Vector3>::success(interpolate(cell, gridPos, position));
+}
+
+Acts::MagneticFieldProvider::Cache Acts::MemoryMappedBFieldMap::makeCache(
+    const MagneticFieldContext& mctx) const {
+  return MagneticFieldProvider::Cache::make<Cache>(mctx);
+}
+
+Acts::Result<Acts::Vector3> Acts::MemoryMappedBFieldMap::getField(
+    const Vector3& position, MagneticFieldProvider::Cache& cache) const {
+  Cache& lcache = cache.get<Cache>();
+  const Vector3 gridPos = gridPosition(position);
+  if (!isInsideLocal(gridPos)) {
+    return Result<Vector3>::failure(MagneticFieldError::OutOfBounds);
+  }
+
+  bool inCell = lcache.initialized;
+  for (std::size_t i = 0; inCell && i < m_header.nDim; ++i) {
+    inCell = lcache.lowerLeft[i] <= gridPos[i] &&
+             gridPos[i] < lcache.upperRight[i];
+  }
+  if (!inCell) {
+    fillCell(gridPos, lcache);
+  }
+  return Result<Vector3>::success(interpolate(lcache, gridPos, position));
+}
+
+Acts::Result<Acts::Vector3> Acts::MemoryMappedBFieldMap::getFieldGradient(
+    const Vector3& position, ActsMatrix<3, 3>& derivative,
+    MagneticFieldProvider::Cache& cache) const {
+  auto res = getField(position, cache);
+  if (!res.ok()) {
+    return res;
+  }
+  detail::interpolatedFieldGradient(*this, position, *res, m_gradientStep,
+                                    derivative);
+  return res;
+}
+
+Acts::Vector3 Acts::MemoryMappedBFieldMap::gridPosition(
+    const Vector3& position) const {
+  if (coordinates() == BFieldMapCoordinates::RZ) {
+    return Vector3(VectorHelpers::perp(position), position.z(), 0.);
+  }
+  return position;
+}
+
+bool Acts::MemoryMappedBFieldMap::isInsideLocal(const Vector3& gridPos) const {
+  for (std::size_t i = 0; i < m_header.nDim; ++i) {
+    if (gridPos[i] < m_header.min[i] || gridPos[i] >= m_header.max[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Acts::MemoryMappedBFieldMap::fillCell(const Vector3& gridPos,
+                                           Cache& cell) const {
+  std::size_t base = 0;
+  for (std::size_t i = 0; i < m_header.nDim; ++i) {
+    // clamp such that positions on the last node use the last cell
+    const double bin =
+        std::clamp(std::floor((gridPos[i] - m_header.min[i]) / m_binWidth[i]),
+                   0., static_cast<double>(m_header.nNodes[i] - 2));
+    const auto node = static_cast<std::size_t>(bin);
+    cell.lowerLeft[i] = m_header.min[i] + node * m_binWidth[i];
+    cell.upperRight[i] = cell.lowerLeft[i] + m_binWidth[i];
+    base += node * m_stride[i];
+  }
+
+  const std::size_t nCorners = std::size_t{1} << m_header.nDim;
+  for (std::size_t corner = 0; corner < nCorners; ++corner) {
+    std::size_t index = base;
+    for (std::size_t i = 0; i < m_header.nDim; ++i) {
+      if ((corner >> i) & 1u) {
+        index += m_stride[i];
+      }
+    }
+    Vector3& field = cell.corners[corner];
+    field.setZero();
+    for (std::size_t c = 0; c < m_header.nComponents; ++c) {
+      field[c] = value(index + c);
+    }
+  }
+  cell.initialized = true;
+}
+
+Acts::Vector3 Acts::MemoryMappedBFieldMap::interpolate(
+    const Cache& cell, const Vector3& gridPos, const Vector3& position) const {
+  std::array<double, 3> t = {0., 0., 0.};
+  for (std::size_t i = 0; i < m_header.nDim; ++i) {
+    t[i] = (gridPos[i] - cell.lowerLeft[i]) / m_binWidth[i];
+  }
+
+  const std::size_t nCorners = std::size_t{1} << m_header.nDim;
+  Vector3 local = Vector3::Zero();
+  for (std::size_t corner = 0; corner < nCorners; ++corner) {
+    double weight = 1.;
+    for (std::size_t i = 0; i < m_header.nDim; ++i) {
+      weight *= ((corner >> i) & 1u) ? t[i] : 1. - t[i];
+    }
+    local += weight * cell.corners[corner];
+  }
+  local *= m_scale;
+
+  if (coordinates() == BFieldMapCoordinates::XYZ) {
+    return local;
+  }
+  // map (Br,Bz) -> (Bx,By,Bz)
+  const double r = VectorHelpers::perp(position);
+  double cosPhi = 1.;
+  double sinPhi = 0.;
+  if (r > std::numeric_limits<double>::min()) {
+    cosPhi = position.x() / r;
+    sinPhi = position.y() / r;
+  }
+  return Vector3(local[0] * cosPhi, local[0] * sinPhi, local[1]);
+}
+
+double Acts::MemoryMappedBFieldMap::value(std::size_t index) const {
+  double stored = 0.;
+  switch (storage()) {
+    case BFieldMapStorage::Float64: {
+      std::memcpy(&stored, m_data + index * sizeof(double), sizeof(double));
+      break;
+    }
+    case BFieldMapStorage::Float32: {
+      float f = 0;
+      std::memcpy(&f, m_data + index * sizeof(float), sizeof(float));
+      stored = f;
+      break;
+    }
+    case BFieldMapStorage::Float16: {
+      std::uint16_t h = 0;
+      std::memcpy(&h, m_data + index * sizeof(h), sizeof(h));
+      stored = halfToFloat(h);
+      break;
+    }
+    case BFieldMapStorage::Fixed16: {
+      std::int16_t s = 0;
+      std::memcpy(&s, m_data + index * sizeof(s), sizeof(s));
+      stored = s;
+      break;
+    }
+  }
+  return stored * m_header.fieldScale;
+}
+
+void Acts::writeBinaryBFieldMap(
+    const std::string& path,
+    const InterpolatedBFieldMap<detail::Grid<
+        Vector2, detail::EquidistantAxis, detail::EquidistantAxis>>& bField,
+    BFieldMapStorage storage) {
+  writeGrid(path, bField, BFieldMapCoordinates::RZ, storage);
+}
+
+void Acts::writeBinaryBFieldMap(
+    const std::string& path,
+    const InterpolatedBFieldMap<
+        detail::Grid<Vector3, detail::EquidistantAxis, detail::EquidistantAxis,
+                     detail::EquidistantAxis>>& bField,
+    BFieldMapStorage storage) {
+  writeGrid(path, bField, BFieldMapCoordinates::XYZ, storage);
+}
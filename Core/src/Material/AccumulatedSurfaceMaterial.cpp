@@ -12,6 +12,7 @@
 #include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
 #include "Acts/Material/ISurfaceMaterial.hpp"
 
+#include <stdexcept>
 #include <utility>
 
 // Default Constructor - for homogeneous material
@@ -130,6 +131,27 @@ void Acts::AccumulatedSurfaceMaterial::trackAverage(
   }
 }
 
+// Merge the material accumulated by another instance
+void Acts::AccumulatedSurfaceMaterial::merge(
+    const AccumulatedSurfaceMaterial& other) {
+  const auto& otherMaterial = other.m_accumulatedMaterial;
+  if (otherMaterial.size() != m_accumulatedMaterial.size()) {
+    throw std::invalid_argument(
+        "Accumulated surface material with different binning can not be "
+        "merged");
+  }
+  for (size_t ib1 = 0; ib1 < m_accumulatedMaterial.size(); ++ib1) {
+    if (otherMaterial[ib1].size() != m_accumulatedMaterial[ib1].size()) {
+      throw std::invalid_argument(
+          "Accumulated surface material with different binning can not be "
+          "merged");
+    }
+    for (size_t ib0 = 0; ib0 < m_accumulatedMaterial[ib1].size(); ++ib0) {
+      m_accumulatedMaterial[ib1][ib0].merge(otherMaterial[ib1][ib0]);
+    }
+  }
+}
+
 /// Total average creates SurfaceMaterial
 std::unique_ptr<const Acts::ISurfaceMaterial>
 Acts::AccumulatedSurfaceMaterial::totalAverage() {
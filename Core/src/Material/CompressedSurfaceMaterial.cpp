@@ -0,0 +1,273 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Material/CompressedSurfaceMaterial.hpp"
+
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+/// Round a value to the given number of significant mantissa bits
+float roundMantissa(float value, int bits) {
+  if (value == 0.f or not std::isfinite(value)) {
+    return value;
+  }
+  int exponent = 0;
+  float mantissa = std::frexp(value, &exponent);
+  float scale = std::ldexp(1.f, bits);
+  return std::ldexp(std::round(mantissa * scale) / scale, exponent);
+}
+
+/// The number of mantissa bits which resolve the requested precision
+int mantissaBits(float precision) {
+  int bits = std::numeric_limits<float>::digits;
+  if (precision > 0.f) {
+    bits = std::clamp(static_cast<int>(std::ceil(-std::log2(precision))), 1,
+                      bits);
+  }
+  return bits;
+}
+
+/// The palette is keyed by the (rounded) thickness and material parameters
+using PaletteKey = std::array<float, 6>;
+
+PaletteKey paletteKey(const Acts::MaterialSlab& slab, int bits) {
+  const Acts::Material& material = slab.material();
+  return {roundMantissa(slab.thickness(), bits),
+          roundMantissa(material.X0(), bits),
+          roundMantissa(material.L0(), bits),
+          roundMantissa(material.Ar(), bits),
+          roundMantissa(material.Z(), bits),
+          roundMantissa(material.molarDensity(), bits)};
+}
+
+}  // namespace
+
+bool Acts::CompressedSurfaceMaterial::fitsPalette(
+    const MaterialSlabMatrix& fullProperties, float precision) {
+  const int bits = mantissaBits(precision);
+  std::set<PaletteKey> keys;
+  for (const auto& materialVector : fullProperties) {
+    for (const auto& slab : materialVector) {
+      keys.insert(paletteKey(slab, bits));
+      if (keys.size() >
+          static_cast<size_t>(std::numeric_limits<PaletteIndex>::max()) + 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Acts::CompressedSurfaceMaterial::CompressedSurfaceMaterial(
+    const BinUtility& binUtility, const MaterialSlabMatrix& fullProperties,
+    double splitFactor, Acts::MappingType mappingType, float precision)
+    : ISurfaceMaterial(splitFactor, mappingType),
+      m_binUtility(binUtility),
+      m_itransform(binUtility.transform().inverse()),
+      m_identity(binUtility.transform().matrix().isIdentity(0.)) {
+  const auto& binningData = m_binUtility.binningData();
+  if (binningData.size() > 2) {
+    throw std::invalid_argument(
+        "Compressed surface material supports at most two bin dimensions");
+  }
+  for (size_t ib = 0; ib < binningData.size(); ++ib) {
+    const auto& bData = binningData[ib];
+    BinLookup& lookup = m_lookup[ib];
+    lookup.value = bData.binvalue;
+    lookup.option = bData.option;
+    // see BinningData::value(const Vector2&)
+    lookup.localIndex = (bData.binvalue == binR or bData.binvalue == binRPhi or
+                         bData.binvalue == binX or bData.binvalue == binH)
+                            ? 0
+                            : 1;
+    lookup.bins = bData.bins();
+    lookup.min = bData.min;
+    lookup.max = bData.max;
+    lookup.step = bData.step;
+    if (bData.type == arbitrary) {
+      lookup.boundaries = bData.boundaries();
+    }
+    m_fastLookup = m_fastLookup and (bData.subBinningData == nullptr);
+  }
+  m_bins0 = m_binUtility.bins(0);
+  compress(fullProperties, precision);
+}
+
+Acts::CompressedSurfaceMaterial::CompressedSurfaceMaterial(
+    const BinnedSurfaceMaterial& bsm, float precision)
+    : CompressedSurfaceMaterial(bsm.binUtility(), bsm.fullMaterial(),
+                                bsm.splitFactor(), bsm.mappingType(),
+                                precision) {}
+
+void Acts::CompressedSurfaceMaterial::compress(
+    const MaterialSlabMatrix& fullProperties, float precision) {
+  size_t bins1 = m_binUtility.bins(1);
+  if (fullProperties.size() != bins1) {
+    throw std::invalid_argument(
+        "Material matrix does not match the binning of the surface");
+  }
+  const int bits = mantissaBits(precision);
+
+  std::map<PaletteKey, PaletteIndex> paletteIndices;
+  m_indices.reserve(bins1 * m_bins0);
+  for (const auto& materialVector : fullProperties) {
+    if (materialVector.size() != m_bins0) {
+      throw std::invalid_argument(
+          "Material matrix does not match the binning of the surface");
+    }
+    for (const auto& slab : materialVector) {
+      const PaletteKey key = paletteKey(slab, bits);
+      auto [entry, inserted] =
+          paletteIndices.emplace(key, static_cast<PaletteIndex>(0));
+      if (inserted) {
+        if (m_palette.size() > std::numeric_limits<PaletteIndex>::max()) {
+          throw std::invalid_argument(
+              "Too many distinct material slabs for the palette, use a "
+              "coarser precision");
+        }
+        entry->second = static_cast<PaletteIndex>(m_palette.size());
+        if (bits == std::numeric_limits<float>::digits) {
+          m_palette.push_back(slab);
+        } else if (not slab.material()) {
+          m_palette.emplace_back(key[0]);
+        } else {
+          m_palette.emplace_back(Material::fromMolarDensity(
+                                     key[1], key[2], key[3], key[4], key[5]),
+                                 key[0]);
+        }
+      }
+      m_indices.push_back(entry->second);
+    }
+  }
+  m_palette.shrink_to_fit();
+}
+
+size_t Acts::CompressedSurfaceMaterial::BinLookup::search(float v) const {
+  if (bins == 1) {
+    return 0;
+  }
+  if (boundaries.empty()) {
+    // see BinningData::searchEquidistantWithBoundary
+    int bin = static_cast<int>((v - min) / step);
+    if (option == closed) {
+      if (v < min) {
+        return (bins - 1);
+      }
+      if (v > max) {
+        return 0;
+      }
+    }
+    bin = bin < 0 ? ((option == open) ? 0 : (bins - 1)) : bin;
+    return size_t((bin <= int(bins - 1)) ? bin
+                                         : ((option == open) ? (bins - 1) : 0));
+  }
+  // see BinningData::searchInVectorWithBoundary
+  if (v <= boundaries[0]) {
+    return (option == closed) ? (bins - 1) : 0;
+  }
+  if (v >= max) {
+    return (option == closed) ? 0 : (bins - 1);
+  }
+  auto lb = std::lower_bound(boundaries.begin(), boundaries.end(), v);
+  return static_cast<size_t>(std::distance(boundaries.begin(), lb) - 1);
+}
+
+Acts::CompressedSurfaceMaterial& Acts::CompressedSurfaceMaterial::operator*=(
+    double scale) {
+  for (auto& slab : m_palette) {
+    slab.scaleThickness(scale);
+  }
+  return (*this);
+}
+
+Acts::MaterialSlabMatrix Acts::CompressedSurfaceMaterial::fullMaterial()
+    const {
+  size_t bins1 = m_indices.size() / m_bins0;
+  MaterialSlabMatrix matrix(bins1, MaterialSlabVector(m_bins0));
+  for (size_t ib1 = 0; ib1 < bins1; ++ib1) {
+    for (size_t ib0 = 0; ib0 < m_bins0; ++ib0) {
+      matrix[ib1][ib0] = materialSlab(ib0, ib1);
+    }
+  }
+  return matrix;
+}
+
+const Acts::MaterialSlab& Acts::CompressedSurfaceMaterial::materialSlab(
+    const Vector2& lp) const {
+  if (not m_fastLookup) {
+    size_t ibin0 = m_binUtility.bin(lp, 0);
+    size_t ibin1 = m_binUtility.max(1) != 0u ? m_binUtility.bin(lp, 1) : 0;
+    return materialSlab(ibin0, ibin1);
+  }
+  size_t ibin0 = m_lookup[0].search(lp[m_lookup[0].localIndex]);
+  size_t ibin1 = m_lookup[1].search(lp[m_lookup[1].localIndex]);
+  return materialSlab(ibin0, ibin1);
+}
+
+const Acts::MaterialSlab& Acts::CompressedSurfaceMaterial::materialSlab(
+    const Vector3& gp) const {
+  if (not m_fastLookup) {
+    size_t ibin0 = m_binUtility.bin(gp, 0);
+    size_t ibin1 = m_binUtility.max(1) != 0u ? m_binUtility.bin(gp, 1) : 0;
+    return materialSlab(ibin0, ibin1);
+  }
+  // a single transform for both dimensions
+  const Vector3 position = m_identity ? gp : Vector3(m_itransform * gp);
+  // see BinningData::value(const Vector3&)
+  auto value = [&position](BinningValue bValue) -> float {
+    using VectorHelpers::eta;
+    using VectorHelpers::perp;
+    using VectorHelpers::phi;
+    if (bValue == binR or bValue == binH) {
+      return perp(position);
+    }
+    if (bValue == binRPhi) {
+      return perp(position) * phi(position);
+    }
+    if (bValue == binEta) {
+      return eta(position);
+    }
+    if (bValue < 3) {
+      return position[bValue];
+    }
+    return phi(position);
+  };
+  size_t ibin0 = m_lookup[0].bins == 1
+                     ? 0
+                     : m_lookup[0].search(value(m_lookup[0].value));
+  size_t ibin1 = m_lookup[1].bins == 1
+                     ? 0
+                     : m_lookup[1].search(value(m_lookup[1].value));
+  return materialSlab(ibin0, ibin1);
+}
+
+std::ostream& Acts::CompressedSurfaceMaterial::toStream(
+    std::ostream& sl) const {
+  sl << "Acts::CompressedSurfaceMaterial : " << std::endl;
+  sl << "   - Number of Material bins [0,1] : " << m_binUtility.max(0) + 1
+     << " / " << m_binUtility.max(1) + 1 << std::endl;
+  sl << "   - Number of distinct material   : " << m_palette.size()
+     << std::endl;
+  sl << "   - Parse palette material        : " << std::endl;
+  for (size_t ip = 0; ip < m_palette.size(); ++ip) {
+    sl << " Entry [" << ip << "] - " << m_palette[ip];
+  }
+  sl << "  - BinUtility: " << m_binUtility << std::endl;
+  return sl;
+}
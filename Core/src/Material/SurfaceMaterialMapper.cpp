@@ -65,6 +65,27 @@ Acts::SurfaceMaterialMapper::State Acts::SurfaceMaterialMapper::createState(
   return mState;
 }
 
+Acts::SurfaceMaterialMapper::State Acts::SurfaceMaterialMapper::createState(
+    const State& prototype) const {
+  State mState(prototype.geoContext, prototype.magFieldContext);
+  mState.accumulatedMaterial = prototype.accumulatedMaterial;
+  mState.inputSurfaceMaterial = prototype.inputSurfaceMaterial;
+  mState.volumeMaterial = prototype.volumeMaterial;
+  return mState;
+}
+
+void Acts::SurfaceMaterialMapper::mergeState(State& mState,
+                                             const State& other) const {
+  for (const auto& [geoID, accMaterial] : other.accumulatedMaterial) {
+    auto target = mState.accumulatedMaterial.find(geoID);
+    if (target == mState.accumulatedMaterial.end()) {
+      mState.accumulatedMaterial.emplace(geoID, accMaterial);
+    } else {
+      target->second.merge(accMaterial);
+    }
+  }
+}
+
 void Acts::SurfaceMaterialMapper::resolveMaterialSurfaces(
     State& mState, const TrackingVolume& tVolume) const {
   ACTS_VERBOSE("Checking volume '" << tVolume.volumeName()
@@ -60,6 +60,50 @@ Acts::VolumeMaterialMapper::State Acts::VolumeMaterialMapper::createState(
   return mState;
 }
 
+Acts::VolumeMaterialMapper::State Acts::VolumeMaterialMapper::createState(
+    const State& prototype) const {
+  State mState(prototype.geoContext, prototype.magFieldContext);
+  mState.homogeneousGrid = prototype.homogeneousGrid;
+  mState.transform2D = prototype.transform2D;
+  mState.grid2D = prototype.grid2D;
+  mState.transform3D = prototype.transform3D;
+  mState.grid3D = prototype.grid3D;
+  mState.materialBin = prototype.materialBin;
+  mState.surfaceMaterial = prototype.surfaceMaterial;
+  return mState;
+}
+
+namespace {
+/// Merge the grids of one dimension bin by bin
+template <typename grid_t>
+void mergeGrids(std::map<const Acts::GeometryIdentifier, grid_t>& grids,
+                const std::map<const Acts::GeometryIdentifier, grid_t>& other) {
+  for (const auto& [geoID, otherGrid] : other) {
+    auto grid = grids.find(geoID);
+    if (grid == grids.end()) {
+      grids.emplace(geoID, otherGrid);
+      continue;
+    }
+    if (grid->second.size() != otherGrid.size()) {
+      throw std::invalid_argument(
+          "Material grids with different binning can not be merged");
+    }
+    for (size_t bin = 0; bin < otherGrid.size(); ++bin) {
+      grid->second.at(bin).merge(otherGrid.at(bin));
+    }
+  }
+}
+}  // namespace
+
+void Acts::VolumeMaterialMapper::mergeState(State& mState,
+                                            const State& other) const {
+  for (const auto& [geoID, accMaterial] : other.homogeneousGrid) {
+    mState.homogeneousGrid[geoID].merge(accMaterial);
+  }
+  mergeGrids(mState.grid2D, other.grid2D);
+  mergeGrids(mState.grid3D, other.grid3D);
+}
+
 void Acts::VolumeMaterialMapper::resolveMaterialVolume(
     State& mState, const TrackingVolume& tVolume) const {
   ACTS_VERBOSE("Checking volume '" << tVolume.volumeName()
@@ -0,0 +1,112 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Navigation/SurfaceBoundingVolumeHierarchy.hpp"
+
+#include "Acts/Geometry/Extent.hpp"
+#include "Acts/Geometry/Polyhedron.hpp"
+#include "Acts/Geometry/Volume.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using Node = Acts::Experimental::SurfaceBoundingVolumeHierarchy::Node;
+using Box = Acts::Volume::BoundingBox;
+
+/// Recursively build the nodes for the boxes [begin, end) of the order
+///
+/// @param nodes [in,out] are the flattened nodes, the new ones are appended
+/// @param boxes are the surface boxes
+/// @param order [in,out] is the box order, it is sorted into the leaf order
+/// @param begin is the first box of this node in the order
+/// @param end is the end of the boxes of this node in the order
+/// @param leafSize is the maximum number of boxes in a leaf
+void buildNode(std::vector<Node>& nodes, const std::vector<Box>& boxes,
+               std::vector<std::size_t>& order, std::size_t begin,
+               std::size_t end, std::size_t leafSize) {
+  std::size_t index = nodes.size();
+  nodes.emplace_back();
+
+  std::vector<const Box*> nodeBoxes;
+  nodeBoxes.reserve(end - begin);
+  for (std::size_t ib = begin; ib < end; ++ib) {
+    nodeBoxes.push_back(&boxes[order[ib]]);
+  }
+  std::tie(nodes[index].min, nodes[index].max) = Box::wrap(nodeBoxes);
+
+  if (end - begin <= leafSize) {
+    nodes[index].first = static_cast<std::uint32_t>(begin);
+    nodes[index].count = static_cast<std::uint32_t>(end - begin);
+  } else {
+    // Split at the median center along the axis of largest spread
+    Acts::Vector3 cMin = boxes[order[begin]].center();
+    Acts::Vector3 cMax = cMin;
+    for (std::size_t ib = begin + 1; ib < end; ++ib) {
+      cMin = cMin.cwiseMin(boxes[order[ib]].center());
+      cMax = cMax.cwiseMax(boxes[order[ib]].center());
+    }
+    Acts::Vector3::Index axis = 0;
+    (cMax - cMin).maxCoeff(&axis);
+    std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid,
+                     order.begin() + end, [&](std::size_t a, std::size_t b) {
+                       return boxes[a].center()[axis] <
+                              boxes[b].center()[axis];
+                     });
+    buildNode(nodes, boxes, order, begin, mid, leafSize);
+    buildNode(nodes, boxes, order, mid, end, leafSize);
+  }
+  // Missing this node means skipping its whole sub tree
+  nodes[index].skip = static_cast<std::uint32_t>(nodes.size());
+}
+
+}  // namespace
+
+Acts::Experimental::SurfaceBoundingVolumeHierarchy::
+    SurfaceBoundingVolumeHierarchy(const GeometryContext& gctx,
+                                   const std::vector<const Surface*>& surfaces,
+                                   const Config& cfg) noexcept(false)
+    : m_cfg(cfg) {
+  if (m_cfg.leafSize == 0u) {
+    throw std::invalid_argument(
+        "SurfaceBoundingVolumeHierarchy: leaf size must be at least one.");
+  }
+  if (surfaces.empty()) {
+    return;
+  }
+
+  // The surface boxes, including the envelope
+  std::vector<Box> boxes;
+  boxes.reserve(surfaces.size());
+  Vector3 envelope(m_cfg.envelope, m_cfg.envelope, m_cfg.envelope);
+  for (const auto* surface : surfaces) {
+    if (surface == nullptr) {
+      throw std::invalid_argument(
+          "SurfaceBoundingVolumeHierarchy: nullptr surface given.");
+    }
+    auto extent =
+        surface->polyhedronRepresentation(gctx, m_cfg.nSegments).extent();
+    Vector3 vmin(extent.min(binX), extent.min(binY), extent.min(binZ));
+    Vector3 vmax(extent.max(binX), extent.max(binY), extent.max(binZ));
+    boxes.emplace_back(nullptr, vmin - envelope, vmax + envelope);
+  }
+
+  std::vector<std::size_t> order(surfaces.size());
+  std::iota(order.begin(), order.end(), 0u);
+  m_nodes.reserve(2 * surfaces.size() / m_cfg.leafSize + 1);
+  buildNode(m_nodes, boxes, order, 0, order.size(), m_cfg.leafSize);
+
+  m_surfaces.reserve(surfaces.size());
+  for (std::size_t io : order) {
+    m_surfaces.push_back(surfaces[io]);
+  }
+}
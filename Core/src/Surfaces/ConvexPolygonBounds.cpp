@@ -46,6 +46,12 @@ bool Acts::ConvexPolygonBounds<Acts::PolygonDynamic>::inside(
   return bcheck.isInside(lposition, m_vertices);
 }
 
+void Acts::ConvexPolygonBounds<Acts::PolygonDynamic>::insideBatch(
+    const std::vector<Acts::Vector2>& lpositions,
+    const Acts::BoundaryCheck& bcheck, std::vector<bool>& result) const {
+  bcheck.isInside(lpositions, m_vertices, result);
+}
+
 std::vector<Acts::Vector2> Acts::ConvexPolygonBounds<
     Acts::PolygonDynamic>::vertices(unsigned int /*lseg*/) const {
   return {m_vertices.begin(), m_vertices.end()};
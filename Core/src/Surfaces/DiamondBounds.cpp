@@ -22,6 +22,12 @@ bool Acts::DiamondBounds::inside(const Acts::Vector2& lposition,
   return bcheck.isInside(lposition, vertices());
 }
 
+void Acts::DiamondBounds::insideBatch(
+    const std::vector<Acts::Vector2>& lpositions,
+    const Acts::BoundaryCheck& bcheck, std::vector<bool>& result) const {
+  bcheck.isInside(lpositions, vertices(), result);
+}
+
 std::vector<Acts::Vector2> Acts::DiamondBounds::vertices(
     unsigned int /*lseg*/) const {
   // Vertices starting at lower left (min rel. phi)
@@ -19,6 +19,12 @@ bool Acts::RectangleBounds::inside(const Acts::Vector2& lposition,
   return bcheck.isInside(lposition, m_min, m_max);
 }
 
+void Acts::RectangleBounds::insideBatch(
+    const std::vector<Acts::Vector2>& lpositions,
+    const Acts::BoundaryCheck& bcheck, std::vector<bool>& result) const {
+  bcheck.isInside(lpositions, m_min, m_max, result);
+}
+
 std::vector<Acts::Vector2> Acts::RectangleBounds::vertices(
     unsigned int /*lseg*/) const {
   // counter-clockwise starting from bottom-left corner
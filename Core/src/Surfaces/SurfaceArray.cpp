@@ -12,8 +12,81 @@
 #include "Acts/Geometry/SurfaceArrayCreator.hpp"
 #include "Acts/Utilities/ThrowAssert.hpp"
 
+#include <cmath>
 #include <utility>
 
+namespace {
+
+/// Local position from the two binning values of a flat grid
+template <Acts::BinningValue bValue0, Acts::BinningValue bValue1>
+Acts::Vector3 localPosition(Acts::ActsScalar v0, Acts::ActsScalar v1) {
+  if constexpr (bValue0 == Acts::binPhi) {
+    return Acts::Vector3(std::cos(v0), std::sin(v0), v1);
+  } else {
+    return Acts::Vector3(v0 * std::cos(v1), v0 * std::sin(v1), 0.);
+  }
+}
+
+/// Copy the neighbor map of a grid lookup into a flat grid
+///
+/// Every regular bin is probed at a few positions, which have to end up in
+/// the very same bin in the grid lookup and in the flat grid. Otherwise the
+/// binning is not the expected one and no flat grid is returned.
+///
+/// @param gridLookup is the grid lookup to be copied
+/// @param transform is the global to local transform of the surface array
+template <Acts::BinningValue bValue0, Acts::BinningValue bValue1>
+std::optional<Acts::detail::FlatSurfaceGrid<bValue0, bValue1>> makeFlatGrid(
+    const Acts::SurfaceArray::ISurfaceGridLookup& gridLookup,
+    const Acts::Transform3& transform) {
+  if (gridLookup.dimensions() != 2u or
+      gridLookup.binningValues() !=
+          std::vector<Acts::BinningValue>{bValue0, bValue1}) {
+    return std::nullopt;
+  }
+  auto axes = gridLookup.getAxes();
+  Acts::detail::FlatSurfaceGrid<bValue0, bValue1> grid(
+      transform, Acts::detail::FlatSurfaceGridAxis(*axes[0]),
+      Acts::detail::FlatSurfaceGridAxis(*axes[1]));
+  if (grid.size() != gridLookup.size()) {
+    return std::nullopt;
+  }
+
+  const auto& axis0 = grid.axis0();
+  const auto& axis1 = grid.axis1();
+  const Acts::Transform3 itransform = transform.inverse();
+  const Acts::SurfaceVector empty;
+  const std::size_t nBins1 = axis1.getNBins() + 2;
+  for (std::size_t bin = 0; bin < grid.size(); ++bin) {
+    if (not gridLookup.isValidBin(bin)) {
+      grid.push_back(empty);
+      continue;
+    }
+    std::size_t bin0 = bin / nBins1;
+    std::size_t bin1 = bin % nBins1;
+    const auto& content = gridLookup.lookup(bin);
+    const Acts::SurfaceVector* neighbors = nullptr;
+    for (double f0 : {0.1, 0.5, 0.9}) {
+      for (double f1 : {0.1, 0.5, 0.9}) {
+        Acts::Vector3 position =
+            itransform *
+            localPosition<bValue0, bValue1>(
+                (1. - f0) * axis0.lowerEdge(bin0) + f0 * axis0.upperEdge(bin0),
+                (1. - f1) * axis1.lowerEdge(bin1) + f1 * axis1.upperEdge(bin1));
+        if (grid.globalBin(position) != bin or
+            &gridLookup.lookup(position) != &content) {
+          return std::nullopt;
+        }
+        neighbors = &gridLookup.neighbors(position);
+      }
+    }
+    grid.push_back(*neighbors);
+  }
+  return grid;
+}
+
+}  // namespace
+
 // implementation for pure virtual destructor of ISurfaceGridLookup
 Acts::SurfaceArray::ISurfaceGridLookup::~ISurfaceGridLookup() = default;
 
@@ -24,7 +97,12 @@ Acts::SurfaceArray::SurfaceArray(
     : p_gridLookup(std::move(gridLookup)),
       m_surfaces(std::move(surfaces)),
       m_surfacesRawPointers(unpack_shared_vector(m_surfaces)),
-      m_transform(transform) {}
+      m_transform(transform) {
+  m_cylinderGrid = makeFlatGrid<binPhi, binZ>(*p_gridLookup, m_transform);
+  if (not m_cylinderGrid) {
+    m_discGrid = makeFlatGrid<binR, binPhi>(*p_gridLookup, m_transform);
+  }
+}
 
 Acts::SurfaceArray::SurfaceArray(std::shared_ptr<const Surface> srf)
     : p_gridLookup(
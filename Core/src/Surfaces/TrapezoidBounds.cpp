@@ -54,6 +54,17 @@ bool Acts::TrapezoidBounds::inside(const Acts::Vector2& lposition,
   return bcheck.isInside(lposition, v);
 }
 
+void Acts::TrapezoidBounds::insideBatch(
+    const std::vector<Acts::Vector2>& lpositions,
+    const Acts::BoundaryCheck& bcheck, std::vector<bool>& result) const {
+  BoundaryCheck(true).isInside(lpositions, vertices(), result);
+  for (size_t i = 0; i < lpositions.size(); ++i) {
+    if (not result[i]) {
+      result[i] = inside(lpositions[i], bcheck);
+    }
+  }
+}
+
 std::vector<Acts::Vector2> Acts::TrapezoidBounds::vertices(
     unsigned int /*lseg*/) const {
   double minhx = get(TrapezoidBounds::eHalfLengthXnegY);
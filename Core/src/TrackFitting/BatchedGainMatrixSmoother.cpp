@@ -0,0 +1,166 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/TrackFitting/BatchedGainMatrixSmoother.hpp"
+
+#include "Acts/EventData/detail/covariance_helper.hpp"
+
+#include <algorithm>
+
+namespace Acts {
+
+namespace {
+
+constexpr std::size_t kLanes = BatchedGainMatrixSmoother::kChunkSize;
+constexpr std::size_t B = eBoundSize;
+using Lanes = detail::Lanes<kLanes>;
+using LaneMask = detail::LaneMask<kLanes>;
+using LaneVector = detail::LaneVector<kLanes, B>;
+using LaneMatrix = detail::LaneMatrix<kLanes, B>;
+
+}  // namespace
+
+Result<void> BatchedGainMatrixSmoother::operator()(
+    States& states, const Logger& logger) const {
+  static constexpr double epsilon = 1e-13;
+  const std::size_t nStates = states.size();
+
+  ACTS_VERBOSE("Invoked BatchedGainMatrixSmoother for " << nStates
+                                                        << " track states");
+  assert(static_cast<std::size_t>(states.smoothed.rows()) == nStates);
+
+  std::size_t nFailed = 0;
+  for (std::size_t begin = 0; begin < nStates; begin += kLanes) {
+    const std::size_t size = std::min(kLanes, nStates - begin);
+    const auto load = [&](const auto& column) {
+      return detail::loadLanes<kLanes>(column, begin, size);
+    };
+    const auto store = [&](const Lanes& lanes, auto&& column) {
+      detail::storeLanes<kLanes>(lanes, column, begin, size);
+    };
+
+    const LaneMatrix filteredCov = detail::loadSymmetricLanes<kLanes, B>(
+        states.filteredCovariance, begin, size);
+    const LaneMatrix nextPredictedCov = detail::loadSymmetricLanes<kLanes, B>(
+        states.nextPredictedCovariance, begin, size);
+    LaneMatrix jacobian;
+    for (std::size_t i = 0; i < B * B; ++i) {
+      jacobian[i] = load(states.nextJacobian.col(i));
+    }
+
+    // Gain smoothing matrix G = C J^T (P + eps)^-1, where the jacobian is the
+    // one from this state to the next state in forward propagation. The rows
+    // of G are the solutions of (P + eps) g = (C J^T)^T as P is symmetric.
+    LaneMatrix regularized = nextPredictedCov;
+    for (std::size_t i = 0; i < B; ++i) {
+      regularized[i * B + i] += epsilon;
+    }
+    LaneMatrix L;
+    LaneVector invDiag;
+    LaneMask ok = detail::choleskyLanes<kLanes, B>(regularized, L, invDiag);
+
+    LaneMatrix G;
+    for (std::size_t i = 0; i < B; ++i) {
+      LaneVector g;
+      for (std::size_t j = 0; j < B; ++j) {
+        g[j] = filteredCov[i * B] * jacobian[j * B];
+        for (std::size_t k = 1; k < B; ++k) {
+          g[j] += filteredCov[i * B + k] * jacobian[j * B + k];
+        }
+      }
+      detail::choleskySolveLanes<kLanes, B>(L, invDiag, g);
+      for (std::size_t j = 0; j < B; ++j) {
+        G[i * B + j] = g[j];
+      }
+    }
+
+    // Smoothed parameters
+    LaneVector delta;
+    for (std::size_t k = 0; k < B; ++k) {
+      delta[k] =
+          load(states.nextSmoothed.col(k)) - load(states.nextPredicted.col(k));
+    }
+    for (std::size_t i = 0; i < B; ++i) {
+      Lanes smoothed = load(states.filtered.col(i));
+      for (std::size_t k = 0; k < B; ++k) {
+        smoothed += G[i * B + k] * delta[k];
+      }
+      store(smoothed, states.smoothed.col(i));
+    }
+
+    // Smoothed covariance C - G (P - C_next) G^T, which is symmetric
+    const LaneMatrix nextSmoothedCov = detail::loadSymmetricLanes<kLanes, B>(
+        states.nextSmoothedCovariance, begin, size);
+    LaneMatrix D;
+    for (std::size_t i = 0; i < B * B; ++i) {
+      D[i] = nextPredictedCov[i] - nextSmoothedCov[i];
+    }
+    LaneMatrix GD;
+    for (std::size_t i = 0; i < B; ++i) {
+      for (std::size_t j = 0; j < B; ++j) {
+        GD[i * B + j] = G[i * B] * D[j];
+        for (std::size_t k = 1; k < B; ++k) {
+          GD[i * B + j] += G[i * B + k] * D[k * B + j];
+        }
+      }
+    }
+    LaneMatrix smoothedCov;
+    for (std::size_t i = 0; i < B; ++i) {
+      for (std::size_t j = i; j < B; ++j) {
+        Lanes c = filteredCov[i * B + j];
+        for (std::size_t k = 0; k < B; ++k) {
+          c -= GD[i * B + k] * G[j * B + k];
+        }
+        smoothedCov[i * B + j] = c;
+        smoothedCov[j * B + i] = c;
+      }
+    }
+
+    // Check if the covariance matrix is semi-positive definite. A positive
+    // definite matrix is cheap to confirm for all lanes at once, all other
+    // lanes are checked and corrected one by one as for the
+    // GainMatrixSmoother.
+    LaneMatrix smoothedL;
+    LaneVector smoothedInvDiag;
+    const LaneMask positive = detail::choleskyLanes<kLanes, B>(
+        smoothedCov, smoothedL, smoothedInvDiag);
+    for (std::size_t l = 0; l < size; ++l) {
+      if (positive(l) or not ok(l)) {
+        continue;
+      }
+      BoundSymMatrix cov;
+      for (std::size_t i = 0; i < B * B; ++i) {
+        cov(i / B, i % B) = smoothedCov[i](l);
+      }
+      if (not detail::covariance_helper<BoundSymMatrix>::validate(cov)) {
+        ACTS_DEBUG(
+            "Smoothed covariance is not positive definite. Could result in "
+            "negative covariance!");
+      }
+      for (std::size_t i = 0; i < B * B; ++i) {
+        smoothedCov[i](l) = cov(i / B, i % B);
+      }
+    }
+    for (std::size_t i = 0; i < B * B; ++i) {
+      store(smoothedCov[i], states.smoothedCovariance.col(i));
+    }
+
+    states.ok.segment(begin, size) = ok.head(size);
+    nFailed += (!ok.head(size)).count();
+  }
+
+  if (nFailed != 0) {
+    ACTS_DEBUG("Smoothing failed for " << nFailed << " of " << nStates
+                                       << " track states");
+    return KalmanFitterError::SmoothFailed;
+  }
+
+  return Result<void>::success();
+}
+
+}  // namespace Acts
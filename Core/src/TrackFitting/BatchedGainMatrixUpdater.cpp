@@ -0,0 +1,205 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/TrackFitting/BatchedGainMatrixUpdater.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace Acts {
+
+namespace {
+
+constexpr std::size_t kLanes = BatchedGainMatrixUpdater::kChunkSize;
+using Lanes = detail::Lanes<kLanes>;
+using LaneMask = detail::LaneMask<kLanes>;
+
+/// The projection of a measured parameter for all lanes of a chunk
+///
+/// If all track states of a chunk measure the same bound parameter, the
+/// projection simply selects a bound element for all lanes at once.
+/// Otherwise it is gathered lane by lane.
+class LaneProjection {
+ public:
+  LaneProjection() = default;
+
+  template <typename column_t>
+  LaneProjection(const column_t& column, std::size_t begin, std::size_t size) {
+    m_indices.setConstant(column(begin + size - 1));
+    m_indices.head(size) = column.segment(begin, size);
+    m_uniform = (m_indices == m_indices(0)).all();
+  }
+
+  /// Select the projected element from the elements of all bound parameters
+  ///
+  /// @param element Returns the lanes of the bound parameter with the given
+  ///                index
+  template <typename element_t>
+  Lanes operator()(const element_t& element) const {
+    if (m_uniform) {
+      return element(m_indices(0));
+    }
+    Lanes lanes;
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      lanes(l) = element(m_indices(l))(l);
+    }
+    return lanes;
+  }
+
+ private:
+  Eigen::Array<std::uint8_t, kLanes, 1> m_indices;
+  bool m_uniform = false;
+};
+
+}  // namespace
+
+template <std::size_t kMeasurementSize>
+Result<void> BatchedGainMatrixUpdater::operator()(
+    States<kMeasurementSize>& states, NavigationDirection direction,
+    const Logger& logger) const {
+  constexpr std::size_t M = kMeasurementSize;
+  constexpr std::size_t B = eBoundSize;
+  const std::size_t nStates = states.size();
+
+  ACTS_VERBOSE("Invoked BatchedGainMatrixUpdater for "
+               << nStates << " track states with measurement dimension " << M);
+  assert(static_cast<std::size_t>(states.filtered.rows()) == nStates);
+
+  std::size_t nFailed = 0;
+  for (std::size_t begin = 0; begin < nStates; begin += kLanes) {
+    const std::size_t size = std::min(kLanes, nStates - begin);
+    const auto load = [&](const auto& column) {
+      return detail::loadLanes<kLanes>(column, begin, size);
+    };
+    const auto store = [&](const Lanes& lanes, auto&& column) {
+      detail::storeLanes<kLanes>(lanes, column, begin, size);
+    };
+
+    std::array<LaneProjection, M> projections;
+    for (std::size_t a = 0; a < M; ++a) {
+      projections[a] = LaneProjection(states.indices.col(a), begin, size);
+    }
+
+    detail::LaneVector<kLanes, B> x;
+    for (std::size_t i = 0; i < B; ++i) {
+      x[i] = load(states.predicted.col(i));
+    }
+    const auto P = detail::loadSymmetricLanes<kLanes, B>(
+        states.predictedCovariance, begin, size);
+    const auto V = detail::loadSymmetricLanes<kLanes, M>(
+        states.calibratedCovariance, begin, size);
+
+    // P H^T, with row i stored at i * M
+    std::array<Lanes, B * M> PHt;
+    for (std::size_t i = 0; i < B; ++i) {
+      for (std::size_t a = 0; a < M; ++a) {
+        PHt[i * M + a] =
+            projections[a]([&](std::size_t k) -> const Lanes& {
+              return P[i * B + k];
+            });
+      }
+    }
+
+    // Residual covariance S = H P H^T + V, only the lower triangle is needed
+    detail::LaneMatrix<kLanes, M> S;
+    for (std::size_t a = 0; a < M; ++a) {
+      for (std::size_t c = 0; c <= a; ++c) {
+        S[a * M + c] = projections[a]([&](std::size_t k) -> const Lanes& {
+                         return PHt[k * M + c];
+                       }) +
+                       V[a * M + c];
+      }
+    }
+
+    // Residual of the prediction
+    detail::LaneVector<kLanes, M> r;
+    for (std::size_t a = 0; a < M; ++a) {
+      r[a] = load(states.calibrated.col(a)) -
+             projections[a](
+                 [&](std::size_t k) -> const Lanes& { return x[k]; });
+    }
+
+    detail::LaneMatrix<kLanes, M> L;
+    detail::LaneVector<kLanes, M> invDiag;
+    const LaneMask ok = detail::choleskyLanes<kLanes, M>(S, L, invDiag);
+
+    // S^-1 r gives the filtered parameters and the chi2 of the filtered
+    // residual, which is r^T S^-1 r.
+    detail::LaneVector<kLanes, M> w = r;
+    detail::choleskySolveLanes<kLanes, M>(L, invDiag, w);
+    Lanes chi2 = r[0] * w[0];
+    for (std::size_t a = 1; a < M; ++a) {
+      chi2 += r[a] * w[a];
+    }
+    for (std::size_t i = 0; i < B; ++i) {
+      Lanes filtered = x[i];
+      for (std::size_t a = 0; a < M; ++a) {
+        filtered += PHt[i * M + a] * w[a];
+      }
+      store(filtered, states.filtered.col(i));
+    }
+
+    // Gain matrix K = P H^T S^-1, with row i stored at i * M
+    std::array<Lanes, B * M> K;
+    for (std::size_t i = 0; i < B; ++i) {
+      detail::LaneVector<kLanes, M> k;
+      for (std::size_t a = 0; a < M; ++a) {
+        k[a] = PHt[i * M + a];
+      }
+      detail::choleskySolveLanes<kLanes, M>(L, invDiag, k);
+      for (std::size_t a = 0; a < M; ++a) {
+        K[i * M + a] = k[a];
+      }
+    }
+
+    // Filtered covariance (1 - K H) P = P - K (P H^T)^T, which is symmetric
+    for (std::size_t i = 0; i < B; ++i) {
+      for (std::size_t j = i; j < B; ++j) {
+        Lanes c = P[i * B + j];
+        for (std::size_t a = 0; a < M; ++a) {
+          c -= K[i * M + a] * PHt[j * M + a];
+        }
+        store(c, states.filteredCovariance.col(i * B + j));
+        if (j != i) {
+          store(c, states.filteredCovariance.col(j * B + i));
+        }
+      }
+    }
+
+    store(chi2, states.chi2);
+    states.ok.segment(begin, size) = ok.head(size);
+    nFailed += (!ok.head(size)).count();
+  }
+
+  if (nFailed != 0) {
+    ACTS_DEBUG("Kalman update failed for " << nFailed << " of " << nStates
+                                           << " track states");
+    return (direction == NavigationDirection::Forward)
+               ? KalmanFitterError::ForwardUpdateFailed
+               : KalmanFitterError::BackwardUpdateFailed;
+  }
+
+  return Result<void>::success();
+}
+
+// Explicit instantiations for all measurement dimensions
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<1>&, NavigationDirection, const Logger&) const;
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<2>&, NavigationDirection, const Logger&) const;
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<3>&, NavigationDirection, const Logger&) const;
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<4>&, NavigationDirection, const Logger&) const;
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<5>&, NavigationDirection, const Logger&) const;
+template Result<void> BatchedGainMatrixUpdater::operator()(
+    States<6>&, NavigationDirection, const Logger&) const;
+
+}  // namespace Acts
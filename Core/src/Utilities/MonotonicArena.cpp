@@ -0,0 +1,93 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Utilities/MonotonicArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+constexpr std::size_t kMinBlockSize = 4096;
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+}  // namespace
+
+Acts::MonotonicArena::MonotonicArena(std::size_t initialSize,
+                                     std::pmr::memory_resource* upstream)
+    : m_upstream{upstream} {
+  if (initialSize > 0) {
+    addBlock(initialSize);
+    m_upstreamAllocations = 0;
+  }
+}
+
+Acts::MonotonicArena::~MonotonicArena() {
+  releaseBlocks();
+}
+
+void Acts::MonotonicArena::reset() {
+  if (m_blocks.size() > 1) {
+    // merge the blocks such that the next cycle is served from a single one
+    std::size_t size = std::max(m_capacity, m_peakBytes);
+    releaseBlocks();
+    addBlock(size);
+  }
+  m_offset = 0;
+  m_bytes = 0;
+  m_upstreamAllocations = 0;
+}
+
+Acts::MonotonicArena::Statistics Acts::MonotonicArena::statistics() const {
+  Statistics stats;
+  stats.bytes = m_bytes;
+  stats.peakBytes = m_peakBytes;
+  stats.capacity = m_capacity;
+  stats.upstreamAllocations = m_upstreamAllocations;
+  return stats;
+}
+
+void* Acts::MonotonicArena::do_allocate(std::size_t bytes,
+                                        std::size_t alignment) {
+  auto padding = [&]() -> std::size_t {
+    auto address =
+        reinterpret_cast<std::uintptr_t>(m_blocks.back().data) + m_offset;
+    return (alignment - address % alignment) % alignment;
+  };
+
+  if (m_blocks.empty() ||
+      m_offset + padding() + bytes > m_blocks.back().size) {
+    std::size_t size = bytes + alignment;
+    if (!m_blocks.empty()) {
+      size = std::max(size, 2 * m_blocks.back().size);
+    }
+    addBlock(std::max(size, kMinBlockSize));
+  }
+
+  std::size_t used = padding() + bytes;
+  void* p = m_blocks.back().data + m_offset + used - bytes;
+  m_offset += used;
+  m_bytes += used;
+  m_peakBytes = std::max(m_peakBytes, m_bytes);
+  return p;
+}
+
+void Acts::MonotonicArena::addBlock(std::size_t size) {
+  auto* data =
+      static_cast<std::byte*>(m_upstream->allocate(size, kBlockAlignment));
+  m_blocks.push_back({data, size});
+  m_offset = 0;
+  m_capacity += size;
+  ++m_upstreamAllocations;
+}
+
+void Acts::MonotonicArena::releaseBlocks() {
+  for (const Block& block : m_blocks) {
+    m_upstream->deallocate(block.data, block.size, kBlockAlignment);
+  }
+  m_blocks.clear();
+  m_capacity = 0;
+}
@@ -15,8 +15,11 @@
 #include "ActsExamples/MaterialMapping/IMaterialWriter.hpp"
 
 #include <climits>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <utility>
 
 namespace Acts {
 
@@ -48,8 +51,11 @@ namespace ActsExamples {
 /// However, running it in one single event, puts enormous pressure onto
 /// the I/O structure.
 ///
-/// It therefore saves the mapping state/cache as a private member variable
-/// and is designed to be executed in a single threaded mode.
+/// Each event is therefore mapped into its own mapping state/cache. The
+/// states of adjacent events are merged along a binary tree over the event
+/// numbers, and the remaining ones are merged in event order at the end of
+/// the run. The merge order thus only depends on the event numbers, and the
+/// maps are reproducible for any number of threads.
 class MaterialMapping : public ActsExamples::IAlgorithm {
  public:
   /// @class nested Config class
@@ -98,6 +104,11 @@ class MaterialMapping : public ActsExamples::IAlgorithm {
   ActsExamples::ProcessCode execute(
       const AlgorithmContext& context) const override;
 
+  /// Framework finalize method
+  ///
+  /// Merges the mapping states of all events into the final one
+  ActsExamples::ProcessCode finalize() override;
+
   /// Return the parameters to optimised the material map for a given surface
   /// Those parameters are the variance and the number of track for each bin
   ///
@@ -108,11 +119,25 @@ class MaterialMapping : public ActsExamples::IAlgorithm {
   const Config& config() const { return m_cfg; }
 
  private:
+  /// The mapping states of a range of consecutive events
+  struct EventStates {
+    std::optional<Acts::SurfaceMaterialMapper::State> surface;
+    std::optional<Acts::VolumeMaterialMapper::State> volume;
+  };
+
+  /// Merge the states of the event range following the one of `states`
+  void mergeStates(EventStates& states, const EventStates& next) const;
+
   Config m_cfg;  //!< internal config object
-  Acts::SurfaceMaterialMapper::State
-      m_mappingState;  //!< Material mapping state
-  Acts::VolumeMaterialMapper::State
-      m_mappingStateVol;  //!< Material mapping state
+  /// Material mapping states, they are the empty prototypes of the event
+  /// states during the run and contain all events after `finalize()`
+  Acts::SurfaceMaterialMapper::State m_mappingState;
+  Acts::VolumeMaterialMapper::State m_mappingStateVol;
+
+  /// Event ranges waiting for their neighbour to be merged with, keyed by
+  /// the level and the index in the binary tree over the event numbers
+  mutable std::map<std::pair<size_t, size_t>, EventStates> m_pendingStates;
+  mutable std::mutex m_pendingStatesMutex;
 };
 
 }  // namespace ActsExamples
@@ -11,8 +11,10 @@
 #include "ActsExamples/Framework/WhiteBoard.hpp"
 
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 
 ActsExamples::MaterialMapping::MaterialMapping(
     const ActsExamples::MaterialMapping::Config& cfg,
@@ -27,9 +29,6 @@ ActsExamples::MaterialMapping::MaterialMapping(
     throw std::invalid_argument("Missing tracking geometry");
   }
 
-  ACTS_INFO("This algorithm requires inter-event information, "
-            << "run in single-threaded mode!");
-
   if (m_cfg.materialSurfaceMapper) {
     // Generate and retrieve the central cache object
     m_mappingState = m_cfg.materialSurfaceMapper->createState(
@@ -97,31 +96,90 @@ ActsExamples::ProcessCode ActsExamples::MaterialMapping::execute(
           .get<std::unordered_map<size_t, Acts::RecordedMaterialTrack>>(
               m_cfg.collection);
 
+  // Map the tracks of this event into its own states
+  EventStates states;
   if (m_cfg.materialSurfaceMapper) {
-    // To make it work with the framework needs a lock guard
-    auto mappingState =
-        const_cast<Acts::SurfaceMaterialMapper::State*>(&m_mappingState);
+    states.surface = m_cfg.materialSurfaceMapper->createState(m_mappingState);
     for (auto& [idTrack, mTrack] : mtrackCollection) {
       // Map this one onto the geometry
-      m_cfg.materialSurfaceMapper->mapMaterialTrack(*mappingState, mTrack);
+      m_cfg.materialSurfaceMapper->mapMaterialTrack(*states.surface, mTrack);
     }
   }
   if (m_cfg.materialVolumeMapper) {
-    // To make it work with the framework needs a lock guard
-    auto mappingState =
-        const_cast<Acts::VolumeMaterialMapper::State*>(&m_mappingStateVol);
-
+    states.volume = m_cfg.materialVolumeMapper->createState(m_mappingStateVol);
     for (auto& [idTrack, mTrack] : mtrackCollection) {
       // Map this one onto the geometry
-      m_cfg.materialVolumeMapper->mapMaterialTrack(*mappingState, mTrack);
+      m_cfg.materialVolumeMapper->mapMaterialTrack(*states.volume, mTrack);
     }
   }
   // Write take the collection to the EventStore
   context.eventStore.add(m_cfg.mappingMaterialCollection,
                          std::move(mtrackCollection));
+
+  // Merge with the neighbouring event range as long as it is done already.
+  // The node at a given level and index holds the events
+  // [index * 2^level, (index + 1) * 2^level), which makes the merge order
+  // independent of the order in which the events finish.
+  size_t level = 0;
+  size_t index = context.eventNumber;
+  while (true) {
+    EventStates neighbour;
+    {
+      std::lock_guard<std::mutex> lock(m_pendingStatesMutex);
+      auto pending = m_pendingStates.find({level, index ^ 1u});
+      if (pending == m_pendingStates.end()) {
+        m_pendingStates.emplace(std::make_pair(level, index),
+                                std::move(states));
+        break;
+      }
+      neighbour = std::move(pending->second);
+      m_pendingStates.erase(pending);
+    }
+    // The merging is done outside the lock, the earlier events go first
+    if (index % 2 == 0) {
+      mergeStates(states, neighbour);
+    } else {
+      mergeStates(neighbour, states);
+      states = std::move(neighbour);
+    }
+    level += 1;
+    index /= 2;
+  }
+  return ActsExamples::ProcessCode::SUCCESS;
+}
+
+ActsExamples::ProcessCode ActsExamples::MaterialMapping::finalize() {
+  // Merge the remaining event ranges in the order of their first event
+  std::map<size_t, EventStates*> ranges;
+  for (auto& [node, states] : m_pendingStates) {
+    ranges.emplace(node.second << node.first, &states);
+  }
+  for (auto& [firstEvent, states] : ranges) {
+    if (m_cfg.materialSurfaceMapper) {
+      m_cfg.materialSurfaceMapper->mergeState(m_mappingState,
+                                              *states->surface);
+    }
+    if (m_cfg.materialVolumeMapper) {
+      m_cfg.materialVolumeMapper->mergeState(m_mappingStateVol,
+                                             *states->volume);
+    }
+  }
+  ACTS_DEBUG("Merged the mapping states of " << ranges.size()
+                                             << " event ranges");
+  m_pendingStates.clear();
   return ActsExamples::ProcessCode::SUCCESS;
 }
 
+void ActsExamples::MaterialMapping::mergeStates(EventStates& states,
+                                                const EventStates& next) const {
+  if (m_cfg.materialSurfaceMapper) {
+    m_cfg.materialSurfaceMapper->mergeState(*states.surface, *next.surface);
+  }
+  if (m_cfg.materialVolumeMapper) {
+    m_cfg.materialVolumeMapper->mergeState(*states.volume, *next.volume);
+  }
+}
+
 std::vector<std::pair<double, int>>
 ActsExamples::MaterialMapping::scoringParameters(uint64_t surfaceID) {
   std::vector<std::pair<double, int>> scoringParameters;
@@ -13,10 +13,16 @@
 #include "Acts/Seeding/SeedFinder.hpp"
 #include "Acts/Seeding/SeedFinderConfig.hpp"
 #include "Acts/Seeding/SpacePointGrid.hpp"
+#include "ActsExamples/EventData/ProtoTrack.hpp"
+#include "ActsExamples/EventData/SimSeed.hpp"
 #include "ActsExamples/EventData/SimSpacePoint.hpp"
+#include "ActsExamples/Framework/DataHandle.hpp"
 #include "ActsExamples/Framework/IAlgorithm.hpp"
 #include "ActsExamples/Framework/ProcessCode.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -53,6 +59,12 @@ class SeedingAlgorithm final : public IAlgorithm {
     // number of phiBin neighbors at each side of the current bin that will be
     // used to search for SPs
     int numPhiNeighbors = 0;
+
+    /// Number of tasks the groups of middle space point bins of one event are
+    /// split into. The tasks are processed in parallel if the sequencer runs
+    /// with more than one thread. The seeds do not depend on the number of
+    /// tasks nor on the number of threads.
+    std::size_t numSeedingTasks = 1;
   };
 
   /// Construct the seeding algorithm.
@@ -71,10 +83,31 @@ class SeedingAlgorithm final : public IAlgorithm {
   const Config& config() const { return m_cfg; }
 
  private:
+  /// Seeding state and seeds of one seeding task, which are kept between
+  /// events such that the seeding does not allocate in the steady state
+  struct TaskCache {
+    Acts::SeedFinder<SimSpacePoint>::SeedingState state;
+    SimSeedContainer seeds;
+  };
+
+  /// Take a task cache from the pool, or create a new one
+  std::unique_ptr<TaskCache> acquireTaskCache() const;
+  /// Return a task cache to the pool
+  void releaseTaskCache(std::unique_ptr<TaskCache> cache) const;
+
   Acts::SeedFinder<SimSpacePoint> m_seedFinder;
   std::shared_ptr<const Acts::BinFinder<SimSpacePoint>> m_bottomBinFinder;
   std::shared_ptr<const Acts::BinFinder<SimSpacePoint>> m_topBinFinder;
   Config m_cfg;
+
+  std::vector<std::unique_ptr<ReadDataHandle<SimSpacePointContainer>>>
+      m_inputSpacePoints;
+  WriteDataHandle<SimSeedContainer> m_outputSeeds{this, "OutputSeeds"};
+  WriteDataHandle<ProtoTrackContainer> m_outputProtoTracks{this,
+                                                           "OutputProtoTracks"};
+
+  mutable std::mutex m_taskCacheMutex;
+  mutable std::vector<std::unique_ptr<TaskCache>> m_taskCaches;
 };
 
 }  // namespace ActsExamples
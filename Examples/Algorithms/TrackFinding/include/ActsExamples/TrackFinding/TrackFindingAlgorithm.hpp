@@ -15,15 +15,21 @@
 #include "Acts/TrackFinding/CombinatorialKalmanFilter.hpp"
 #include "Acts/TrackFinding/MeasurementSelector.hpp"
 #include "Acts/TrackFinding/SourceLinkAccessorConcept.hpp"
+#include "Acts/Utilities/MonotonicArena.hpp"
 #include "ActsExamples/EventData/IndexSourceLink.hpp"
 #include "ActsExamples/EventData/Measurement.hpp"
+#include "ActsExamples/EventData/SimSeed.hpp"
 #include "ActsExamples/EventData/Track.hpp"
+#include "ActsExamples/Framework/DataHandle.hpp"
 #include "ActsExamples/Framework/IAlgorithm.hpp"
 #include "ActsExamples/Framework/ProcessCode.hpp"
 #include "ActsExamples/MagneticField/MagneticField.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <tbb/combinable.h>
@@ -66,6 +72,9 @@ class TrackFindingAlgorithm final : public IAlgorithm {
     std::string inputSourceLinks;
     /// Input initial track parameter estimates for for each proto track.
     std::string inputInitialTrackParameters;
+    /// Optional input seeds collection, in the same order as the initial
+    /// track parameters. Only needed to skip seeds with claimed measurements.
+    std::string inputSeeds;
     /// Output find trajectories collection.
     std::string outputTracks;
     /// Type erased track finder function.
@@ -74,6 +83,16 @@ class TrackFindingAlgorithm final : public IAlgorithm {
     Acts::MeasurementSelector::Config measurementSelectorCfg;
     /// Compute shared hit information
     bool computeSharedHits = false;
+    /// Number of tasks the seeds of one event are split into. The tracks of
+    /// each task are found into separate containers, which are appended to the
+    /// output in the order of the seeds.
+    std::size_t numFindingTasks = 1;
+    /// Skip seeds whose measurements are all used by the tracks found from
+    /// earlier seeds. Requires the input seeds. The tracks do not depend on
+    /// the number of tasks. With more than one task, all seeds are processed
+    /// and the tracks of the skipped seeds are dropped when the tasks are
+    /// merged, such that skipping saves no time.
+    bool skipClaimedSeeds = false;
   };
 
   /// Constructor of the track finding algorithm
@@ -99,11 +118,30 @@ class TrackFindingAlgorithm final : public IAlgorithm {
 
   ActsExamples::ProcessCode finalize() override;
 
+  /// Take an arena for the track states of a task from the pool
+  std::unique_ptr<Acts::MonotonicArena> acquireArena() const;
+  /// Reset an arena and return it to the pool
+  void releaseArena(std::unique_ptr<Acts::MonotonicArena> arena) const;
+
  private:
   Config m_cfg;
 
   mutable std::atomic<size_t> m_nTotalSeeds{0};
   mutable std::atomic<size_t> m_nFailedSeeds{0};
+  mutable std::atomic<size_t> m_nSkippedSeeds{0};
+
+  ReadDataHandle<MeasurementContainer> m_inputMeasurements{this,
+                                                           "InputMeasurements"};
+  ReadDataHandle<IndexSourceLinkContainer> m_inputSourceLinks{
+      this, "InputSourceLinks"};
+  ReadDataHandle<TrackParametersContainer> m_inputInitialTrackParameters{
+      this, "InputInitialTrackParameters"};
+  ReadDataHandle<SimSeedContainer> m_inputSeeds{this, "InputSeeds"};
+  WriteDataHandle<ConstTrackContainer> m_outputTracks{this, "OutputTracks"};
+
+  /// arenas for the track states of the tasks, reused between events
+  mutable std::mutex m_arenaMutex;
+  mutable std::vector<std::unique_ptr<Acts::MonotonicArena>> m_arenas;
 
   mutable tbb::combinable<Acts::VectorMultiTrajectory::Statistics>
       m_memoryStatistics{[]() {
@@ -18,10 +18,14 @@
 #include "ActsExamples/EventData/ProtoTrack.hpp"
 #include "ActsExamples/EventData/SimSeed.hpp"
 #include "ActsExamples/Framework/WhiteBoard.hpp"
+#include "ActsExamples/Utilities/tbbWrap.hpp"
 
+#include <algorithm>
 #include <csignal>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 
 ActsExamples::SeedingAlgorithm::SeedingAlgorithm(
     ActsExamples::SeedingAlgorithm::Config cfg, Acts::Logging::Level lvl)
@@ -48,6 +52,18 @@ ActsExamples::SeedingAlgorithm::SeedingAlgorithm(
   if (m_cfg.outputSeeds.empty()) {
     throw std::invalid_argument("Missing seeds output collection");
   }
+  for (const auto& i : m_cfg.inputSpacePoints) {
+    auto& handle = m_inputSpacePoints.emplace_back(
+        std::make_unique<ReadDataHandle<SimSpacePointContainer>>(
+            this, "InputSpacePoints#" +
+                      std::to_string(m_inputSpacePoints.size())));
+    handle->initialize(i);
+  }
+  m_outputSeeds.initialize(m_cfg.outputSeeds);
+  m_outputProtoTracks.initialize(m_cfg.outputProtoTracks);
+  if (m_cfg.numSeedingTasks == 0) {
+    throw std::invalid_argument("Number of seeding tasks must be at least 1");
+  }
 
   if (m_cfg.gridConfig.rMax != m_cfg.seedFinderConfig.rMax and
       m_cfg.allowSeparateRMax == false) {
@@ -195,15 +211,14 @@ ActsExamples::ProcessCode ActsExamples::SeedingAlgorithm::execute(
   // configured input sources.
   // pre-compute the total size required so we only need to allocate once
   size_t nSpacePoints = 0;
-  for (const auto& isp : m_cfg.inputSpacePoints) {
-    nSpacePoints += ctx.eventStore.get<SimSpacePointContainer>(isp).size();
+  for (const auto& isp : m_inputSpacePoints) {
+    nSpacePoints += (*isp)(ctx).size();
   }
 
   std::vector<const SimSpacePoint*> spacePointPtrs;
   spacePointPtrs.reserve(nSpacePoints);
-  for (const auto& isp : m_cfg.inputSpacePoints) {
-    for (const auto& spacePoint :
-         ctx.eventStore.get<SimSpacePointContainer>(isp)) {
+  for (const auto& isp : m_inputSpacePoints) {
+    for (const auto& spacePoint : (*isp)(ctx)) {
       // since the event store owns the space points, their pointers should be
       // stable and we do not need to create local copies.
       spacePointPtrs.push_back(&spacePoint);
@@ -240,17 +255,64 @@ ActsExamples::ProcessCode ActsExamples::SeedingAlgorithm::execute(
           m_cfg.seedFinderConfig.deltaRMiddleMinSPRange,
       up - m_cfg.seedFinderConfig.deltaRMiddleMaxSPRange);
 
-  // run the seeding
-  static thread_local SimSeedContainer seeds;
-  seeds.clear();
-  static thread_local decltype(m_seedFinder)::SeedingState state;
-
-  auto group = spacePointsGrouping.begin();
-  auto groupEnd = spacePointsGrouping.end();
-  for (; !(group == groupEnd); ++group) {
-    m_seedFinder.createSeedsForGroup(
-        m_cfg.seedFinderOptions, state, std::back_inserter(seeds),
-        group.bottom(), group.middle(), group.top(), rMiddleSPRange);
+  // run the seeding, the seeds and the groups are not thread local, since
+  // the nested parallel section can run the seeding of another event on this
+  // thread
+  SimSeedContainer seeds;
+
+  if (m_cfg.numSeedingTasks == 1) {
+    static thread_local decltype(m_seedFinder)::SeedingState state;
+
+    auto group = spacePointsGrouping.begin();
+    auto groupEnd = spacePointsGrouping.end();
+    for (; !(group == groupEnd); ++group) {
+      m_seedFinder.createSeedsForGroup(
+          m_cfg.seedFinderOptions, state, std::back_inserter(seeds),
+          group.bottom(), group.middle(), group.top(), rMiddleSPRange);
+    }
+  } else {
+    // the groups are independent, they are split into consecutive ranges
+    // which are processed in parallel with their own seeding state
+    struct Group {
+      Acts::Neighborhood<SimSpacePoint> bottom;
+      Acts::Neighborhood<SimSpacePoint> middle;
+      Acts::Neighborhood<SimSpacePoint> top;
+    };
+    std::vector<Group> groups;
+    auto group = spacePointsGrouping.begin();
+    auto groupEnd = spacePointsGrouping.end();
+    for (; !(group == groupEnd); ++group) {
+      groups.push_back({group.bottom(), group.middle(), group.top()});
+    }
+
+    const std::size_t nTasks = std::min(m_cfg.numSeedingTasks, groups.size());
+    std::vector<std::unique_ptr<TaskCache>> caches;
+    caches.reserve(nTasks);
+    for (std::size_t task = 0; task < nTasks; ++task) {
+      caches.push_back(acquireTaskCache());
+    }
+    tbbWrap::parallel_for(
+        tbb::blocked_range<std::size_t>(0, nTasks),
+        [&](const tbb::blocked_range<std::size_t>& range) {
+          for (std::size_t task = range.begin(); task != range.end(); ++task) {
+            TaskCache& cache = *caches[task];
+            const std::size_t begin = groups.size() * task / nTasks;
+            const std::size_t end = groups.size() * (task + 1) / nTasks;
+            for (std::size_t i = begin; i < end; ++i) {
+              m_seedFinder.createSeedsForGroup(
+                  m_cfg.seedFinderOptions, cache.state,
+                  std::back_inserter(cache.seeds), groups[i].bottom,
+                  groups[i].middle, groups[i].top, rMiddleSPRange);
+            }
+          }
+        });
+
+    // merging in the order of the tasks gives the same seeds as the
+    // sequential processing of the groups
+    for (auto& cache : caches) {
+      seeds.insert(seeds.end(), cache->seeds.begin(), cache->seeds.end());
+      releaseTaskCache(std::move(cache));
+    }
   }
 
   // extract proto tracks, i.e. groups of measurement indices, from tracks seeds
@@ -273,7 +335,30 @@ ActsExamples::ProcessCode ActsExamples::SeedingAlgorithm::execute(
   ACTS_DEBUG("Created " << seeds.size() << " track seeds from "
                         << spacePointPtrs.size() << " space points");
 
-  ctx.eventStore.add(m_cfg.outputSeeds, SimSeedContainer{seeds});
-  ctx.eventStore.add(m_cfg.outputProtoTracks, ProtoTrackContainer{protoTracks});
+  m_outputSeeds(ctx, std::move(seeds));
+  m_outputProtoTracks(ctx, ProtoTrackContainer{protoTracks});
   return ActsExamples::ProcessCode::SUCCESS;
 }
+
+std::unique_ptr<ActsExamples::SeedingAlgorithm::TaskCache>
+ActsExamples::SeedingAlgorithm::acquireTaskCache() const {
+  std::unique_ptr<TaskCache> cache;
+  {
+    std::lock_guard<std::mutex> lock(m_taskCacheMutex);
+    if (not m_taskCaches.empty()) {
+      cache = std::move(m_taskCaches.back());
+      m_taskCaches.pop_back();
+    }
+  }
+  if (not cache) {
+    cache = std::make_unique<TaskCache>();
+  }
+  cache->seeds.clear();
+  return cache;
+}
+
+void ActsExamples::SeedingAlgorithm::releaseTaskCache(
+    std::unique_ptr<TaskCache> cache) const {
+  std::lock_guard<std::mutex> lock(m_taskCacheMutex);
+  m_taskCaches.push_back(std::move(cache));
+}
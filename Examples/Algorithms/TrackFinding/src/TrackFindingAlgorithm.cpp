@@ -10,18 +10,26 @@
 
 #include "Acts/EventData/MultiTrajectory.hpp"
 #include "Acts/EventData/Track.hpp"
+#include "Acts/EventData/TrackHelpers.hpp"
 #include "Acts/EventData/VectorMultiTrajectory.hpp"
 #include "Acts/EventData/VectorTrackContainer.hpp"
 #include "Acts/Surfaces/PerigeeSurface.hpp"
 #include "Acts/TrackFitting/GainMatrixSmoother.hpp"
 #include "Acts/TrackFitting/GainMatrixUpdater.hpp"
+#include "Acts/Utilities/MonotonicArena.hpp"
 #include "ActsExamples/EventData/Measurement.hpp"
+#include "ActsExamples/EventData/SimSeed.hpp"
 #include "ActsExamples/EventData/Track.hpp"
 #include "ActsExamples/Framework/ProcessCode.hpp"
 #include "ActsExamples/Framework/WhiteBoard.hpp"
+#include "ActsExamples/Utilities/tbbWrap.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <system_error>
+#include <vector>
 
 #include <boost/histogram.hpp>
 
@@ -42,17 +50,40 @@ ActsExamples::TrackFindingAlgorithm::TrackFindingAlgorithm(
   if (m_cfg.outputTracks.empty()) {
     throw std::invalid_argument("Missing tracks output collection");
   }
+  if (m_cfg.skipClaimedSeeds and m_cfg.inputSeeds.empty()) {
+    throw std::invalid_argument(
+        "Missing seeds input collection to skip seeds with claimed "
+        "measurements");
+  }
+  if (m_cfg.numFindingTasks == 0) {
+    throw std::invalid_argument("Number of track finding tasks must be > 0");
+  }
+  m_inputMeasurements.initialize(m_cfg.inputMeasurements);
+  m_inputSourceLinks.initialize(m_cfg.inputSourceLinks);
+  m_inputInitialTrackParameters.initialize(m_cfg.inputInitialTrackParameters);
+  if (m_cfg.skipClaimedSeeds) {
+    m_inputSeeds.initialize(m_cfg.inputSeeds);
+  }
+  m_outputTracks.initialize(m_cfg.outputTracks);
 }
 
 ActsExamples::ProcessCode ActsExamples::TrackFindingAlgorithm::execute(
     const ActsExamples::AlgorithmContext& ctx) const {
   // Read input data
-  const auto& measurements =
-      ctx.eventStore.get<MeasurementContainer>(m_cfg.inputMeasurements);
-  const auto& sourceLinks =
-      ctx.eventStore.get<IndexSourceLinkContainer>(m_cfg.inputSourceLinks);
-  const auto& initialParameters = ctx.eventStore.get<TrackParametersContainer>(
-      m_cfg.inputInitialTrackParameters);
+  const auto& measurements = m_inputMeasurements(ctx);
+  const auto& sourceLinks = m_inputSourceLinks(ctx);
+  const auto& initialParameters = m_inputInitialTrackParameters(ctx);
+  const SimSeedContainer* seeds = nullptr;
+  if (m_cfg.skipClaimedSeeds) {
+    seeds = &m_inputSeeds(ctx);
+    if (seeds->size() != initialParameters.size()) {
+      ACTS_ERROR("Number of seeds " << seeds->size()
+                                    << " does not match the number of initial "
+                                       "track parameters "
+                                    << initialParameters.size());
+      return ProcessCode::ABORT;
+    }
+  }
 
   // Construct a perigee surface as the target surface
   auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
@@ -100,27 +131,160 @@ ActsExamples::ProcessCode ActsExamples::TrackFindingAlgorithm::execute(
   TrackContainer tracks(trackContainer, trackStateContainer);
 
   tracks.addColumn<unsigned int>("trackGroup");
+
   Acts::TrackAccessor<unsigned int> seedNumber("trackGroup");
 
-  unsigned int nSeed = 0;
+  // Measurements used by the tracks of the seeds processed so far
+  std::vector<bool> claimed;
+  if (seeds != nullptr) {
+    claimed.resize(sourceLinks.size(), false);
+  }
+  auto isClaimed = [&](std::size_t iseed) {
+    const auto& sps = seeds->at(iseed).sp();
+    return std::all_of(sps.begin(), sps.end(), [&](auto sp) {
+      return std::all_of(
+          sp->sourceLinks().begin(), sp->sourceLinks().end(),
+          [&](const auto& sl) {
+            return claimed.at(sl.template get<IndexSourceLink>().index());
+          });
+    });
+  };
+  auto claim = [&](const auto& track) {
+    for (auto state : track.trackStates()) {
+      if (state.typeFlags().test(Acts::TrackStateFlag::MeasurementFlag)) {
+        claimed.at(state.uncalibratedSourceLink()
+                       .template get<IndexSourceLink>()
+                       .index()) = true;
+      }
+    }
+  };
+
+  // Find the tracks for the seeds [begin, end) into the given container. If
+  // the claimed seeds are skipped here, the measurements of the found tracks
+  // are claimed. Otherwise failures are only recorded in @p errors.
+  auto findTracks = [&](std::size_t begin, std::size_t end,
+                        TrackContainer& tracksOfSeeds, bool skipClaimed,
+                        std::vector<std::error_code>& errors) {
+    for (std::size_t iseed = begin; iseed < end; ++iseed) {
+      m_nTotalSeeds++;
+
+      if (skipClaimed && isClaimed(iseed)) {
+        m_nSkippedSeeds++;
+        continue;
+      }
+
+      auto result = (*m_cfg.findTracks)(initialParameters.at(iseed), options,
+                                        tracksOfSeeds);
 
-  for (std::size_t iseed = 0; iseed < initialParameters.size(); ++iseed) {
-    auto result =
-        (*m_cfg.findTracks)(initialParameters.at(iseed), options, tracks);
-    m_nTotalSeeds++;
-    nSeed++;
+      if (!result.ok()) {
+        errors[iseed] = result.error();
+        continue;
+      }
 
-    if (!result.ok()) {
-      m_nFailedSeeds++;
-      ACTS_WARNING("Track finding failed for seed " << iseed << " with error"
-                                                    << result.error());
-      continue;
+      for (auto& track : result.value()) {
+        seedNumber(track) = iseed + 1;
+        if (skipClaimed) {
+          claim(track);
+        }
+      }
     }
+  };
+
+  auto reportFailure = [&](std::size_t iseed, const std::error_code& error) {
+    m_nFailedSeeds++;
+    ACTS_WARNING("Track finding failed for seed " << iseed << " with error"
+                                                  << error);
+  };
+
+  // The seeds are split into consecutive ranges, whose tracks are found into
+  // separate containers. Their track states, including the ones of the
+  // discarded branches, are allocated from an arena, which is reset once the
+  // found tracks are appended to the output.
+  const std::size_t nTasks = std::max<std::size_t>(
+      1, std::min(m_cfg.numFindingTasks, initialParameters.size()));
+  std::vector<std::unique_ptr<Acts::MonotonicArena>> arenas;
+  std::vector<TrackContainer> taskTracks;
+  arenas.reserve(nTasks);
+  taskTracks.reserve(nTasks);
+  for (std::size_t task = 0; task < nTasks; ++task) {
+    arenas.push_back(acquireArena());
+    auto& tracksOfTask = taskTracks.emplace_back(
+        std::make_shared<Acts::VectorTrackContainer>(),
+        std::make_shared<Acts::VectorMultiTrajectory>(arenas.back().get()));
+    tracksOfTask.addColumn<unsigned int>("trackGroup");
+  }
 
-    auto& tracksForSeed = result.value();
-    for (auto& track : tracksForSeed) {
-      seedNumber(track) = nSeed;
+  std::vector<std::error_code> errors(initialParameters.size());
+  std::vector<bool> keepSeed(initialParameters.size(), true);
+  if (nTasks == 1) {
+    findTracks(0, initialParameters.size(), taskTracks.front(),
+               seeds != nullptr, errors);
+    for (std::size_t iseed = 0; iseed < errors.size(); ++iseed) {
+      if (errors[iseed]) {
+        reportFailure(iseed, errors[iseed]);
+      }
     }
+  } else {
+    tbbWrap::parallel_for(
+        tbb::blocked_range<std::size_t>(0, nTasks),
+        [&](const tbb::blocked_range<std::size_t>& range) {
+          for (std::size_t task = range.begin(); task != range.end(); ++task) {
+            findTracks(initialParameters.size() * task / nTasks,
+                       initialParameters.size() * (task + 1) / nTasks,
+                       taskTracks[task], false, errors);
+          }
+        });
+
+    // The claimed seeds are skipped in the order of the seeds, with the
+    // measurements of the tracks of the earlier seeds which are kept, which
+    // gives the same tracks as the sequential processing.
+    if (seeds != nullptr) {
+      std::vector<std::vector<std::size_t>> tracksOfSeed(
+          initialParameters.size());
+      std::vector<std::size_t> taskOfSeed(initialParameters.size());
+      for (std::size_t task = 0; task < nTasks; ++task) {
+        for (auto track : taskTracks[task]) {
+          tracksOfSeed[seedNumber(track) - 1].push_back(track.index());
+          taskOfSeed[seedNumber(track) - 1] = task;
+        }
+      }
+      for (std::size_t iseed = 0; iseed < initialParameters.size(); ++iseed) {
+        if (isClaimed(iseed)) {
+          keepSeed[iseed] = false;
+          m_nSkippedSeeds++;
+          continue;
+        }
+        for (auto itrack : tracksOfSeed[iseed]) {
+          claim(taskTracks[taskOfSeed[iseed]].getTrack(itrack));
+        }
+      }
+    }
+    for (std::size_t iseed = 0; iseed < errors.size(); ++iseed) {
+      if (keepSeed[iseed] && errors[iseed]) {
+        reportFailure(iseed, errors[iseed]);
+      }
+    }
+  }
+
+  // appending in the order of the tasks keeps the order of the seeds
+  Acts::ConstTrackAccessor<unsigned int> constSeedNumber("trackGroup");
+  auto keep = [&](const auto& track) {
+    return keepSeed[constSeedNumber(track) - 1];
+  };
+  for (auto& tracksOfTask : taskTracks) {
+    auto offset = tracks.size();
+    Acts::appendTracks(tracksOfTask, tracks, keep);
+    for (auto track : tracksOfTask) {
+      if (keep(track)) {
+        seedNumber(tracks.getTrack(offset++)) = seedNumber(track);
+      }
+    }
+  }
+
+  // the task containers have to be gone before the arenas are reset
+  taskTracks.clear();
+  for (auto& arena : arenas) {
+    releaseArena(std::move(arena));
   }
 
   // Compute shared hits from all the reconstructed tracks
@@ -144,14 +308,35 @@ ActsExamples::ProcessCode ActsExamples::TrackFindingAlgorithm::execute(
   ConstTrackContainer constTracks{constTrackContainer,
                                   constTrackStateContainer};
 
-  ctx.eventStore.add(m_cfg.outputTracks, std::move(constTracks));
+  m_outputTracks(ctx, std::move(constTracks));
   return ActsExamples::ProcessCode::SUCCESS;
 }
 
+std::unique_ptr<Acts::MonotonicArena>
+ActsExamples::TrackFindingAlgorithm::acquireArena() const {
+  {
+    std::lock_guard<std::mutex> lock(m_arenaMutex);
+    if (not m_arenas.empty()) {
+      auto arena = std::move(m_arenas.back());
+      m_arenas.pop_back();
+      return arena;
+    }
+  }
+  return std::make_unique<Acts::MonotonicArena>();
+}
+
+void ActsExamples::TrackFindingAlgorithm::releaseArena(
+    std::unique_ptr<Acts::MonotonicArena> arena) const {
+  arena->reset();
+  std::lock_guard<std::mutex> lock(m_arenaMutex);
+  m_arenas.push_back(std::move(arena));
+}
+
 ActsExamples::ProcessCode ActsExamples::TrackFindingAlgorithm::finalize() {
   ACTS_INFO("TrackFindingAlgorithm statistics:");
   ACTS_INFO("- total seeds: " << m_nTotalSeeds);
   ACTS_INFO("- failed seeds: " << m_nFailedSeeds);
+  ACTS_INFO("- skipped seeds: " << m_nSkippedSeeds);
   ACTS_INFO("- failure ratio: " << static_cast<double>(m_nFailedSeeds) /
                                        m_nTotalSeeds);
 
@@ -28,6 +28,9 @@ ActsExamples::TrackParamsEstimationAlgorithm::TrackParamsEstimationAlgorithm(
   if (m_cfg.outputTrackParameters.empty()) {
     throw std::invalid_argument("Missing track parameters output collection");
   }
+  m_inputSeeds.initialize(m_cfg.inputSeeds);
+  m_outputTrackParameters.initialize(m_cfg.outputTrackParameters);
+  m_outputSeeds.maybeInitialize(m_cfg.outputSeeds);
   if (not m_cfg.trackingGeometry) {
     throw std::invalid_argument("Missing tracking geometry");
   }
@@ -58,11 +61,15 @@ ActsExamples::TrackParamsEstimationAlgorithm::TrackParamsEstimationAlgorithm(
 
 ActsExamples::ProcessCode ActsExamples::TrackParamsEstimationAlgorithm::execute(
     const ActsExamples::AlgorithmContext& ctx) const {
-  auto const& seeds = ctx.eventStore.get<SimSeedContainer>(m_cfg.inputSeeds);
+  auto const& seeds = m_inputSeeds(ctx);
   ACTS_VERBOSE("Read " << seeds.size() << " seeds");
 
   TrackParametersContainer trackParameters;
   trackParameters.reserve(seeds.size());
+  SimSeedContainer outputSeeds;
+  if (not m_cfg.outputSeeds.empty()) {
+    outputSeeds.reserve(seeds.size());
+  }
 
   auto bCache = m_cfg.magneticField->makeCache(ctx.magFieldContext);
 
@@ -106,11 +113,17 @@ ActsExamples::ProcessCode ActsExamples::TrackParamsEstimationAlgorithm::execute(
       double charge = std::copysign(1, params[Acts::eBoundQOverP]);
       trackParameters.emplace_back(surface->getSharedPtr(), params, charge,
                                    m_covariance);
+      if (not m_cfg.outputSeeds.empty()) {
+        outputSeeds.push_back(seed);
+      }
     }
   }
 
   ACTS_VERBOSE("Estimated " << trackParameters.size() << " track parameters");
 
-  ctx.eventStore.add(m_cfg.outputTrackParameters, std::move(trackParameters));
+  m_outputTrackParameters(ctx, std::move(trackParameters));
+  if (m_outputSeeds.isInitialized()) {
+    m_outputSeeds(ctx, std::move(outputSeeds));
+  }
   return ProcessCode::SUCCESS;
 }
@@ -14,6 +14,7 @@
 #include "Acts/Geometry/TrackingGeometry.hpp"
 #include "Acts/Propagator/MultiEigenStepperLoop.hpp"
 #include "Acts/TrackFitting/KalmanFitter.hpp"
+#include "Acts/TrackFitting/TrackRefitter.hpp"
 #include "ActsExamples/EventData/IndexSourceLink.hpp"
 #include "ActsExamples/EventData/Measurement.hpp"
 #include "ActsExamples/EventData/Track.hpp"
@@ -89,6 +90,9 @@ class TrackFittingAlgorithm final : public IAlgorithm {
     std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry;
     /// Pick a single track for debugging (-1 process all tracks)
     int pickTrack = -1;
+    /// Number of tasks the proto tracks of one event are split into. The
+    /// tasks are fitted in parallel, the output keeps the proto track order.
+    std::size_t numFittingTasks = 1;
   };
 
   /// Constructor of the fitting algorithm
@@ -108,6 +112,8 @@ class TrackFittingAlgorithm final : public IAlgorithm {
 
  private:
   Config m_cfg;
+
+  std::unique_ptr<Acts::TrackRefitter<std::shared_ptr>> m_refitter;
 };
 
 }  // namespace ActsExamples
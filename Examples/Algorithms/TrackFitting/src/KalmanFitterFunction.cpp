@@ -58,13 +58,12 @@ struct KalmanFitterFunctionImpl
   bool energyLoss = false;
   Acts::FreeToBoundCorrection freeToBoundCorrection;
 
-  KalmanFitterFunctionImpl(Fitter&& f, DirectFitter&& df)
-      : fitter(std::move(f)), directFitter(std::move(df)) {}
+  // The extensions refer to the members above, they are set up once instead
+  // of for every track
+  Acts::KalmanFitterExtensions<Acts::VectorMultiTrajectory> extensions;
 
-  auto makeKfOptions(
-      const ActsExamples::TrackFittingAlgorithm::GeneralFitterOptions& options)
-      const {
-    Acts::KalmanFitterExtensions<Acts::VectorMultiTrajectory> extensions;
+  KalmanFitterFunctionImpl(Fitter&& f, DirectFitter&& df)
+      : fitter(std::move(f)), directFitter(std::move(df)) {
     extensions.updater.connect<
         &Acts::GainMatrixUpdater::operator()<Acts::VectorMultiTrajectory>>(
         &kfUpdater);
@@ -74,7 +73,15 @@ struct KalmanFitterFunctionImpl
     extensions.reverseFilteringLogic
         .connect<&SimpleReverseFilteringLogic::doBackwardFiltering>(
             &reverseFilteringLogic);
+  }
+
+  KalmanFitterFunctionImpl(const KalmanFitterFunctionImpl&) = delete;
+  KalmanFitterFunctionImpl& operator=(const KalmanFitterFunctionImpl&) =
+      delete;
 
+  auto makeKfOptions(
+      const ActsExamples::TrackFittingAlgorithm::GeneralFitterOptions& options)
+      const {
     Acts::KalmanFitterOptions<Acts::VectorMultiTrajectory> kfOptions(
         options.geoContext, options.magFieldContext, options.calibrationContext,
         extensions, options.propOptions, &(*options.referenceSurface));
@@ -15,7 +15,9 @@
 #include "Acts/TrackFitting/GainMatrixUpdater.hpp"
 #include "ActsExamples/EventData/ProtoTrack.hpp"
 #include "ActsExamples/Framework/WhiteBoard.hpp"
+#include "ActsExamples/Utilities/tbbWrap.hpp"
 
+#include <atomic>
 #include <stdexcept>
 
 ActsExamples::TrackFittingAlgorithm::TrackFittingAlgorithm(
@@ -41,6 +43,24 @@ ActsExamples::TrackFittingAlgorithm::TrackFittingAlgorithm(
   if (m_cfg.outputTracks.empty()) {
     throw std::invalid_argument("Missing output tracks collection");
   }
+  if (m_cfg.numFittingTasks == 0) {
+    throw std::invalid_argument("Need at least one fitting task");
+  }
+
+  Acts::TrackRefitter<std::shared_ptr>::Config refitterCfg;
+  refitterCfg.numTasks = m_cfg.numFittingTasks;
+  refitterCfg.executor =
+      [](std::size_t nTasks, const std::function<void(std::size_t)>& task) {
+        tbbWrap::parallel_for(
+            tbb::blocked_range<std::size_t>(0, nTasks),
+            [&](const tbb::blocked_range<std::size_t>& range) {
+              for (std::size_t i = range.begin(); i != range.end(); ++i) {
+                task(i);
+              }
+            });
+      };
+  m_refitter =
+      std::make_unique<Acts::TrackRefitter<std::shared_ptr>>(refitterCfg);
 }
 
 ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
@@ -79,13 +99,14 @@ ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
   auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
   TrackContainer tracks(trackContainer, trackStateContainer);
 
-  // Perform the fit for each input track
-  std::vector<Acts::SourceLink> trackSourceLinks;
-  std::vector<const Acts::Surface*> surfSequence;
-  for (std::size_t itrack = 0; itrack < protoTracks.size(); ++itrack) {
+  // Perform the fit for each input track. The proto tracks are split into
+  // consecutive ranges which are fitted in parallel, the tracks are appended
+  // to the output in the order of the proto tracks.
+  std::atomic<bool> invalidHitIndex = false;
+  auto fitTrack = [&](std::size_t itrack, TrackContainer& tracksOfTask) {
     // Check if you are not in picking mode
     if (m_cfg.pickTrack > -1 and m_cfg.pickTrack != static_cast<int>(itrack)) {
-      continue;
+      return;
     }
 
     // The list of hits and the initial start parameters
@@ -96,17 +117,16 @@ ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
     // of entries in input and output containers matches.
     if (protoTrack.empty()) {
       ACTS_WARNING("Empty track " << itrack << " found.");
-      continue;
+      return;
     }
 
     ACTS_VERBOSE("Initial parameters: "
                  << initialParams.fourPosition(ctx.geoContext).transpose()
                  << " -> " << initialParams.unitDirection().transpose());
 
-    // Clear & reserve the right size
-    trackSourceLinks.clear();
+    std::vector<Acts::SourceLink> trackSourceLinks;
     trackSourceLinks.reserve(protoTrack.size());
-    surfSequence.clear();
+    std::vector<const Acts::Surface*> surfSequence;
     surfSequence.reserve(protoTrack.size());
 
     // Fill the source links via their indices from the container
@@ -119,7 +139,8 @@ ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
       } else {
         ACTS_FATAL("Proto track " << itrack << " contains invalid hit index"
                                   << hitIndex);
-        return ProcessCode::ABORT;
+        invalidHitIndex = true;
+        return;
       }
     }
 
@@ -127,8 +148,9 @@ ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
     auto result =
         m_cfg.directNavigation
             ? (*m_cfg.fit)(trackSourceLinks, initialParams, options,
-                           surfSequence, tracks)
-            : (*m_cfg.fit)(trackSourceLinks, initialParams, options, tracks);
+                           surfSequence, tracksOfTask)
+            : (*m_cfg.fit)(trackSourceLinks, initialParams, options,
+                           tracksOfTask);
 
     if (result.ok()) {
       // Get the fit output object
@@ -144,6 +166,11 @@ ActsExamples::ProcessCode ActsExamples::TrackFittingAlgorithm::execute(
                    << itrack << " with error: " << result.error() << ", "
                    << result.error().message());
     }
+  };
+  m_refitter->refit(protoTracks.size(), fitTrack, tracks);
+
+  if (invalidHitIndex) {
+    return ProcessCode::ABORT;
   }
 
   std::stringstream ss;
@@ -0,0 +1,159 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "ActsExamples/Framework/AlgorithmContext.hpp"
+#include "ActsExamples/Framework/SequenceElement.hpp"
+#include "ActsExamples/Framework/WhiteBoard.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ActsExamples {
+
+/// Common base of the typed whiteboard access handles.
+///
+/// A handle is a member of a sequence element and registers itself with it.
+/// Initializing it with the name of a whiteboard object declares the read or
+/// write access of the element. The sequencer then resolves the name to a
+/// slot of the whiteboard layout, such that the object is accessed without
+/// any name lookup during the event loop. Unresolved handles fall back to the
+/// access by name.
+class DataHandleBase {
+ public:
+  virtual ~DataHandleBase() = default;
+
+  // handles are registered by address with their element
+  DataHandleBase(const DataHandleBase&) = delete;
+  DataHandleBase& operator=(const DataHandleBase&) = delete;
+
+  /// Name of the handle within its element
+  const std::string& name() const { return m_name; }
+
+  /// Name of the whiteboard object
+  const std::string& key() const { return m_key; }
+
+  bool isInitialized() const { return not m_key.empty(); }
+
+  /// Resolve the slot of the object in a whiteboard layout.
+  ///
+  /// The handle stays unresolved if the object is not part of the layout.
+  void resolve(std::shared_ptr<const WhiteBoard::Layout> layout) {
+    m_layout.reset();
+    if (layout and isInitialized()) {
+      if (auto it = layout->find(m_key); it != layout->end()) {
+        m_slot = it->second;
+        m_layout = std::move(layout);
+      }
+    }
+  }
+
+ protected:
+  DataHandleBase(SequenceElement* parent, std::string name)
+      : m_parent(parent), m_name(std::move(name)) {
+    m_parent->m_dataHandles.push_back(this);
+  }
+
+  /// Set the object name and declare the access with the parent element
+  ///
+  /// @throws std::invalid_argument if the name is empty
+  void initializeKey(const std::string& key, bool write) {
+    if (key.empty()) {
+      throw std::invalid_argument("Missing object name for data handle '" +
+                                  m_name + "'");
+    }
+    m_key = key;
+    if (write) {
+      m_parent->declareWrite(key);
+    } else {
+      m_parent->declareRead(key);
+    }
+  }
+
+  /// Slot of the object on the given whiteboard or nullptr if the handle
+  /// was not resolved for its layout
+  const std::size_t* slot(const WhiteBoard& board) const {
+    if (not isInitialized()) {
+      throw std::runtime_error("Data handle '" + m_name +
+                               "' is not initialized");
+    }
+    return (m_layout and board.layout() == m_layout) ? &m_slot : nullptr;
+  }
+
+ private:
+  SequenceElement* m_parent;
+  std::string m_name;
+  std::string m_key;
+  std::shared_ptr<const WhiteBoard::Layout> m_layout;
+  std::size_t m_slot = 0;
+};
+
+/// Handle to add an object of type T to the whiteboard.
+template <typename T>
+class WriteDataHandle final : public DataHandleBase {
+ public:
+  WriteDataHandle(SequenceElement* parent, std::string name)
+      : DataHandleBase(parent, std::move(name)) {}
+
+  /// @throws std::invalid_argument if the name is empty
+  void initialize(const std::string& key) { initializeKey(key, true); }
+
+  /// Initialize the handle unless the name of an optional object is empty
+  void maybeInitialize(const std::string& key) {
+    if (not key.empty()) {
+      initialize(key);
+    }
+  }
+
+  void operator()(const AlgorithmContext& ctx, T&& value) const {
+    (*this)(ctx.eventStore, std::move(value));
+  }
+
+  void operator()(WhiteBoard& board, T&& value) const {
+    if (const std::size_t* s = slot(board)) {
+      board.addToSlot(*s, key(), std::move(value));
+    } else {
+      board.add(key(), std::move(value));
+    }
+  }
+};
+
+/// Handle to read an object of type T from the whiteboard.
+template <typename T>
+class ReadDataHandle final : public DataHandleBase {
+ public:
+  ReadDataHandle(SequenceElement* parent, std::string name)
+      : DataHandleBase(parent, std::move(name)) {}
+
+  /// @throws std::invalid_argument if the name is empty
+  void initialize(const std::string& key) { initializeKey(key, false); }
+
+  /// Initialize the handle unless the name of an optional object is empty
+  void maybeInitialize(const std::string& key) {
+    if (not key.empty()) {
+      initialize(key);
+    }
+  }
+
+  const T& operator()(const AlgorithmContext& ctx) const {
+    return (*this)(ctx.eventStore);
+  }
+
+  const T& operator()(const WhiteBoard& board) const {
+    if (const std::size_t* s = slot(board)) {
+      return board.getFromSlot<T>(*s, key());
+    }
+    return board.get<T>(key());
+  }
+};
+
+}  // namespace ActsExamples
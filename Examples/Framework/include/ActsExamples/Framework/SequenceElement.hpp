@@ -12,9 +12,12 @@
 #include "ActsExamples/Framework/ProcessCode.hpp"
 
 #include <string>
+#include <vector>
 
 namespace ActsExamples {
 
+class DataHandleBase;
+
 /// Event processing interface.
 ///
 class SequenceElement {
@@ -33,6 +36,54 @@ class SequenceElement {
   /// Internal method to execute the algorithm for one event.
   /// @note Usually, you should not override this method
   virtual ProcessCode internalExecute(const AlgorithmContext& context) = 0;
+
+  /// Whether the element declared the whiteboard objects it reads and writes.
+  ///
+  /// Elements without declarations are never reordered by the sequencer, i.e.
+  /// they run after all preceding and before all following elements.
+  bool declaresDataDependencies() const { return m_declaresDataDependencies; }
+
+  /// Names of the whiteboard objects read by the element
+  const std::vector<std::string>& readKeys() const { return m_readKeys; }
+
+  /// Names of the whiteboard objects written by the element
+  const std::vector<std::string>& writeKeys() const { return m_writeKeys; }
+
+  /// Data handles owned by the element
+  const std::vector<DataHandleBase*>& dataHandles() const {
+    return m_dataHandles;
+  }
+
+ protected:
+  /// Declare that the element reads a whiteboard object.
+  ///
+  /// Empty names, e.g. from unset optional inputs, are ignored. Once any
+  /// object is declared, the declarations must be complete since they are
+  /// used to schedule the element.
+  void declareRead(const std::string& key) {
+    m_declaresDataDependencies = true;
+    if (!key.empty()) {
+      m_readKeys.push_back(key);
+    }
+  }
+
+  /// Declare that the element writes a whiteboard object.
+  ///
+  /// Empty names, e.g. from unset optional outputs, are ignored.
+  void declareWrite(const std::string& key) {
+    m_declaresDataDependencies = true;
+    if (!key.empty()) {
+      m_writeKeys.push_back(key);
+    }
+  }
+
+ private:
+  friend class DataHandleBase;
+
+  bool m_declaresDataDependencies = false;
+  std::vector<std::string> m_readKeys;
+  std::vector<std::string> m_writeKeys;
+  std::vector<DataHandleBase*> m_dataHandles;
 };
 
 }  // namespace ActsExamples
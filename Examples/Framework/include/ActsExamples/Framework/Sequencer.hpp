@@ -13,6 +13,7 @@
 #include "ActsExamples/Framework/IReader.hpp"
 #include "ActsExamples/Framework/IWriter.hpp"
 #include "ActsExamples/Framework/SequenceElement.hpp"
+#include "ActsExamples/Framework/WhiteBoard.hpp"
 #include "ActsExamples/Utilities/tbbWrap.hpp"
 #include <Acts/Utilities/Logger.hpp>
 
@@ -48,6 +49,23 @@ class Sequencer {
     std::string outputDir;
     /// output name of the timing file
     std::string outputTimingFile = "timing.tsv";
+    /// run independent sequence elements of the same event concurrently.
+    ///
+    /// The order is derived from the whiteboard objects each element declares
+    /// to read and write. Elements without declarations keep their position
+    /// in the sequence relative to all other elements.
+    bool concurrentAlgorithms = false;
+    /// overlap the I/O with the computation of other events.
+    ///
+    /// The readers at the beginning and the writers at the end of the
+    /// sequence are run as serial pipeline stages that process the events in
+    /// order. The readers prefetch the upcoming events while the algorithms of
+    /// the events in flight are executed in parallel, and the writers drain
+    /// the finished events.
+    bool pipelinedIO = false;
+    /// maximum number of events in flight in pipelined mode to bound the
+    /// memory usage, zero for twice the number of threads
+    std::size_t maxEventsInFlight = 0;
     /// Callback that is invoked in the event loop.
     /// @warning This function can be called from multiple threads and should therefore be thread-safe
     IterationCallback iterationCallback = []() {};
@@ -120,6 +138,14 @@ class Sequencer {
   std::vector<std::string> listAlgorithmNames() const;
   /// Determine range of (requested) events; [SIZE_MAX, SIZE_MAX) for error.
   std::pair<size_t, size_t> determineEventsRange() const;
+  /// Check the declared whiteboard accesses of the sequence elements and
+  /// derive for each element the preceding elements it has to wait for.
+  ///
+  /// @throws std::runtime_error if an object is read before it is written or
+  ///         if it is written by more than one element
+  std::vector<std::vector<std::size_t>> analyzeDataFlow() const;
+  /// Assign a whiteboard slot to each object declared by the elements.
+  std::shared_ptr<const WhiteBoard::Layout> buildWhiteBoardLayout() const;
 
   Config m_cfg;
   tbbWrap::task_arena m_taskArena;
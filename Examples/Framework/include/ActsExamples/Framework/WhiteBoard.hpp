@@ -10,9 +10,15 @@
 
 #include <Acts/Utilities/Logger.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
@@ -20,17 +26,34 @@
 
 namespace ActsExamples {
 
+template <typename T>
+class ReadDataHandle;
+template <typename T>
+class WriteDataHandle;
+
 /// A container to store arbitrary objects with ownership transfer.
 ///
 /// This is an append-only container that takes ownership of the objects
 /// added to it. Once an object has been added, it can only be read but not
 /// be modified. Trying to replace an existing object is considered an error.
 /// Its lifetime is bound to the liftime of the white board.
+///
+/// Objects whose names are part of the layout are stored in a flat array of
+/// slots. Data handles resolve their slot once, such that accessing these
+/// objects requires neither a name lookup nor locking. All other objects are
+/// stored by name and can be added and retrieved concurrently.
+///
+/// Aliases are never part of the layout. Several objects can share an alias,
+/// which always refers to the object written last under one of their names.
 class WhiteBoard {
  public:
+  /// Slot index for each object name
+  using Layout = std::unordered_map<std::string, std::size_t>;
+
   WhiteBoard(std::unique_ptr<const Acts::Logger> logger =
                  Acts::getDefaultLogger("WhiteBoard", Acts::Logging::INFO),
-             std::unordered_map<std::string, std::string> objectAliases = {});
+             std::unordered_map<std::string, std::string> objectAliases = {},
+             std::shared_ptr<const Layout> layout = nullptr);
 
   // A WhiteBoard holds unique elements and can not be copied
   WhiteBoard(const WhiteBoard& other) = delete;
@@ -54,11 +77,25 @@ class WhiteBoard {
 
   bool exists(const std::string& name) const;
 
+  /// Remove all objects such that the white board can be reused.
+  ///
+  /// The layout is kept and the slots are not reallocated.
+  void clear();
+
+  /// Replace the logger, e.g. when the white board is reused for another
+  /// event.
+  void setLogger(std::unique_ptr<const Acts::Logger> logger) {
+    m_logger = std::move(logger);
+  }
+
+  /// The layout the slots of this white board are organized in
+  const std::shared_ptr<const Layout>& layout() const { return m_layout; }
+
  private:
-  /// Find similar names for suggestions with levenshtein-distance
-  std::vector<std::string_view> similarNames(const std::string_view& name,
-                                             int distThreshold,
-                                             std::size_t maxNumber) const;
+  template <typename T>
+  friend class ReadDataHandle;
+  template <typename T>
+  friend class WriteDataHandle;
 
   // type-erased value holder for move-constructible types
   struct IHolder {
@@ -75,7 +112,36 @@ class WhiteBoard {
     const std::type_info& type() const override { return typeid(T); }
   };
 
+  /// Store an object in a slot of the layout
+  template <typename T>
+  void addToSlot(std::size_t slot, const std::string& name, T&& object);
+
+  /// Get an object from a slot of the layout
+  template <typename T>
+  const T& getFromSlot(std::size_t slot, const std::string& name) const;
+
+  /// Store the alias of an object name, replacing the previous object
+  void addAlias(const std::string& alias, std::shared_ptr<IHolder> holder);
+
+  /// Cast a holder to the requested type
+  template <typename T>
+  static const T& unpack(const IHolder* holder, const std::string& name);
+
+  /// Slot of an object name or nullptr if it is not part of the layout
+  const std::size_t* findSlot(const std::string& name) const;
+
+  /// Find similar names for suggestions with levenshtein-distance
+  std::vector<std::string_view> similarNames(const std::string_view& name,
+                                             int distThreshold,
+                                             std::size_t maxNumber) const;
+
   std::unique_ptr<const Acts::Logger> m_logger;
+  std::shared_ptr<const Layout> m_layout;
+  std::vector<std::shared_ptr<IHolder>> m_slots;
+  /// alias of the object in each slot or nullptr
+  std::vector<const std::string*> m_slotAliases;
+  /// objects outside of the layout
+  mutable std::shared_mutex m_storeMutex;
   std::unordered_map<std::string, std::shared_ptr<IHolder>> m_store;
   std::unordered_map<std::string, std::string> m_objectAliases;
 
@@ -86,30 +152,112 @@ class WhiteBoard {
 
 inline ActsExamples::WhiteBoard::WhiteBoard(
     std::unique_ptr<const Acts::Logger> logger,
-    std::unordered_map<std::string, std::string> objectAliases)
-    : m_logger(std::move(logger)), m_objectAliases(std::move(objectAliases)) {}
+    std::unordered_map<std::string, std::string> objectAliases,
+    std::shared_ptr<const Layout> layout)
+    : m_logger(std::move(logger)),
+      m_layout(std::move(layout)),
+      m_objectAliases(std::move(objectAliases)) {
+  if (m_layout) {
+    std::size_t nSlots = 0;
+    for (const auto& [name, slot] : *m_layout) {
+      nSlots = std::max(nSlots, slot + 1);
+    }
+    m_slots.resize(nSlots);
+    m_slotAliases.resize(nSlots, nullptr);
+    for (const auto& [name, slot] : *m_layout) {
+      if (auto it = m_objectAliases.find(name); it != m_objectAliases.end()) {
+        m_slotAliases[slot] = &it->second;
+      }
+    }
+  }
+}
+
+inline const std::size_t* ActsExamples::WhiteBoard::findSlot(
+    const std::string& name) const {
+  if (not m_layout) {
+    return nullptr;
+  }
+  auto it = m_layout->find(name);
+  return (it != m_layout->end()) ? &it->second : nullptr;
+}
 
 template <typename T>
 inline void ActsExamples::WhiteBoard::add(const std::string& name, T&& object) {
   if (name.empty()) {
     throw std::invalid_argument("Object can not have an empty name");
   }
-  if (0 < m_store.count(name)) {
-    throw std::invalid_argument("Object '" + name + "' already exists");
+  if (const std::size_t* slot = findSlot(name)) {
+    addToSlot(*slot, name, std::forward<T>(object));
+    return;
   }
   auto holder = std::make_shared<HolderT<T>>(std::forward<T>(object));
-  m_store.emplace(name, holder);
+  {
+    std::unique_lock lock(m_storeMutex);
+    if (0 < m_store.count(name)) {
+      throw std::invalid_argument("Object '" + name + "' already exists");
+    }
+    m_store.emplace(name, holder);
+  }
   ACTS_VERBOSE("Added object '" << name << "' of type " << typeid(T).name());
   if (auto it = m_objectAliases.find(name); it != m_objectAliases.end()) {
-    m_store[it->second] = holder;
-    ACTS_VERBOSE("Added alias object '" << it->second << "'");
+    addAlias(it->second, std::move(holder));
   }
 }
 
+template <typename T>
+inline void ActsExamples::WhiteBoard::addToSlot(std::size_t slot,
+                                                const std::string& name,
+                                                T&& object) {
+  // the sequencer ensures that each slot has a single writer which is
+  // executed before all its readers
+  auto& holder = m_slots[slot];
+  if (holder) {
+    throw std::invalid_argument("Object '" + name + "' already exists");
+  }
+  holder = std::make_shared<HolderT<T>>(std::forward<T>(object));
+  ACTS_VERBOSE("Added object '" << name << "' of type " << typeid(T).name()
+                                << " to slot " << slot);
+  if (const std::string* alias = m_slotAliases[slot]) {
+    addAlias(*alias, holder);
+  }
+}
+
+inline void ActsExamples::WhiteBoard::addAlias(
+    const std::string& alias, std::shared_ptr<IHolder> holder) {
+  // the previous object is still owned under its own name, such that
+  // references obtained through the alias stay valid
+  std::unique_lock lock(m_storeMutex);
+  m_store[alias] = std::move(holder);
+  ACTS_VERBOSE("Added alias object '" << alias << "'");
+}
+
+template <typename T>
+inline const T& ActsExamples::WhiteBoard::unpack(const IHolder* holder,
+                                                 const std::string& name) {
+  if (holder->type() != typeid(T)) {
+    throw std::out_of_range("Type mismatch for object '" + name + "'");
+  }
+  return static_cast<const HolderT<T>*>(holder)->value;
+}
+
+template <typename T>
+inline const T& ActsExamples::WhiteBoard::getFromSlot(
+    std::size_t slot, const std::string& name) const {
+  const IHolder* holder = m_slots[slot].get();
+  if (holder == nullptr) {
+    throw std::out_of_range("Object '" + name + "' does not exists");
+  }
+  return unpack<T>(holder, name);
+}
+
 template <typename T>
 inline const T& ActsExamples::WhiteBoard::get(const std::string& name) const {
   ACTS_VERBOSE("Attempt to get object '" << name << "' of type "
                                          << typeid(T).name());
+  if (const std::size_t* slot = findSlot(name)) {
+    return getFromSlot<T>(*slot, name);
+  }
+  std::shared_lock lock(m_storeMutex);
   auto it = m_store.find(name);
   if (it == m_store.end()) {
     const auto names = similarNames(name, 10, 3);
@@ -126,17 +274,23 @@ inline const T& ActsExamples::WhiteBoard::get(const std::string& name) const {
     throw std::out_of_range("Object '" + name + "' does not exists" + ss.str());
   }
 
-  const IHolder* holder = it->second.get();
-
-  const auto* castedHolder = dynamic_cast<const HolderT<T>*>(holder);
-  if (castedHolder == nullptr) {
-    throw std::out_of_range("Type mismatch for object '" + name + "'");
-  }
-
+  const T& value = unpack<T>(it->second.get(), name);
   ACTS_VERBOSE("Retrieved object '" << name << "'");
-  return castedHolder->value;
+  return value;
 }
 
 inline bool ActsExamples::WhiteBoard::exists(const std::string& name) const {
+  if (const std::size_t* slot = findSlot(name)) {
+    return m_slots[*slot] != nullptr;
+  }
+  std::shared_lock lock(m_storeMutex);
   return m_store.find(name) != m_store.end();
 }
+
+inline void ActsExamples::WhiteBoard::clear() {
+  for (auto& holder : m_slots) {
+    holder.reset();
+  }
+  std::unique_lock lock(m_storeMutex);
+  m_store.clear();
+}
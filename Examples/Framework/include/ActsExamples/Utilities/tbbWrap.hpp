@@ -62,11 +62,12 @@ struct blocked_range {
 
 namespace tbbWrap {
 /// enableTBB keeps a record of whether we are multi-threaded (nthreads!=1) or
-/// not. This is set once in task_arena and stored globally.
+/// not. This is set once in task_arena and stored globally, the setting is
+/// shared by all translation units, including the ones of the algorithms.
 /// This means that enableTBB(nthreads) itself is not thread-safe. That should
 /// be fine because the task_arena is initialised before spawning any threads.
 /// If multi-threading is ever enabled, then it is not disabled.
-static bool enableTBB(int nthreads = -99) {
+inline bool enableTBB(int nthreads = -99) {
   static bool setting = false;
   if (nthreads != -99) {
 #ifdef ACTS_EXAMPLES_NO_TBB
@@ -9,6 +9,7 @@
 #include "ActsExamples/Framework/Sequencer.hpp"
 
 #include "Acts/Utilities/Helpers.hpp"
+#include "ActsExamples/Framework/DataHandle.hpp"
 #include "ActsExamples/Framework/IAlgorithm.hpp"
 #include "ActsExamples/Framework/ProcessCode.hpp"
 #include "ActsExamples/Framework/SequenceElement.hpp"
@@ -16,16 +17,22 @@
 #include "ActsExamples/Utilities/Paths.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cfenv>
 #include <chrono>
 #include <exception>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifndef ACTS_EXAMPLES_NO_TBB
 #include <TROOT.h>
+#include <tbb/flow_graph.h>
+#include <tbb/parallel_pipeline.h>
 #endif
 
 #include <dfe/dfe_io_dsv.hpp>
@@ -195,6 +202,151 @@ std::pair<std::size_t, std::size_t> Sequencer::determineEventsRange() const {
   return {begSelected, endSelected};
 }
 
+std::vector<std::vector<std::size_t>> Sequencer::analyzeDataFlow() const {
+  const std::size_t nElements = m_sequenceElements.size();
+  bool consistent = true;
+
+  auto describe = [&](std::size_t i) {
+    const auto& element = *m_sequenceElements[i];
+    return std::string(getAlgorithmType(element)) + " '" + element.name() +
+           "'";
+  };
+
+  // element that writes each object
+  std::unordered_map<std::string, std::size_t> producers;
+  for (std::size_t i = 0; i < nElements; ++i) {
+    const auto& element = *m_sequenceElements[i];
+    if (not element.declaresDataDependencies()) {
+      continue;
+    }
+    for (const auto& key : element.writeKeys()) {
+      auto [it, inserted] = producers.emplace(key, i);
+      if (not inserted) {
+        ACTS_FATAL("Object '" << key << "' is written by both "
+                              << describe(it->second) << " and "
+                              << describe(i));
+        consistent = false;
+      }
+    }
+  }
+
+  // An alias can be written through several objects and refers to the one
+  // written last. Its accesses keep their order in the sequence: readers wait
+  // for the preceding writers, writers for all preceding accesses.
+  std::unordered_set<std::string> aliasNames;
+  for (const auto& [objectName, aliasName] : m_whiteboardObjectAliases) {
+    aliasNames.insert(aliasName);
+  }
+  std::unordered_map<std::string, std::vector<std::size_t>> aliasWriters;
+  std::unordered_map<std::string, std::vector<std::size_t>> aliasReaders;
+
+  // Elements without declarations act as barriers: they wait for all
+  // preceding elements and all following elements wait for them. Declared
+  // elements only need to wait for the last barrier and the producers of
+  // their inputs behind it.
+  std::vector<std::vector<std::size_t>> dependencies(nElements);
+  std::optional<std::size_t> barrier;
+  for (std::size_t j = 0; j < nElements; ++j) {
+    const auto& element = *m_sequenceElements[j];
+    auto& deps = dependencies[j];
+    if (not element.declaresDataDependencies()) {
+      for (std::size_t i = barrier.value_or(0); i < j; ++i) {
+        deps.push_back(i);
+      }
+      barrier = j;
+      continue;
+    }
+    if (barrier) {
+      deps.push_back(*barrier);
+    }
+    auto dependOn = [&](std::size_t i) {
+      if ((not barrier or *barrier < i) and
+          std::find(deps.begin(), deps.end(), i) == deps.end()) {
+        deps.push_back(i);
+      }
+    };
+    for (const auto& key : element.readKeys()) {
+      if (aliasNames.count(key) != 0) {
+        const auto& writers = aliasWriters[key];
+        if (writers.empty() and not barrier) {
+          ACTS_FATAL(describe(j)
+                     << " reads alias '" << key
+                     << "' which is not written by any preceding element");
+          consistent = false;
+        }
+        std::for_each(writers.begin(), writers.end(), dependOn);
+        aliasReaders[key].push_back(j);
+        continue;
+      }
+      auto it = producers.find(key);
+      if (it == producers.end()) {
+        // objects might be provided by a preceding undeclared element
+        if (not barrier) {
+          ACTS_FATAL(describe(j)
+                     << " reads object '" << key
+                     << "' which is not written by any preceding element");
+          consistent = false;
+        }
+        continue;
+      }
+      std::size_t i = it->second;
+      if (j <= i) {
+        ACTS_FATAL(describe(j) << " reads object '" << key
+                               << "' before it is written by "
+                               << describe(i));
+        consistent = false;
+        continue;
+      }
+      dependOn(i);
+    }
+    for (const auto& key : element.writeKeys()) {
+      auto alias = m_whiteboardObjectAliases.find(key);
+      if (alias == m_whiteboardObjectAliases.end()) {
+        continue;
+      }
+      auto& writers = aliasWriters[alias->second];
+      const auto& readers = aliasReaders[alias->second];
+      std::for_each(writers.begin(), writers.end(), dependOn);
+      std::for_each(readers.begin(), readers.end(), dependOn);
+      writers.push_back(j);
+    }
+  }
+
+  if (not consistent) {
+    throw std::runtime_error("Inconsistent sequence element data flow");
+  }
+  return dependencies;
+}
+
+std::shared_ptr<const WhiteBoard::Layout> Sequencer::buildWhiteBoardLayout()
+    const {
+  auto layout = std::make_shared<WhiteBoard::Layout>();
+  std::size_t nSlots = 0;
+
+  // aliases can refer to different objects and are stored by name
+  std::unordered_set<std::string> aliasNames;
+  for (const auto& [objectName, aliasName] : m_whiteboardObjectAliases) {
+    aliasNames.insert(aliasName);
+  }
+  auto assign = [&](const std::string& key) {
+    if (aliasNames.count(key) == 0 and layout->count(key) == 0) {
+      layout->emplace(key, nSlots++);
+    }
+  };
+
+  for (const auto& element : m_sequenceElements) {
+    for (const auto& key : element->writeKeys()) {
+      assign(key);
+    }
+  }
+  for (const auto& element : m_sequenceElements) {
+    for (const auto& key : element->readKeys()) {
+      assign(key);
+    }
+  }
+  return layout;
+}
+
 // helpers for per-algorithm timing information
 namespace {
 using Clock = std::chrono::high_resolution_clock;
@@ -297,6 +449,54 @@ int Sequencer::run() {
   ACTS_INFO("  " << nAlgorithms << " algorithms");
   ACTS_INFO("  " << nWriters << " writers");
 
+  const auto dependencies = analyzeDataFlow();
+  bool concurrentAlgorithms = m_cfg.concurrentAlgorithms;
+#ifdef ACTS_EXAMPLES_NO_TBB
+  concurrentAlgorithms = false;
+#else
+  concurrentAlgorithms = concurrentAlgorithms and tbbWrap::enableTBB();
+#endif
+  if (concurrentAlgorithms) {
+    ACTS_INFO("Run sequence elements concurrently within each event");
+    for (std::size_t j = 0; j < m_sequenceElements.size(); ++j) {
+      ACTS_DEBUG("  " << m_sequenceElements[j]->name() << " waits for "
+                      << dependencies[j].size() << " elements");
+    }
+  }
+
+  const auto layout = buildWhiteBoardLayout();
+  for (const auto& element : m_sequenceElements) {
+    for (auto* handle : element->dataHandles()) {
+      handle->resolve(layout);
+    }
+  }
+  ACTS_DEBUG("Whiteboard layout with " << layout->size() << " objects");
+
+  // whiteboards are reused for the following events to avoid reallocating
+  // the slots and the alias lookup
+  std::vector<std::unique_ptr<WhiteBoard>> freeEventStores;
+  tbbWrap::queuing_mutex eventStoresMutex;
+  auto acquireEventStore = [&](std::size_t event) {
+    auto storeLogger = Acts::getDefaultLogger(
+        "EventStore#" + std::to_string(event), m_cfg.logLevel);
+    {
+      tbbWrap::queuing_mutex::scoped_lock lock(eventStoresMutex);
+      if (not freeEventStores.empty()) {
+        auto store = std::move(freeEventStores.back());
+        freeEventStores.pop_back();
+        store->setLogger(std::move(storeLogger));
+        return store;
+      }
+    }
+    return std::make_unique<WhiteBoard>(std::move(storeLogger),
+                                        m_whiteboardObjectAliases, layout);
+  };
+  auto releaseEventStore = [&](std::unique_ptr<WhiteBoard> store) {
+    store->clear();
+    tbbWrap::queuing_mutex::scoped_lock lock(eventStoresMutex);
+    freeEventStores.push_back(std::move(store));
+  };
+
   ACTS_VERBOSE("Initialize sequence elements");
   for (auto& alg : m_sequenceElements) {
     ACTS_VERBOSE("Initialize " << getAlgorithmType(*alg) << ": "
@@ -308,70 +508,221 @@ int Sequencer::run() {
     }
   }
 
-  // execute the parallel event loop
+  // decorate the context of one event
+  auto decorate = [&](AlgorithmContext& context,
+                      std::vector<Duration>& clocks) {
+    for (std::size_t i = 0; i < m_decorators.size(); ++i) {
+      auto& cdr = m_decorators[i];
+      StopWatch sw(clocks[i]);
+      ACTS_VERBOSE("Execute context decorator: " << cdr->name());
+      if (cdr->decorate(++context) != ProcessCode::SUCCESS) {
+        throw std::runtime_error("Failed to decorate event context");
+      }
+    }
+  };
+
+  // execute the sequence elements [begin, end) of one event on the decorated
+  // context. each element gets its own context copy with the same algorithm
+  // number, independent of the processing mode.
+  auto executeElements = [&](const AlgorithmContext& context,
+                             std::size_t begin, std::size_t end,
+                             std::vector<Duration>& clocks) {
+    auto execute = [&](std::size_t ielement) {
+      auto& alg = m_sequenceElements[ielement];
+      AlgorithmContext algContext = context;
+      algContext.algorithmNumber += ielement + 1;
+      StopWatch sw(clocks[m_decorators.size() + ielement]);
+      ACTS_VERBOSE("Execute " << getAlgorithmType(*alg) << ": "
+                              << alg->name());
+      if (alg->internalExecute(algContext) != ProcessCode::SUCCESS) {
+        ACTS_FATAL("Failed to execute " << getAlgorithmType(*alg) << ": "
+                                        << alg->name());
+        throw std::runtime_error("Failed to process event data");
+      }
+    };
+
+    if (not concurrentAlgorithms) {
+      for (std::size_t i = begin; i < end; ++i) {
+        execute(i);
+      }
+      return;
+    }
+#ifndef ACTS_EXAMPLES_NO_TBB
+    using Node = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    tbb::flow::graph graph;
+    tbb::flow::broadcast_node<tbb::flow::continue_msg> start(graph);
+    std::vector<std::unique_ptr<Node>> nodes;
+    nodes.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      nodes.push_back(std::make_unique<Node>(
+          graph, [&, i](const tbb::flow::continue_msg&) { execute(i); }));
+      // elements before the range have already been executed
+      bool independent = true;
+      for (std::size_t dep : dependencies[i]) {
+        if (begin <= dep) {
+          tbb::flow::make_edge(*nodes[dep - begin], *nodes.back());
+          independent = false;
+        }
+      }
+      if (independent) {
+        tbb::flow::make_edge(start, *nodes.back());
+      }
+    }
+    start.try_put(tbb::flow::continue_msg());
+    // rethrows the first exception thrown by any of the elements
+    graph.wait_for_all();
+#endif
+  };
+
   std::atomic<size_t> nProcessedEvents = 0;
   size_t nTotalEvents = eventsRange.second - eventsRange.first;
-  m_taskArena.execute([&] {
-    tbbWrap::parallel_for(
-        tbb::blocked_range<size_t>(eventsRange.first, eventsRange.second),
-        [&](const tbb::blocked_range<size_t>& r) {
-          std::vector<Duration> localClocksAlgorithms(names.size(),
-                                                      Duration::zero());
-
-          for (size_t event = r.begin(); event != r.end(); ++event) {
-            m_cfg.iterationCallback();
-            // Use per-event store
-            WhiteBoard eventStore(
-                Acts::getDefaultLogger("EventStore#" + std::to_string(event),
-                                       m_cfg.logLevel),
-                m_whiteboardObjectAliases);
-            // If we ever wanted to run algorithms in parallel, this needs to
-            // be changed to Algorithm context copies
-            AlgorithmContext context(0, event, eventStore);
-            size_t ialgo = 0;
-
-            /// Decorate the context
-            for (auto& cdr : m_decorators) {
-              StopWatch sw(localClocksAlgorithms[ialgo++]);
-              ACTS_VERBOSE("Execute context decorator: " << cdr->name());
-              if (cdr->decorate(++context) != ProcessCode::SUCCESS) {
-                throw std::runtime_error("Failed to decorate event context");
-              }
-            }
+  auto reportProgress = [&](std::size_t event) {
+    nProcessedEvents++;
+    if (nTotalEvents <= 100) {
+      ACTS_INFO("finished event " << event);
+    } else {
+      if (nProcessedEvents % 100 == 0) {
+        ACTS_INFO(nProcessedEvents << " / " << nTotalEvents
+                                   << " events processed");
+      }
+    }
+  };
 
-            ACTS_VERBOSE("Execute sequence elements");
+  bool pipelinedIO = m_cfg.pipelinedIO;
+#ifdef ACTS_EXAMPLES_NO_TBB
+  pipelinedIO = false;
+#else
+  pipelinedIO = pipelinedIO and tbbWrap::enableTBB();
+#endif
+  if (m_cfg.pipelinedIO and not pipelinedIO) {
+    ACTS_INFO("Pipelined I/O requires multi-threading and is disabled");
+  }
 
-            for (auto& alg : m_sequenceElements) {
-              StopWatch sw(localClocksAlgorithms[ialgo++]);
-              ACTS_VERBOSE("Execute " << getAlgorithmType(*alg) << ": "
-                                      << alg->name());
-              if (alg->internalExecute(++context) != ProcessCode::SUCCESS) {
-                ACTS_FATAL("Failed to execute " << getAlgorithmType(*alg)
-                                                << ": " << alg->name());
-                throw std::runtime_error("Failed to process event data");
-              }
+  // total time spent in the read, compute, and write stages
+  std::array<Duration, 3> clocksStages = {};
+
+  if (not pipelinedIO) {
+    // execute the parallel event loop
+    m_taskArena.execute([&] {
+      tbbWrap::parallel_for(
+          tbb::blocked_range<size_t>(eventsRange.first, eventsRange.second),
+          [&](const tbb::blocked_range<size_t>& r) {
+            std::vector<Duration> localClocksAlgorithms(names.size(),
+                                                        Duration::zero());
+
+            for (size_t event = r.begin(); event != r.end(); ++event) {
+              m_cfg.iterationCallback();
+              // Use per-event store
+              auto eventStore = acquireEventStore(event);
+              AlgorithmContext context(0, event, *eventStore);
+              decorate(context, localClocksAlgorithms);
+              ACTS_VERBOSE("Execute sequence elements");
+              executeElements(context, 0, m_sequenceElements.size(),
+                              localClocksAlgorithms);
+              releaseEventStore(std::move(eventStore));
+              reportProgress(event);
             }
 
-            nProcessedEvents++;
-            if (nTotalEvents <= 100) {
-              ACTS_INFO("finished event " << event);
-            } else {
-              if (nProcessedEvents % 100 == 0) {
-                ACTS_INFO(nProcessedEvents << " / " << nTotalEvents
-                                           << " events processed");
+            // add timing info to global information
+            {
+              tbbWrap::queuing_mutex::scoped_lock lock(clocksAlgorithmsMutex);
+              for (size_t i = 0; i < clocksAlgorithms.size(); ++i) {
+                clocksAlgorithms[i] += localClocksAlgorithms[i];
               }
             }
-          }
+          });
+    });
+  }
+#ifndef ACTS_EXAMPLES_NO_TBB
+  else {
+    // the readers at the front and the writers at the end of the sequence
+    // form the serial read and write stages
+    std::size_t readEnd = 0;
+    while (readEnd < m_sequenceElements.size() and
+           dynamic_cast<const IReader*>(
+               m_sequenceElements[readEnd].get()) != nullptr) {
+      ++readEnd;
+    }
+    std::size_t writeBegin = m_sequenceElements.size();
+    while (readEnd < writeBegin and
+           dynamic_cast<const IWriter*>(
+               m_sequenceElements[writeBegin - 1].get()) != nullptr) {
+      --writeBegin;
+    }
 
-          // add timing info to global information
-          {
-            tbbWrap::queuing_mutex::scoped_lock lock(clocksAlgorithmsMutex);
-            for (size_t i = 0; i < clocksAlgorithms.size(); ++i) {
-              clocksAlgorithms[i] += localClocksAlgorithms[i];
-            }
-          }
-        });
-  });
+    std::size_t maxInFlight = m_cfg.maxEventsInFlight;
+    m_taskArena.execute([&] {
+      if (maxInFlight == 0) {
+        maxInFlight = 2 * tbb::this_task_arena::max_concurrency();
+      }
+    });
+    ACTS_INFO("Pipelined I/O with up to " << maxInFlight
+                                          << " events in flight");
+    ACTS_INFO("  " << readEnd << " elements in the read stage");
+    ACTS_INFO("  " << (m_sequenceElements.size() - writeBegin)
+                   << " elements in the write stage");
+
+    struct EventState {
+      std::size_t event = 0;
+      std::unique_ptr<WhiteBoard> store;
+      std::optional<AlgorithmContext> context;
+      std::vector<Duration> clocks;
+      std::array<Duration, 3> stages = {};
+    };
+    using EventStatePtr = std::shared_ptr<EventState>;
+
+    std::size_t nextEvent = eventsRange.first;
+    auto read = [&](tbb::flow_control& fc) -> EventStatePtr {
+      if (nextEvent == eventsRange.second) {
+        fc.stop();
+        return nullptr;
+      }
+      m_cfg.iterationCallback();
+      auto state = std::make_shared<EventState>();
+      StopWatch sw(state->stages[0]);
+      state->event = nextEvent++;
+      state->store = acquireEventStore(state->event);
+      state->context.emplace(0, state->event, *state->store);
+      state->clocks.resize(names.size(), Duration::zero());
+      decorate(*state->context, state->clocks);
+      executeElements(*state->context, 0, readEnd, state->clocks);
+      return state;
+    };
+    auto compute = [&](EventStatePtr state) {
+      StopWatch sw(state->stages[1]);
+      executeElements(*state->context, readEnd, writeBegin, state->clocks);
+      return state;
+    };
+    auto write = [&](EventStatePtr state) {
+      {
+        StopWatch sw(state->stages[2]);
+        executeElements(*state->context, writeBegin,
+                        m_sequenceElements.size(), state->clocks);
+      }
+      // the write stage is serial, no locking required
+      for (size_t i = 0; i < clocksAlgorithms.size(); ++i) {
+        clocksAlgorithms[i] += state->clocks[i];
+      }
+      for (size_t i = 0; i < clocksStages.size(); ++i) {
+        clocksStages[i] += state->stages[i];
+      }
+      state->context.reset();
+      releaseEventStore(std::move(state->store));
+      reportProgress(state->event);
+    };
+
+    m_taskArena.execute([&] {
+      tbb::parallel_pipeline(
+          maxInFlight,
+          tbb::make_filter<void, EventStatePtr>(
+              tbb::filter_mode::serial_in_order, read) &
+              tbb::make_filter<EventStatePtr, EventStatePtr>(
+                  tbb::filter_mode::parallel, compute) &
+              tbb::make_filter<EventStatePtr, void>(
+                  tbb::filter_mode::serial_in_order, write));
+    });
+  }
+#endif
 
   ACTS_VERBOSE("Finalize sequence elements");
   for (auto& alg : m_sequenceElements) {
@@ -396,6 +747,23 @@ int Sequencer::run() {
     ACTS_DEBUG("  " << names[i] << ": "
                     << perEvent(clocksAlgorithms[i], numEvents));
   }
+  if (pipelinedIO) {
+    // stage times add up to more than the wall clock time if the stages
+    // overlap, i.e. if the I/O is hidden behind the computation
+    std::array<std::string, 3> stageNames = {"read", "compute", "write"};
+    Duration totalStages = std::accumulate(
+        clocksStages.begin(), clocksStages.end(), Duration::zero());
+    ACTS_INFO("Average time per pipeline stage:");
+    for (size_t i = 0; i < clocksStages.size(); ++i) {
+      ACTS_INFO("  " << stageNames[i] << ": "
+                     << perEvent(clocksStages[i], numEvents));
+      names.push_back("Stage:" + stageNames[i]);
+      clocksAlgorithms.push_back(clocksStages[i]);
+    }
+    ACTS_INFO("Stage time / wall clock time: "
+              << std::chrono::duration_cast<Seconds>(totalStages).count() /
+                     std::chrono::duration_cast<Seconds>(totalWall).count());
+  }
 
   if (!m_cfg.outputDir.empty()) {
     storeTiming(names, clocksAlgorithms, numEvents,
@@ -60,10 +60,20 @@ std::vector<std::string_view> ActsExamples::WhiteBoard::similarNames(
     const std::string_view &name, int distThreshold,
     std::size_t maxNumber) const {
   std::vector<std::pair<int, std::string_view>> names;
-  for (const auto &[n, h] : m_store) {
+  auto consider = [&](const std::string &n) {
     if (const auto d = levenshteinDistance(n, name); d < distThreshold) {
       names.push_back({d, n});
     }
+  };
+  for (const auto &[n, h] : m_store) {
+    consider(n);
+  }
+  if (m_layout) {
+    for (const auto &[n, slot] : *m_layout) {
+      if (m_slots[slot]) {
+        consider(n);
+      }
+    }
   }
 
   std::sort(names.begin(), names.end(),
@@ -79,6 +79,10 @@ class RootMaterialDecorator : public Acts::IMaterialDecorator {
     std::string rhotag = "rho";
     /// The name of the output file
     std::string fileName = "material-maps.root";
+    /// Read the binned surface material as compressed material
+    bool compressBinnedMaterial = false;
+    /// Relative precision of the compressed material, zero for exact
+    float compressionPrecision = 0.;
   };
 
   /// Constructor
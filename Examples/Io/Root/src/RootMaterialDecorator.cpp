@@ -12,6 +12,7 @@
 #include "Acts/Material/MaterialGridHelper.hpp"
 #include <Acts/Geometry/GeometryIdentifier.hpp>
 #include <Acts/Material/BinnedSurfaceMaterial.hpp>
+#include <Acts/Material/CompressedSurfaceMaterial.hpp>
 #include <Acts/Material/HomogeneousSurfaceMaterial.hpp>
 #include <Acts/Material/HomogeneousVolumeMaterial.hpp>
 #include <Acts/Utilities/BinUtility.hpp>
@@ -177,8 +178,23 @@ ActsExamples::RootMaterialDecorator::RootMaterialDecorator(
           ACTS_VERBOSE("Created " << bUtility);
 
           // Construct the binned material with the right bin utility
-          sMaterial = std::make_shared<const Acts::BinnedSurfaceMaterial>(
-              bUtility, std::move(materialMatrix));
+          bool compress = m_cfg.compressBinnedMaterial;
+          if (compress and
+              not Acts::CompressedSurfaceMaterial::fitsPalette(
+                  materialMatrix, m_cfg.compressionPrecision)) {
+            ACTS_WARNING("Too many distinct material slabs to compress the "
+                         "material of surface "
+                         << geoID << ", keep the binned material");
+            compress = false;
+          }
+          if (compress) {
+            sMaterial = std::make_shared<const Acts::CompressedSurfaceMaterial>(
+                bUtility, materialMatrix, 0., Acts::MappingType::Default,
+                m_cfg.compressionPrecision);
+          } else {
+            sMaterial = std::make_shared<const Acts::BinnedSurfaceMaterial>(
+                bUtility, std::move(materialMatrix));
+          }
 
         } else {
           // Only homogeneous material present
@@ -102,8 +102,9 @@ SeedingAlgorithmConfigArg = namedtuple(
         "zBinNeighborsTop",
         "zBinNeighborsBottom",
         "numPhiNeighbors",
+        "numSeedingTasks",
     ],
-    defaults=[None] * 4,
+    defaults=[None] * 5,
 )
 
 TruthEstimatedSeedingAlgorithmConfigArg = namedtuple(
@@ -134,6 +135,12 @@ CKFPerformanceConfig = namedtuple(
     defaults=[None] * 3,
 )
 
+TrackFindingConfigArg = namedtuple(
+    "TrackFindingConfig",
+    ["numFindingTasks", "skipClaimedSeeds"],
+    defaults=[None] * 2,
+)
+
 AmbiguityResolutionConfig = namedtuple(
     "AmbiguityResolutionConfig",
     ["maximumSharedHits", "nMeasurementsMin"],
@@ -216,7 +223,7 @@ def addSeeding(
     spacePointGridConfigArg : SpacePointGridConfigArg(rMax, zBinEdges, phiBinDeflectionCoverage, phi, impactMax)
                                 SpacePointGridConfigArg settings. phi is specified as a tuple of (min,max).
         Defaults specified in Core/include/Acts/Seeding/SpacePointGrid.hpp
-    seedingAlgorithmConfigArg : SeedingAlgorithmConfigArg(allowSeparateRMax, zBinNeighborsTop, zBinNeighborsBottom, numPhiNeighbors)
+    seedingAlgorithmConfigArg : SeedingAlgorithmConfigArg(allowSeparateRMax, zBinNeighborsTop, zBinNeighborsBottom, numPhiNeighbors, numSeedingTasks)
                                 Defaults specified in Examples/Algorithms/TrackFinding/include/ActsExamples/TrackFinding/SeedingAlgorithm.hpp
     trackParamsEstimationConfig : TrackParamsEstimationConfig(deltaR)
         TrackParamsEstimationAlgorithm configuration. Currently only deltaR=(min,max) range specified here.
@@ -301,6 +308,7 @@ def addSeeding(
             level=logLevel,
             inputSeeds=inputSeeds,
             outputTrackParameters="estimatedparameters",
+            outputSeeds="estimatedseeds",
             trackingGeometry=trackingGeometry,
             magneticField=field,
             **acts.examples.defaultKWArgs(
@@ -602,6 +610,7 @@ def addStandardSeeding(
             zBinNeighborsTop=seedingAlgorithmConfigArg.zBinNeighborsTop,
             zBinNeighborsBottom=seedingAlgorithmConfigArg.zBinNeighborsBottom,
             numPhiNeighbors=seedingAlgorithmConfigArg.numPhiNeighbors,
+            numSeedingTasks=seedingAlgorithmConfigArg.numSeedingTasks,
         ),
         gridConfig=gridConfig,
         gridOptions=gridOptions,
@@ -871,6 +880,7 @@ def addTruthTrackingGsf(
 @acts.examples.NamedTypeArgs(
     ckfPerformanceConfig=CKFPerformanceConfig,
     trackSelectorRanges=TrackSelectorRanges,
+    trackFindingConfigArg=TrackFindingConfigArg,
 )
 def addCKFTracks(
     s: acts.examples.Sequencer,
@@ -878,6 +888,7 @@ def addCKFTracks(
     field: acts.MagneticFieldProvider,
     trackSelectorRanges: Optional[TrackSelectorRanges] = None,
     ckfPerformanceConfig: CKFPerformanceConfig = CKFPerformanceConfig(),
+    trackFindingConfigArg: TrackFindingConfigArg = TrackFindingConfigArg(),
     outputDirCsv: Optional[Union[Path, str]] = None,
     outputDirRoot: Optional[Union[Path, str]] = None,
     writeTrajectories: bool = True,
@@ -894,6 +905,9 @@ def addCKFTracks(
     ckfPerformanceConfigArg : CKFPerformanceConfig(truthMatchProbMin, nMeasurementsMin, ptMin)
         CKFPerformanceWriter configuration.
         Defaults specified in Examples/Io/Performance/ActsExamples/Io/Performance/CKFPerformanceWriter.hpp
+    trackFindingConfigArg : TrackFindingConfigArg(numFindingTasks, skipClaimedSeeds)
+        TrackFindingAlgorithm configuration. Skipping seeds with claimed measurements requires the seeds of addSeeding.
+        Defaults specified in Examples/Algorithms/TrackFinding/include/ActsExamples/TrackFinding/TrackFindingAlgorithm.hpp
     outputDirCsv : Path|str, path, None
         the output folder for the Csv output, None triggers no output
     outputDirRoot : Path|str, path, None
@@ -918,10 +932,17 @@ def addCKFTracks(
         inputMeasurements="measurements",
         inputSourceLinks="sourcelinks",
         inputInitialTrackParameters="estimatedparameters",
+        inputSeeds="estimatedseeds"
+        if trackFindingConfigArg.skipClaimedSeeds
+        else "",
         outputTracks="ckfTracks",
         findTracks=acts.examples.TrackFindingAlgorithm.makeTrackFinderFunction(
             trackingGeometry, field
         ),
+        **acts.examples.defaultKWArgs(
+            numFindingTasks=trackFindingConfigArg.numFindingTasks,
+            skipClaimedSeeds=trackFindingConfigArg.skipClaimedSeeds,
+        ),
     )
     s.addAlgorithm(trackFinder)
 
@@ -60,6 +60,8 @@ void addJson(Context& ctx) {
     ACTS_PYTHON_MEMBER(processVolumes);
     ACTS_PYTHON_MEMBER(processDenseVolumes);
     ACTS_PYTHON_MEMBER(processNonMaterial);
+    ACTS_PYTHON_MEMBER(compressBinnedMaterial);
+    ACTS_PYTHON_MEMBER(compressionPrecision);
     ACTS_PYTHON_STRUCT_END();
   }
 
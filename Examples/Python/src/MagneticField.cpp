@@ -11,6 +11,7 @@
 #include "Acts/MagneticField/BFieldMapUtils.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/MagneticField/MemoryMappedBFieldMap.hpp"
 #include "Acts/MagneticField/NullBField.hpp"
 #include "Acts/MagneticField/SolenoidBField.hpp"
 #include "Acts/Plugins/Python/Utilities.hpp"
@@ -55,6 +56,38 @@ void addMagneticField(Context& ctx) {
              std::shared_ptr<ActsExamples::detail::InterpolatedMagneticField3>>(
       mex, "InterpolatedMagneticField3");
 
+  py::enum_<Acts::BFieldMapStorage>(m, "BFieldMapStorage")
+      .value("Float64", Acts::BFieldMapStorage::Float64)
+      .value("Float32", Acts::BFieldMapStorage::Float32)
+      .value("Float16", Acts::BFieldMapStorage::Float16)
+      .value("Fixed16", Acts::BFieldMapStorage::Fixed16);
+
+  py::class_<Acts::MemoryMappedBFieldMap, Acts::InterpolatedMagneticField,
+             Acts::MagneticFieldProvider,
+             std::shared_ptr<Acts::MemoryMappedBFieldMap>>(
+      m, "MemoryMappedBFieldMap")
+      .def(py::init<const std::string&, double>(), py::arg("path"),
+           py::arg("scale") = 1.)
+      .def_property_readonly("storage", &Acts::MemoryMappedBFieldMap::storage);
+
+  m.def(
+      "writeBinaryBFieldMap",
+      [](const std::string& path,
+         const ActsExamples::detail::InterpolatedMagneticField2& field,
+         Acts::BFieldMapStorage storage) {
+        Acts::writeBinaryBFieldMap(path, field, storage);
+      },
+      py::arg("path"), py::arg("field"), py::arg("storage"));
+
+  m.def(
+      "writeBinaryBFieldMap",
+      [](const std::string& path,
+         const ActsExamples::detail::InterpolatedMagneticField3& field,
+         Acts::BFieldMapStorage storage) {
+        Acts::writeBinaryBFieldMap(path, field, storage);
+      },
+      py::arg("path"), py::arg("field"), py::arg("storage"));
+
   py::class_<Acts::NullBField, Acts::MagneticFieldProvider,
              std::shared_ptr<Acts::NullBField>>(m, "NullBField")
       .def(py::init<>());
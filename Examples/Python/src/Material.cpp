@@ -64,6 +64,8 @@ void addMaterial(Context& ctx) {
     ACTS_PYTHON_MEMBER(ztag);
     ACTS_PYTHON_MEMBER(rhotag);
     ACTS_PYTHON_MEMBER(fileName);
+    ACTS_PYTHON_MEMBER(compressBinnedMaterial);
+    ACTS_PYTHON_MEMBER(compressionPrecision);
     ACTS_PYTHON_STRUCT_END();
   }
 
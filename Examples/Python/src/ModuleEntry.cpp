@@ -59,6 +59,13 @@ class PySequenceElement : public SequenceElement {
 #pragma clang diagnostic pop
 #endif
 
+// Exposes the protected data dependency declarations to the bindings
+class SequenceElementPublicist : public SequenceElement {
+ public:
+  using SequenceElement::declareRead;
+  using SequenceElement::declareWrite;
+};
+
 class PyIAlgorithm : public IAlgorithm {
  public:
   using IAlgorithm::IAlgorithm;
@@ -163,7 +170,11 @@ PYBIND11_MODULE(ActsPythonBindings, m) {
           mex, "SequenceElement")
           .def(py::init_alias<>())
           .def("internalExecute", &SequenceElement::internalExecute)
-          .def("name", &SequenceElement::name);
+          .def("name", &SequenceElement::name)
+          .def("declareRead", &SequenceElementPublicist::declareRead)
+          .def("declareWrite", &SequenceElementPublicist::declareWrite)
+          .def_property_readonly("readKeys", &SequenceElement::readKeys)
+          .def_property_readonly("writeKeys", &SequenceElement::writeKeys);
 
   auto bareAlgorithm =
       py::class_<ActsExamples::IAlgorithm,
@@ -223,7 +234,10 @@ PYBIND11_MODULE(ActsPythonBindings, m) {
       .def_readwrite("logLevel", &Config::logLevel)
       .def_readwrite("numThreads", &Config::numThreads)
       .def_readwrite("outputDir", &Config::outputDir)
-      .def_readwrite("outputTimingFile", &Config::outputTimingFile);
+      .def_readwrite("outputTimingFile", &Config::outputTimingFile)
+      .def_readwrite("concurrentAlgorithms", &Config::concurrentAlgorithms)
+      .def_readwrite("pipelinedIO", &Config::pipelinedIO)
+      .def_readwrite("maxEventsInFlight", &Config::maxEventsInFlight);
 
   struct PyFpeMonitor {
     std::optional<Acts::FpeMonitor> mon;
@@ -223,7 +223,7 @@ void addTrackFinding(Context& ctx) {
       ActsExamples::SeedingAlgorithm, mex, "SeedingAlgorithm", inputSpacePoints,
       outputSeeds, outputProtoTracks, seedFilterConfig, seedFinderConfig,
       seedFinderOptions, gridConfig, gridOptions, allowSeparateRMax,
-      zBinNeighborsTop, zBinNeighborsBottom, numPhiNeighbors);
+      zBinNeighborsTop, zBinNeighborsBottom, numPhiNeighbors, numSeedingTasks);
 
   ACTS_PYTHON_DECLARE_ALGORITHM(
       ActsExamples::SeedingOrthogonalAlgorithm, mex,
@@ -240,7 +240,7 @@ void addTrackFinding(Context& ctx) {
   ACTS_PYTHON_DECLARE_ALGORITHM(
       ActsExamples::TrackParamsEstimationAlgorithm, mex,
       "TrackParamsEstimationAlgorithm", inputSeeds, outputTrackParameters,
-      trackingGeometry, magneticField, bFieldMin, sigmaLoc0, sigmaLoc1,
+      outputSeeds, trackingGeometry, magneticField, bFieldMin, sigmaLoc0, sigmaLoc1,
       sigmaPhi, sigmaTheta, sigmaQOverP, sigmaT0, initialVarInflation);
 
   {
@@ -264,9 +264,13 @@ void addTrackFinding(Context& ctx) {
     ACTS_PYTHON_MEMBER(inputMeasurements);
     ACTS_PYTHON_MEMBER(inputSourceLinks);
     ACTS_PYTHON_MEMBER(inputInitialTrackParameters);
+    ACTS_PYTHON_MEMBER(inputSeeds);
     ACTS_PYTHON_MEMBER(outputTracks);
     ACTS_PYTHON_MEMBER(findTracks);
     ACTS_PYTHON_MEMBER(measurementSelectorCfg);
+    ACTS_PYTHON_MEMBER(computeSharedHits);
+    ACTS_PYTHON_MEMBER(numFindingTasks);
+    ACTS_PYTHON_MEMBER(skipClaimedSeeds);
     ACTS_PYTHON_STRUCT_END();
   }
 
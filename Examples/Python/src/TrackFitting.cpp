@@ -61,6 +61,7 @@ void addTrackFitting(Context& ctx) {
     ACTS_PYTHON_MEMBER(fit);
     ACTS_PYTHON_MEMBER(trackingGeometry);
     ACTS_PYTHON_MEMBER(pickTrack);
+    ACTS_PYTHON_MEMBER(numFittingTasks);
     ACTS_PYTHON_STRUCT_END();
 
     mex.def(
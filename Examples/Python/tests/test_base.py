@@ -71,6 +71,108 @@ def test_sequencer_multi_threaded(ptcl_gun, capfd):
     assert "Processed 2 events" in cap.out
 
 
+def test_sequencer_concurrent_algorithms(ptcl_gun, capfd):
+    # Elements without declared inputs and outputs keep their order, such
+    # that any sequence can be run in this mode.
+    s = acts.examples.Sequencer(numThreads=-1, events=2, concurrentAlgorithms=True)
+    ptcl_gun(s)
+    s.run()
+    cap = capfd.readouterr()
+    assert cap.err == ""
+    assert "Processed 2 events" in cap.out
+
+
+class DataFlowAlg(acts.examples.IAlgorithm):
+    def __init__(self, name, reads=(), writes=(), log=None, delay=0):
+        acts.examples.IAlgorithm.__init__(self, name=name, level=acts.logging.INFO)
+        for key in reads:
+            self.declareRead(key)
+        for key in writes:
+            self.declareWrite(key)
+        self.log = log
+        self.delay = delay
+
+    def execute(self, ctx):
+        import time
+
+        time.sleep(self.delay)
+        self.log.append((ctx.eventNumber, self.name()))
+        return acts.examples.ProcessCode.SUCCESS
+
+
+def test_sequencer_concurrent_algorithms_order():
+    s = acts.examples.Sequencer(numThreads=-1, events=4, concurrentAlgorithms=True)
+    log = []
+    s.addAlgorithm(DataFlowAlg("slow", writes=["a"], log=log, delay=0.05))
+    s.addAlgorithm(DataFlowAlg("fast", writes=["b"], log=log))
+    s.addAlgorithm(DataFlowAlg("both", reads=["a", "b"], writes=["c"], log=log))
+    s.addAlgorithm(DataFlowAlg("last", reads=["c"], log=log))
+    s.run()
+
+    assert len(log) == 16
+    for event in range(4):
+        order = [name for ev, name in log if ev == event]
+        assert sorted(order) == ["both", "fast", "last", "slow"]
+        assert order.index("both") > order.index("slow")
+        assert order.index("both") > order.index("fast")
+        assert order.index("last") > order.index("both")
+
+
+def test_sequencer_data_flow_read_before_write():
+    s = acts.examples.Sequencer(numThreads=1, events=1)
+    s.addAlgorithm(DataFlowAlg("reader", reads=["a"], log=[]))
+    s.addAlgorithm(DataFlowAlg("writer", writes=["a"], log=[]))
+    with pytest.raises(RuntimeError):
+        s.run()
+
+
+def test_sequencer_data_flow_duplicate_writer():
+    s = acts.examples.Sequencer(numThreads=1, events=1)
+    s.addAlgorithm(DataFlowAlg("first", writes=["a"], log=[]))
+    s.addAlgorithm(DataFlowAlg("second", writes=["a"], log=[]))
+    with pytest.raises(RuntimeError):
+        s.run()
+
+
+def test_sequencer_pipelined_io(ptcl_gun, capfd):
+    s = acts.examples.Sequencer(
+        numThreads=-1, events=4, pipelinedIO=True, maxEventsInFlight=2
+    )
+    ptcl_gun(s)
+    s.run()
+    cap = capfd.readouterr()
+    assert cap.err == ""
+    assert "Processed 4 events" in cap.out
+
+
+@pytest.mark.root
+def test_sequencer_pipelined_io_write_order(ptcl_gun, tmp_path):
+    # Events are processed out of order, but written in order
+    s = acts.examples.Sequencer(
+        numThreads=-1, events=8, pipelinedIO=True, maxEventsInFlight=4
+    )
+    evGen = ptcl_gun(s)
+    file = tmp_path / "particles.root"
+    s.addWriter(
+        acts.examples.RootParticleWriter(
+            level=acts.logging.INFO,
+            inputParticles=evGen.config.outputParticles,
+            filePath=str(file),
+        )
+    )
+    s.run()
+
+    import ROOT
+
+    ROOT.PyConfig.IgnoreCommandLineOptions = True
+    ROOT.gROOT.SetBatch(True)
+
+    rf = ROOT.TFile.Open(str(file))
+    tree = rf.Get("particles")
+    events = [entry.event_id for entry in tree]
+    assert events == list(range(8))
+
+
 def test_random_number():
     rnd = acts.examples.RandomNumbers(seed=42)
 
@@ -36,3 +36,28 @@ def test_solenoid(conf_const):
     )
 
     assert isinstance(field, acts.examples.InterpolatedMagneticField2)
+
+
+def test_memory_mapped_bfield(conf_const, tmp_path):
+    solenoid = conf_const(
+        acts.SolenoidBField,
+        radius=1200 * u.mm,
+        length=6000 * u.mm,
+        bMagCenter=2 * u.T,
+        nCoils=1194,
+    )
+
+    field = acts.solenoidFieldMap(
+        rlim=(0, 1200 * u.mm),
+        zlim=(-5000 * u.mm, 5000 * u.mm),
+        nbins=(10, 10),
+        field=solenoid,
+    )
+
+    path = tmp_path / "solenoid.bfm"
+    acts.writeBinaryBFieldMap(str(path), field, acts.BFieldMapStorage.Float32)
+    assert path.exists()
+
+    mapped = acts.MemoryMappedBFieldMap(str(path))
+    assert isinstance(mapped, acts.MagneticFieldProvider)
+    assert mapped.storage == acts.BFieldMapStorage.Float32
@@ -11,6 +11,7 @@
 #include "Acts/Definitions/Units.hpp"
 #include "Acts/MagneticField/BFieldMapUtils.hpp"
 #include "Acts/MagneticField/MagneticFieldProvider.hpp"
+#include "Acts/MagneticField/MemoryMappedBFieldMap.hpp"
 #include "Acts/MagneticField/SolenoidBField.hpp"
 #include "Acts/Utilities/Logger.hpp"
 #include "ActsExamples/Framework/Sequencer.hpp"
@@ -46,8 +47,10 @@ void ActsExamples::Options::addMagneticFieldOptions(Description& desc) {
       "Scaling factor for the event-dependent field strength scaling. A unit "
       "value means that the field strength stays the same for every event.");
   opt("bf-map-file", value<std::string>(),
-      "Read a magnetic field map from the given file. ROOT and text file "
-      "formats are supported. Only used if no constant field is given.");
+      "Read a magnetic field map from the given file. ROOT, text and binary "
+      "(.bfm) file formats are supported. Binary files are memory-mapped and "
+      "describe their grid type and units themselves, such that the other "
+      "map options are ignored. Only used if no constant field is given.");
   opt("bf-map-tree", value<std::string>()->default_value("bField"),
       "Name of the TTree in the ROOT file. Only used if the field map is read "
       "from a ROOT file.");
@@ -126,6 +129,11 @@ ActsExamples::Options::readMagneticField(const Variables& vars) {
   // second option: read a field map from a file
   if (vars.count("bf-map-file") != 0u) {
     const path file = vars["bf-map-file"].as<std::string>();
+    if (file.extension() == ".bfm") {
+      ACTS_INFO("Map magnetic field map from binary file '" << file << "'");
+      return std::make_shared<Acts::MemoryMappedBFieldMap>(file.native());
+    }
+
     const auto tree = vars["bf-map-tree"].as<std::string>();
     const auto type = vars["bf-map-type"].as<std::string>();
     const auto useOctantOnly = vars["bf-map-octantonly"].as<bool>();
@@ -10,8 +10,6 @@
 
 #include "ActsExamples/Framework/WhiteBoard.hpp"
 
-#include "HelloData.hpp"
-
 ActsExamples::HelloWhiteBoardAlgorithm::HelloWhiteBoardAlgorithm(
     const Config& cfg, Acts::Logging::Level level)
     : ActsExamples::IAlgorithm("HelloWhiteBoard", level), m_cfg(cfg) {
@@ -22,13 +20,17 @@ ActsExamples::HelloWhiteBoardAlgorithm::HelloWhiteBoardAlgorithm(
   if (m_cfg.output.empty()) {
     throw std::invalid_argument("Missing output collection");
   }
+  // the handles are resolved once by the sequencer and then access the
+  // event store without looking up the collection names.
+  m_input.initialize(m_cfg.input);
+  m_output.initialize(m_cfg.output);
 }
 
 ActsExamples::ProcessCode ActsExamples::HelloWhiteBoardAlgorithm::execute(
     const ActsExamples::AlgorithmContext& ctx) const {
   // event-store is append-only and always returns a const reference.
   ACTS_INFO("Reading HelloDataCollection " << m_cfg.input);
-  const auto& in = ctx.eventStore.get<HelloDataCollection>(m_cfg.input);
+  const auto& in = m_input(ctx);
   ACTS_VERBOSE("Read HelloDataCollection with size " << in.size());
 
   // create a copy
@@ -37,7 +39,7 @@ ActsExamples::ProcessCode ActsExamples::HelloWhiteBoardAlgorithm::execute(
   // transfer the copy to the event store. this always transfers ownership
   // via r-value reference/ move construction.
   ACTS_INFO("Writing HelloDataCollection " << m_cfg.output);
-  ctx.eventStore.add(m_cfg.output, std::move(copy));
+  m_output(ctx, std::move(copy));
 
   return ActsExamples::ProcessCode::SUCCESS;
 }
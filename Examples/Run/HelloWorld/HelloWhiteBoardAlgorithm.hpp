@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include "ActsExamples/Framework/DataHandle.hpp"
 #include "ActsExamples/Framework/IAlgorithm.hpp"
 #include "ActsExamples/Framework/ProcessCode.hpp"
 
 #include <memory>
 
+#include "HelloData.hpp"
+
 namespace ActsExamples {
 
 /// Example algorithm that reads/writes data from/to the event store.
@@ -33,6 +36,9 @@ class HelloWhiteBoardAlgorithm : public ActsExamples::IAlgorithm {
 
  private:
   Config m_cfg;
+
+  ReadDataHandle<HelloDataCollection> m_input{this, "Input"};
+  WriteDataHandle<HelloDataCollection> m_output{this, "Output"};
 };
 
 }  // namespace ActsExamples
@@ -0,0 +1,148 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/MagneticField/MemoryMappedBFieldMap.hpp"
+#include "ActsExamples/MagneticField/MagneticField.hpp"
+#include "ActsExamples/Options/CommonOptions.hpp"
+#include "ActsExamples/Options/MagneticFieldOptions.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+/// The main executable
+///
+/// Converts an interpolated field map from a txt, csv or root file into the
+/// memory-mappable binary format with all storage precisions and reports the
+/// file size and the interpolation deviation of each precision with respect
+/// to the source map at random positions.
+
+namespace po = boost::program_options;
+
+namespace {
+
+struct Deviation {
+  double maxAbs = 0.;
+  double meanAbs = 0.;
+  double maxRel = 0.;
+};
+
+Deviation compare(const Acts::InterpolatedMagneticField& source,
+                  const Acts::MemoryMappedBFieldMap& mapped, size_t nPoints) {
+  Acts::MagneticFieldContext mctx;
+  auto cache = mapped.makeCache(mctx);
+
+  // sample the bounding box of the map domain and keep the inside points
+  const auto min = source.getMin();
+  const auto max = source.getMax();
+  const bool isRZ = mapped.coordinates() == Acts::BFieldMapCoordinates::RZ;
+  std::uniform_real_distribution<double> xDist(isRZ ? -max[0] : min[0],
+                                               max[0]);
+  std::uniform_real_distribution<double> yDist(isRZ ? -max[0] : min[1],
+                                               isRZ ? max[0] : max[1]);
+  std::uniform_real_distribution<double> zDist(min.back(), max.back());
+  std::mt19937 rng;
+
+  Deviation deviation;
+  size_t nInside = 0;
+  for (size_t i = 0; i < nPoints; ++i) {
+    const Acts::Vector3 pos(xDist(rng), yDist(rng), zDist(rng));
+    if (!source.isInside(pos)) {
+      continue;
+    }
+    const Acts::Vector3 reference = source.getFieldUnchecked(pos);
+    const auto field = mapped.getField(pos, cache);
+    if (!field.ok()) {
+      continue;
+    }
+    const double absDeviation = (*field - reference).norm();
+    deviation.maxAbs = std::max(deviation.maxAbs, absDeviation);
+    deviation.meanAbs += absDeviation;
+    if (reference.norm() > 0.) {
+      deviation.maxRel =
+          std::max(deviation.maxRel, absDeviation / reference.norm());
+    }
+    ++nInside;
+  }
+  if (nInside > 0) {
+    deviation.meanAbs /= nInside;
+  }
+  return deviation;
+}
+
+}  // namespace
+
+/// @brief main executable
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int main(int argc, char* argv[]) {
+  using Acts::BFieldMapStorage;
+
+  // Declare the supported program options.
+  auto desc = ActsExamples::Options::makeDefaultOptions();
+  ActsExamples::Options::addMagneticFieldOptions(desc);
+  desc.add_options()("bf-binary-out",
+                     po::value<std::string>()->default_value("bfield"),
+                     "prefix of the binary field map files, the storage "
+                     "precision and the extension are appended.")(
+      "bf-compare-points", po::value<size_t>()->default_value(100000),
+      "number of random positions to compare the field maps at.");
+  auto vm = ActsExamples::Options::parse(desc, argc, argv);
+  if (vm.empty()) {
+    return EXIT_FAILURE;
+  }
+
+  auto bField = ActsExamples::Options::readMagneticField(vm);
+  auto fieldRZ = std::dynamic_pointer_cast<
+      const ActsExamples::detail::InterpolatedMagneticField2>(bField);
+  auto fieldXYZ = std::dynamic_pointer_cast<
+      const ActsExamples::detail::InterpolatedMagneticField3>(bField);
+  if (!fieldRZ && !fieldXYZ) {
+    std::cerr << "The magnetic field is not read from a field map"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const Acts::InterpolatedMagneticField& source =
+      fieldRZ ? static_cast<const Acts::InterpolatedMagneticField&>(*fieldRZ)
+              : *fieldXYZ;
+
+  const auto prefix = vm["bf-binary-out"].as<std::string>();
+  const auto nPoints = vm["bf-compare-points"].as<size_t>();
+  const std::vector<std::pair<BFieldMapStorage, std::string>> storages = {
+      {BFieldMapStorage::Float64, "float64"},
+      {BFieldMapStorage::Float32, "float32"},
+      {BFieldMapStorage::Float16, "float16"},
+      {BFieldMapStorage::Fixed16, "fixed16"},
+  };
+
+  for (const auto& [storage, name] : storages) {
+    const std::string path = prefix + "_" + name + ".bfm";
+    if (fieldRZ) {
+      Acts::writeBinaryBFieldMap(path, *fieldRZ, storage);
+    } else {
+      Acts::writeBinaryBFieldMap(path, *fieldXYZ, storage);
+    }
+    Acts::MemoryMappedBFieldMap mapped(path);
+    const auto deviation = compare(source, mapped, nPoints);
+
+    std::cout << "[>>>] " << path << ": " << mapped.mappedSize() / 1024
+              << " kB, max deviation "
+              << deviation.maxAbs / Acts::UnitConstants::T << " T ("
+              << deviation.maxRel << " relative), mean deviation "
+              << deviation.meanAbs / Acts::UnitConstants::T << " T"
+              << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -64,6 +64,10 @@ class MaterialMapJsonConverter {
     bool processDenseVolumes = false;
     /// Add proto material to all surfaces
     bool processNonMaterial = false;
+    /// Convert the binned surface material into compressed material on read
+    bool compressBinnedMaterial = false;
+    /// Relative precision of the compressed material, zero for exact
+    float compressionPrecision = 0.;
   };
 
   /// Constructor
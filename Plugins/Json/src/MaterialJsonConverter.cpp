@@ -9,6 +9,7 @@
 #include "Acts/Plugins/Json/MaterialJsonConverter.hpp"
 
 #include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/CompressedSurfaceMaterial.hpp"
 #include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
 #include "Acts/Material/HomogeneousVolumeMaterial.hpp"
 #include "Acts/Material/ISurfaceMaterial.hpp"
@@ -115,9 +116,20 @@ void Acts::to_json(nlohmann::json& j, const surfaceMaterialPointer& material) {
     j[Acts::jsonKey().materialkey] = jMaterial;
     return;
   }
-  // Only option remaining: BinnedSurface material
+  // Only options remaining: BinnedSurface or CompressedSurface material,
+  // the latter is written as binned material
+  Acts::MaterialSlabMatrix fullMaterial;
   auto bsMaterial = dynamic_cast<const Acts::BinnedSurfaceMaterial*>(material);
+  auto csMaterial =
+      dynamic_cast<const Acts::CompressedSurfaceMaterial*>(material);
   if (bsMaterial != nullptr) {
+    bUtility = &(bsMaterial->binUtility());
+    fullMaterial = bsMaterial->fullMaterial();
+  } else if (csMaterial != nullptr) {
+    bUtility = &(csMaterial->binUtility());
+    fullMaterial = csMaterial->fullMaterial();
+  }
+  if (bUtility != nullptr) {
     // type is binned
     jMaterial[Acts::jsonKey().typekey] = "binned";
     // Set mapping type
@@ -125,11 +137,10 @@ void Acts::to_json(nlohmann::json& j, const surfaceMaterialPointer& material) {
     jMaterial[Acts::jsonKey().maptype] = mapType;
     // Material has been mapped
     jMaterial[Acts::jsonKey().mapkey] = true;
-    bUtility = &(bsMaterial->binUtility());
     // convert the data
     // get the material matrix
     nlohmann::json mmat = nlohmann::json::array();
-    for (const auto& mpVector : bsMaterial->fullMaterial()) {
+    for (const auto& mpVector : fullMaterial) {
       nlohmann::json mvec = nlohmann::json::array();
       for (const auto& mp : mpVector) {
         nlohmann::json jmat(mp);
@@ -12,6 +12,8 @@
 #include "Acts/Geometry/CutoutCylinderVolumeBounds.hpp"
 #include "Acts/Geometry/CylinderVolumeBounds.hpp"
 #include "Acts/Geometry/GeometryIdentifier.hpp"
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/CompressedSurfaceMaterial.hpp"
 #include "Acts/Material/ProtoSurfaceMaterial.hpp"
 #include "Acts/Material/ProtoVolumeMaterial.hpp"
 #include "Acts/Plugins/Json/MaterialJsonConverter.hpp"
@@ -273,6 +275,21 @@ Acts::MaterialMapJsonConverter::jsonToMaterialMaps(
   for (size_t i = 0; i < hierarchySurfaceMap.size(); i++) {
     std::shared_ptr<const ISurfaceMaterial> surfacePointer(
         hierarchySurfaceMap.valueAt(i));
+    if (m_cfg.compressBinnedMaterial) {
+      auto bsMaterial =
+          dynamic_cast<const BinnedSurfaceMaterial*>(surfacePointer.get());
+      if (bsMaterial != nullptr and
+          CompressedSurfaceMaterial::fitsPalette(bsMaterial->fullMaterial(),
+                                                 m_cfg.compressionPrecision)) {
+        surfacePointer = std::make_shared<const CompressedSurfaceMaterial>(
+            *bsMaterial, m_cfg.compressionPrecision);
+      } else if (bsMaterial != nullptr) {
+        ACTS_WARNING("Too many distinct material slabs to compress the "
+                     "material of surface "
+                     << hierarchySurfaceMap.idAt(i)
+                     << ", keep the binned material");
+      }
+    }
     surfaceMap.insert({hierarchySurfaceMap.idAt(i), std::move(surfacePointer)});
   }
 
@@ -0,0 +1,212 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/VectorMultiTrajectory.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/TrackFitting/BatchedGainMatrixSmoother.hpp"
+#include "Acts/TrackFitting/BatchedGainMatrixUpdater.hpp"
+#include "Acts/TrackFitting/GainMatrixSmoother.hpp"
+#include "Acts/TrackFitting/GainMatrixUpdater.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts;
+
+namespace {
+
+BoundVector randomParameters(std::mt19937& rng) {
+  std::normal_distribution<double> normal(0., 1.);
+  BoundVector parameters;
+  for (std::size_t i = 0; i < eBoundSize; ++i) {
+    parameters[i] = normal(rng);
+  }
+  return parameters;
+}
+
+BoundSymMatrix randomCovariance(std::mt19937& rng, double scale) {
+  std::normal_distribution<double> normal(0., 1.);
+  BoundMatrix a;
+  for (std::size_t i = 0; i < eBoundSize * eBoundSize; ++i) {
+    a(i) = normal(rng);
+  }
+  return scale * (a * a.transpose() + BoundSymMatrix::Identity());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  unsigned int lvl = Acts::Logging::INFO;
+  unsigned int nStates = 1;
+  unsigned int runs = 1;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("states",po::value<unsigned int>(&nStates)->default_value(1000),"number of track states per run")
+      ("runs",po::value<unsigned int>(&runs)->default_value(1000),"number of benchmark runs")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  ACTS_LOCAL_LOGGER(
+      getDefaultLogger("BatchedGainMatrix", Acts::Logging::Level(lvl)));
+
+  GeometryContext gctx;
+  std::mt19937 rng(42);
+
+  // Independent tracks of two track states each, with pixel measurements on
+  // the first state and the second state already smoothed
+  VectorMultiTrajectory traj;
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> last;
+  ActsMatrix<2, eBoundSize> projector = ActsMatrix<2, eBoundSize>::Zero();
+  projector(0, eBoundLoc0) = 1;
+  projector(1, eBoundLoc1) = 1;
+  for (unsigned int i = 0; i < nStates; ++i) {
+    auto ts = traj.getTrackState(traj.addTrackState(TrackStatePropMask::All));
+    ts.predicted() = randomParameters(rng);
+    ts.predictedCovariance() = randomCovariance(rng, 1.);
+    ts.allocateCalibrated(2);
+    ts.calibrated<2>() = randomParameters(rng).head<2>();
+    ts.calibratedCovariance<2>() =
+        randomCovariance(rng, 0.01).topLeftCorner<2, 2>();
+    ts.setProjector(projector);
+    ts.filtered() = ts.predicted();
+    ts.filteredCovariance() = 0.5 * ts.predictedCovariance();
+    ts.jacobian().setIdentity();
+    first.push_back(ts.index());
+
+    // consistent covariances, such that the smoothed covariance stays
+    // positive definite
+    auto next = traj.getTrackState(
+        traj.addTrackState(TrackStatePropMask::All, ts.index()));
+    next.jacobian() = BoundMatrix::Identity() + 0.1 * randomCovariance(rng, 1.);
+    next.predicted() = randomParameters(rng);
+    next.predictedCovariance() =
+        next.jacobian() * ts.filteredCovariance() *
+            next.jacobian().transpose() +
+        randomCovariance(rng, 0.1);
+    next.filtered() = randomParameters(rng);
+    next.filteredCovariance() = 0.5 * next.predictedCovariance();
+    last.push_back(next.index());
+  }
+
+  ACTS_INFO("Benchmarking " << nStates << " track states");
+
+  // Kalman update
+  GainMatrixUpdater updater;
+  const auto updaterBenchmark = Acts::Test::microBenchmark(
+      [&] {
+        for (std::size_t i : first) {
+          if (not updater
+                      .operator()<VectorMultiTrajectory>(
+                          gctx, traj.getTrackState(i))
+                      .ok()) {
+            throw std::runtime_error("Kalman update failed");
+          }
+        }
+      },
+      1, runs);
+  ACTS_INFO("Execution stats per-state update: " << updaterBenchmark);
+
+  BatchedGainMatrixUpdater batchedUpdater;
+  BatchedGainMatrixUpdater::States<2> updateStates;
+  updateStates.resize(nStates);
+  for (std::size_t i = 0; i < nStates; ++i) {
+    updateStates.setTrackState(i, traj.getTrackState(first[i]));
+  }
+  const auto batchedUpdaterBenchmark = Acts::Test::microBenchmark(
+      [&] {
+        if (not batchedUpdater(updateStates).ok()) {
+          throw std::runtime_error("Batched Kalman update failed");
+        }
+      },
+      1, runs);
+  ACTS_INFO("Execution stats batched update: " << batchedUpdaterBenchmark);
+
+  // including the copies from and to the trajectory
+  const auto batchedUpdaterCopyBenchmark = Acts::Test::microBenchmark(
+      [&] {
+        for (std::size_t i = 0; i < nStates; ++i) {
+          updateStates.setTrackState(i, traj.getTrackState(first[i]));
+        }
+        if (not batchedUpdater(updateStates).ok()) {
+          throw std::runtime_error("Batched Kalman update failed");
+        }
+        for (std::size_t i = 0; i < nStates; ++i) {
+          updateStates.writeFiltered(i, traj.getTrackState(first[i]));
+        }
+      },
+      1, runs);
+  ACTS_INFO("Execution stats batched update with copies: "
+            << batchedUpdaterCopyBenchmark);
+
+  // Smoothing
+  GainMatrixSmoother smoother;
+  const auto smootherBenchmark = Acts::Test::microBenchmark(
+      [&] {
+        for (std::size_t i : last) {
+          if (not smoother(gctx, traj, i).ok()) {
+            throw std::runtime_error("Smoothing failed");
+          }
+        }
+      },
+      1, runs);
+  ACTS_INFO("Execution stats per-state smoothing: " << smootherBenchmark);
+
+  BatchedGainMatrixSmoother batchedSmoother;
+  BatchedGainMatrixSmoother::States smoothStates;
+  smoothStates.resize(nStates);
+  for (std::size_t i = 0; i < nStates; ++i) {
+    smoothStates.setTrackStates(i, traj.getTrackState(first[i]),
+                                traj.getTrackState(last[i]));
+  }
+  const auto batchedSmootherBenchmark = Acts::Test::microBenchmark(
+      [&] {
+        if (not batchedSmoother(smoothStates).ok()) {
+          throw std::runtime_error("Batched smoothing failed");
+        }
+      },
+      1, runs);
+  ACTS_INFO("Execution stats batched smoothing: " << batchedSmootherBenchmark);
+
+  const auto perState = [&](const auto& result) {
+    return result.iterTimeAverage().count() / nStates;
+  };
+  ACTS_INFO("Update time per track state [ns]: per-state "
+            << perState(updaterBenchmark) << ", batched "
+            << perState(batchedUpdaterBenchmark) << ", batched with copies "
+            << perState(batchedUpdaterCopyBenchmark));
+  ACTS_INFO("Smoothing time per track state [ns]: per-state "
+            << perState(smootherBenchmark) << ", batched "
+            << perState(batchedSmootherBenchmark));
+
+  return 0;
+}
@@ -118,6 +118,18 @@ int main(int /*argc*/, char** /*argv[]*/) {
     run_bench_with_inputs(
         [&](const auto& point) { return check.isInside(point, poly); }, points,
         "Random");
+
+    // The same points checked in one batch, timings are given per point
+    const std::vector<Vector2> polyVertices(std::begin(poly), std::end(poly));
+    std::vector<bool> inside;
+    auto batch_result = Acts::Test::microBenchmark(
+        [&] {
+          check.isInside(points, polyVertices, inside);
+          return inside.size();
+        },
+        1);
+    batch_result.iters_per_run = points.size();
+    print_bench_result("Random (batched)", batch_result);
   };
 
   // Benchmark scenarios
@@ -11,12 +11,16 @@
 #include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/BatchedEigenStepper.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
 #include "Acts/Propagator/Propagator.hpp"
 #include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
 #include "Acts/Utilities/Logger.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
@@ -31,6 +35,8 @@ int main(int argc, char* argv[]) {
   double maxPathInM = 1;
   unsigned int lvl = Acts::Logging::INFO;
   bool withCov = true;
+  unsigned int lanes = 8;
+  unsigned int batchSize = 256;
 
   // Create a test context
   GeometryContext tgContext = GeometryContext();
@@ -46,6 +52,8 @@ int main(int argc, char* argv[]) {
       ("B",po::value<double>(&BzInT)->default_value(2),"z-component of B-field in T")
       ("path",po::value<double>(&maxPathInM)->default_value(5),"maximum path length in m")
       ("cov",po::value<bool>(&withCov)->default_value(true),"propagation with covariance matrix")
+      ("lanes",po::value<unsigned int>(&lanes)->default_value(8),"number of lanes of the batched stepper (0, 4, 8 or 16), 0 disables it")
+      ("batch",po::value<unsigned int>(&batchSize)->default_value(256),"number of tracks per batched propagation call")
       ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
     // clang-format on
     po::variables_map vm;
@@ -56,6 +64,9 @@ int main(int argc, char* argv[]) {
       std::cout << desc << std::endl;
       return 0;
     }
+    if (lanes != 0 && lanes != 4 && lanes != 8 && lanes != 16) {
+      throw std::invalid_argument("lanes must be one of 0, 4, 8 or 16");
+    }
   } catch (std::exception& e) {
     std::cerr << "error: " << e.what() << std::endl;
     return 1;
@@ -75,8 +86,8 @@ int main(int argc, char* argv[]) {
 
   auto bField =
       std::make_shared<BField_type>(Vector3{0, 0, BzInT * UnitConstants::T});
-  Stepper_type atlas_stepper(std::move(bField));
-  Propagator_type propagator(std::move(atlas_stepper));
+  Stepper_type eigen_stepper(bField);
+  Propagator_type propagator(std::move(eigen_stepper));
 
   PropagatorOptions<> options(tgContext, mfContext);
   options.pathLimit = maxPathInM * UnitConstants::m;
@@ -118,6 +129,53 @@ int main(int argc, char* argv[]) {
   ACTS_INFO("Execution stats: " << propagation_bench_result);
   ACTS_INFO("average path length = " << totalPathLength / num_iters / 1_mm
                                      << "mm");
+  ACTS_INFO("scalar throughput = "
+            << 1e9 / propagation_bench_result.iterTimeAverage().count()
+            << " tracks/s");
+
+  if (lanes == 0) {
+    return 0;
+  }
+
+  // The same propagation with the tracks advanced in lockstep
+  const auto batchedBenchmark = [&](auto batchedStepper) {
+    const std::vector<CurvilinearTrackParameters> starts(batchSize, pars);
+    const size_t nCalls = std::max<size_t>(1, toys / batchSize);
+    double batchedPathLength = 0;
+    size_t nTracks = 0;
+    const auto batched_bench_result = Acts::Test::microBenchmark(
+        [&] {
+          auto results = batchedStepper.propagate(starts, options);
+          for (auto& r : results) {
+            batchedPathLength += r.value().pathLength;
+          }
+          nTracks += results.size();
+          return results;
+        },
+        1, nCalls);
+
+    ACTS_INFO("Batched execution stats (" << lanes << " lanes, " << batchSize
+                                          << " tracks per call): "
+                                          << batched_bench_result);
+    ACTS_INFO("average path length = " << batchedPathLength / nTracks / 1_mm
+                                       << "mm");
+    ACTS_INFO("batched throughput = "
+              << batchSize * 1e9 /
+                     batched_bench_result.iterTimeAverage().count()
+              << " tracks/s");
+  };
+
+  switch (lanes) {
+    case 4:
+      batchedBenchmark(BatchedEigenStepper<4>(bField));
+      break;
+    case 8:
+      batchedBenchmark(BatchedEigenStepper<8>(bField));
+      break;
+    case 16:
+      batchedBenchmark(BatchedEigenStepper<16>(bField));
+      break;
+  }
 
   return 0;
 }
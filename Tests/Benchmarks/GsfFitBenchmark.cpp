@@ -0,0 +1,230 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/MultiComponentBoundTrackParameters.hpp"
+#include "Acts/EventData/Track.hpp"
+#include "Acts/EventData/VectorMultiTrajectory.hpp"
+#include "Acts/EventData/VectorTrackContainer.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Material/HomogeneousSurfaceMaterial.hpp"
+#include "Acts/Material/MaterialSlab.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/MultiEigenStepperLoop.hpp"
+#include "Acts/Propagator/MultiEigenStepperVectorized.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Tests/CommonHelpers/CubicTrackingGeometry.hpp"
+#include "Acts/Tests/CommonHelpers/MeasurementsCreator.hpp"
+#include "Acts/Tests/CommonHelpers/PredefinedMaterials.hpp"
+#include "Acts/Tests/CommonHelpers/TestSourceLink.hpp"
+#include "Acts/TrackFitting/BetheHeitlerApprox.hpp"
+#include "Acts/TrackFitting/GainMatrixUpdater.hpp"
+#include "Acts/TrackFitting/GaussianSumFitter.hpp"
+#include "Acts/Utilities/CalibrationContext.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts;
+using namespace Acts::Test;
+using namespace Acts::UnitLiterals;
+using namespace Acts::Experimental;
+
+namespace {
+
+/// The input of a single fit
+struct FitInput {
+  std::vector<SourceLink> sourceLinks;
+  MultiComponentBoundTrackParameters<SinglyCharged> start;
+};
+
+Navigator makeNavigator(std::shared_ptr<const TrackingGeometry> geometry) {
+  Navigator::Config cfg{std::move(geometry)};
+  cfg.resolvePassive = false;
+  cfg.resolveMaterial = true;
+  cfg.resolveSensitive = true;
+  return Navigator(cfg);
+}
+
+/// Fit all inputs with the GSF using the given multi-component stepper
+template <typename stepper_t>
+Acts::Test::MicroBenchmarkResult benchmarkFits(
+    std::shared_ptr<const TrackingGeometry> geometry,
+    std::shared_ptr<const MagneticFieldProvider> field,
+    const GsfOptions<VectorMultiTrajectory>& options,
+    const std::vector<FitInput>& inputs, unsigned int runs,
+    const Logger& logger) {
+  using Propagator = Acts::Propagator<stepper_t, Navigator>;
+  using GSF = GaussianSumFitter<Propagator, AtlasBetheHeitlerApprox<6, 5>,
+                                VectorMultiTrajectory>;
+
+  GSF gsf(Propagator(stepper_t(std::move(field)),
+                     makeNavigator(std::move(geometry))),
+          makeDefaultBetheHeitlerApprox(),
+          getDefaultLogger("GSF", logger.level()));
+
+  std::vector<std::size_t> indices(inputs.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  const auto fit = [&](std::size_t i) {
+    const FitInput& input = inputs[i];
+    TrackContainer tracks{VectorTrackContainer{}, VectorMultiTrajectory{}};
+    auto res = gsf.fit(input.sourceLinks.begin(), input.sourceLinks.end(),
+                       input.start, options, tracks);
+    if (not res.ok()) {
+      ACTS_VERBOSE("Fit " << i << " failed: " << res.error().message());
+    }
+    return res.ok();
+  };
+
+  // Failed fits are timed as well, but should be the exception
+  std::size_t nFailed = 0;
+  for (std::size_t i : indices) {
+    nFailed += fit(i) ? 0 : 1;
+  }
+  ACTS_DEBUG("Failed fits: " << nFailed << " of " << inputs.size());
+
+  return Acts::Test::microBenchmark(fit, indices, runs);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  unsigned int lvl = Acts::Logging::INFO;
+  unsigned int fits = 1;
+  unsigned int runs = 1;
+  unsigned int components = 12;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("fits",po::value<unsigned int>(&fits)->default_value(100),"number of electron fits per run")
+      ("runs",po::value<unsigned int>(&runs)->default_value(10),"number of benchmark runs")
+      ("components",po::value<unsigned int>(&components)->default_value(12),"maximum number of GSF components")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  ACTS_LOCAL_LOGGER(getDefaultLogger("GsfFit", Acts::Logging::Level(lvl)));
+
+  GeometryContext geoCtx;
+  MagneticFieldContext magCtx;
+  CalibrationContext calCtx;
+
+  // The telescope-like detector of the fitter tests in a solenoid-like
+  // field. The silicon layers are thick enough for the Bethe-Heitler mixture
+  // to split the components.
+  CubicTrackingGeometry geometryStore(geoCtx);
+  geometryStore.surfaceMaterial = std::make_shared<HomogeneousSurfaceMaterial>(
+      MaterialSlab(makeSilicon(), 1_mm));
+  std::shared_ptr<const TrackingGeometry> geometry = geometryStore();
+  auto field = std::make_shared<ConstantBField>(Vector3(0., 0., 0.5_T));
+
+  MeasurementResolution resPixel = {MeasurementType::eLoc01, {25_um, 50_um}};
+  MeasurementResolution resStrip0 = {MeasurementType::eLoc0, {100_um}};
+  MeasurementResolution resStrip1 = {MeasurementType::eLoc1, {150_um}};
+  MeasurementResolutionMap resolutions = {
+      {GeometryIdentifier().setVolume(2), resPixel},
+      {GeometryIdentifier().setVolume(3).setLayer(2), resStrip0},
+      {GeometryIdentifier().setVolume(3).setLayer(4), resStrip1},
+      {GeometryIdentifier().setVolume(3).setLayer(6), resStrip0},
+      {GeometryIdentifier().setVolume(3).setLayer(8), resStrip1},
+  };
+
+  // Simulate the measurements of electrons with a smeared direction
+  Acts::Propagator<EigenStepper<>, Navigator> simPropagator(
+      EigenStepper<>(field), makeNavigator(geometry));
+
+  BoundVector stddev;
+  stddev[eBoundLoc0] = 100_um;
+  stddev[eBoundLoc1] = 100_um;
+  stddev[eBoundTime] = 25_ns;
+  stddev[eBoundPhi] = 2_degree;
+  stddev[eBoundTheta] = 2_degree;
+  stddev[eBoundQOverP] = 1 / 100_GeV;
+  BoundSymMatrix cov = stddev.cwiseProduct(stddev).asDiagonal();
+
+  std::default_random_engine rng(42);
+  std::normal_distribution<double> angle(0., 1_degree);
+  std::uniform_real_distribution<double> momentum(5_GeV, 20_GeV);
+  std::vector<FitInput> inputs;
+  inputs.reserve(fits);
+  while (inputs.size() < fits) {
+    CurvilinearTrackParameters cp(Vector4(-3_m, 0., 0., 42_ns), angle(rng),
+                                  90_degree + angle(rng), momentum(rng), -1_e,
+                                  cov);
+    auto measurements = createMeasurements(simPropagator, geoCtx, magCtx, cp,
+                                           resolutions, rng);
+    std::vector<SourceLink> sourceLinks;
+    for (const auto& sl : measurements.sourceLinks) {
+      sourceLinks.emplace_back(sl);
+    }
+    inputs.push_back(
+        {std::move(sourceLinks),
+         MultiComponentBoundTrackParameters<SinglyCharged>(
+             cp.referenceSurface().getSharedPtr(), cp.parameters(), cov)});
+  }
+
+  GainMatrixUpdater updater;
+  GsfExtensions<VectorMultiTrajectory> extensions;
+  extensions.calibrator
+      .connect<&testSourceLinkCalibrator<VectorMultiTrajectory>>();
+  extensions.updater
+      .connect<&GainMatrixUpdater::operator()<VectorMultiTrajectory>>(
+          &updater);
+  GsfOptions<VectorMultiTrajectory> options{
+      geoCtx, magCtx, calCtx, extensions, PropagatorPlainOptions()};
+  options.maxComponents = components;
+  options.abortOnError = false;
+  // The backward pass ends within the tolerance of the mean, which can be too
+  // far from a plane for the bound state. A line surface always works.
+  auto perigee = Surface::makeShared<PerigeeSurface>(Vector3(-3_m, 0., 0.));
+  options.referenceSurface = perigee.get();
+
+  ACTS_INFO("Fitting " << fits << " electrons with up to " << components
+                       << " components");
+
+  const auto loopBenchmark = benchmarkFits<MultiEigenStepperLoop<>>(
+      geometry, field, options, inputs, runs, logger());
+  ACTS_INFO("Execution stats loop stepper: " << loopBenchmark);
+  ACTS_INFO("Fits per second loop stepper: "
+            << 1e9 / loopBenchmark.iterTimeAverage().count());
+
+  const auto vectorizedBenchmark =
+      benchmarkFits<MultiEigenStepperVectorized<>>(geometry, field, options,
+                                                   inputs, runs, logger());
+  ACTS_INFO("Execution stats vectorized stepper: " << vectorizedBenchmark);
+  ACTS_INFO("Fits per second vectorized stepper: "
+            << 1e9 / vectorizedBenchmark.iterTimeAverage().count());
+
+  return 0;
+}
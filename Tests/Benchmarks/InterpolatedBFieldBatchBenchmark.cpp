@@ -0,0 +1,117 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/MagneticField/BFieldMapUtils.hpp"
+#include "Acts/MagneticField/InterpolatedBFieldMap.hpp"
+#include "Acts/MagneticField/SolenoidBField.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Acts::UnitLiterals;
+
+int main(int argc, char* argv[]) {
+  size_t nTracks = 100;
+  size_t nSteps = 200;
+  size_t runs = 200;
+  if (argc >= 2) {
+    nTracks = std::stoi(argv[1]);
+  }
+  if (argc >= 3) {
+    nSteps = std::stoi(argv[2]);
+  }
+  if (argc >= 4) {
+    runs = std::stoi(argv[3]);
+  }
+
+  // same solenoid and map binning as in the SolenoidField benchmark
+  const double L = 5.8_m;
+  const double R = (2.56 + 2.46) * 0.5 * 0.5_m;
+  const size_t nCoils = 1154;
+  const double bMagCenter = 2_T;
+  const size_t nBinsR = 150;
+  const size_t nBinsZ = 200;
+
+  const double rMin = -0.1;
+  const double rMax = R * 2.;
+  const double zMin = 2 * (-L / 2.);
+  const double zMax = 2 * (L / 2.);
+
+  Acts::SolenoidBField bSolenoidField({R, L, nCoils, bMagCenter});
+  std::cout << "Building interpolated field map" << std::endl;
+  auto bFieldMap = Acts::solenoidFieldMap({rMin, rMax}, {zMin, zMax},
+                                          {nBinsR, nBinsZ}, bSolenoidField);
+  Acts::MagneticFieldContext mctx{};
+
+  // The lookup positions follow straight tracks from the origin with a step
+  // of 1 cm, which resembles the access pattern of the stepper. The field
+  // map is only evaluated inside the solenoid volume.
+  std::minstd_rand rng;
+  std::uniform_real_distribution<> etaDist(-2.5, 2.5);
+  std::uniform_real_distribution<> phiDist(-M_PI, M_PI);
+  std::vector<Acts::Vector3> positions;
+  positions.reserve(nTracks * nSteps);
+  for (size_t t = 0; t < nTracks; ++t) {
+    const double theta = 2 * std::atan(std::exp(-etaDist(rng)));
+    const double phi = phiDist(rng);
+    const Acts::Vector3 dir(std::cos(phi) * std::sin(theta),
+                            std::sin(phi) * std::sin(theta), std::cos(theta));
+    for (size_t s = 0; s < nSteps; ++s) {
+      const Acts::Vector3 pos = dir * (s * 1_cm);
+      if (Acts::VectorHelpers::perp(pos) > R || std::abs(pos.z()) > L / 2.) {
+        break;
+      }
+      positions.push_back(pos);
+    }
+  }
+  std::cout << "Using " << positions.size() << " lookup positions"
+            << std::endl;
+
+  std::cout << "Benchmarking scalar cached interpolated field lookup: "
+            << std::flush;
+  std::vector<Acts::Vector3> fields(positions.size());
+  auto scalarCache = bFieldMap.makeCache(mctx);
+  const auto scalar_result = Acts::Test::microBenchmark(
+      [&] {
+        for (size_t i = 0; i < positions.size(); ++i) {
+          fields[i] = bFieldMap.getField(positions[i], scalarCache).value();
+        }
+        return fields.back();
+      },
+      1, runs);
+  std::cout << scalar_result << std::endl;
+
+  std::cout << "Benchmarking batched interpolated field lookup: "
+            << std::flush;
+  auto batchCache = bFieldMap.makeCache(mctx);
+  const auto batch_result = Acts::Test::microBenchmark(
+      [&] {
+        if (!bFieldMap.getFieldBatch(positions, fields, batchCache).ok()) {
+          throw std::runtime_error("Batched field lookup failed");
+        }
+        return fields.back();
+      },
+      1, runs);
+  std::cout << batch_result << std::endl;
+
+  const auto throughput = [&](const auto& res) {
+    return positions.size() * 1e9 / res.iterTimeAverage().count();
+  };
+  std::cout << "scalar throughput = " << throughput(scalar_result)
+            << " lookups/s" << std::endl;
+  std::cout << "batched throughput = " << throughput(batch_result)
+            << " lookups/s" << std::endl;
+
+  return 0;
+}
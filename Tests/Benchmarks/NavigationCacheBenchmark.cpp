@@ -0,0 +1,205 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/NavigationCache.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StandardAborters.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts;
+using namespace Acts::UnitLiterals;
+
+int main(int argc, char* argv[]) {
+  unsigned int toys = 1;
+  unsigned int runs = 1;
+  double ptInGeV = 1;
+  double BzInT = 1;
+  double maxEta = 1;
+  bool validate = false;
+  unsigned int lvl = Acts::Logging::INFO;
+
+  // Create a test context
+  GeometryContext tgContext = GeometryContext();
+  MagneticFieldContext mfContext = MagneticFieldContext();
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("toys",po::value<unsigned int>(&toys)->default_value(2000),"number of tracks to propagate")
+      ("runs",po::value<unsigned int>(&runs)->default_value(10),"number of benchmark runs over all tracks")
+      ("pT",po::value<double>(&ptInGeV)->default_value(1),"transverse momentum in GeV")
+      ("B",po::value<double>(&BzInT)->default_value(2),"z-component of B-field in T")
+      ("eta",po::value<double>(&maxEta)->default_value(1),"maximum absolute pseudo-rapidity of the tracks")
+      ("validate",po::value<bool>(&validate)->default_value(false),"also run the cached navigation with validation")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  ACTS_LOCAL_LOGGER(
+      getDefaultLogger("NavigationCache", Acts::Logging::Level(lvl)));
+
+  Test::CylindricalTrackingGeometry cGeometry(tgContext);
+  auto tGeometry = cGeometry();
+
+  auto buildStart = std::chrono::steady_clock::now();
+  auto cache = std::make_shared<const NavigationCache>(
+      tgContext, *tGeometry, NavigationCache::Config{},
+      getDefaultLogger("NavigationCache", Acts::Logging::Level(lvl)));
+  std::chrono::duration<double, std::milli> buildTime =
+      std::chrono::steady_clock::now() - buildStart;
+  const auto& stats = cache->statistics();
+  ACTS_INFO("navigation cache built in "
+            << buildTime.count() << "ms for " << stats.layers << " layers, "
+            << stats.cachedBins << " cached bins, " << stats.surfaceCandidates
+            << " surface candidates, " << stats.prunedCandidates
+            << " pruned");
+
+  // print information about profiling setup
+  ACTS_INFO("propagating " << toys << " tracks with pT = " << ptInGeV
+                           << "GeV and |eta| < " << maxEta << " in a "
+                           << BzInT << "T B-field");
+
+  using Stepper_type = EigenStepper<>;
+  using Propagator_type = Propagator<Stepper_type, Navigator>;
+
+  auto bField = std::make_shared<ConstantBField>(
+      Vector3{0, 0, BzInT * UnitConstants::T});
+
+  // the same tracks for all navigation modes
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> etaDist(-maxEta, maxEta);
+  std::uniform_int_distribution<int> chargeDist(0, 1);
+  std::vector<CurvilinearTrackParameters> starts;
+  starts.reserve(toys);
+  for (unsigned int i = 0; i < toys; ++i) {
+    double theta = 2 * std::atan(std::exp(-etaDist(rng)));
+    double charge = 2 * chargeDist(rng) - 1;
+    double p = ptInGeV * UnitConstants::GeV / std::sin(theta);
+    starts.emplace_back(Vector4(0, 0, 0, 0), phiDist(rng), theta,
+                        charge / p);
+  }
+
+  // the candidate search alone, on the layers at the start of the tracks
+  std::vector<const Layer*> layers;
+  for (const auto& volume :
+       tGeometry->highestTrackingVolume()->confinedVolumes()->arrayObjects()) {
+    if (volume->confinedLayers() == nullptr) {
+      continue;
+    }
+    for (const auto& layer : volume->confinedLayers()->arrayObjects()) {
+      if (layer->surfaceArray() != nullptr) {
+        layers.push_back(layer.get());
+      }
+    }
+  }
+  std::vector<std::pair<const Layer*, Vector3>> onLayer;
+  for (const auto& start : starts) {
+    const Layer* layer = layers[onLayer.size() % layers.size()];
+    double radius = layer->surfaceRepresentation().binningPositionValue(
+        tgContext, binR);
+    Vector3 direction = start.unitDirection();
+    onLayer.emplace_back(layer, radius / VectorHelpers::perp(direction) *
+                                    direction);
+  }
+  auto search = [&](const std::string& mode, bool useCache) {
+    const auto bench_result = Acts::Test::microBenchmark(
+        [&](const std::pair<const Layer*, Vector3>& input) {
+          const auto& [layer, position] = input;
+          NavigationOptions<Surface> navOpts(
+              NavigationDirection::Forward, true, true, true, false,
+              &layer->surfaceRepresentation());
+          NavigationCache::SurfaceCandidates candidates;
+          if (!useCache ||
+              !cache->compatibleSurfaces(tgContext, *layer, position,
+                                         position.normalized(), navOpts,
+                                         candidates)) {
+            candidates = layer->compatibleSurfaces(
+                tgContext, position, position.normalized(), navOpts);
+          }
+          return candidates;
+        },
+        onLayer, runs);
+    ACTS_INFO(mode << " surface candidate search: " << bench_result);
+  };
+  search("exhaustive", false);
+  search("cached", true);
+
+  PropagatorOptions<ActionList<>, AbortList<EndOfWorldReached>> options(
+      tgContext, mfContext);
+
+  auto run = [&](const std::string& mode, bool useCache, bool validateCache) {
+    Navigator::Config navCfg;
+    navCfg.trackingGeometry = tGeometry;
+    if (useCache) {
+      navCfg.navigationCache = cache;
+      navCfg.validateNavigationCache = validateCache;
+    }
+    Propagator_type propagator{Stepper_type(bField), Navigator(navCfg)};
+
+    std::size_t steps = 0;
+    std::size_t reallocations = 0;
+    std::size_t nTracks = 0;
+    const auto bench_result = Acts::Test::microBenchmark(
+        [&](const CurvilinearTrackParameters& start) {
+          auto r = propagator.propagate(start, options).value();
+          steps += r.steps;
+          reallocations += r.candidateBufferReallocations;
+          ++nTracks;
+          return r;
+        },
+        starts, runs);
+
+    ACTS_INFO(mode << " navigation: " << bench_result);
+    ACTS_INFO("- average number of steps = "
+              << static_cast<double>(steps) / nTracks);
+    ACTS_INFO("- average number of candidate buffer reallocations = "
+              << static_cast<double>(reallocations) / nTracks);
+    ACTS_INFO("- throughput = "
+              << 1e9 / bench_result.iterTimeAverage().count() << " tracks/s");
+  };
+
+  run("exhaustive", false, false);
+  run("cached", true, false);
+  if (validate) {
+    run("validated", true, true);
+  }
+
+  return 0;
+}
@@ -0,0 +1,308 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Geometry/Extent.hpp"
+#include "Acts/Seeding/BinFinder.hpp"
+#include "Acts/Seeding/BinnedSPGroup.hpp"
+#include "Acts/Seeding/Seed.hpp"
+#include "Acts/Seeding/SeedFilter.hpp"
+#include "Acts/Seeding/SeedFinder.hpp"
+#include "Acts/Seeding/SpacePointGrid.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Utilities/TaskExecutor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+struct SpacePoint {
+  float m_x;
+  float m_y;
+  float m_z;
+  float varianceR;
+  float varianceZ;
+  std::size_t index;
+  float x() const { return m_x; }
+  float y() const { return m_y; }
+  float z() const { return m_z; }
+};
+
+/// Read space points in the format of the seed finder unit test
+/// (`lxyz layer x y z varianceR varianceZ` per line)
+std::vector<SpacePoint> readFile(const std::string& filename) {
+  std::vector<SpacePoint> spacePoints;
+  std::ifstream spFile(filename);
+  if (!spFile.good()) {
+    throw std::invalid_argument("Could not read space points from " +
+                                filename);
+  }
+  std::string line;
+  while (std::getline(spFile, line)) {
+    std::stringstream ss(line);
+    std::string linetype;
+    ss >> linetype;
+    if (linetype != "lxyz") {
+      continue;
+    }
+    int layer = 0;
+    float x = 0, y = 0, z = 0, varianceR = 0, varianceZ = 0;
+    ss >> layer >> x >> y >> z >> varianceR >> varianceZ;
+    spacePoints.push_back(
+        {x, y, z, varianceR, varianceZ, spacePoints.size()});
+  }
+  return spacePoints;
+}
+
+/// Generate an event with charged tracks from a luminous region crossing a
+/// barrel pixel detector in a solenoid field, and uniform noise hits
+std::vector<SpacePoint> generateEvent(std::size_t nTracks, std::size_t nNoise,
+                                      double bFieldInZ) {
+  const std::vector<double> layerRadii = {32_mm, 72_mm, 116_mm, 172_mm};
+  const double halfLength = 1000_mm;
+  const double resolution = 10_um;
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> etaDist(-2.5, 2.5);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> invPtDist(1. / 10_GeV, 1. / 500_MeV);
+  std::normal_distribution<double> zVertexDist(0., 50_mm);
+  std::normal_distribution<double> smearDist(0., resolution);
+  std::bernoulli_distribution chargeDist(0.5);
+
+  std::vector<SpacePoint> spacePoints;
+  const float variance = resolution * resolution;
+  auto addHit = [&](double r, double phi, double z) {
+    const double rPhi = smearDist(rng);
+    const double phiSmeared = phi + rPhi / r;
+    spacePoints.push_back({static_cast<float>(r * std::cos(phiSmeared)),
+                           static_cast<float>(r * std::sin(phiSmeared)),
+                           static_cast<float>(z + smearDist(rng)), variance,
+                           variance, spacePoints.size()});
+  };
+
+  for (std::size_t t = 0; t < nTracks; ++t) {
+    const double cotTheta = std::sinh(etaDist(rng));
+    const double phi0 = phiDist(rng);
+    const double z0 = zVertexDist(rng);
+    const double q = chargeDist(rng) ? 1. : -1.;
+    const double pT = 1. / invPtDist(rng);
+    // helix radius in the transverse plane
+    const double radius = pT / (1_e * bFieldInZ);
+    for (double r : layerRadii) {
+      if (r >= 2 * radius) {
+        break;
+      }
+      const double halfAngle = std::asin(r / (2 * radius));
+      const double z = z0 + 2 * radius * halfAngle * cotTheta;
+      if (std::abs(z) > halfLength) {
+        break;
+      }
+      addHit(r, phi0 - q * halfAngle, z);
+    }
+  }
+
+  std::uniform_int_distribution<std::size_t> layerDist(
+      0, layerRadii.size() - 1);
+  std::uniform_real_distribution<double> zDist(-halfLength, halfLength);
+  for (std::size_t n = 0; n < nNoise; ++n) {
+    addHit(layerRadii[layerDist(rng)], phiDist(rng), zDist(rng));
+  }
+  return spacePoints;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string file;
+  std::size_t nTracks = 10000;
+  std::size_t nNoise = 10000;
+  std::size_t runs = 5;
+  std::size_t nTasks = 1;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+      ("help", "produce help message")
+      ("file",po::value<std::string>(&file),"read the space points of one event from this file in the format of the seed finder test, e.g. a ttbar sample with pile-up, instead of generating them")
+      ("tracks",po::value<std::size_t>(&nTracks)->default_value(10000),"number of generated tracks")
+      ("noise",po::value<std::size_t>(&nNoise)->default_value(10000),"number of generated noise hits")
+      ("runs",po::value<std::size_t>(&runs)->default_value(5),"number of benchmark runs")
+      ("tasks",po::value<std::size_t>(&nTasks)->default_value(1),"number of tasks the groups of middle space point bins are split into as in the seeding algorithm of the examples, each task runs in its own thread");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  Acts::SeedFinderConfig<SpacePoint> config;
+  config.rMin = 0._mm;
+  config.rMax = 200._mm;
+  config.deltaRMin = 5._mm;
+  config.deltaRMax = 160._mm;
+  config.deltaRMinTopSP = config.deltaRMin;
+  config.deltaRMinBottomSP = config.deltaRMin;
+  config.deltaRMaxTopSP = config.deltaRMax;
+  config.deltaRMaxBottomSP = config.deltaRMax;
+  config.collisionRegionMin = -250._mm;
+  config.collisionRegionMax = 250._mm;
+  config.zMin = -1000._mm;
+  config.zMax = 1000._mm;
+  config.maxSeedsPerSpM = 5;
+  // 2.7 eta
+  config.cotThetaMax = 7.40627;
+  config.sigmaScattering = 5.;
+  config.radLengthPerSeed = 0.1;
+  config.minPt = 500._MeV;
+  config.impactMax = 3._mm;
+  config.useVariableMiddleSPRange = false;
+
+  const double bFieldInZ = 2_T;
+  Acts::SeedFinderOptions options;
+  options.beamPos = {0_mm, 0_mm};
+  options.bFieldInZ = bFieldInZ;
+
+  Acts::SpacePointGridConfig gridConfig;
+  gridConfig.minPt = config.minPt;
+  gridConfig.rMax = config.rMax;
+  gridConfig.zMax = config.zMax;
+  gridConfig.zMin = config.zMin;
+  gridConfig.deltaRMax = config.deltaRMax;
+  gridConfig.cotThetaMax = config.cotThetaMax;
+  Acts::SpacePointGridOptions gridOptions;
+  gridOptions.bFieldInZ = bFieldInZ;
+  gridConfig = gridConfig.toInternalUnits();
+  gridOptions = gridOptions.toInternalUnits();
+
+  Acts::SeedFilterConfig filterConfig;
+  filterConfig.deltaRMin = config.deltaRMin;
+  filterConfig.maxSeedsPerSpM = config.maxSeedsPerSpM;
+  config.seedFilter = std::make_shared<Acts::SeedFilter<SpacePoint>>(
+      filterConfig.toInternalUnits());
+  config = config.toInternalUnits().calculateDerivedQuantities();
+  options = options.toInternalUnits().calculateDerivedQuantities(config);
+  Acts::SeedFinder<SpacePoint> seedFinder(config);
+
+  const std::vector<SpacePoint> spacePoints =
+      file.empty() ? generateEvent(nTracks, nNoise, bFieldInZ)
+                   : readFile(file);
+  std::vector<const SpacePoint*> spacePointPtrs;
+  for (const auto& sp : spacePoints) {
+    spacePointPtrs.push_back(&sp);
+  }
+  std::cout << "Seeding " << spacePoints.size() << " space points"
+            << std::endl;
+
+  auto covariance = [](const SpacePoint& sp, float, float,
+                       float) -> std::pair<Acts::Vector3, Acts::Vector2> {
+    return {Acts::Vector3(sp.x(), sp.y(), sp.z()),
+            Acts::Vector2(sp.varianceR, sp.varianceZ)};
+  };
+
+  auto bottomBinFinder = std::make_shared<Acts::BinFinder<SpacePoint>>(
+      std::vector<std::pair<int, int>>{}, 1);
+  auto topBinFinder = std::make_shared<Acts::BinFinder<SpacePoint>>(
+      std::vector<std::pair<int, int>>{}, 1);
+  Acts::Extent rRangeSPExtent;
+  auto spGroup = Acts::BinnedSPGroup<SpacePoint>(
+      spacePointPtrs.begin(), spacePointPtrs.end(), covariance,
+      bottomBinFinder, topBinFinder,
+      Acts::SpacePointGridCreator::createGrid<SpacePoint>(gridConfig,
+                                                          gridOptions),
+      rRangeSPExtent, config, options);
+
+  const Acts::Range1D<float> rMiddleSPRange;
+  decltype(seedFinder)::SeedingState state;
+  std::vector<Acts::Seed<SpacePoint>> seeds;
+
+  // the consecutive ranges of groups of the tasks have their own seeding
+  // state and seeds, which are kept between the runs
+  struct Group {
+    Acts::Neighborhood<SpacePoint> bottom;
+    Acts::Neighborhood<SpacePoint> middle;
+    Acts::Neighborhood<SpacePoint> top;
+  };
+  std::vector<Group> groups;
+  for (auto groupIt = spGroup.begin(); !(groupIt == spGroup.end());
+       ++groupIt) {
+    groups.push_back({groupIt.bottom(), groupIt.middle(), groupIt.top()});
+  }
+  nTasks = std::max<std::size_t>(std::min(nTasks, groups.size()), 1);
+  std::vector<decltype(seedFinder)::SeedingState> taskStates(nTasks);
+  std::vector<std::vector<Acts::Seed<SpacePoint>>> taskSeeds(nTasks);
+  Acts::ThreadTaskExecutor executor(nTasks);
+
+  auto findSeeds = [&]() {
+    seeds.clear();
+    if (nTasks == 1) {
+      for (const auto& group : groups) {
+        seedFinder.createSeedsForGroup(options, state,
+                                       std::back_inserter(seeds), group.bottom,
+                                       group.middle, group.top, rMiddleSPRange);
+      }
+      return seeds.size();
+    }
+    executor(nTasks, [&](std::size_t task) {
+      taskSeeds[task].clear();
+      for (std::size_t i = groups.size() * task / nTasks;
+           i < groups.size() * (task + 1) / nTasks; ++i) {
+        seedFinder.createSeedsForGroup(
+            options, taskStates[task], std::back_inserter(taskSeeds[task]),
+            groups[i].bottom, groups[i].middle, groups[i].top, rMiddleSPRange);
+      }
+    });
+    for (const auto& seedsOfTask : taskSeeds) {
+      seeds.insert(seeds.end(), seedsOfTask.begin(), seedsOfTask.end());
+    }
+    return seeds.size();
+  };
+
+  // the space point indices of the seeds allow to compare the seeds between
+  // different versions of the seed finder
+  findSeeds();
+  std::size_t checksum = 0;
+  for (const auto& seed : seeds) {
+    for (const SpacePoint* sp : seed.sp()) {
+      checksum = checksum * 31 + sp->index;
+    }
+  }
+  std::cout << "Number of seeds: " << seeds.size() << ", checksum "
+            << checksum << std::endl;
+
+  std::cout << "Benchmarking seed finding with " << nTasks
+            << " task(s): " << std::flush;
+  const auto result = Acts::Test::microBenchmark(findSeeds, 1, runs);
+  std::cout << result << std::endl;
+  std::cout << "space point throughput = "
+            << spacePoints.size() * 1e9 / result.iterTimeAverage().count()
+            << " SP/s" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/SurfaceArrayCreator.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/RectangleBounds.hpp"
+#include "Acts/Surfaces/SurfaceArray.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts;
+
+namespace {
+
+/// Planar modules on a ring around the z axis, facing the beam line
+std::vector<std::shared_ptr<const Surface>> makeRing(unsigned int nPhi,
+                                                     double r, double z,
+                                                     bool barrel) {
+  std::vector<std::shared_ptr<const Surface>> ring;
+  auto bounds = std::make_shared<const RectangleBounds>(8.4, 36.);
+  double phiStep = 2 * M_PI / nPhi;
+  for (unsigned int iphi = 0; iphi < nPhi; ++iphi) {
+    Transform3 transform = Transform3::Identity();
+    transform.rotate(Eigen::AngleAxisd(iphi * phiStep, Vector3(0, 0, 1)));
+    transform.translate(Vector3(r, 0, z + ((iphi % 2 == 0) ? 1 : -1) * 2.));
+    if (barrel) {
+      transform.rotate(Eigen::AngleAxisd(M_PI / 2, Vector3(0, 1, 0)));
+      transform.rotate(Eigen::AngleAxisd(M_PI / 2, Vector3(0, 0, 1)));
+    }
+    ring.push_back(Surface::makeShared<PlaneSurface>(transform, bounds));
+  }
+  return ring;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  unsigned int toys = 1;
+  unsigned int runs = 1;
+  unsigned int lvl = Acts::Logging::INFO;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("toys",po::value<unsigned int>(&toys)->default_value(10000),"number of lookup positions")
+      ("runs",po::value<unsigned int>(&runs)->default_value(2000),"number of benchmark runs over all positions")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  ACTS_LOCAL_LOGGER(
+      getDefaultLogger("SurfaceArrayLookup", Acts::Logging::Level(lvl)));
+
+  GeometryContext tgContext = GeometryContext();
+  SurfaceArrayCreator surfaceArrayCreator(
+      getDefaultLogger("SurfaceArrayCreator", Acts::Logging::Level(lvl)));
+
+  // A pixel barrel layer with 32 x 14 modules
+  std::vector<std::shared_ptr<const Surface>> barrelModules;
+  for (int iz = 0; iz < 14; ++iz) {
+    auto ring = makeRing(32, 72., (iz - 6.5) * 70., true);
+    barrelModules.insert(barrelModules.end(), ring.begin(), ring.end());
+  }
+  auto barrel = surfaceArrayCreator.surfaceArrayOnCylinder(
+      tgContext, barrelModules, 32, 14);
+
+  // A pixel endcap disc with two rings
+  std::vector<std::shared_ptr<const Surface>> discModules =
+      makeRing(24, 50., 600., false);
+  auto outerRing = makeRing(48, 120., 600., false);
+  discModules.insert(discModules.end(), outerRing.begin(), outerRing.end());
+  auto disc = surfaceArrayCreator.surfaceArrayOnDisc(tgContext, discModules,
+                                                     2, 48);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> zDist(-490., 490.);
+  std::uniform_real_distribution<double> rDist(20., 150.);
+  std::vector<Vector3> barrelPositions;
+  std::vector<Vector3> discPositions;
+  for (unsigned int i = 0; i < toys; ++i) {
+    double phi = phiDist(rng);
+    barrelPositions.emplace_back(72. * std::cos(phi), 72. * std::sin(phi),
+                                 zDist(rng));
+    double r = rDist(rng);
+    discPositions.emplace_back(r * std::cos(phi), r * std::sin(phi), 600.);
+  }
+
+  auto benchmark = [&](const std::string& name, const SurfaceArray& sa,
+                       const std::vector<Vector3>& positions) {
+    ACTS_INFO(name << " flat lookup available: " << sa.hasFlatLookup());
+    const auto virtualLookup = Acts::Test::microBenchmark(
+        [&](const Vector3& position) {
+          return sa.neighbors(position).size();
+        },
+        positions, runs);
+    ACTS_INFO("  neighbors:     " << virtualLookup);
+    ACTS_INFO("  lookups/s:     "
+              << 1e9 / virtualLookup.iterTimeAverage().count());
+    const auto flatLookup = Acts::Test::microBenchmark(
+        [&](const Vector3& position) {
+          return sa.neighborRange(position).size();
+        },
+        positions, runs);
+    ACTS_INFO("  neighborRange: " << flatLookup);
+    ACTS_INFO("  lookups/s:     "
+              << 1e9 / flatLookup.iterTimeAverage().count());
+  };
+
+  benchmark("Barrel", *barrel, barrelPositions);
+  benchmark("Disc", *disc, discPositions);
+
+  return 0;
+}
@@ -19,9 +19,13 @@
 #include "Acts/Surfaces/RadialBounds.hpp"
 #include "Acts/Surfaces/RectangleBounds.hpp"
 #include "Acts/Surfaces/StrawSurface.hpp"
+#include "Acts/Surfaces/SurfaceBatchIntersector.hpp"
 #include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <string>
+#include <vector>
 
 namespace bdata = boost::unit_test::data;
 namespace tt = boost::test_tools;
@@ -122,5 +126,122 @@ BOOST_DATA_TEST_CASE(
   }
 }
 
+// Number of surfaces of the same type for the batched intersection
+const unsigned int nBatchSurfaces = 64;
+
+/// Scalar and batched intersection of one track with many surfaces, the
+/// timings are given per surface
+template <typename surface_t>
+void batchIntersectionTest(
+    const std::string& name,
+    const std::vector<std::shared_ptr<surface_t>>& surfaces,
+    const Vector3& position, const Vector3& direction) {
+  std::vector<const surface_t*> surfacePtrs;
+  for (const auto& surface : surfaces) {
+    surfacePtrs.push_back(surface.get());
+  }
+  SurfaceBatchIntersector<surface_t> batch(tgContext, surfacePtrs);
+  BoundaryCheck bcheck(boundaryCheck);
+
+  auto report = [&](const std::string& mode, MicroBenchmarkResult result) {
+    result.iters_per_run = surfaces.size();
+    std::cout << "- " << name << " (" << mode << "): " << result << ", "
+              << 1e9 / result.iterTimeAverage().count() << " intersections/s"
+              << std::endl;
+  };
+
+  // The scalar path as the navigator uses it: one call per surface, then
+  // sort the reachable intersections
+  std::vector<SurfaceIntersection> intersections;
+  intersections.reserve(surfaces.size());
+  report("scalar", Acts::Test::microBenchmark(
+                       [&] {
+                         intersections.clear();
+                         for (const auto& surface : surfaces) {
+                           auto sIntersection = surface->intersect(
+                               tgContext, position, direction, bcheck);
+                           if (sIntersection.intersection.status !=
+                                   Intersection3D::Status::missed and
+                               sIntersection.intersection.status !=
+                                   Intersection3D::Status::unreachable) {
+                             intersections.push_back(sIntersection);
+                           }
+                         }
+                         std::sort(intersections.begin(), intersections.end());
+                         return intersections.size();
+                       },
+                       1, nrepts));
+  report("batched", Acts::Test::microBenchmark(
+                        [&] {
+                          batch.intersect(position, direction, bcheck,
+                                          intersections);
+                          return intersections.size();
+                        },
+                        1, nrepts));
+}
+
+BOOST_DATA_TEST_CASE(
+    benchmark_surface_batch_intersections,
+    bdata::random(
+        (bdata::seed = 23,
+         bdata::distribution = std::uniform_real_distribution<>(-M_PI, M_PI))) ^
+        bdata::random((bdata::seed = 24,
+                       bdata::distribution =
+                           std::uniform_real_distribution<>(-0.3, 0.3))) ^
+        bdata::xrange(ntests),
+    phi, theta, index) {
+  (void)index;
+
+  Vector3 direction(std::cos(phi) * std::sin(theta),
+                    std::sin(phi) * std::sin(theta), std::cos(theta));
+  std::cout << std::endl
+            << "Benchmarking " << nBatchSurfaces
+            << " surfaces with theta=" << theta << ", phi=" << phi << "..."
+            << std::endl;
+
+  // Copies of the single surfaces, rotated around the global z axis
+  auto rotated = [&](const auto& surface, unsigned int isurface) {
+    return Transform3(AngleAxis3(2. * M_PI * isurface / nBatchSurfaces,
+                                 Vector3::UnitZ())) *
+           surface.transform(tgContext);
+  };
+  if (testPlane) {
+    std::vector<std::shared_ptr<PlaneSurface>> planes;
+    for (unsigned int is = 0; is < nBatchSurfaces; ++is) {
+      planes.push_back(Surface::makeShared<PlaneSurface>(
+          rotated(*aPlane, is), std::make_shared<RectangleBounds>(1_m, 1_m)));
+    }
+    batchIntersectionTest("Plane", planes, origin, direction);
+  }
+  if (testDisc) {
+    std::vector<std::shared_ptr<DiscSurface>> discs;
+    for (unsigned int is = 0; is < nBatchSurfaces; ++is) {
+      discs.push_back(Surface::makeShared<DiscSurface>(
+          rotated(*aDisc, is), std::make_shared<RadialBounds>(0.2_m, 1.2_m)));
+    }
+    batchIntersectionTest("Disc", discs, origin, direction);
+  }
+  if (testCylinder) {
+    std::vector<std::shared_ptr<CylinderSurface>> cylinders;
+    for (unsigned int is = 0; is < nBatchSurfaces; ++is) {
+      cylinders.push_back(Surface::makeShared<CylinderSurface>(
+          rotated(*aCylinder, is),
+          std::make_shared<CylinderBounds>(10_m, 100_m)));
+    }
+    batchIntersectionTest("Cylinder", cylinders, origin, direction);
+  }
+  if (testStraw) {
+    Vector3 strawDirection(std::cos(phi) * std::sin(theta + M_PI),
+                           std::sin(phi) * std::sin(theta + M_PI),
+                           std::cos(theta + M_PI));
+    std::vector<std::shared_ptr<StrawSurface>> straws;
+    for (unsigned int is = 0; is < nBatchSurfaces; ++is) {
+      straws.push_back(Surface::makeShared<StrawSurface>(rotated(*aStraw, is),
+                                                         50_cm, 2_m));
+    }
+    batchIntersectionTest("Straw", straws, originStraw, strawDirection);
+  }
+}
+
 }  // namespace Test
 }  // namespace Acts
@@ -0,0 +1,115 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/CompressedSurfaceMaterial.hpp"
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialSlab.hpp"
+#include "Acts/Tests/CommonHelpers/BenchmarkTools.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace Acts;
+
+int main(int argc, char* argv[]) {
+  unsigned int lvl = Acts::Logging::INFO;
+  unsigned int lookups = 1;
+  unsigned int runs = 1;
+
+  try {
+    po::options_description desc("Allowed options");
+    // clang-format off
+  desc.add_options()
+      ("help", "produce help message")
+      ("lookups",po::value<unsigned int>(&lookups)->default_value(10000),"number of lookups per run")
+      ("runs",po::value<unsigned int>(&runs)->default_value(1000),"number of benchmark runs")
+      ("verbose",po::value<unsigned int>(&lvl)->default_value(Acts::Logging::INFO),"logging level");
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  ACTS_LOCAL_LOGGER(
+      getDefaultLogger("SurfaceMaterialLookup", Acts::Logging::Level(lvl)));
+
+  // A barrel like binning in phi and z with a mapped material matrix
+  Transform3 transform(Translation3(0., 0., 10.));
+  BinUtility binUtility(200, -M_PI, M_PI, closed, binPhi, transform);
+  binUtility += BinUtility(100, -500., 500., open, binZ);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> variation(0.99, 1.01);
+  MaterialSlabMatrix matrix;
+  for (size_t ib1 = 0; ib1 < binUtility.bins(1); ++ib1) {
+    MaterialSlabVector slabs;
+    for (size_t ib0 = 0; ib0 < binUtility.bins(0); ++ib0) {
+      double scale = variation(rng);
+      slabs.emplace_back(Material::fromMolarDensity(93.7 * scale, 465.2,
+                                                    28.03, 14., 0.0833 * scale),
+                         0.3 * scale);
+    }
+    matrix.push_back(std::move(slabs));
+  }
+  BinnedSurfaceMaterial binned(binUtility, matrix);
+  CompressedSurfaceMaterial exact(binned);
+  CompressedSurfaceMaterial compressed(binned, 1e-2);
+
+  ACTS_INFO("Palette size exact: " << exact.palette().size()
+                                   << ", with precision 1e-2: "
+                                   << compressed.palette().size());
+
+  // Global positions on the cylinder
+  std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+  std::uniform_real_distribution<double> z(-600., 600.);
+  std::vector<Vector3> positions;
+  positions.reserve(lookups);
+  for (unsigned int il = 0; il < lookups; ++il) {
+    double p = phi(rng);
+    positions.emplace_back(300. * std::cos(p), 300. * std::sin(p), z(rng));
+  }
+
+  const auto binnedBenchmark = Acts::Test::microBenchmark(
+      [&](const Vector3& position) {
+        return binned.materialSlab(position).thicknessInX0();
+      },
+      positions, runs);
+  ACTS_INFO("Execution stats binned: " << binnedBenchmark);
+
+  const auto exactBenchmark = Acts::Test::microBenchmark(
+      [&](const Vector3& position) {
+        return exact.materialSlab(position).thicknessInX0();
+      },
+      positions, runs);
+  ACTS_INFO("Execution stats compressed (exact): " << exactBenchmark);
+
+  const auto compressedBenchmark = Acts::Test::microBenchmark(
+      [&](const Vector3& position) {
+        return compressed.materialSlab(position).thicknessInX0();
+      },
+      positions, runs);
+  ACTS_INFO("Execution stats compressed (1e-2): " << compressedBenchmark);
+
+  return 0;
+}
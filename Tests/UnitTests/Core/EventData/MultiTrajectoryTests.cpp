@@ -22,6 +22,7 @@
 #include "Acts/Tests/CommonHelpers/TestSourceLink.hpp"
 #include "Acts/Tests/CommonHelpers/TestTrackState.hpp"
 #include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/MonotonicArena.hpp"
 #include "Acts/Utilities/TypeTraits.hpp"
 
 #include <numeric>
@@ -1179,4 +1180,70 @@ BOOST_AUTO_TEST_CASE(MemoryStats) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(ArenaBacked) {
+  MonotonicArena arena;
+
+  auto runEvent = [&]() {
+    VectorMultiTrajectory mt{&arena};
+    std::vector<TestTrackState> pcs;
+    auto iprevious = MultiTrajectoryTraits::kInvalid;
+    for (std::size_t i = 0; i < 50; ++i) {
+      pcs.emplace_back(rng, 2u);
+      iprevious = mt.addTrackState(TrackStatePropMask::All, iprevious);
+      auto ts = mt.getTrackState(iprevious);
+      fillTrackState(pcs.back(), TrackStatePropMask::All, ts);
+    }
+
+    std::vector<const Surface*> surfaces;
+    for (const auto& pc : pcs) {
+      surfaces.push_back(pc.surface.get());
+    }
+    // the free surfaces are kept alive by the trajectory
+    pcs.clear();
+
+    for (std::size_t i = 0; i < mt.size(); ++i) {
+      auto ts = mt.getTrackState(i);
+      BOOST_CHECK_EQUAL(&ts.referenceSurface(), surfaces[i]);
+      BOOST_CHECK(ts.referenceSurface().getSharedPtr() != nullptr);
+      BOOST_CHECK(ts.hasCalibrated());
+    }
+
+    auto stats = mt.statistics();
+    BOOST_REQUIRE(stats.arena.has_value());
+    BOOST_CHECK_GT(stats.arena->bytes, 0u);
+    BOOST_CHECK_EQUAL(stats.arena->bytes, arena.bytes());
+
+    std::stringstream ss;
+    stats.toStream(ss);
+    BOOST_CHECK(ss.str().find("peakBytes") != std::string::npos);
+
+    // copies are independent of the arena
+    ConstVectorMultiTrajectory copy{mt};
+    BOOST_CHECK(!copy.statistics().arena.has_value());
+    return std::make_pair(*stats.arena, copy);
+  };
+
+  auto [first, firstCopy] = runEvent();
+  arena.reset();
+  BOOST_CHECK_EQUAL(arena.bytes(), 0u);
+
+  auto [second, secondCopy] = runEvent();
+  arena.reset();
+
+  // the second event is served from the memory of the first one
+  BOOST_CHECK_GT(first.upstreamAllocations, 0u);
+  BOOST_CHECK_EQUAL(second.upstreamAllocations, 0u);
+  BOOST_CHECK_EQUAL(second.bytes, first.bytes);
+  BOOST_CHECK_EQUAL(second.peakBytes, first.peakBytes);
+
+  BOOST_CHECK_EQUAL(firstCopy.size(), 50u);
+  BOOST_CHECK_EQUAL(secondCopy.size(), 50u);
+  for (std::size_t i = 0; i < firstCopy.size(); ++i) {
+    auto ts = firstCopy.getTrackState(i);
+    BOOST_CHECK(ts.hasCalibrated());
+    BOOST_CHECK_EQUAL(ts.calibratedSize(), 2u);
+    BOOST_CHECK(ts.referenceSurface().getSharedPtr() != nullptr);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
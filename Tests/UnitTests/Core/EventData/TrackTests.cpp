@@ -12,12 +12,15 @@
 
 #include "Acts/EventData/MultiTrajectory.hpp"
 #include "Acts/EventData/Track.hpp"
+#include "Acts/EventData/TrackHelpers.hpp"
 #include "Acts/EventData/TrackStatePropMask.hpp"
 #include "Acts/EventData/VectorMultiTrajectory.hpp"
 #include "Acts/EventData/VectorTrackContainer.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
 #include "Acts/Tests/CommonHelpers/TestTrackState.hpp"
 
 #include <iterator>
+#include <vector>
 
 namespace {
 
@@ -458,4 +461,82 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(DynamicColumns, factory_t, holder_types) {
   BOOST_CHECK_EQUAL((t.template component<float, "col_a"_hash>()), 5.6f);
 }
 
+BOOST_AUTO_TEST_CASE(AppendTracks) {
+  VectorTrackContainer svtc;
+  VectorMultiTrajectory smtj;
+  TrackContainer source{svtc, smtj};
+
+  // two tracks sharing their first two track states
+  auto first = smtj.getTrackState(smtj.addTrackState());
+  first.predicted().setConstant(1);
+  auto second = smtj.getTrackState(smtj.addTrackState(
+      TrackStatePropMask::All, first.index()));
+  second.predicted().setConstant(2);
+  IndexType tips[2];
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto ts = smtj.getTrackState(
+        smtj.addTrackState(TrackStatePropMask::All, second.index()));
+    ts.predicted().setConstant(3 + i);
+    tips[i] = ts.index();
+  }
+
+  auto perigee = Surface::makeShared<PerigeeSurface>(Vector3::Zero());
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto t = source.getTrack(source.addTrack());
+    t.tipIndex() = tips[i];
+    t.parameters().setConstant(i);
+    t.covariance().setIdentity();
+    t.setReferenceSurface(perigee);
+    t.nMeasurements() = 3;
+    t.nHoles() = i;
+  }
+
+  // the destination has a track already
+  VectorTrackContainer dvtc;
+  VectorMultiTrajectory dmtj;
+  TrackContainer destination{dvtc, dmtj};
+  auto existing = destination.getTrack(destination.addTrack());
+  existing.tipIndex() = dmtj.addTrackState();
+
+  appendTracks(source, destination);
+
+  BOOST_CHECK_EQUAL(destination.size(), 3);
+  // the shared states are copied only once
+  BOOST_CHECK_EQUAL(dmtj.size(), 1 + smtj.size());
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto s = source.getTrack(i);
+    auto d = destination.getTrack(i + 1);
+    BOOST_CHECK_EQUAL(d.parameters(), s.parameters());
+    BOOST_CHECK_EQUAL(d.covariance(), s.covariance());
+    BOOST_CHECK_EQUAL(&d.referenceSurface(), perigee.get());
+    BOOST_CHECK_EQUAL(d.nMeasurements(), s.nMeasurements());
+    BOOST_CHECK_EQUAL(d.nHoles(), s.nHoles());
+
+    std::vector<ActsScalar> predicted;
+    for (auto ts : d.trackStates()) {
+      predicted.push_back(ts.predicted()[0]);
+    }
+    BOOST_CHECK_EQUAL(predicted.size(), 3);
+    BOOST_CHECK_EQUAL(predicted[0], 3 + i);
+    BOOST_CHECK_EQUAL(predicted[1], 2);
+    BOOST_CHECK_EQUAL(predicted[2], 1);
+  }
+  auto shared = [&](auto track) {
+    return dmtj.getTrackState(track.tipIndex()).previous();
+  };
+  BOOST_CHECK_EQUAL(shared(destination.getTrack(1)),
+                    shared(destination.getTrack(2)));
+
+  // only the states of the selected tracks are copied
+  VectorTrackContainer svtc2;
+  VectorMultiTrajectory smtj2;
+  TrackContainer selected{svtc2, smtj2};
+  appendTracks(source, selected,
+               [](const auto& track) { return track.nHoles() == 1; });
+  BOOST_CHECK_EQUAL(selected.size(), 1);
+  BOOST_CHECK_EQUAL(smtj2.size(), 3);
+  BOOST_CHECK_EQUAL(selected.getTrack(0).parameters(),
+                    source.getTrack(1).parameters());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
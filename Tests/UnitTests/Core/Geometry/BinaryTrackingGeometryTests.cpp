@@ -0,0 +1,287 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/BinaryTrackingGeometry.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Material/ISurfaceMaterial.hpp"
+#include "Acts/Material/MaterialSlab.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/MaterialInteractor.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/detail/SteppingLogger.hpp"
+#include "Acts/Tests/CommonHelpers/CubicTrackingGeometry.hpp"
+#include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace Acts {
+namespace Test {
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+/// A temporary file, which is removed on destruction
+struct TemporaryFile {
+  std::string path;
+
+  explicit TemporaryFile(const std::string& name)
+      : path("BinaryTrackingGeometryTests_" + name + ".bin") {}
+  ~TemporaryFile() { std::remove(path.c_str()); }
+};
+
+std::map<GeometryIdentifier, const Surface*> surfacesById(
+    const TrackingGeometry& geometry) {
+  std::map<GeometryIdentifier, const Surface*> surfaces;
+  geometry.visitSurfaces([&](const Surface* surface) {
+    surfaces.emplace(surface->geometryId(), surface);
+  });
+  return surfaces;
+}
+
+void checkSameSurface(const Surface& original, const Surface& read) {
+  BOOST_CHECK_EQUAL(original.type(), read.type());
+  BOOST_CHECK_EQUAL(original.bounds().type(), read.bounds().type());
+  BOOST_CHECK(original.bounds().values() == read.bounds().values());
+  BOOST_CHECK(original.transform(tgContext).matrix() ==
+              read.transform(tgContext).matrix());
+  const auto* oMaterial = original.surfaceMaterial();
+  const auto* rMaterial = read.surfaceMaterial();
+  BOOST_REQUIRE_EQUAL(oMaterial == nullptr, rMaterial == nullptr);
+  if (oMaterial != nullptr) {
+    BOOST_CHECK_EQUAL(oMaterial->mappingType(), rMaterial->mappingType());
+    BOOST_CHECK(oMaterial->materialSlab(Vector2(0., 0.)) ==
+                rMaterial->materialSlab(Vector2(0., 0.)));
+  }
+}
+
+void collectVolumes(
+    const TrackingVolume& volume,
+    std::map<GeometryIdentifier, const TrackingVolume*>& volumes) {
+  volumes.emplace(volume.geometryId(), &volume);
+  if (auto confinedVolumes = volume.confinedVolumes()) {
+    for (const auto& cVolume : confinedVolumes->arrayObjects()) {
+      collectVolumes(*cVolume, volumes);
+    }
+  }
+}
+
+void checkSameGeometry(const TrackingGeometry& original,
+                       const TrackingGeometry& read) {
+  auto oSurfaces = surfacesById(original);
+  auto rSurfaces = surfacesById(read);
+  BOOST_CHECK(!oSurfaces.empty());
+  BOOST_REQUIRE_EQUAL(oSurfaces.size(), rSurfaces.size());
+  for (auto oIt = oSurfaces.begin(), rIt = rSurfaces.begin();
+       oIt != oSurfaces.end(); ++oIt, ++rIt) {
+    BOOST_REQUIRE_EQUAL(oIt->first, rIt->first);
+    checkSameSurface(*oIt->second, *rIt->second);
+  }
+
+  std::map<GeometryIdentifier, const TrackingVolume*> oVolumes;
+  std::map<GeometryIdentifier, const TrackingVolume*> rVolumes;
+  collectVolumes(*original.highestTrackingVolume(), oVolumes);
+  collectVolumes(*read.highestTrackingVolume(), rVolumes);
+  BOOST_REQUIRE_EQUAL(oVolumes.size(), rVolumes.size());
+  for (auto oIt = oVolumes.begin(), rIt = rVolumes.begin();
+       oIt != oVolumes.end(); ++oIt, ++rIt) {
+    const TrackingVolume& oVolume = *oIt->second;
+    const TrackingVolume& rVolume = *rIt->second;
+    BOOST_REQUIRE_EQUAL(oIt->first, rIt->first);
+    BOOST_CHECK_EQUAL(oVolume.volumeName(), rVolume.volumeName());
+    BOOST_CHECK(oVolume.volumeBounds().values() ==
+                rVolume.volumeBounds().values());
+    BOOST_CHECK(oVolume.transform().matrix() == rVolume.transform().matrix());
+
+    const auto& oBoundaries = oVolume.boundarySurfaces();
+    const auto& rBoundaries = rVolume.boundarySurfaces();
+    BOOST_REQUIRE_EQUAL(oBoundaries.size(), rBoundaries.size());
+    for (std::size_t ib = 0; ib < oBoundaries.size(); ++ib) {
+      const Surface& oSurface = oBoundaries[ib]->surfaceRepresentation();
+      const Surface& rSurface = rBoundaries[ib]->surfaceRepresentation();
+      BOOST_CHECK_EQUAL(oSurface.geometryId(), rSurface.geometryId());
+      checkSameSurface(oSurface, rSurface);
+    }
+
+    BOOST_REQUIRE_EQUAL(oVolume.confinedLayers() == nullptr,
+                        rVolume.confinedLayers() == nullptr);
+    if (oVolume.confinedLayers() != nullptr) {
+      const auto& oLayers = oVolume.confinedLayers()->arrayObjects();
+      const auto& rLayers = rVolume.confinedLayers()->arrayObjects();
+      BOOST_REQUIRE_EQUAL(oLayers.size(), rLayers.size());
+      for (std::size_t il = 0; il < oLayers.size(); ++il) {
+        BOOST_CHECK_EQUAL(oLayers[il]->geometryId(),
+                          rLayers[il]->geometryId());
+        BOOST_CHECK_EQUAL(oLayers[il]->layerType(), rLayers[il]->layerType());
+        BOOST_CHECK_EQUAL(oLayers[il]->thickness(), rLayers[il]->thickness());
+        checkSameSurface(oLayers[il]->surfaceRepresentation(),
+                         rLayers[il]->surfaceRepresentation());
+      }
+    }
+  }
+}
+
+using Stepper = EigenStepper<>;
+using TestPropagator = Propagator<Stepper, Navigator>;
+
+TestPropagator makePropagator(
+    std::shared_ptr<const TrackingGeometry> geometry) {
+  auto bField = std::make_shared<ConstantBField>(Vector3(0., 0., 2_T));
+  return TestPropagator(Stepper(bField), Navigator({std::move(geometry)}));
+}
+
+/// Propagate the same tracks through both geometries and compare the steps
+void checkSameNavigation(std::shared_ptr<const TrackingGeometry> original,
+                         std::shared_ptr<const TrackingGeometry> read,
+                         const Vector3& start, const Vector3& mainDirection) {
+  auto oPropagator = makePropagator(std::move(original));
+  auto rPropagator = makePropagator(std::move(read));
+
+  PropagatorOptions<ActionList<detail::SteppingLogger, MaterialInteractor>>
+      options(tgContext, mfContext);
+  options.maxStepSize = 10_cm;
+  options.pathLimit = 5_m;
+
+  std::mt19937 rng(42);
+  std::normal_distribution<double> angle(0., 0.3);
+  std::uniform_real_distribution<double> momentum(0.5_GeV, 10_GeV);
+  std::size_t nSurfaceSteps = 0;
+  for (std::size_t itrack = 0; itrack < 20; ++itrack) {
+    Vector3 direction =
+        (mainDirection + Vector3(angle(rng), angle(rng), angle(rng)))
+            .normalized();
+    double q = (itrack % 2 == 0) ? 1. : -1.;
+    CurvilinearTrackParameters pars(
+        Vector4(start.x(), start.y(), start.z(), 0.), direction,
+        q / momentum(rng));
+
+    const auto oResult = oPropagator.propagate(pars, options).value();
+    const auto rResult = rPropagator.propagate(pars, options).value();
+
+    const auto& oSteps = oResult.get<detail::SteppingLogger::result_type>();
+    const auto& rSteps = rResult.get<detail::SteppingLogger::result_type>();
+    BOOST_REQUIRE_EQUAL(oSteps.steps.size(), rSteps.steps.size());
+    for (std::size_t istep = 0; istep < oSteps.steps.size(); ++istep) {
+      const auto& oStep = oSteps.steps[istep];
+      const auto& rStep = rSteps.steps[istep];
+      BOOST_CHECK(oStep.position == rStep.position);
+      BOOST_REQUIRE_EQUAL(oStep.surface == nullptr, rStep.surface == nullptr);
+      if (oStep.surface != nullptr) {
+        ++nSurfaceSteps;
+        BOOST_CHECK_EQUAL(oStep.surface->geometryId(),
+                          rStep.surface->geometryId());
+      }
+      BOOST_REQUIRE_EQUAL(oStep.volume == nullptr, rStep.volume == nullptr);
+      if (oStep.volume != nullptr) {
+        BOOST_CHECK_EQUAL(oStep.volume->geometryId(),
+                          rStep.volume->geometryId());
+      }
+    }
+
+    const auto& oMaterial = oResult.get<MaterialInteractor::result_type>();
+    const auto& rMaterial = rResult.get<MaterialInteractor::result_type>();
+    BOOST_CHECK_EQUAL(oMaterial.materialInteractions.size(),
+                      rMaterial.materialInteractions.size());
+    BOOST_CHECK_EQUAL(oMaterial.materialInX0, rMaterial.materialInX0);
+    BOOST_CHECK_EQUAL(oMaterial.materialInL0, rMaterial.materialInL0);
+  }
+  // the tracks have to cross the detector
+  BOOST_CHECK_GT(nSurfaceSteps, 0u);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(Geometry)
+
+BOOST_AUTO_TEST_CASE(BinaryTrackingGeometryCylindrical) {
+  CylindricalTrackingGeometry cGeometry(tgContext);
+  std::shared_ptr<const TrackingGeometry> original = cGeometry();
+
+  TemporaryFile file("Cylindrical");
+  writeBinaryTrackingGeometry(file.path, tgContext, *original);
+  std::shared_ptr<const TrackingGeometry> read =
+      readBinaryTrackingGeometry(file.path);
+  BOOST_REQUIRE(read != nullptr);
+
+  checkSameGeometry(*original, *read);
+  checkSameNavigation(original, read, Vector3(0., 0., 0.),
+                      Vector3(1., 0., 0.));
+}
+
+BOOST_AUTO_TEST_CASE(BinaryTrackingGeometryCubic) {
+  CubicTrackingGeometry cGeometry(tgContext);
+  std::shared_ptr<const TrackingGeometry> original = cGeometry();
+
+  TemporaryFile file("Cubic");
+  writeBinaryTrackingGeometry(file.path, tgContext, *original);
+  std::shared_ptr<const TrackingGeometry> read =
+      readBinaryTrackingGeometry(file.path);
+  BOOST_REQUIRE(read != nullptr);
+
+  checkSameGeometry(*original, *read);
+  checkSameNavigation(original, read, Vector3(-1_m, 0., 0.),
+                      Vector3(1., 0., 0.));
+}
+
+BOOST_AUTO_TEST_CASE(BinaryTrackingGeometryInvalidFiles) {
+  CylindricalTrackingGeometry cGeometry(tgContext);
+  auto original = cGeometry();
+
+  TemporaryFile file("Invalid");
+  BOOST_CHECK_THROW(readBinaryTrackingGeometry(file.path), std::runtime_error);
+
+  writeBinaryTrackingGeometry(file.path, tgContext, *original);
+  std::string content;
+  {
+    std::ifstream in(file.path, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  }
+  auto rewrite = [&](const std::string& modified) {
+    std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+    out.write(modified.data(), modified.size());
+  };
+
+  // wrong file type
+  std::string modified = content;
+  modified[0] = 'X';
+  rewrite(modified);
+  BOOST_CHECK_THROW(readBinaryTrackingGeometry(file.path), std::runtime_error);
+
+  // truncated file
+  rewrite(content.substr(0, content.size() / 2));
+  BOOST_CHECK_THROW(readBinaryTrackingGeometry(file.path), std::runtime_error);
+
+  // too short for the header
+  rewrite(content.substr(0, 16));
+  BOOST_CHECK_THROW(readBinaryTrackingGeometry(file.path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
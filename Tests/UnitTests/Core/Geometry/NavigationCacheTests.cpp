@@ -0,0 +1,202 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/NavigationCache.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Surfaces/CylinderBounds.hpp"
+#include "Acts/Tests/CommonHelpers/CylindricalTrackingGeometry.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Acts {
+namespace Test {
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+GeometryContext tgContext = GeometryContext();
+
+CylindricalTrackingGeometry cGeometry(tgContext);
+auto tGeometry = cGeometry();
+
+/// Collect the layers with a surface array
+void collectLayers(const TrackingVolume& volume,
+                   std::vector<const Layer*>& layers) {
+  if (auto confinedVolumes = volume.confinedVolumes()) {
+    for (const auto& cVolume : confinedVolumes->arrayObjects()) {
+      collectLayers(*cVolume, layers);
+    }
+  }
+  if (volume.confinedLayers() != nullptr) {
+    for (const auto& layer : volume.confinedLayers()->arrayObjects()) {
+      if (layer->surfaceArray() != nullptr) {
+        layers.push_back(layer.get());
+      }
+    }
+  }
+}
+
+template <typename candidates_t>
+void checkSameCandidates(const candidates_t& exhaustive,
+                         const candidates_t& cached) {
+  BOOST_REQUIRE_EQUAL(exhaustive.size(), cached.size());
+  for (std::size_t i = 0; i < exhaustive.size(); ++i) {
+    BOOST_CHECK_EQUAL(exhaustive[i].object, cached[i].object);
+    BOOST_CHECK_EQUAL(exhaustive[i].intersection.pathLength,
+                      cached[i].intersection.pathLength);
+  }
+}
+
+Vector3 randomDirection(std::mt19937& rng) {
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> cosThetaDist(-1., 1.);
+  double phi = phiDist(rng);
+  double cosTheta = cosThetaDist(rng);
+  double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+  return Vector3(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(Geometry)
+
+BOOST_AUTO_TEST_CASE(NavigationCacheConstruction) {
+  NavigationCache::Config cfg;
+  NavigationCache cache(tgContext, *tGeometry, cfg);
+
+  const auto& stats = cache.statistics();
+  // the four pixel barrel layers
+  BOOST_CHECK_EQUAL(stats.layers, 4u);
+  BOOST_CHECK_EQUAL(stats.uncachedBins, 0u);
+  BOOST_CHECK_EQUAL(stats.cachedBins, (16u + 32u + 52u + 78u) * 14u);
+  BOOST_CHECK_GT(stats.surfaceCandidates, 0u);
+  BOOST_CHECK_GT(stats.prunedCandidates, 0u);
+
+  cfg.pruningTolerance = 0.;
+  BOOST_CHECK_THROW(NavigationCache(tgContext, *tGeometry, cfg),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(NavigationCacheSurfaces) {
+  NavigationCache cache(tgContext, *tGeometry, NavigationCache::Config{});
+
+  std::vector<const Layer*> layers;
+  collectLayers(*tGeometry->highestTrackingVolume(), layers);
+  BOOST_REQUIRE_EQUAL(layers.size(), 4u);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::size_t nCached = 0;
+  std::size_t nCandidates = 0;
+  for (const Layer* layer : layers) {
+    const auto& bounds = static_cast<const CylinderBounds&>(
+        layer->surfaceRepresentation().bounds());
+    const double radius = bounds.get(CylinderBounds::eR);
+    const double halfZ = bounds.get(CylinderBounds::eHalfLengthZ);
+
+    for (std::size_t i = 0; i < 2000; ++i) {
+      double r = radius + (uniform(rng) - 0.5) * layer->thickness();
+      double phi = M_PI * (2 * uniform(rng) - 1);
+      double z = halfZ * (2 * uniform(rng) - 1);
+      Vector3 position(r * std::cos(phi), r * std::sin(phi), z);
+      Vector3 direction = randomDirection(rng);
+      auto navDir = (i % 2 == 0) ? NavigationDirection::Forward
+                                 : NavigationDirection::Backward;
+
+      NavigationOptions<Surface> navOpts(navDir, true, true, true, false,
+                                         &layer->surfaceRepresentation());
+      navOpts.overstepLimit = -100_um;
+
+      auto exhaustive =
+          layer->compatibleSurfaces(tgContext, position, direction, navOpts);
+      NavigationCache::SurfaceCandidates cached;
+      if (cache.compatibleSurfaces(tgContext, *layer, position, direction,
+                                   navOpts, cached)) {
+        ++nCached;
+        nCandidates += cached.size();
+        checkSameCandidates(exhaustive, cached);
+      }
+    }
+  }
+  // everything inside the layers is covered
+  BOOST_CHECK_EQUAL(nCached, layers.size() * 2000u);
+  BOOST_CHECK_GT(nCandidates, 0u);
+
+  // not covered configurations are left to the exhaustive search
+  const Layer& layer = *layers.front();
+  Vector3 position(32., 0., 0.);
+  Vector3 direction(1., 0., 0.);
+  NavigationCache::SurfaceCandidates cached;
+  NavigationOptions<Surface> navOpts(NavigationDirection::Forward, true, true,
+                                     true, true);
+  BOOST_CHECK(!cache.compatibleSurfaces(tgContext, layer, position, direction,
+                                        navOpts, cached));
+  navOpts.resolvePassive = false;
+  navOpts.externalSurfaces.push_back(GeometryIdentifier());
+  BOOST_CHECK(!cache.compatibleSurfaces(tgContext, layer, position, direction,
+                                        navOpts, cached));
+  navOpts.externalSurfaces.clear();
+  navOpts.overstepLimit = -2_mm;
+  BOOST_CHECK(!cache.compatibleSurfaces(tgContext, layer, position, direction,
+                                        navOpts, cached));
+  navOpts.overstepLimit = -1_um;
+  BOOST_CHECK(cache.compatibleSurfaces(tgContext, layer, position, direction,
+                                       navOpts, cached));
+  // far outside of the layer
+  BOOST_CHECK(!cache.compatibleSurfaces(tgContext, layer, Vector3(1., 0., 0.),
+                                        direction, navOpts, cached));
+}
+
+BOOST_AUTO_TEST_CASE(NavigationCacheLayers) {
+  NavigationCache cache(tgContext, *tGeometry, NavigationCache::Config{});
+
+  std::mt19937 rng(23);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::size_t nCached = 0;
+  for (std::size_t i = 0; i < 2000; ++i) {
+    double r = 300. * uniform(rng);
+    double phi = M_PI * (2 * uniform(rng) - 1);
+    double z = 1000. * (2 * uniform(rng) - 1);
+    Vector3 position(r * std::cos(phi), r * std::sin(phi), z);
+    Vector3 direction = randomDirection(rng);
+    auto navDir = (i % 2 == 0) ? NavigationDirection::Forward
+                               : NavigationDirection::Backward;
+
+    const TrackingVolume* volume =
+        tGeometry->lowestTrackingVolume(tgContext, position);
+    BOOST_REQUIRE_NE(volume, nullptr);
+
+    NavigationOptions<Layer> navOpts(navDir, true, true, true, false);
+    if (i % 3 == 0) {
+      navOpts.startObject = volume->associatedLayer(tgContext, position);
+    }
+    auto exhaustive =
+        volume->compatibleLayers(tgContext, position, direction, navOpts);
+    NavigationCache::LayerCandidates cached;
+    if (cache.compatibleLayers(tgContext, *volume, position, direction,
+                               navOpts, cached)) {
+      ++nCached;
+      checkSameCandidates(exhaustive, cached);
+    }
+  }
+  BOOST_CHECK_EQUAL(nCached, 2000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
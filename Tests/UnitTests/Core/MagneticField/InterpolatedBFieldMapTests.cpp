@@ -160,6 +160,95 @@ BOOST_AUTO_TEST_CASE(InterpolatedBFieldMap_rz) {
   BOOST_CHECK(c.isInside(transformPos((pos << 0, 2, -4.7).finished())));
   BOOST_CHECK(not c.isInside(transformPos((pos << 5, 2, 14.).finished())));
 }
+
+BOOST_AUTO_TEST_CASE(InterpolatedBFieldMap_xyz_batch_gradient) {
+  // definition of dummy BField
+  struct BField {
+    static Vector3 value(const Vector3& xyz) {
+      double x = xyz.x();
+      double y = xyz.y();
+      double z = xyz.z();
+      // multi-linear in x, y and z so interpolation should be exact
+      return Vector3(x * y, 3 * z, x - 2 * y * z);
+    }
+
+    static ActsMatrix<3, 3> gradient(const Vector3& xyz) {
+      ActsMatrix<3, 3> g;
+      // clang-format off
+      g << xyz.y(), xyz.x(), 0,
+           0, 0, 3,
+           1, -2 * xyz.z(), -2 * xyz.y();
+      // clang-format on
+      return g;
+    }
+  };
+
+  auto transformPos = [](const Vector3& pos) { return pos; };
+  auto transformBField = [](const Vector3& field, const Vector3&) {
+    return field;
+  };
+
+  detail::EquidistantAxis x(-2.0, 2.0, 4u);
+  detail::EquidistantAxis y(-3.0, 3.0, 3u);
+  detail::EquidistantAxis z(-5.0, 7.0, 6u);
+
+  using Grid_t =
+      detail::Grid<Vector3, detail::EquidistantAxis, detail::EquidistantAxis,
+                   detail::EquidistantAxis>;
+  using BField_t = InterpolatedBFieldMap<Grid_t>;
+
+  Grid_t g(std::make_tuple(std::move(x), std::move(y), std::move(z)));
+  for (size_t i = 1; i <= g.numLocalBins().at(0) + 1; ++i) {
+    for (size_t j = 1; j <= g.numLocalBins().at(1) + 1; ++j) {
+      for (size_t k = 1; k <= g.numLocalBins().at(2) + 1; ++k) {
+        Grid_t::index_t indices = {{i, j, k}};
+        const auto& llCorner = g.lowerLeftBinEdge(indices);
+        g.atLocalBins(indices) =
+            BField::value(Vector3(llCorner[0], llCorner[1], llCorner[2]));
+      }
+    }
+  }
+  BField_t b{{transformPos, transformBField, std::move(g)}};
+
+  // the cell cache keeps previously used cells
+  BOOST_CHECK_GE(BField_t::Cache::kPreviousCells, 1u);
+
+  // positions wandering back and forth between a few cells, the
+  // interpolation domain is [-2,1) x [-3,1) x [-5,5)
+  std::vector<Vector3> positions;
+  for (int i = 0; i < 50; ++i) {
+    positions.emplace_back(-1.9 + 0.055 * i, -1. + std::sin(0.3 * i) * 1.8,
+                           -4.9 + 0.2 * i);
+    positions.emplace_back(0.3, 0.2 + 0.01 * i, 1.1);
+  }
+
+  auto batchCache = b.makeCache(mfContext);
+  auto singleCache = b.makeCache(mfContext);
+  std::vector<Vector3> fields;
+  BOOST_CHECK(b.getFieldBatch(positions, fields, batchCache).ok());
+  BOOST_CHECK_EQUAL(fields.size(), positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    CHECK_CLOSE_OR_SMALL(fields[i],
+                         b.getField(positions[i], singleCache).value(), 1e-12,
+                         1e-12);
+    CHECK_CLOSE_OR_SMALL(fields[i], BField::value(positions[i]), 1e-6, 1e-12);
+  }
+
+  // a position outside of the map fails the batch
+  positions.emplace_back(0, 0, 8);
+  BOOST_CHECK(!b.getFieldBatch(positions, fields, batchCache).ok());
+
+  // the gradient of the interpolation, also at the boundary of the map
+  ActsMatrix<3, 3> deriv;
+  for (const Vector3& pos :
+       {Vector3(0.3, 0.2, 1.1), Vector3(-0.7, -1.9, -3.2),
+        Vector3(0.0, -3.0, 2.0), Vector3(-2.0, 0.5, 0.5)}) {
+    auto res = b.getFieldGradient(pos, deriv, singleCache);
+    BOOST_REQUIRE(res.ok());
+    CHECK_CLOSE_OR_SMALL(*res, BField::value(pos), 1e-6, 1e-12);
+    CHECK_CLOSE_OR_SMALL(deriv, BField::gradient(pos), 1e-6, 1e-9);
+  }
+}
 }  // namespace Test
 
 }  // namespace Acts
@@ -0,0 +1,231 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/MagneticField/BFieldMapUtils.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/MagneticFieldError.hpp"
+#include "Acts/MagneticField/MemoryMappedBFieldMap.hpp"
+#include "Acts/MagneticField/SolenoidBField.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+namespace {
+
+std::filesystem::path tmpPath(const std::string& name) {
+  auto p = std::filesystem::temp_directory_path() / "acts_unit_tests";
+  std::filesystem::create_directory(p);
+  return p / name;
+}
+
+/// the expected interpolation deviation of each storage precision for fields
+/// of a few Tesla
+const std::vector<std::pair<BFieldMapStorage, double>> kStorages = {
+    {BFieldMapStorage::Float64, 1e-12_T},
+    {BFieldMapStorage::Float32, 1e-6_T},
+    {BFieldMapStorage::Float16, 4e-3_T},
+    {BFieldMapStorage::Fixed16, 1e-4_T},
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(MemoryMappedBFieldMapTests)
+
+BOOST_AUTO_TEST_CASE(memory_mapped_xyz) {
+  // a field linear in each coordinate, such that the interpolation is exact
+  std::vector<double> xPos = {0., 1., 2., 3., 4.};
+  std::vector<double> yPos = {0., 1., 2., 3., 4.};
+  std::vector<double> zPos = {0., 1., 2., 3., 4.};
+  std::vector<Vector3> values;
+  for (double x : xPos) {
+    for (double y : yPos) {
+      for (double z : zPos) {
+        values.emplace_back(1. + 0.1 * x, -0.2 * y, 2. + 0.05 * x * z);
+      }
+    }
+  }
+  auto localToGlobalBin = [](std::array<size_t, 3> bins,
+                             std::array<size_t, 3> sizes) {
+    return (bins[0] * (sizes[1] * sizes[2]) + bins[1] * sizes[2] + bins[2]);
+  };
+  auto source = fieldMapXYZ(localToGlobalBin, xPos, yPos, zPos, values,
+                            1_mm, 1_T, false);
+
+  std::minstd_rand rng;
+  std::uniform_real_distribution<> dist(0., 3.999);
+
+  for (const auto& [storage, tolerance] : kStorages) {
+    const auto path = tmpPath("bfield_xyz.bfm").string();
+    writeBinaryBFieldMap(path, source, storage);
+    MemoryMappedBFieldMap mapped(path);
+
+    BOOST_CHECK(mapped.storage() == storage);
+    BOOST_CHECK(mapped.coordinates() == BFieldMapCoordinates::XYZ);
+    BOOST_CHECK(mapped.getNBins() == source.getNBins());
+    BOOST_CHECK(mapped.getMin() == source.getMin());
+    BOOST_CHECK(mapped.getMax() == source.getMax());
+
+    auto cache = mapped.makeCache(mfContext);
+    for (size_t i = 0; i < 100; ++i) {
+      const Vector3 pos(dist(rng), dist(rng), dist(rng));
+      BOOST_CHECK(mapped.isInside(pos));
+      auto field = mapped.getField(pos, cache);
+      BOOST_REQUIRE(field.ok());
+      CHECK_CLOSE_ABS(*field, source.getFieldUnchecked(pos), tolerance);
+      CHECK_CLOSE_ABS(*mapped.getField(pos), *field, 1e-12_T);
+    }
+
+    const Vector3 outside(1., 2., 4.5);
+    BOOST_CHECK(!mapped.isInside(outside));
+    auto res = mapped.getField(outside, cache);
+    BOOST_CHECK(!res.ok());
+    BOOST_CHECK(res.error() == MagneticFieldError::OutOfBounds);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(memory_mapped_rz) {
+  SolenoidBField::Config cfg{};
+  cfg.length = 5.8_m;
+  cfg.radius = (2.56 + 2.46) * 0.5 * 0.5_m;
+  cfg.nCoils = 1154;
+  cfg.bMagCenter = 2_T;
+  SolenoidBField solenoid(cfg);
+  auto source =
+      solenoidFieldMap({0., 2_m}, {-3_m, 3_m}, {40, 60}, solenoid);
+
+  std::minstd_rand rng;
+  std::uniform_real_distribution<> xyDist(-1.4_m, 1.4_m);
+  std::uniform_real_distribution<> zDist(-2.9_m, 2.9_m);
+
+  size_t previousSize = 0;
+  for (const auto& [storage, tolerance] : kStorages) {
+    const auto path = tmpPath("bfield_rz.bfm").string();
+    writeBinaryBFieldMap(path, source, storage);
+    MemoryMappedBFieldMap mapped(path);
+    BOOST_CHECK(mapped.coordinates() == BFieldMapCoordinates::RZ);
+
+    // the reduced precisions need less space
+    if (previousSize != 0) {
+      BOOST_CHECK_LE(mapped.mappedSize(), previousSize);
+    }
+    previousSize = mapped.mappedSize();
+
+    auto cache = mapped.makeCache(mfContext);
+    for (size_t i = 0; i < 200; ++i) {
+      const Vector3 pos(xyDist(rng), xyDist(rng), zDist(rng));
+      BOOST_REQUIRE(source.isInside(pos));
+      auto field = mapped.getField(pos, cache);
+      BOOST_REQUIRE(field.ok());
+      CHECK_CLOSE_ABS(*field, source.getFieldUnchecked(pos), tolerance);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(memory_mapped_gradient) {
+  SolenoidBField::Config cfg{};
+  cfg.length = 5.8_m;
+  cfg.radius = (2.56 + 2.46) * 0.5 * 0.5_m;
+  cfg.nCoils = 1154;
+  cfg.bMagCenter = 2_T;
+  SolenoidBField solenoid(cfg);
+  auto source =
+      solenoidFieldMap({0., 2_m}, {-3_m, 3_m}, {40, 60}, solenoid);
+
+  const auto path = tmpPath("bfield_gradient.bfm").string();
+  writeBinaryBFieldMap(path, source, BFieldMapStorage::Float64);
+  MemoryMappedBFieldMap mapped(path);
+
+  std::minstd_rand rng;
+  std::uniform_real_distribution<> xyDist(-1.4_m, 1.4_m);
+  std::uniform_real_distribution<> zDist(-2.9_m, 2.9_m);
+
+  auto sourceCache = source.makeCache(mfContext);
+  auto cache = mapped.makeCache(mfContext);
+  for (size_t i = 0; i < 100; ++i) {
+    const Vector3 pos(xyDist(rng), xyDist(rng), zDist(rng));
+    ActsMatrix<3, 3> expected = ActsMatrix<3, 3>::Zero();
+    ActsMatrix<3, 3> derivative = ActsMatrix<3, 3>::Zero();
+    auto expectedField = source.getFieldGradient(pos, expected, sourceCache);
+    auto field = mapped.getFieldGradient(pos, derivative, cache);
+    BOOST_REQUIRE(expectedField.ok());
+    BOOST_REQUIRE(field.ok());
+    CHECK_CLOSE_ABS(*field, *expectedField, 1e-12_T);
+    CHECK_CLOSE_ABS(derivative, expected, 1e-9_T / 1_mm);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(memory_mapped_custom_transforms) {
+  std::vector<double> pos = {0., 1., 2., 3.};
+  std::vector<Vector3> values(pos.size() * pos.size() * pos.size(),
+                              Vector3(0., 0., 2_T));
+  auto localToGlobalBin = [](std::array<size_t, 3> bins,
+                             std::array<size_t, 3> sizes) {
+    return (bins[0] * (sizes[1] * sizes[2]) + bins[1] * sizes[2] + bins[2]);
+  };
+  auto source =
+      fieldMapXYZ(localToGlobalBin, pos, pos, pos, values, 1_mm, 1_T, false);
+  using Map = decltype(source);
+
+  // the map of one octant is mirrored into the others by its position
+  // transform, which the file can not represent
+  Map mirrored({[](const Vector3& p) { return Vector3(p.cwiseAbs()); },
+                [](const Vector3& field, const Vector3& /*p*/) {
+                  return field;
+                },
+                source.getGrid()});
+  const auto path = tmpPath("bfield_custom.bfm").string();
+  BOOST_CHECK_THROW(
+      writeBinaryBFieldMap(path, mirrored, BFieldMapStorage::Float32),
+      std::invalid_argument);
+
+  Map flipped({[](const Vector3& p) { return p; },
+               [](const Vector3& field, const Vector3& /*p*/) {
+                 return Vector3(-field);
+               },
+               source.getGrid()});
+  BOOST_CHECK_THROW(
+      writeBinaryBFieldMap(path, flipped, BFieldMapStorage::Float32),
+      std::invalid_argument);
+
+  BOOST_CHECK_NO_THROW(
+      writeBinaryBFieldMap(path, source, BFieldMapStorage::Float32));
+}
+
+BOOST_AUTO_TEST_CASE(memory_mapped_invalid_file) {
+  BOOST_CHECK_THROW(MemoryMappedBFieldMap{tmpPath("missing.bfm").string()},
+                    std::runtime_error);
+
+  const auto path = tmpPath("invalid.bfm").string();
+  {
+    std::ofstream out(path, std::ios::binary);
+    const std::vector<char> garbage(256, 'x');
+    out.write(garbage.data(), garbage.size());
+  }
+  BOOST_CHECK_THROW(MemoryMappedBFieldMap{path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
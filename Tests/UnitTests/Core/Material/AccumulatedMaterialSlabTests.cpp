@@ -195,4 +195,49 @@ BOOST_AUTO_TEST_CASE(MultipleDifferentTracks) {
   }
 }
 
+// merging two accumulations is equivalent to a single accumulation
+BOOST_AUTO_TEST_CASE(MergeTracks) {
+  MaterialSlab unit = makeUnitSlab();
+  MaterialSlab three = unit;
+  three.scaleThickness(3);
+  MaterialSlab silicon(makeSilicon(), 2 * unit.thickness());
+
+  AccumulatedMaterialSlab single;
+  AccumulatedMaterialSlab first;
+  AccumulatedMaterialSlab second;
+  for (const auto& slab : {unit, three, silicon}) {
+    single.accumulate(slab);
+    single.trackAverage();
+    first.accumulate(slab);
+    first.trackAverage();
+  }
+  for (const auto& slab : {silicon, unit}) {
+    single.accumulate(slab);
+    single.trackAverage();
+    second.accumulate(slab);
+    second.trackAverage();
+  }
+
+  // merging an empty accumulation does not change anything
+  AccumulatedMaterialSlab empty;
+  first.merge(empty);
+  BOOST_CHECK_EQUAL(first.totalAverage().second, 3u);
+  // merging into an empty accumulation copies it
+  empty.merge(second);
+  BOOST_CHECK_EQUAL(empty.totalAverage().first, second.totalAverage().first);
+  BOOST_CHECK_EQUAL(empty.totalAverage().second, 2u);
+
+  first.merge(second);
+  auto [average, trackCount] = first.totalAverage();
+  auto [reference, referenceCount] = single.totalAverage();
+  BOOST_CHECK_EQUAL(trackCount, 5u);
+  BOOST_CHECK_EQUAL(trackCount, referenceCount);
+  CHECK_CLOSE_REL(average.thickness(), reference.thickness(), 2 * eps);
+  CHECK_CLOSE_REL(average.thicknessInX0(), reference.thicknessInX0(), 2 * eps);
+  CHECK_CLOSE_REL(average.thicknessInL0(), reference.thicknessInL0(), 2 * eps);
+  CHECK_CLOSE_REL(average.material().Z(), reference.material().Z(), 2 * eps);
+  CHECK_CLOSE_REL(average.material().molarDensity(),
+                  reference.material().molarDensity(), 2 * eps);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,7 @@
 #include "Acts/Material/ISurfaceMaterial.hpp"
 
 #include <climits>
+#include <stdexcept>
 
 namespace Acts {
 namespace Test {
@@ -178,5 +179,44 @@ BOOST_AUTO_TEST_CASE(AccumulatedSurfaceMaterial_variance_0D) {
   BOOST_CHECK_EQUAL(trackCount, 2u);
 }
 
+/// Test the merging of separately accumulated material
+BOOST_AUTO_TEST_CASE(AccumulatedSurfaceMaterial_merge) {
+  Material mat = Material::fromMolarDensity(1., 1., 1., 1., 1.);
+  MaterialSlab one(mat, 1.);
+  MaterialSlab three(mat, 3.);
+
+  BinUtility binUtility2D(2, -1., 1., open, binX);
+  binUtility2D += BinUtility(2, -1., 1., open, binY);
+  AccumulatedSurfaceMaterial first{binUtility2D};
+  AccumulatedSurfaceMaterial second{binUtility2D};
+
+  first.accumulate(Vector2{-0.5, -0.5}, one);
+  first.accumulate(Vector2{0.5, 0.5}, one);
+  first.trackAverage();
+  second.accumulate(Vector2{0.5, 0.5}, three);
+  second.trackAverage();
+  second.accumulate(Vector2{0.5, -0.5}, three);
+  second.trackAverage();
+
+  first.merge(second);
+  auto accMat2D = first.accumulatedMaterial();
+  auto [accMatProp00, trackCount00] = accMat2D[0][0].totalAverage();
+  auto [accMatProp01, trackCount01] = accMat2D[0][1].totalAverage();
+  auto [accMatProp10, trackCount10] = accMat2D[1][0].totalAverage();
+  auto [accMatProp11, trackCount11] = accMat2D[1][1].totalAverage();
+
+  BOOST_CHECK_EQUAL(trackCount00, 1u);
+  BOOST_CHECK_EQUAL(trackCount01, 1u);
+  BOOST_CHECK_EQUAL(trackCount10, 0u);
+  BOOST_CHECK_EQUAL(trackCount11, 2u);
+  BOOST_CHECK_EQUAL(accMatProp00.thickness(), 1.);
+  BOOST_CHECK_EQUAL(accMatProp01.thickness(), 3.);
+  BOOST_CHECK_EQUAL(accMatProp11.thickness(), 2.);
+
+  // different binning can not be merged
+  AccumulatedSurfaceMaterial homogeneous;
+  BOOST_CHECK_THROW(first.merge(homogeneous), std::invalid_argument);
+}
+
 }  // namespace Test
 }  // namespace Acts
\ No newline at end of file
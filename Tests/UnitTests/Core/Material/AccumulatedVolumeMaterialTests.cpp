@@ -101,6 +101,34 @@ BOOST_AUTO_TEST_CASE(two_materials_different_lengh) {
                   1e-4);
 }
 
+BOOST_AUTO_TEST_CASE(merge) {
+  Material mat1 = Material::fromMolarDensity(1., 2., 3., 4., 5.);
+  Material mat2 = Material::fromMolarDensity(6., 7., 8., 9., 10.);
+
+  MaterialSlab matprop1(mat1, 0.5);
+  MaterialSlab matprop2(mat2, 2);
+
+  AccumulatedVolumeMaterial single;
+  single.accumulate(matprop1);
+  single.accumulate(matprop2);
+  single.accumulate(matprop1);
+
+  AccumulatedVolumeMaterial first;
+  first.accumulate(matprop1);
+  AccumulatedVolumeMaterial second;
+  second.accumulate(matprop2);
+  second.accumulate(matprop1);
+  first.merge(second);
+
+  CHECK_CLOSE_REL(first.average().parameters(), single.average().parameters(),
+                  1e-6);
+
+  // merging nothing is a no-op
+  first.merge(AccumulatedVolumeMaterial());
+  CHECK_CLOSE_REL(first.average().parameters(), single.average().parameters(),
+                  1e-6);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace Test
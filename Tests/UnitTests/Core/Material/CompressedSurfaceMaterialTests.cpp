@@ -0,0 +1,188 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Material/BinnedSurfaceMaterial.hpp"
+#include "Acts/Material/CompressedSurfaceMaterial.hpp"
+#include "Acts/Material/Material.hpp"
+#include "Acts/Material/MaterialSlab.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Utilities/BinUtility.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Acts {
+namespace Test {
+
+namespace {
+
+/// Material matrix with a few distinct slabs and some vacuum
+MaterialSlabMatrix materialMatrix(const BinUtility& binUtility) {
+  std::vector<MaterialSlab> slabs = {
+      MaterialSlab(Material::fromMolarDensity(1., 2., 3., 4., 5.), 6.),
+      MaterialSlab(Material::fromMolarDensity(2., 3., 4., 5., 6.), 7.),
+      MaterialSlab(Material::fromMolarDensity(3., 4., 5., 6., 7.), 8.),
+      MaterialSlab()};
+  MaterialSlabMatrix matrix(binUtility.bins(1),
+                            MaterialSlabVector(binUtility.bins(0)));
+  for (size_t ib1 = 0; ib1 < binUtility.bins(1); ++ib1) {
+    for (size_t ib0 = 0; ib0 < binUtility.bins(0); ++ib0) {
+      matrix[ib1][ib0] = slabs[(ib0 + 2 * ib1) % slabs.size()];
+    }
+  }
+  return matrix;
+}
+
+/// Check the lookups against the binned surface material
+void checkLookup(const BinUtility& binUtility, double range) {
+  BinnedSurfaceMaterial bsm(binUtility, materialMatrix(binUtility));
+  CompressedSurfaceMaterial csm(bsm);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(-range, range);
+  for (unsigned int i = 0; i < 10000; ++i) {
+    Vector3 gp(uniform(rng), uniform(rng), uniform(rng));
+    Vector2 lp(uniform(rng), uniform(rng));
+    BOOST_CHECK(csm.materialSlab(gp) == bsm.materialSlab(gp));
+    BOOST_CHECK(csm.materialSlab(lp) == bsm.materialSlab(lp));
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(CompressedSurfaceMaterialTests)
+
+/// Test the palette and the bin access
+BOOST_AUTO_TEST_CASE(CompressedSurfaceMaterial_construction_test) {
+  BinUtility xyBinning(4, -1., 1., open, binX);
+  xyBinning += BinUtility(3, -3., 3., open, binY);
+  auto matrix = materialMatrix(xyBinning);
+
+  CompressedSurfaceMaterial csm(xyBinning, matrix, 0.5);
+  BOOST_CHECK_EQUAL(csm.palette().size(), 4u);
+  BOOST_CHECK_EQUAL(csm.indices().size(), 12u);
+  BOOST_CHECK_EQUAL(csm.splitFactor(), 0.5);
+  for (size_t ib1 = 0; ib1 < 3; ++ib1) {
+    for (size_t ib0 = 0; ib0 < 4; ++ib0) {
+      BOOST_CHECK(csm.materialSlab(ib0, ib1) == matrix[ib1][ib0]);
+    }
+  }
+  BOOST_CHECK(csm.fullMaterial() == matrix);
+
+  // Scaling applies to all bins
+  CompressedSurfaceMaterial scaled(csm);
+  scaled *= 0.5;
+  BOOST_CHECK_EQUAL(scaled.materialSlab(1, 2).thickness(),
+                    0.5 * csm.materialSlab(1, 2).thickness());
+
+  // From binned material
+  BinnedSurfaceMaterial bsm(xyBinning, matrix, 0.25, MappingType::Sensor);
+  CompressedSurfaceMaterial fromBinned(bsm);
+  BOOST_CHECK_EQUAL(fromBinned.splitFactor(), 0.25);
+  BOOST_CHECK_EQUAL(fromBinned.mappingType(), MappingType::Sensor);
+  BOOST_CHECK(fromBinned.fullMaterial() == matrix);
+
+  // The matrix has to match the binning
+  matrix.pop_back();
+  BOOST_CHECK_THROW(CompressedSurfaceMaterial(xyBinning, matrix),
+                    std::invalid_argument);
+}
+
+/// Test the deduplication with a finite precision
+BOOST_AUTO_TEST_CASE(CompressedSurfaceMaterial_precision_test) {
+  BinUtility rBinning(100, 0., 100., open, binR);
+  MaterialSlabMatrix matrix(1);
+  for (unsigned int ib = 0; ib < 100; ++ib) {
+    // tiny variations, as left by the averaging in the mapping
+    double variation = 1. + 1e-5 * std::sin(ib);
+    matrix[0].emplace_back(
+        Material::fromMolarDensity(93.7 * variation, 465.2, 28.03, 14.,
+                                   0.0833 * variation),
+        (ib < 50 ? 0.3 : 0.6) * variation);
+  }
+
+  // exact comparison hardly deduplicates, only single precision collisions
+  CompressedSurfaceMaterial exact(rBinning, matrix);
+  BOOST_CHECK_GT(exact.palette().size(), 90u);
+
+  float precision = 1e-3;
+  CompressedSurfaceMaterial compressed(rBinning, matrix, 0.,
+                                       MappingType::Default, precision);
+  BOOST_CHECK_LT(compressed.palette().size(), 10u);
+  for (unsigned int ib = 0; ib < 100; ++ib) {
+    const auto& slab = compressed.materialSlab(ib, 0);
+    const auto& reference = matrix[0][ib];
+    CHECK_CLOSE_REL(slab.thickness(), reference.thickness(), precision);
+    CHECK_CLOSE_REL(slab.material().X0(), reference.material().X0(),
+                    precision);
+    CHECK_CLOSE_REL(slab.material().molarDensity(),
+                    reference.material().molarDensity(), precision);
+    CHECK_CLOSE_REL(slab.thicknessInX0(), reference.thicknessInX0(),
+                    2 * precision);
+  }
+}
+
+/// Test the check for more distinct slabs than palette indices
+BOOST_AUTO_TEST_CASE(CompressedSurfaceMaterial_palette_size_test) {
+  using Index = CompressedSurfaceMaterial::PaletteIndex;
+  const size_t maxSlabs = size_t(std::numeric_limits<Index>::max()) + 1;
+  BinUtility xyBinning(256, 0., 256., open, binX);
+  xyBinning += BinUtility(257, 0., 257., open, binY);
+  MaterialSlabMatrix matrix(257);
+  for (size_t ib1 = 0; ib1 < 257; ++ib1) {
+    for (size_t ib0 = 0; ib0 < 256; ++ib0) {
+      // distinct thicknesses, which are equal within a coarse precision
+      matrix[ib1].emplace_back(Material::fromMolarDensity(1., 2., 3., 4., 5.),
+                               1. + 1e-6 * (ib0 + 256 * ib1));
+    }
+  }
+  BOOST_CHECK_GT(256u * 257u, maxSlabs);
+
+  BOOST_CHECK(not CompressedSurfaceMaterial::fitsPalette(matrix));
+  BOOST_CHECK_THROW(CompressedSurfaceMaterial(xyBinning, matrix),
+                    std::invalid_argument);
+  BOOST_CHECK(CompressedSurfaceMaterial::fitsPalette(matrix, 1e-2));
+
+  matrix.pop_back();
+  BOOST_CHECK(CompressedSurfaceMaterial::fitsPalette(matrix));
+}
+
+/// Test that the lookup is identical to the binned surface material
+BOOST_AUTO_TEST_CASE(CompressedSurfaceMaterial_lookup_test) {
+  // Equidistant cartesian binning
+  BinUtility xyBinning(10, -5., 5., open, binX);
+  xyBinning += BinUtility(7, -5., 5., open, binY);
+  checkLookup(xyBinning, 6.);
+
+  // Closed phi and r binning, with a transform
+  Transform3 transform(Translation3(1., -2., 3.) *
+                       AngleAxis3(0.3, Vector3::UnitZ()));
+  BinUtility rphiBinning(5, 0., 6., open, binR, transform);
+  rphiBinning += BinUtility(12, -M_PI, M_PI, closed, binPhi);
+  checkLookup(rphiBinning, 6.);
+
+  // Arbitrary binning in z and phi
+  std::vector<float> zBoundaries = {-6., -2., -1., 0.5, 3., 6.};
+  BinUtility zBinning(zBoundaries, open, binZ);
+  zBinning += BinUtility(8, -M_PI, M_PI, closed, binPhi);
+  checkLookup(zBinning, 7.);
+
+  // One dimensional binning
+  checkLookup(BinUtility(20, -4., 4., open, binZ), 5.);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
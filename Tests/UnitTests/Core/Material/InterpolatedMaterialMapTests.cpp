@@ -12,12 +12,15 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Material/HomogeneousVolumeMaterial.hpp"
 #include "Acts/Material/InterpolatedMaterialMap.hpp"
 #include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
 #include "Acts/Utilities/detail/Axis.hpp"
 #include "Acts/Utilities/detail/Grid.hpp"
 
 #include <array>
+#include <random>
+#include <utility>
 
 namespace Acts {
 
@@ -159,6 +162,72 @@ BOOST_AUTO_TEST_CASE(InterpolatedMaterialMap_test) {
   BOOST_CHECK_EQUAL(ipolMatMap.isInside(Vector3(0., 4., 0.)), false);
   BOOST_CHECK_EQUAL(ipolMatMap.isInside(Vector3(0., 0., 4.)), true);
 }
+
+BOOST_AUTO_TEST_CASE(InterpolatedMaterialMap_cachedMaterial_test) {
+  // Create the axes for the grid
+  detail::EquidistantAxis axisX(0, 3, 3);
+  detail::EquidistantAxis axisY(0, 3, 3);
+
+  // The material mapping grid with varying material
+  auto grid = grid_t(std::make_tuple(std::move(axisX), std::move(axisY)));
+  for (size_t i = 0; i < grid.size(); i++) {
+    Acts::Material::ParametersVector mat;
+    mat << 1 + i, 2 + 2 * i, 3, 4, 5 + 0.5 * i;
+    grid.at(i) = mat;
+  }
+  MaterialMapper<grid_t> matMap(trafoGlobalToLocal, grid);
+  InterpolatedMaterialMap ipolMatMap(std::move(matMap));
+  const IVolumeMaterial& volumeMaterial = ipolMatMap;
+
+  // The cached lookup interpolates like the uncached one
+  IVolumeMaterial::Cache cache;
+  InterpolatedMaterialMap<MaterialMapper<grid_t>>::Cache cellCache;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0., 3.);
+  for (unsigned int i = 0; i < 1000; ++i) {
+    Vector3 position(uniform(rng), uniform(rng), uniform(rng));
+    Material expected = ipolMatMap.getMaterial(position);
+    CHECK_CLOSE_REL(volumeMaterial.cachedMaterial(position, cache).parameters(),
+                    expected.parameters(), 1e-5);
+    CHECK_CLOSE_REL(ipolMatMap.getMaterial(position, cellCache).parameters(),
+                    expected.parameters(), 1e-5);
+  }
+  BOOST_CHECK_EQUAL(cache.owner, &volumeMaterial);
+  BOOST_CHECK(cache.data.has_value());
+
+  // A copy of the cache is empty, a moved cache keeps the cell
+  IVolumeMaterial::Cache copied = cache;
+  BOOST_CHECK(copied.owner == nullptr);
+  BOOST_CHECK(not copied.data.has_value());
+  IVolumeMaterial::Cache moved;
+  moved = std::move(copied);
+  BOOST_CHECK(not moved.data.has_value());
+  moved = std::move(cache);
+  BOOST_CHECK_EQUAL(moved.owner, &volumeMaterial);
+  Vector3 inside(1.5, 2.5, 0.);
+  CHECK_CLOSE_REL(volumeMaterial.cachedMaterial(inside, moved).parameters(),
+                  ipolMatMap.getMaterial(inside).parameters(), 1e-5);
+  cache = std::move(moved);
+
+  // Outside of the grid the binned material is returned
+  Vector3 outside(4., 1., 0.);
+  BOOST_CHECK(volumeMaterial.cachedMaterial(outside, cache) ==
+              volumeMaterial.material(outside));
+
+  // The cache is reset for a different material
+  Acts::Material::ParametersVector mat;
+  mat << 1, 2, 3, 4, 5;
+  HomogeneousVolumeMaterial homogeneous{Material(mat)};
+  BOOST_CHECK(homogeneous.cachedMaterial(Vector3(1., 1., 1.), cache) ==
+              Material(mat));
+  InterpolatedMaterialMap otherMap(
+      MaterialMapper<grid_t>(trafoGlobalToLocal, grid));
+  Vector3 position(1.5, 0.5, 0.);
+  CHECK_CLOSE_REL(otherMap.cachedMaterial(position, cache).parameters(),
+                  otherMap.getMaterial(position).parameters(), 1e-5);
+  BOOST_CHECK_EQUAL(cache.owner, &otherMap);
+}
+
 }  // namespace Test
 
 }  // namespace Acts
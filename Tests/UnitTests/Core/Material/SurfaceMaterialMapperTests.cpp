@@ -23,6 +23,11 @@
 #include "Acts/Material/MaterialSlab.hpp"
 #include "Acts/Material/ProtoSurfaceMaterial.hpp"
 #include "Acts/Material/SurfaceMaterialMapper.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/Tests/CommonHelpers/PredefinedMaterials.hpp"
+
+#include <cmath>
+#include <vector>
 
 namespace Acts {
 
@@ -119,6 +124,85 @@ BOOST_AUTO_TEST_CASE(SurfaceMaterialMapper_tests) {
   BOOST_CHECK_EQUAL(mState.accumulatedMaterial.size(), 3u);
 }
 
+/// Test that mapping into separate states and merging them afterwards gives
+/// the same material as mapping into a single state
+BOOST_AUTO_TEST_CASE(SurfaceMaterialMapper_merge_tests) {
+  Navigator navigator({tGeometry});
+  StraightLineStepper stepper;
+  SurfaceMaterialMapper::StraightLinePropagator propagator(
+      stepper, std::move(navigator));
+  SurfaceMaterialMapper smMapper(SurfaceMaterialMapper::Config(),
+                                 std::move(propagator));
+
+  GeometryContext gCtx;
+  MagneticFieldContext mfCtx;
+  auto prototype = smMapper.createState(gCtx, mfCtx, *tGeometry);
+
+  // Tracks from the origin with one material step on each layer
+  std::vector<RecordedMaterialTrack> tracks;
+  for (unsigned int itrack = 0; itrack < 20; ++itrack) {
+    double phi = 0.3 * itrack;
+    double cotTheta = -0.5 + 0.05 * itrack;
+    Vector3 direction =
+        Vector3(std::cos(phi), std::sin(phi), cotTheta).normalized();
+    RecordedMaterialTrack track{{Vector3::Zero(), direction}, {}};
+    for (double r : {10., 20., 30.}) {
+      MaterialInteraction interaction;
+      interaction.position = direction * r / direction.head<2>().norm();
+      interaction.direction = direction;
+      interaction.materialSlab =
+          MaterialSlab(Test::makeSilicon(), 0.1 + 0.01 * itrack);
+      track.second.materialInteractions.push_back(interaction);
+    }
+    tracks.push_back(track);
+  }
+
+  // Everything into one state
+  auto single = smMapper.createState(prototype);
+  for (auto track : tracks) {
+    smMapper.mapMaterialTrack(single, track);
+  }
+  // Two halves into separate states, merged afterwards
+  auto first = smMapper.createState(prototype);
+  auto second = smMapper.createState(prototype);
+  for (size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    auto track = tracks[itrack];
+    smMapper.mapMaterialTrack(itrack < 7 ? first : second, track);
+  }
+  auto merged = smMapper.createState(prototype);
+  smMapper.mergeState(merged, first);
+  smMapper.mergeState(merged, second);
+
+  BOOST_CHECK_EQUAL(merged.accumulatedMaterial.size(),
+                    single.accumulatedMaterial.size());
+  unsigned int totalCount = 0;
+  for (const auto& [geoID, accMaterial] : single.accumulatedMaterial) {
+    const auto& mergedMatrix =
+        merged.accumulatedMaterial.at(geoID).accumulatedMaterial();
+    const auto& singleMatrix = accMaterial.accumulatedMaterial();
+    // the prototype is not touched by the mapping
+    const auto& protoMatrix =
+        prototype.accumulatedMaterial.at(geoID).accumulatedMaterial();
+    BOOST_REQUIRE_EQUAL(mergedMatrix.size(), singleMatrix.size());
+    for (size_t ib1 = 0; ib1 < singleMatrix.size(); ++ib1) {
+      BOOST_REQUIRE_EQUAL(mergedMatrix[ib1].size(), singleMatrix[ib1].size());
+      for (size_t ib0 = 0; ib0 < singleMatrix[ib1].size(); ++ib0) {
+        auto [singleSlab, singleCount] = singleMatrix[ib1][ib0].totalAverage();
+        auto [mergedSlab, mergedCount] = mergedMatrix[ib1][ib0].totalAverage();
+        BOOST_CHECK_EQUAL(mergedCount, singleCount);
+        CHECK_CLOSE_OR_SMALL(mergedSlab.thickness(), singleSlab.thickness(),
+                             1e-5, 1e-9);
+        CHECK_CLOSE_OR_SMALL(mergedSlab.thicknessInX0(),
+                             singleSlab.thicknessInX0(), 1e-5, 1e-9);
+        BOOST_CHECK_EQUAL(protoMatrix[ib1][ib0].totalAverage().second, 0u);
+        totalCount += singleCount;
+      }
+    }
+  }
+  // each track crosses all three layers
+  BOOST_CHECK_EQUAL(totalCount, 3 * tracks.size());
+}
+
 }  // namespace Test
 
 }  // namespace Acts
@@ -0,0 +1,285 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Detector/DetectorVolume.hpp"
+#include "Acts/Detector/PortalGenerators.hpp"
+#include "Acts/Geometry/CuboidVolumeBounds.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Navigation/NavigationState.hpp"
+#include "Acts/Navigation/SurfaceBoundingVolumeHierarchy.hpp"
+#include "Acts/Navigation/SurfaceCandidatesUpdators.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/RectangleBounds.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace Acts::Experimental;
+
+Acts::GeometryContext tContext;
+
+namespace {
+
+/// Layers of squares in z, 400 per layer
+std::vector<std::shared_ptr<Acts::Surface>> makeSurfaces() {
+  std::vector<std::shared_ptr<Acts::Surface>> surfaces;
+  auto square = std::make_shared<Acts::RectangleBounds>(10., 10.);
+  for (Acts::ActsScalar z : {-200., -100., 0., 100., 200.}) {
+    for (int ix = 0; ix < 20; ++ix) {
+      for (int iy = 0; iy < 20; ++iy) {
+        Acts::Transform3 transform = Acts::Transform3::Identity();
+        transform.pretranslate(
+            Acts::Vector3(-237.5 + 25. * ix, -237.5 + 25. * iy, z));
+        surfaces.push_back(
+            Acts::Surface::makeShared<Acts::PlaneSurface>(transform, square));
+      }
+    }
+  }
+  return surfaces;
+}
+
+std::vector<const Acts::Surface*> unpack(
+    const std::vector<std::shared_ptr<Acts::Surface>>& surfaces) {
+  std::vector<const Acts::Surface*> unpacked;
+  for (const auto& s : surfaces) {
+    unpacked.push_back(s.get());
+  }
+  return unpacked;
+}
+
+/// A random position at the entry of the volume and a forward direction
+std::pair<Acts::Vector3, Acts::Vector3> randomRay(std::mt19937& rng) {
+  std::uniform_real_distribution<Acts::ActsScalar> xy(-100., 100.);
+  std::uniform_real_distribution<Acts::ActsScalar> phi(-M_PI, M_PI);
+  std::uniform_real_distribution<Acts::ActsScalar> theta(0., 0.6);
+  Acts::ActsScalar t = theta(rng);
+  Acts::ActsScalar p = phi(rng);
+  return {Acts::Vector3(xy(rng), xy(rng), -299.),
+          Acts::Vector3(std::sin(t) * std::cos(p), std::sin(t) * std::sin(p),
+                        std::cos(t))};
+}
+
+/// The valid candidates in the order of the navigation
+std::vector<const Acts::Surface*> validCandidates(
+    const NavigationState& nState) {
+  std::vector<const Acts::Surface*> candidates;
+  for (const auto& c : nState.surfaceCandidates) {
+    const auto& intersection = c.objectIntersection.intersection;
+    if (intersection.status >= Acts::Intersection3D::Status::reachable and
+        intersection.pathLength >= nState.overstepTolerance) {
+      candidates.push_back(c.objectIntersection.object);
+    }
+  }
+  return candidates;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(Experimental)
+
+BOOST_AUTO_TEST_CASE(SurfaceBoundingVolumeHierarchyConstruction) {
+  auto surfaces = makeSurfaces();
+  auto unpacked = unpack(surfaces);
+
+  SurfaceBoundingVolumeHierarchy::Config cfg;
+  cfg.leafSize = 0u;
+  BOOST_CHECK_THROW(SurfaceBoundingVolumeHierarchy(tContext, unpacked, cfg),
+                    std::invalid_argument);
+
+  cfg.leafSize = 4u;
+  SurfaceBoundingVolumeHierarchy emptyBvh(tContext, {}, cfg);
+  BOOST_CHECK(emptyBvh.nodes().empty());
+
+  for (std::size_t leafSize : {1u, 4u, 7u}) {
+    cfg.leafSize = leafSize;
+    SurfaceBoundingVolumeHierarchy bvh(tContext, unpacked, cfg);
+    const auto& nodes = bvh.nodes();
+    BOOST_REQUIRE(not nodes.empty());
+    BOOST_CHECK_EQUAL(bvh.surfaces().size(), unpacked.size());
+    BOOST_CHECK_EQUAL(nodes.front().skip, nodes.size());
+
+    // Every surface is in exactly one leaf, the leaves are contiguous
+    std::uint32_t nextSurface = 0;
+    for (std::size_t in = 0; in < nodes.size(); ++in) {
+      const auto& node = nodes[in];
+      BOOST_CHECK_GT(node.skip, in);
+      BOOST_CHECK_LE(node.skip, nodes.size());
+      if (node.count > 0) {
+        BOOST_CHECK_LE(node.count, leafSize);
+        BOOST_CHECK_EQUAL(node.skip, in + 1);
+        BOOST_CHECK_EQUAL(node.first, nextSurface);
+        nextSurface += node.count;
+      } else {
+        // The sub tree boxes are contained in the node box
+        for (std::size_t ic = in + 1; ic < node.skip; ++ic) {
+          BOOST_CHECK(
+              (nodes[ic].min.array() >= node.min.array() - 1e-9).all());
+          BOOST_CHECK(
+              (nodes[ic].max.array() <= node.max.array() + 1e-9).all());
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(nextSurface, unpacked.size());
+    std::set<const Acts::Surface*> unique(bvh.surfaces().begin(),
+                                          bvh.surfaces().end());
+    BOOST_CHECK_EQUAL(unique.size(), unpacked.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SurfaceBoundingVolumeHierarchyRays) {
+  auto surfaces = makeSurfaces();
+  auto unpacked = unpack(surfaces);
+  SurfaceBoundingVolumeHierarchy bvh(tContext, unpacked,
+                                     SurfaceBoundingVolumeHierarchy::Config{});
+
+  std::mt19937 rng(42);
+  std::size_t nVisited = 0;
+  std::size_t nHit = 0;
+  for (std::size_t ir = 0; ir < 500; ++ir) {
+    auto [position, direction] = randomRay(rng);
+
+    std::set<const Acts::Surface*> visited;
+    bvh.intersect(Acts::Ray3D(position, direction),
+                  [&](const Acts::Surface* s) { visited.insert(s); });
+    nVisited += visited.size();
+
+    // Every surface that is hit in front has to be among the candidates
+    for (const auto* s : unpacked) {
+      auto sIntersection = s->intersect(tContext, position, direction, true);
+      if (sIntersection and sIntersection.intersection.pathLength >= 0.) {
+        ++nHit;
+        BOOST_CHECK(visited.count(s) == 1u);
+      }
+    }
+  }
+  BOOST_CHECK_GT(nHit, 0u);
+  // Only a small fraction of all surfaces is tested
+  BOOST_CHECK_LT(nVisited, 500u * unpacked.size() / 20u);
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchyUpdator) {
+  auto surfaces = makeSurfaces();
+  auto portalGenerator = defaultPortalGenerator();
+
+  auto unpacked = unpack(surfaces);
+  auto bvhVolume = DetectorVolumeFactory::construct(
+      portalGenerator, tContext, "Box", Acts::Transform3::Identity(),
+      std::make_unique<Acts::CuboidVolumeBounds>(300., 300., 300.), surfaces,
+      std::vector<std::shared_ptr<DetectorVolume>>{},
+      boundingVolumeHierarchy(tContext, unpacked));
+
+  std::mt19937 rng(23);
+  for (std::size_t ir = 0; ir < 100; ++ir) {
+    auto [position, direction] = randomRay(rng);
+
+    // All portals and surfaces
+    NavigationState exhaustiveState;
+    exhaustiveState.position = position;
+    exhaustiveState.direction = direction;
+    PortalsFiller::fill(exhaustiveState, bvhVolume->portals());
+    SurfacesFiller::fill(exhaustiveState, unpacked);
+    updateCandidates(tContext, exhaustiveState);
+
+    NavigationState bvhState;
+    bvhState.position = position;
+    bvhState.direction = direction;
+    bvhState.currentVolume = bvhVolume.get();
+    bvhVolume->updateNavigationState(tContext, bvhState);
+
+    BOOST_CHECK_LT(bvhState.surfaceCandidates.size(),
+                   exhaustiveState.surfaceCandidates.size());
+    auto exhaustive = validCandidates(exhaustiveState);
+    auto bvh = validCandidates(bvhState);
+    BOOST_REQUIRE_EQUAL(exhaustive.size(), bvh.size());
+    for (std::size_t ic = 0; ic < exhaustive.size(); ++ic) {
+      BOOST_CHECK_EQUAL(exhaustive[ic], bvh[ic]);
+    }
+  }
+
+  // No volume set
+  NavigationState nState;
+  BOOST_CHECK_THROW(bvhVolume->surfaceCandidatesUpdator()(tContext, nState),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(BoundingVolumeHierarchyUpdatorCurvedTrack) {
+  auto surfaces = makeSurfaces();
+  auto portalGenerator = defaultPortalGenerator();
+
+  auto unpacked = unpack(surfaces);
+  auto bvhVolume = DetectorVolumeFactory::construct(
+      portalGenerator, tContext, "Box", Acts::Transform3::Identity(),
+      std::make_unique<Acts::CuboidVolumeBounds>(300., 300., 300.), surfaces,
+      std::vector<std::shared_ptr<DetectorVolume>>{},
+      boundingVolumeHierarchy(tContext, unpacked));
+
+  // Tracks bending around the y axis with a radius of 600 mm, which turn by
+  // more than half a radian through the volume
+  const Acts::ActsScalar radius = 600.;
+  const Acts::ActsScalar step = 5.;
+  const Acts::ActsScalar angle = step / radius;
+
+  std::mt19937 rng(11);
+  std::size_t nSteps = 0;
+  std::size_t nOutsideEntryCorridor = 0;
+  for (std::size_t ir = 0; ir < 50; ++ir) {
+    auto [position, direction] = randomRay(rng);
+
+    // All portals and surfaces, as allPortalsAndSurfaces() provides them
+    NavigationState exhaustiveState;
+    PortalsFiller::fill(exhaustiveState, bvhVolume->portals());
+    SurfacesFiller::fill(exhaustiveState, unpacked);
+
+    NavigationState bvhState;
+    bvhState.currentVolume = bvhVolume.get();
+
+    std::set<const Acts::Surface*> entryCandidates;
+    while (position.cwiseAbs().maxCoeff() < 300.) {
+      exhaustiveState.position = position;
+      exhaustiveState.direction = direction;
+      updateCandidates(tContext, exhaustiveState);
+
+      bvhState.position = position;
+      bvhState.direction = direction;
+      bvhVolume->updateNavigationState(tContext, bvhState);
+
+      auto exhaustive = validCandidates(exhaustiveState);
+      auto bvh = validCandidates(bvhState);
+      BOOST_REQUIRE_EQUAL(exhaustive.size(), bvh.size());
+      for (std::size_t ic = 0; ic < exhaustive.size(); ++ic) {
+        BOOST_CHECK_EQUAL(exhaustive[ic], bvh[ic]);
+      }
+
+      // The candidates of a query at the volume entry only
+      if (entryCandidates.empty()) {
+        entryCandidates.insert(bvh.begin(), bvh.end());
+      } else if (not bvh.empty() and entryCandidates.count(bvh.front()) == 0) {
+        ++nOutsideEntryCorridor;
+      }
+
+      position += step * direction;
+      direction = Acts::Vector3(
+          std::cos(angle) * direction.x() + std::sin(angle) * direction.z(),
+          direction.y(),
+          -std::sin(angle) * direction.x() + std::cos(angle) * direction.z());
+      ++nSteps;
+    }
+  }
+  BOOST_CHECK_GT(nSteps, 0u);
+  // The next candidate is often not found by the straight line query at the
+  // volume entry
+  BOOST_CHECK_GT(nOutsideEntryCorridor, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/SolenoidBField.hpp"
+#include "Acts/Propagator/BatchedEigenStepper.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/PropagatorError.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Acts::UnitLiterals;
+
+namespace Acts {
+namespace Test {
+
+// Create a test context
+GeometryContext tgContext = GeometryContext();
+MagneticFieldContext mfContext = MagneticFieldContext();
+
+namespace {
+
+/// A set of start parameters with varying momenta, charges and directions
+std::vector<CurvilinearTrackParameters> makeStartParameters(size_t nTracks) {
+  BoundSymMatrix cov = BoundSymMatrix::Identity();
+  cov(eBoundLoc0, eBoundLoc0) = 10_um;
+  cov(eBoundLoc1, eBoundLoc1) = 10_um;
+  cov(eBoundQOverP, eBoundQOverP) = 1_e / 10_GeV;
+
+  std::vector<CurvilinearTrackParameters> starts;
+  for (size_t i = 0; i < nTracks; ++i) {
+    const double phi = -M_PI + 0.37 * i;
+    const double theta = 0.4 + 0.11 * (i % 20);
+    const double p = (0.5 + 0.3 * (i % 7)) * 1_GeV;
+    const double q = (i % 2 == 0) ? 1_e : -1_e;
+    const Vector4 pos4(0.1 * i, -0.2 * i, 0.5 * i, 0.);
+    const Vector3 dir(std::cos(phi) * std::sin(theta),
+                      std::sin(phi) * std::sin(theta), std::cos(theta));
+    starts.emplace_back(pos4, dir, p, q,
+                        (i % 3 == 0) ? std::nullopt
+                                     : std::optional<BoundSymMatrix>(cov));
+  }
+  return starts;
+}
+
+/// Compare the batched propagation against the single track one
+template <size_t N>
+void checkAgainstEigenStepper(
+    std::shared_ptr<const MagneticFieldProvider> bField,
+    const std::vector<CurvilinearTrackParameters>& starts,
+    const PropagatorOptions<>& options) {
+  Propagator<EigenStepper<>> propagator{EigenStepper<>(bField)};
+  BatchedEigenStepper<N> batched(bField);
+
+  auto results = batched.propagate(starts, options);
+  BOOST_CHECK_EQUAL(results.size(), starts.size());
+
+  for (size_t i = 0; i < starts.size(); ++i) {
+    auto ref = propagator.propagate(starts[i], options);
+    BOOST_REQUIRE(ref.ok());
+    BOOST_REQUIRE(results[i].ok());
+    const auto& res = *results[i];
+
+    BOOST_CHECK_EQUAL(res.steps, ref->steps);
+    CHECK_CLOSE_REL(res.pathLength, ref->pathLength, 1e-10);
+
+    const auto& par = *res.endParameters;
+    const auto& refPar = *ref->endParameters;
+    CHECK_CLOSE_ABS(par.position(tgContext), refPar.position(tgContext),
+                    1e-8_mm);
+    CHECK_CLOSE_ABS(par.unitDirection(), refPar.unitDirection(), 1e-10);
+    CHECK_CLOSE_REL(par.time(), refPar.time(), 1e-10);
+
+    BOOST_CHECK_EQUAL(res.transportJacobian.has_value(),
+                      ref->transportJacobian.has_value());
+    BOOST_CHECK_EQUAL(par.covariance().has_value(),
+                      refPar.covariance().has_value());
+    if (res.transportJacobian.has_value()) {
+      CHECK_CLOSE_OR_SMALL(*res.transportJacobian, *ref->transportJacobian,
+                           1e-8, 1e-10);
+      CHECK_CLOSE_COVARIANCE(*par.covariance(), *refPar.covariance(), 1e-8);
+    }
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BatchedEigenStepperTests)
+
+BOOST_AUTO_TEST_CASE(batched_constant_field) {
+  auto bField = std::make_shared<ConstantBField>(Vector3(0., 0., 2_T));
+
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 2_m;
+
+  // fewer tracks than lanes, exactly the lanes, and refilled lanes
+  checkAgainstEigenStepper<4>(bField, makeStartParameters(3), options);
+  checkAgainstEigenStepper<4>(bField, makeStartParameters(4), options);
+  checkAgainstEigenStepper<8>(bField, makeStartParameters(21), options);
+
+  // backward propagation with a maximum step size
+  options.direction = NavigationDirection::Backward;
+  options.maxStepSize = 10_cm;
+  checkAgainstEigenStepper<4>(bField, makeStartParameters(9), options);
+}
+
+BOOST_AUTO_TEST_CASE(batched_solenoid_field) {
+  SolenoidBField::Config cfg{};
+  cfg.length = 5.8_m;
+  cfg.radius = (2.56 + 2.46) * 0.5 * 0.5_m;
+  cfg.nCoils = 1154;
+  cfg.bMagCenter = 2_T;
+  auto bField = std::make_shared<SolenoidBField>(cfg);
+
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 1_m;
+
+  checkAgainstEigenStepper<4>(bField, makeStartParameters(13), options);
+}
+
+BOOST_AUTO_TEST_CASE(batched_step_count_limit) {
+  auto bField = std::make_shared<ConstantBField>(Vector3(0., 0., 2_T));
+  BatchedEigenStepper<4> batched(bField);
+
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 2_m;
+  options.maxStepSize = 1_cm;
+  options.maxSteps = 10;
+
+  auto starts = makeStartParameters(6);
+  auto results = batched.propagate(starts, options);
+  BOOST_CHECK_EQUAL(results.size(), starts.size());
+  for (auto& res : results) {
+    BOOST_CHECK(!res.ok());
+    BOOST_CHECK(res.error() == PropagatorError::StepCountLimitReached);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(batched_lane_state) {
+  auto bField = std::make_shared<ConstantBField>(Vector3(0., 0., 2_T));
+  BatchedEigenStepper<4> batched(bField);
+
+  PropagatorOptions<> options(tgContext, mfContext);
+  options.pathLimit = 10_cm;
+
+  auto starts = makeStartParameters(2);
+  auto state = batched.makeState(tgContext, mfContext);
+  batched.loadLane(state, 1, starts[1], options);
+  BOOST_CHECK(!state.active()[0]);
+  BOOST_CHECK(state.active()[1]);
+
+  while (state.active().any()) {
+    batched.step(state, options);
+  }
+  using LaneStatus = BatchedEigenStepper<4>::LaneStatus;
+  BOOST_CHECK(state.status[0] == LaneStatus::Idle);
+  BOOST_CHECK(state.status[1] == LaneStatus::Done);
+  CHECK_CLOSE_REL(state.pathAccumulated[1], 10_cm, 1e-6);
+  // idle lanes are not moved
+  CHECK_SMALL(state.pathAccumulated[0], 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
@@ -11,8 +11,10 @@
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/MagneticField/NullBField.hpp"
 #include "Acts/Propagator/MultiEigenStepperLoop.hpp"
+#include "Acts/Propagator/MultiEigenStepperVectorized.hpp"
 #include "Acts/Propagator/MultiStepperAborters.hpp"
 #include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
 
 using namespace Acts;
 using namespace Acts::VectorHelpers;
@@ -26,6 +28,11 @@ const GeometryContext geoCtx;
 using MultiStepperLoop =
     MultiEigenStepperLoop<StepperExtensionList<DefaultExtension>>;
 using SingleStepper = EigenStepper<StepperExtensionList<DefaultExtension>>;
+// Less lanes than components in the tests, to test the chunking as well
+using MultiStepperVectorized =
+    MultiEigenStepperVectorized<StepperExtensionList<DefaultExtension>,
+                                WeightedComponentReducerLoop,
+                                Acts::detail::VoidAuctioneer, 4>;
 
 const double defaultStepSize = 123.;
 const double defaultTolerance = 234.;
@@ -247,6 +254,76 @@ BOOST_AUTO_TEST_CASE(multi_eigen_vs_single_eigen) {
   test_multi_stepper_vs_eigen_stepper<MultiStepperLoop>();
 }
 
+////////////////////////////////////////////////////////////////////
+// Compare the lockstep Multi-Stepper against the loop Multi-Stepper
+////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(multi_eigen_vectorized_vs_loop) {
+  using MultiState = typename MultiStepperLoop::State;
+
+  // Components with different momenta and directions, such that they need
+  // different step sizes
+  std::vector<std::tuple<double, BoundVector, std::optional<BoundSymMatrix>>>
+      cmps;
+  for (unsigned int i = 0; i < 6; ++i) {
+    BoundVector pars = BoundVector::Zero();
+    pars[eBoundLoc0] = 0.1 * i;
+    pars[eBoundPhi] = 0.2 * i;
+    pars[eBoundTheta] = 1. + 0.1 * i;
+    pars[eBoundQOverP] = (i % 2 == 0 ? 1. : -1.) / (0.5 + i);
+    cmps.push_back({1. / 6, pars, BoundSymMatrix::Identity()});
+  }
+  auto surface = Acts::Surface::makeShared<Acts::PlaneSurface>(
+      Vector3::Zero(), Vector3::Ones().normalized());
+  MultiComponentBoundTrackParameters<SinglyCharged> multi_pars(surface, cmps);
+
+  MultiState loop_state(geoCtx, magCtx, defaultBField, multi_pars, defaultNDir,
+                        defaultStepSize, defaultTolerance);
+  MultiState vectorized_state(geoCtx, magCtx, defaultBField, multi_pars,
+                              defaultNDir, defaultStepSize, defaultTolerance);
+
+  MultiStepperLoop loop_stepper(defaultBField);
+  MultiStepperVectorized vectorized_stepper(defaultBField);
+
+  // Components on a surface are not stepped
+  for (auto *state : {&loop_state, &vectorized_state}) {
+    state->components[2].status = Intersection3D::Status::onSurface;
+  }
+  const FreeVector onSurfacePars = loop_state.components[2].state.pars;
+
+  for (int i = 0; i < 10; ++i) {
+    auto loop_prop_state = DummyPropState(loop_state);
+    auto loop_result = loop_stepper.step(loop_prop_state);
+
+    auto vectorized_prop_state = DummyPropState(vectorized_state);
+    auto vectorized_result = vectorized_stepper.step(vectorized_prop_state);
+
+    BOOST_REQUIRE(loop_result.ok());
+    BOOST_REQUIRE(vectorized_result.ok());
+    CHECK_CLOSE_REL(*vectorized_result, *loop_result, 1e-12);
+    CHECK_CLOSE_REL(vectorized_state.pathAccumulated,
+                    loop_state.pathAccumulated, 1e-12);
+
+    BOOST_REQUIRE_EQUAL(vectorized_state.components.size(),
+                        loop_state.components.size());
+    for (std::size_t c = 0; c < loop_state.components.size(); ++c) {
+      const auto &expected = loop_state.components[c].state;
+      const auto &actual = vectorized_state.components[c].state;
+      CHECK_CLOSE_OR_SMALL(actual.pars, expected.pars, 1e-12, 1e-12);
+      CHECK_CLOSE_OR_SMALL(actual.derivative, expected.derivative, 1e-12,
+                           1e-12);
+      CHECK_CLOSE_OR_SMALL(actual.jacTransport, expected.jacTransport, 1e-10,
+                           1e-10);
+      CHECK_CLOSE_OR_SMALL(actual.pathAccumulated, expected.pathAccumulated,
+                           1e-12, 1e-12);
+      CHECK_CLOSE_REL(actual.stepSize.value(), expected.stepSize.value(),
+                      1e-12);
+    }
+  }
+  BOOST_CHECK_EQUAL(vectorized_state.components[2].state.pars, onSurfacePars);
+  BOOST_CHECK_NE(vectorized_state.components[0].state.pars,
+                 vectorized_state.components[1].state.pars);
+}
+
 /////////////////////////////
 // Test stepsize accessors
 /////////////////////////////
@@ -439,6 +516,7 @@ void test_multi_stepper_surface_status_update() {
 
 BOOST_AUTO_TEST_CASE(test_surface_status_and_cmpwise_bound_state) {
   test_multi_stepper_surface_status_update<MultiStepperLoop>();
+  test_multi_stepper_surface_status_update<MultiStepperVectorized>();
 }
 
 //////////////////////////////////
@@ -728,4 +806,5 @@ void propagator_instatiation_test_function() {
 
 BOOST_AUTO_TEST_CASE(propagator_instatiation_test) {
   propagator_instatiation_test_function<MultiStepperLoop>();
+  propagator_instatiation_test_function<MultiStepperVectorized>();
 }
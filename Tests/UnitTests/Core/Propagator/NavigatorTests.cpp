@@ -14,10 +14,14 @@
 #include "Acts/Definitions/Units.hpp"
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/NavigationCache.hpp"
 #include "Acts/Propagator/ConstrainedStep.hpp"
 #include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StandardAborters.hpp"
 #include "Acts/Propagator/StepperConcept.hpp"
 #include "Acts/Propagator/StraightLineStepper.hpp"
+#include "Acts/Propagator/SurfaceCollector.hpp"
 #include "Acts/Propagator/detail/SteppingHelper.hpp"
 #include "Acts/Surfaces/CylinderSurface.hpp"
 #include "Acts/Tests/CommonHelpers/CubicBVHTrackingGeometry.hpp"
@@ -712,5 +716,85 @@ BOOST_AUTO_TEST_CASE(Navigator_target_methods) {
   BOOST_CHECK_EQUAL(BVHState.navigation.navSurfaces.size(), 42u);
 }
 
+BOOST_AUTO_TEST_CASE(Navigator_navigation_cache) {
+  Navigator::Config navCfg;
+  navCfg.trackingGeometry = tGeometry;
+  Propagator<StraightLineStepper, Navigator> propagator{StraightLineStepper(),
+                                                        Navigator(navCfg)};
+
+  NavigationCache::Config cacheCfg;
+  navCfg.navigationCache =
+      std::make_shared<NavigationCache>(tgContext, *tGeometry, cacheCfg);
+  // without validation, such that wrong cached candidates are not corrected
+  navCfg.validateNavigationCache = false;
+  Propagator<StraightLineStepper, Navigator> cachedPropagator{
+      StraightLineStepper(), Navigator(navCfg)};
+
+  // the cache has to be built with the same resolve flags
+  navCfg.resolvePassive = true;
+  BOOST_CHECK_THROW(Navigator{navCfg}, std::invalid_argument);
+
+  MagneticFieldContext mfContext;
+  PropagatorOptions<ActionList<SurfaceCollector<>>,
+                    AbortList<EndOfWorldReached>>
+      options(tgContext, mfContext);
+  auto& collector = options.actionList.get<SurfaceCollector<>>();
+  collector.selector.selectSensitive = true;
+  collector.selector.selectMaterial = true;
+
+  for (double phi : {-3., -2., -1., 0., 0.5, 1., 2., 3.}) {
+    for (double theta : {0.4, 1., 1.5, 2., 2.6}) {
+      CurvilinearTrackParameters start(Vector4(0., 0., 0., 0.), phi, theta,
+                                       1 / 1_GeV);
+      auto result = propagator.propagate(start, options);
+      auto cachedResult = cachedPropagator.propagate(start, options);
+      BOOST_REQUIRE(result.ok());
+      BOOST_REQUIRE(cachedResult.ok());
+
+      const auto& collected =
+          result.value().get<SurfaceCollector<>::result_type>().collected;
+      const auto& cachedCollected =
+          cachedResult.value().get<SurfaceCollector<>::result_type>().collected;
+      BOOST_CHECK(!collected.empty());
+      BOOST_REQUIRE_EQUAL(collected.size(), cachedCollected.size());
+      for (std::size_t i = 0; i < collected.size(); ++i) {
+        BOOST_CHECK_EQUAL(collected[i].surface, cachedCollected[i].surface);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Navigator_candidate_buffer_reallocations) {
+  Navigator::Config navCfg;
+  navCfg.trackingGeometry = tGeometry;
+  Propagator<StraightLineStepper, Navigator> propagator{StraightLineStepper(),
+                                                        Navigator(navCfg)};
+
+  navCfg.navigationCache = std::make_shared<NavigationCache>(
+      tgContext, *tGeometry, NavigationCache::Config{});
+  Propagator<StraightLineStepper, Navigator> cachedPropagator{
+      StraightLineStepper(), Navigator(navCfg)};
+
+  MagneticFieldContext mfContext;
+  PropagatorOptions<ActionList<>, AbortList<EndOfWorldReached>> options(
+      tgContext, mfContext);
+
+  // the candidates of the cylindrical geometry fit into the inline buffers
+  for (double phi : {-3., -2., -1., 0., 0.5, 1., 2., 3.}) {
+    for (double theta : {0.4, 1., 1.5, 2., 2.6}) {
+      CurvilinearTrackParameters start(Vector4(0., 0., 0., 0.), phi, theta,
+                                       1 / 1_GeV);
+      auto result = propagator.propagate(start, options);
+      auto cachedResult = cachedPropagator.propagate(start, options);
+      BOOST_REQUIRE(result.ok());
+      BOOST_REQUIRE(cachedResult.ok());
+      BOOST_CHECK_GT(result.value().steps, 0u);
+      BOOST_CHECK_EQUAL(result.value().candidateBufferReallocations, 0u);
+      BOOST_CHECK_EQUAL(cachedResult.value().candidateBufferReallocations,
+                        0u);
+    }
+  }
+}
+
 }  // namespace Test
 }  // namespace Acts
@@ -734,6 +734,20 @@ BOOST_AUTO_TEST_CASE(step_extension_material_test) {
     CHECK_CLOSE_ABS(stepResult.momentum[i], stepResultDense.momentum[i], 1_keV);
   }
 
+  // Averaging the homogeneous material along the steps changes nothing
+  auto propOptsSampled = propOptsDense;
+  propOptsSampled.stepMaterialSamples = 4;
+  const auto& resultSampled =
+      propDense.propagate(sbtp, propOptsSampled).value();
+  const StepCollector::this_result& stepResultSampled =
+      resultSampled.get<typename StepCollector::result_type>();
+  BOOST_CHECK_EQUAL(stepResultDense.momentum.size(),
+                    stepResultSampled.momentum.size());
+  for (unsigned int i = 0; i < stepResultSampled.momentum.size(); i++) {
+    CHECK_CLOSE_ABS(stepResultDense.momentum[i], stepResultSampled.momentum[i],
+                    1_keV);
+  }
+
   ////////////////////////////////////////////////////////////////////
 
   // Re-launch the configuration with magnetic field
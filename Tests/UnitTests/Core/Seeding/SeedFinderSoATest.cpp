@@ -0,0 +1,201 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Seeding/BinFinder.hpp"
+#include "Acts/Seeding/BinnedSPGroup.hpp"
+#include "Acts/Seeding/Seed.hpp"
+#include "Acts/Seeding/SeedFilter.hpp"
+#include "Acts/Seeding/SeedFinder.hpp"
+#include "Acts/Seeding/SpacePointGrid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ATLASCuts.hpp"
+#include "SpacePoint.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Triplet = std::array<std::size_t, 3>;
+
+/// Space points of straight tracks from the beam line on seven barrel
+/// layers, from a portable pseudo random sequence
+///
+/// Every track has a second space point at exactly the radius of its space
+/// point on the third layer.
+std::vector<SpacePoint> makeSpacePoints() {
+  std::uint32_t seed = 12345;
+  auto uniform = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<double>(seed >> 8) / (1u << 24);
+  };
+
+  const std::array<double, 7> radii = {32., 50., 72., 90., 116., 135., 155.};
+  std::vector<SpacePoint> spacePoints;
+  for (int track = 0; track < 200; ++track) {
+    const double phi = -M_PI + 2 * M_PI * uniform();
+    const double cotTheta = -3. + 6. * uniform();
+    const double z0 = -100. + 200. * uniform();
+    for (std::size_t layer = 0; layer < radii.size(); ++layer) {
+      const double phiSmeared = phi + 1e-4 * (uniform() - 0.5);
+      const auto x = static_cast<float>(radii[layer] * std::cos(phiSmeared));
+      const auto y = static_cast<float>(radii[layer] * std::sin(phiSmeared));
+      const auto z = static_cast<float>(z0 + radii[layer] * cotTheta);
+      const float r = std::sqrt(x * x + y * y);
+      const int id = static_cast<int>(layer) + 1;
+      spacePoints.push_back({x, y, z, r, id, 0.06f, 0.06f});
+      if (layer == 2) {
+        spacePoints.push_back({x, y, z + 1.f, r, id, 0.06f, 0.06f});
+      }
+    }
+  }
+  return spacePoints;
+}
+
+/// Find the seeds with the configuration of the seed finder test and return
+/// the indices of their space points
+std::vector<Triplet> findSeeds(const std::vector<SpacePoint>& spacePoints) {
+  Acts::SeedFinderConfig<SpacePoint> config;
+  config.rMax = 160._mm;
+  config.deltaRMin = 5._mm;
+  config.deltaRMax = 160._mm;
+  config.deltaRMinTopSP = config.deltaRMin;
+  config.deltaRMinBottomSP = config.deltaRMin;
+  config.deltaRMaxTopSP = config.deltaRMax;
+  config.deltaRMaxBottomSP = config.deltaRMax;
+  config.collisionRegionMin = -250._mm;
+  config.collisionRegionMax = 250._mm;
+  config.zMin = -2800._mm;
+  config.zMax = 2800._mm;
+  config.maxSeedsPerSpM = 5;
+  config.cotThetaMax = 7.40627;
+  config.sigmaScattering = 1.00000;
+  config.minPt = 500._MeV;
+  config.impactMax = 10._mm;
+  config.useVariableMiddleSPRange = false;
+
+  Acts::SeedFinderOptions options;
+  options.beamPos = {0., 0.};
+  options.bFieldInZ = 1.99724_T;
+
+  std::vector<std::pair<int, int>> zBinNeighbors;
+  auto bottomBinFinder =
+      std::make_shared<Acts::BinFinder<SpacePoint>>(zBinNeighbors, 1);
+  auto topBinFinder =
+      std::make_shared<Acts::BinFinder<SpacePoint>>(zBinNeighbors, 1);
+  Acts::SeedFilterConfig sfconf;
+  sfconf.deltaRMin = config.deltaRMin;
+  sfconf.maxSeedsPerSpM = config.maxSeedsPerSpM;
+  Acts::ATLASCuts<SpacePoint> atlasCuts;
+  config.seedFilter = std::make_unique<Acts::SeedFilter<SpacePoint>>(
+      sfconf.toInternalUnits(), &atlasCuts);
+  config = config.toInternalUnits().calculateDerivedQuantities();
+  options = options.toInternalUnits().calculateDerivedQuantities(config);
+  Acts::SeedFinder<SpacePoint> finder(config);
+
+  auto ct = [](const SpacePoint& sp, float, float,
+               float) -> std::pair<Acts::Vector3, Acts::Vector2> {
+    return {Acts::Vector3(sp.x(), sp.y(), sp.z()),
+            Acts::Vector2(sp.varianceR, sp.varianceZ)};
+  };
+
+  Acts::SpacePointGridConfig gridConf;
+  gridConf.minPt = config.minPt;
+  gridConf.rMax = config.rMax;
+  gridConf.zMax = config.zMax;
+  gridConf.zMin = config.zMin;
+  gridConf.deltaRMax = config.deltaRMax;
+  gridConf.cotThetaMax = config.cotThetaMax;
+  Acts::SpacePointGridOptions gridOpts;
+  gridOpts.bFieldInZ = options.bFieldInZ;
+  gridConf = gridConf.toInternalUnits();
+  gridOpts = gridOpts.toInternalUnits();
+  auto grid =
+      Acts::SpacePointGridCreator::createGrid<SpacePoint>(gridConf, gridOpts);
+
+  std::vector<const SpacePoint*> spPtrs;
+  std::map<const SpacePoint*, std::size_t> indices;
+  for (const auto& sp : spacePoints) {
+    indices[&sp] = spPtrs.size();
+    spPtrs.push_back(&sp);
+  }
+  Acts::Extent rRangeSPExtent;
+  auto spGroup = Acts::BinnedSPGroup<SpacePoint>(
+      spPtrs.begin(), spPtrs.end(), ct, bottomBinFinder, topBinFinder,
+      std::move(grid), rRangeSPExtent, config, options);
+
+  std::vector<Acts::Seed<SpacePoint>> seeds;
+  decltype(finder)::SeedingState state;
+  const Acts::Range1D<float> rMiddleSPRange;
+  for (auto groupIt = spGroup.begin(); !(groupIt == spGroup.end());
+       ++groupIt) {
+    finder.createSeedsForGroup(options, state, std::back_inserter(seeds),
+                               groupIt.bottom(), groupIt.middle(),
+                               groupIt.top(), rMiddleSPRange);
+  }
+
+  std::vector<Triplet> triplets;
+  for (const auto& seed : seeds) {
+    triplets.push_back({indices.at(seed.sp()[0]), indices.at(seed.sp()[1]),
+                        indices.at(seed.sp()[2])});
+  }
+  std::sort(triplets.begin(), triplets.end());
+  return triplets;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SeedFinderSoA)
+
+// The seeds of the structure-of-arrays implementation of the doublet and
+// triplet cuts are the same as with the previous implementation, which
+// looped over the space point objects
+BOOST_AUTO_TEST_CASE(SameSeeds) {
+  const auto spacePoints = makeSpacePoints();
+  const auto triplets = findSeeds(spacePoints);
+
+  // number of seeds and checksum of their space point indices found with
+  // the previous implementation
+  const std::size_t expectedSeeds = 2940;
+  const std::uint64_t expectedChecksum = 6041678422595215508u;
+
+  std::uint64_t checksum = 0;
+  for (const auto& triplet : triplets) {
+    for (std::size_t index : triplet) {
+      checksum = checksum * 1000003u + index;
+    }
+  }
+  BOOST_CHECK_EQUAL(triplets.size(), expectedSeeds);
+  BOOST_CHECK_EQUAL(checksum, expectedChecksum);
+}
+
+// Space points at the radius of the middle space point are rejected by the
+// deltaR cut before their cotTheta is used and must not raise floating
+// point exceptions in the vectorised evaluation
+BOOST_AUTO_TEST_CASE(NoFloatingPointExceptionsAtEqualRadius) {
+  const auto spacePoints = makeSpacePoints();
+  std::feclearexcept(FE_ALL_EXCEPT);
+  const auto triplets = findSeeds(spacePoints);
+  BOOST_CHECK(!triplets.empty());
+  BOOST_CHECK_EQUAL(std::fetestexcept(FE_DIVBYZERO), 0);
+  BOOST_CHECK_EQUAL(std::fetestexcept(FE_INVALID), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -15,6 +15,9 @@
 #include "Acts/Surfaces/BoundaryCheck.hpp"
 #include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
 
+#include <random>
+#include <vector>
+
 #include "BoundaryCheckTestsRefs.hpp"
 
 namespace Acts {
@@ -124,6 +127,70 @@ BOOST_AUTO_TEST_CASE(BoundaryCheckTriangleCovariance) {
   BOOST_CHECK(check.isInside({0, 4}, vertices));
   BOOST_CHECK(!check.isInside({0, 5}, vertices));
 }
+
+// Batched checks must agree with the single point checks
+BOOST_AUTO_TEST_CASE(BoundaryCheckBatched) {
+  std::vector<Vector2> vertices = {
+      {0.4, 0.25}, {0.6, 0.25}, {0.8, 0.75}, {0.2, 0.75}};
+  Vector2 ll(0.3, 0.2);
+  Vector2 ur(0.7, 0.8);
+  SymMatrix2 cov;
+  cov << 0.2, 0.02, 0.15, 0.02;
+
+  // an odd number of points exercises the partially filled last block
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> axis(-0.5, 1.5);
+  std::vector<Vector2> points(1001);
+  for (auto& point : points) {
+    point = Vector2(axis(rng), axis(rng));
+  }
+  // points on the edges and the corners
+  points.push_back(vertices[0]);
+  points.push_back(0.5 * (vertices[1] + vertices[2]));
+  points.push_back(ll);
+  points.push_back(Vector2(ur.x(), 0.5));
+
+  std::vector<BoundaryCheck> checks = {
+      BoundaryCheck(false), BoundaryCheck(true),
+      BoundaryCheck(true, false, 0.1, 0.0),
+      BoundaryCheck(true, true, 0.2, 0.15), BoundaryCheck(cov, 3.0)};
+
+  std::vector<bool> inside;
+  for (const auto& check : checks) {
+    check.isInside(points, vertices, inside);
+    BOOST_CHECK_EQUAL(inside.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], check.isInside(points[i], vertices));
+    }
+    check.isInside(points, ll, ur, inside);
+    BOOST_CHECK_EQUAL(inside.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], check.isInside(points[i], ll, ur));
+    }
+  }
+
+  // one point against many boxes
+  std::vector<Vector2> lowerLefts;
+  std::vector<Vector2> upperRights;
+  for (size_t i = 0; i < points.size(); i += 2) {
+    lowerLefts.push_back(points[i].cwiseMin(points[i + 1]));
+    upperRights.push_back(points[i].cwiseMax(points[i + 1]));
+  }
+  for (const auto& check : checks) {
+    check.isInside(Vector2(0.5, 0.5), lowerLefts, upperRights, inside);
+    BOOST_CHECK_EQUAL(inside.size(), lowerLefts.size());
+    for (size_t i = 0; i < lowerLefts.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], check.isInside(Vector2(0.5, 0.5),
+                                                  lowerLefts[i],
+                                                  upperRights[i]));
+    }
+  }
+
+  // empty input
+  std::vector<Vector2> none;
+  checks[1].isInside(none, vertices, inside);
+  BOOST_CHECK(inside.empty());
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace Test
 }  // namespace Acts
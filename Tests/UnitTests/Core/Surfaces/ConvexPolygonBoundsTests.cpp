@@ -15,6 +15,7 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 using vec2 = Acts::Vector2;
 template <int N>
@@ -117,6 +118,35 @@ BOOST_AUTO_TEST_CASE(ConvexPolygonBoundsDynamicTest) {
   BOOST_CHECK(!triangle.inside({0.3, -0.2}, bc));
 }
 
+BOOST_AUTO_TEST_CASE(ConvexPolygonBoundsInsideBatch) {
+  std::vector<vec2> vertices = {{0, 0}, {1, 0}, {1.5, 1}, {0.5, 2}, {-0.5, 1}};
+  poly<5> fixed(vertices);
+  poly<PolygonDynamic> dynamic(vertices);
+
+  std::vector<vec2> points;
+  for (double x = -1.; x <= 2.; x += 0.1) {
+    for (double y = -0.5; y <= 2.5; y += 0.1) {
+      points.emplace_back(x, y);
+    }
+  }
+  std::vector<BoundaryCheck> checks = {BoundaryCheck(false),
+                                       BoundaryCheck(true),
+                                       BoundaryCheck(true, true, 0.2, 0.2)};
+  std::vector<bool> inside;
+  for (const auto& bc : checks) {
+    fixed.insideBatch(points, bc, inside);
+    BOOST_CHECK_EQUAL(inside.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], fixed.inside(points[i], bc));
+    }
+    dynamic.insideBatch(points, bc, inside);
+    BOOST_CHECK_EQUAL(inside.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], dynamic.inside(points[i], bc));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace Test
 }  // namespace Acts
@@ -24,6 +24,7 @@
 #include "Acts/Utilities/detail/Grid.hpp"
 
 #include <fstream>
+#include <random>
 
 #include <boost/format.hpp>
 
@@ -219,6 +220,12 @@ BOOST_FIXTURE_TEST_CASE(SurfaceArray_create, SurfaceArrayFixture) {
       sa.neighbors(itransform(Vector2(0, 0)));
   BOOST_CHECK_EQUAL(neighbors.size(), 9u);
 
+  // no binning values given, the range falls back to the neighbor map
+  BOOST_CHECK(not sa.hasFlatLookup());
+  auto neighborRange = sa.neighborRange(itransform(Vector2(0, 0)));
+  BOOST_CHECK_EQUAL_COLLECTIONS(neighborRange.begin(), neighborRange.end(),
+                                neighbors.begin(), neighbors.end());
+
   auto sl2 = std::make_unique<
       SurfaceArray::SurfaceGridLookup<decltype(phiAxis), decltype(zAxis)>>(
       transform, itransform,
@@ -236,6 +243,48 @@ BOOST_FIXTURE_TEST_CASE(SurfaceArray_create, SurfaceArrayFixture) {
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(SurfaceArray_flatLookup, SurfaceArrayFixture) {
+  SurfaceArrayCreator sac;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+
+  auto checkNeighbors = [](const SurfaceArray& sa, const Vector3& position) {
+    const auto& neighbors = sa.neighbors(position);
+    auto neighborRange = sa.neighborRange(position);
+    BOOST_CHECK_EQUAL_COLLECTIONS(neighborRange.begin(), neighborRange.end(),
+                                  neighbors.begin(), neighbors.end());
+  };
+
+  // cylinder (phi, z) grids with equidistant and variable axes
+  SrfVec brl = makeBarrel(30, 7, 2, 1);
+  std::uniform_real_distribution<double> zDist(-16., 16.);
+  for (BinningType bType : {equidistant, arbitrary}) {
+    auto sa = sac.surfaceArrayOnCylinder(tgContext, brl, bType, bType);
+    BOOST_CHECK(sa->hasFlatLookup());
+    for (size_t i = 0; i < 1000; ++i) {
+      double angle = phiDist(rng);
+      Vector3 position(10 * std::cos(angle), 10 * std::sin(angle), zDist(rng));
+      checkNeighbors(*sa, position);
+    }
+  }
+
+  // disc (r, phi) grids with two rings
+  SrfVec ec = fullPhiTestSurfacesEC(20, 0, 0, 10);
+  SrfVec ecOuter = fullPhiTestSurfacesEC(20, 0, 0, 15);
+  ec.insert(ec.end(), ecOuter.begin(), ecOuter.end());
+  std::uniform_real_distribution<double> rDist(5., 20.);
+  for (BinningType bType : {equidistant, arbitrary}) {
+    auto sa = sac.surfaceArrayOnDisc(tgContext, ec, bType, bType);
+    BOOST_CHECK(sa->hasFlatLookup());
+    for (size_t i = 0; i < 1000; ++i) {
+      double r = rDist(rng);
+      double angle = phiDist(rng);
+      Vector3 position(r * std::cos(angle), r * std::sin(angle), 0.);
+      checkNeighbors(*sa, position);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SurfaceArray_singleElement) {
   double w = 3, h = 4;
   auto bounds = std::make_shared<const RectangleBounds>(w, h);
@@ -248,6 +297,8 @@ BOOST_AUTO_TEST_CASE(SurfaceArray_singleElement) {
   BOOST_CHECK_EQUAL(binContent.at(0), srf.get());
   BOOST_CHECK_EQUAL(sa.surfaces().size(), 1u);
   BOOST_CHECK_EQUAL(sa.surfaces().at(0), srf.get());
+  BOOST_CHECK(not sa.hasFlatLookup());
+  BOOST_CHECK_EQUAL(sa.neighborRange(Vector3(42, 42, 42)).size(), 1u);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
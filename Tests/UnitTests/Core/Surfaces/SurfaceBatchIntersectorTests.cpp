@@ -0,0 +1,193 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Surfaces/CylinderBounds.hpp"
+#include "Acts/Surfaces/CylinderSurface.hpp"
+#include "Acts/Surfaces/DiscSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
+#include "Acts/Surfaces/RadialBounds.hpp"
+#include "Acts/Surfaces/RectangleBounds.hpp"
+#include "Acts/Surfaces/StrawSurface.hpp"
+#include "Acts/Surfaces/SurfaceBatchIntersector.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Acts {
+namespace Test {
+
+using namespace UnitLiterals;
+
+namespace {
+
+GeometryContext tgContext = GeometryContext();
+
+/// Straight lines from close to the origin into random directions
+std::vector<std::pair<Vector3, Vector3>> makeTracks(double maxEta) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+  std::uniform_real_distribution<double> eta(-maxEta, maxEta);
+  std::uniform_real_distribution<double> offset(-5_mm, 5_mm);
+  std::vector<std::pair<Vector3, Vector3>> tracks;
+  for (unsigned int itrack = 0; itrack < 500; ++itrack) {
+    double theta = 2. * std::atan(std::exp(-eta(rng)));
+    double p = phi(rng);
+    Vector3 direction(std::cos(p) * std::sin(theta),
+                      std::sin(p) * std::sin(theta), std::cos(theta));
+    Vector3 position(offset(rng), offset(rng), 10. * offset(rng));
+    tracks.emplace_back(position, direction);
+  }
+  return tracks;
+}
+
+/// Compare the batched intersections with the sorted reachable
+/// intersections of Surface::intersect
+template <typename surface_t>
+void checkBatch(const std::vector<std::shared_ptr<surface_t>>& surfaces,
+                const std::vector<std::pair<Vector3, Vector3>>& tracks,
+                const std::vector<BoundaryCheck>& bchecks) {
+  std::vector<const surface_t*> surfacePtrs;
+  for (const auto& surface : surfaces) {
+    surfacePtrs.push_back(surface.get());
+  }
+  SurfaceBatchIntersector<surface_t> batch(tgContext, surfacePtrs);
+  BOOST_CHECK_EQUAL(batch.surfaces().size(), surfaces.size());
+
+  size_t nIntersections = 0;
+  std::vector<SurfaceIntersection> batched;
+  for (const auto& bcheck : bchecks) {
+    for (const auto& [position, direction] : tracks) {
+      std::vector<SurfaceIntersection> expected;
+      for (const auto& surface : surfaces) {
+        auto sIntersection =
+            surface->intersect(tgContext, position, direction, bcheck);
+        auto status = sIntersection.intersection.status;
+        if (status != Intersection3D::Status::missed and
+            status != Intersection3D::Status::unreachable) {
+          expected.push_back(sIntersection);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+
+      batch.intersect(position, direction, bcheck, batched);
+      BOOST_REQUIRE_EQUAL(batched.size(), expected.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        BOOST_CHECK_EQUAL(batched[i].object, expected[i].object);
+        BOOST_CHECK_EQUAL(batched[i].intersection.status,
+                          expected[i].intersection.status);
+        CHECK_CLOSE_ABS(batched[i].intersection.pathLength,
+                        expected[i].intersection.pathLength, 1e-9);
+        CHECK_CLOSE_ABS(batched[i].intersection.position,
+                        expected[i].intersection.position, 1e-9);
+        BOOST_CHECK_EQUAL(batched[i].alternative.status,
+                          expected[i].alternative.status);
+      }
+      nIntersections += expected.size();
+    }
+  }
+  // the setups are chosen such that the tracks hit something
+  BOOST_CHECK_GT(nIntersections, 0u);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(Surfaces)
+
+BOOST_AUTO_TEST_CASE(SurfaceBatchIntersectorPlanes) {
+  // Barrel-like rings of modules facing the beam line
+  auto bounds = std::make_shared<RectangleBounds>(40_mm, 60_mm);
+  std::vector<std::shared_ptr<PlaneSurface>> planes;
+  for (double r : {100_mm, 200_mm}) {
+    for (unsigned int iphi = 0; iphi < 16; ++iphi) {
+      for (double z : {-200_mm, -50_mm, 100_mm}) {
+        double phi = 2. * M_PI * iphi / 16;
+        Transform3 transform(Translation3(r * std::cos(phi), r * std::sin(phi),
+                                          z) *
+                             AngleAxis3(phi, Vector3::UnitZ()) *
+                             AngleAxis3(0.5 * M_PI, Vector3::UnitY()));
+        planes.push_back(Surface::makeShared<PlaneSurface>(transform, bounds));
+      }
+    }
+  }
+  SymMatrix2 cov;
+  cov << 4_mm * 4_mm, 1_mm * 1_mm, 1_mm * 1_mm, 9_mm * 9_mm;
+  checkBatch(planes, makeTracks(1.),
+             {BoundaryCheck(false), BoundaryCheck(true),
+              BoundaryCheck(true, true, 2_mm, 2_mm), BoundaryCheck(cov, 2.)});
+}
+
+BOOST_AUTO_TEST_CASE(SurfaceBatchIntersectorDiscs) {
+  auto fullBounds = std::make_shared<RadialBounds>(50_mm, 400_mm);
+  auto sectorBounds = std::make_shared<RadialBounds>(50_mm, 400_mm, 0.5);
+  std::vector<std::shared_ptr<DiscSurface>> discs;
+  for (double z : {-900_mm, -600_mm, 600_mm, 900_mm}) {
+    Transform3 transform(Translation3(0., 0., z));
+    discs.push_back(Surface::makeShared<DiscSurface>(transform, fullBounds));
+    for (double phi : {-2., 0., 2.}) {
+      Transform3 sector(Translation3(0., 0., z + 20_mm) *
+                        AngleAxis3(phi, Vector3::UnitZ()));
+      discs.push_back(Surface::makeShared<DiscSurface>(sector, sectorBounds));
+    }
+  }
+  checkBatch(discs, makeTracks(3.),
+             {BoundaryCheck(false), BoundaryCheck(true),
+              BoundaryCheck(true, true, 2_mm, 0.01)});
+}
+
+BOOST_AUTO_TEST_CASE(SurfaceBatchIntersectorCylinders) {
+  std::vector<std::shared_ptr<CylinderSurface>> cylinders;
+  for (double r : {30_mm, 100_mm, 300_mm}) {
+    cylinders.push_back(Surface::makeShared<CylinderSurface>(
+        Transform3::Identity(), r, 2. * r));
+  }
+  // A shifted and a tilted cylinder, and a half cylinder
+  cylinders.push_back(Surface::makeShared<CylinderSurface>(
+      Transform3(Translation3(10_mm, -5_mm, 50_mm)), 200_mm, 400_mm));
+  cylinders.push_back(Surface::makeShared<CylinderSurface>(
+      Transform3(AngleAxis3(0.1, Vector3::UnitX())), 250_mm, 500_mm));
+  cylinders.push_back(Surface::makeShared<CylinderSurface>(
+      Transform3::Identity(),
+      std::make_shared<CylinderBounds>(150_mm, 300_mm, 0.5 * M_PI)));
+  checkBatch(cylinders, makeTracks(2.),
+             {BoundaryCheck(false), BoundaryCheck(true),
+              BoundaryCheck(true, true, 0.01, 5_mm)});
+}
+
+BOOST_AUTO_TEST_CASE(SurfaceBatchIntersectorStraws) {
+  // A grid of straws along the z axis
+  std::vector<std::shared_ptr<StrawSurface>> straws;
+  for (int ix = -5; ix <= 5; ++ix) {
+    for (int iy = -5; iy <= 5; ++iy) {
+      Transform3 transform(Translation3(ix * 30_mm, iy * 30_mm, 0.));
+      straws.push_back(
+          Surface::makeShared<StrawSurface>(transform, 15_mm, 500_mm));
+    }
+  }
+  checkBatch(straws, makeTracks(1.),
+             {BoundaryCheck(false), BoundaryCheck(true)});
+}
+
+BOOST_AUTO_TEST_CASE(SurfaceBatchIntersectorEmpty) {
+  SurfaceBatchIntersector<PlaneSurface> batch(tgContext, {});
+  auto intersections =
+      batch.intersect(Vector3::Zero(), Vector3::UnitX(), BoundaryCheck(true));
+  BOOST_CHECK(intersections.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
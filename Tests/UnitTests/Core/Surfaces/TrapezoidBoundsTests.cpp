@@ -15,6 +15,7 @@
 #include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace bdata = boost::unit_test::data;
 
@@ -196,6 +197,30 @@ BOOST_DATA_TEST_CASE(
                     trapezoidBoundsObject.inside({x, y}, bc));
 }
 
+/// Unit test for the batched inside check
+BOOST_AUTO_TEST_CASE(TrapezoidBoundsInsideBatch) {
+  TrapezoidBounds trapezoidBoundsObject(1., 6., 2.);
+  std::vector<Vector2> points;
+  for (double x = -7.; x <= 7.; x += 0.25) {
+    for (double y = -3.; y <= 3.; y += 0.25) {
+      points.emplace_back(x, y);
+    }
+  }
+  SymMatrix2 cov;
+  cov << 0.5, 0.1, 0.1, 0.5;
+  std::vector<BoundaryCheck> checks = {
+      BoundaryCheck(false), BoundaryCheck(true),
+      BoundaryCheck(true, true, 0.5, 0.2), BoundaryCheck(cov, 1.)};
+  std::vector<bool> inside;
+  for (const auto& bc : checks) {
+    trapezoidBoundsObject.insideBatch(points, bc, inside);
+    BOOST_CHECK_EQUAL(inside.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      BOOST_CHECK_EQUAL(inside[i], trapezoidBoundsObject.inside(points[i], bc));
+    }
+  }
+}
+
 /// Unit test for testing TrapezoidBounds assignment
 BOOST_AUTO_TEST_CASE(TrapezoidBoundsAssignment) {
   double minHalfX(1.), maxHalfX(6.), halfY(2.);
@@ -0,0 +1,148 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/VectorMultiTrajectory.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/TrackFitting/BatchedGainMatrixSmoother.hpp"
+#include "Acts/TrackFitting/GainMatrixSmoother.hpp"
+
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace Acts;
+
+const GeometryContext tgContext;
+
+/// Random symmetric, positive definite matrix
+BoundSymMatrix randomCovariance(std::mt19937& rng, double scale) {
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  BoundMatrix a;
+  for (std::size_t i = 0; i < eBoundSize * eBoundSize; ++i) {
+    a(i) = uniform(rng);
+  }
+  return scale * (a * a.transpose() + 0.1 * BoundSymMatrix::Identity());
+}
+
+BoundVector randomParameters(std::mt19937& rng) {
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  BoundVector parameters;
+  for (std::size_t i = 0; i < eBoundSize; ++i) {
+    parameters[i] = uniform(rng);
+  }
+  return parameters;
+}
+
+/// Fill a trajectory with random tracks of two track states each
+///
+/// @return The indices of the first and the last state of every track
+std::vector<std::pair<std::size_t, std::size_t>> makeTracks(
+    VectorMultiTrajectory& traj, std::size_t n, std::mt19937& rng) {
+  std::uniform_real_distribution<double> uniform(-0.1, 0.1);
+  std::vector<std::pair<std::size_t, std::size_t>> tracks;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto first =
+        traj.getTrackState(traj.addTrackState(TrackStatePropMask::All));
+    first.filtered() = randomParameters(rng);
+    first.filteredCovariance() = randomCovariance(rng, 0.5);
+    first.jacobian().setIdentity();
+
+    auto last = traj.getTrackState(
+        traj.addTrackState(TrackStatePropMask::All, first.index()));
+    last.predicted() = randomParameters(rng);
+    last.predictedCovariance() = randomCovariance(rng, 1.);
+    // the last state is smoothed by definition
+    last.filtered() = randomParameters(rng);
+    last.filteredCovariance() = randomCovariance(rng, 0.1);
+    last.smoothed() = last.filtered();
+    last.smoothedCovariance() = last.filteredCovariance();
+    last.jacobian().setIdentity();
+    for (std::size_t k = 0; k < eBoundSize * eBoundSize; ++k) {
+      last.jacobian()(k) += uniform(rng);
+    }
+
+    tracks.emplace_back(first.index(), last.index());
+  }
+  return tracks;
+}
+
+BatchedGainMatrixSmoother::States makeStates(
+    const VectorMultiTrajectory& traj,
+    const std::vector<std::pair<std::size_t, std::size_t>>& tracks) {
+  BatchedGainMatrixSmoother::States states;
+  states.resize(tracks.size());
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    states.setTrackStates(i, traj.getTrackState(tracks[i].first),
+                          traj.getTrackState(tracks[i].second));
+  }
+  return states;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TrackFittingBatchedGainMatrixSmoother)
+
+BOOST_AUTO_TEST_CASE(Smooth) {
+  std::mt19937 rng(42);
+  VectorMultiTrajectory traj;
+  // not a multiple of the chunk size
+  auto tracks = makeTracks(
+      traj, 2 * BatchedGainMatrixSmoother::kChunkSize + 3, rng);
+
+  auto states = makeStates(traj, tracks);
+  BOOST_CHECK(BatchedGainMatrixSmoother()(states).ok());
+  BOOST_CHECK(states.ok.all());
+
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    BOOST_CHECK(GainMatrixSmoother()(tgContext, traj, tracks[i].second).ok());
+    auto ts = traj.getTrackState(tracks[i].first);
+    CHECK_CLOSE_ABS(detail::loadElements<BoundVector>(states.smoothed, i),
+                    ts.smoothed(), 1e-9);
+    CHECK_CLOSE_ABS(
+        detail::loadElements<BoundSymMatrix>(states.smoothedCovariance, i),
+        ts.smoothedCovariance(), 1e-9);
+
+    // write back into a fresh track state
+    auto copy =
+        traj.getTrackState(traj.addTrackState(TrackStatePropMask::All));
+    states.writeSmoothed(i, copy);
+    BOOST_CHECK_EQUAL(copy.smoothed(),
+                      detail::loadElements<BoundVector>(states.smoothed, i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SmoothFailure) {
+  std::mt19937 rng(7);
+  VectorMultiTrajectory traj;
+  auto tracks = makeTracks(traj, 10, rng);
+
+  auto states = makeStates(traj, tracks);
+  states.nextPredictedCovariance(6, 7) =
+      std::numeric_limits<double>::quiet_NaN();
+
+  auto res = BatchedGainMatrixSmoother()(states);
+  BOOST_CHECK(not res.ok());
+  BOOST_CHECK_EQUAL(res.error(),
+                    make_error_code(KalmanFitterError::SmoothFailed));
+  BOOST_CHECK(not states.ok(6));
+  BOOST_CHECK_EQUAL(states.ok.count(), 9);
+  // the other track states are still smoothed
+  BOOST_CHECK(GainMatrixSmoother()(tgContext, traj, tracks[2].second).ok());
+  CHECK_CLOSE_ABS(detail::loadElements<BoundVector>(states.smoothed, 2),
+                  traj.getTrackState(tracks[2].first).smoothed(), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/TrackParametrization.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/VectorMultiTrajectory.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/TrackFitting/BatchedGainMatrixUpdater.hpp"
+#include "Acts/TrackFitting/GainMatrixUpdater.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace Acts;
+
+const GeometryContext tgContext;
+
+/// Random symmetric, positive definite matrix
+template <int kSize>
+ActsSymMatrix<kSize> randomCovariance(std::mt19937& rng) {
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  ActsMatrix<kSize, kSize> a;
+  for (int i = 0; i < kSize * kSize; ++i) {
+    a(i) = uniform(rng);
+  }
+  return a * a.transpose() + 0.1 * ActsSymMatrix<kSize>::Identity();
+}
+
+/// Fill a trajectory with random track states with measurements of
+/// dimension @c kMeasurementSize
+///
+/// @param uniform Whether all states measure the first bound parameters
+template <std::size_t kMeasurementSize>
+std::vector<std::size_t> makeTrackStates(VectorMultiTrajectory& traj,
+                                         std::size_t n, bool uniform,
+                                         std::mt19937& rng) {
+  std::uniform_real_distribution<double> uniformDist(-1., 1.);
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto ts = traj.getTrackState(traj.addTrackState(TrackStatePropMask::All));
+    indices.push_back(ts.index());
+    for (std::size_t k = 0; k < eBoundSize; ++k) {
+      ts.predicted()[k] = uniformDist(rng);
+    }
+    ts.predictedCovariance() = randomCovariance<eBoundSize>(rng);
+
+    std::array<std::size_t, eBoundSize> bound{};
+    std::iota(bound.begin(), bound.end(), 0);
+    if (not uniform) {
+      std::shuffle(bound.begin(), bound.end(), rng);
+      std::sort(bound.begin(), bound.begin() + kMeasurementSize);
+    }
+    ActsMatrix<kMeasurementSize, eBoundSize> projector;
+    projector.setZero();
+    ActsVector<kMeasurementSize> measurement;
+    for (std::size_t a = 0; a < kMeasurementSize; ++a) {
+      projector(a, bound[a]) = 1;
+      measurement[a] = uniformDist(rng);
+    }
+    ts.allocateCalibrated(kMeasurementSize);
+    ts.template calibrated<kMeasurementSize>() = measurement;
+    ts.template calibratedCovariance<kMeasurementSize>() =
+        0.1 * randomCovariance<kMeasurementSize>(rng);
+    ts.setProjector(projector);
+  }
+  return indices;
+}
+
+/// Compare the batched update with the per-state update
+template <std::size_t kMeasurementSize>
+void checkUpdate(bool uniform) {
+  std::mt19937 rng(42 + kMeasurementSize);
+  VectorMultiTrajectory traj;
+  // not a multiple of the chunk size
+  const std::size_t n = 2 * BatchedGainMatrixUpdater::kChunkSize + 5;
+  auto indices = makeTrackStates<kMeasurementSize>(traj, n, uniform, rng);
+
+  BatchedGainMatrixUpdater::States<kMeasurementSize> states;
+  states.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    states.setTrackState(i, traj.getTrackState(indices[i]));
+  }
+  BOOST_CHECK(BatchedGainMatrixUpdater()(states).ok());
+  BOOST_CHECK(states.ok.all());
+
+  for (std::size_t i = 0; i < n; ++i) {
+    auto ts = traj.getTrackState(indices[i]);
+    BOOST_CHECK(GainMatrixUpdater()
+                    .
+                    operator()<VectorMultiTrajectory>(tgContext, ts)
+                    .ok());
+    CHECK_CLOSE_ABS(detail::loadElements<BoundVector>(states.filtered, i),
+                    ts.filtered(), 1e-10);
+    CHECK_CLOSE_ABS(
+        detail::loadElements<BoundSymMatrix>(states.filteredCovariance, i),
+        ts.filteredCovariance(), 1e-10);
+    CHECK_CLOSE_REL(states.chi2(i), ts.chi2(), 1e-8);
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TrackFittingBatchedGainMatrixUpdater)
+
+BOOST_AUTO_TEST_CASE(UpdateUniformProjection) {
+  checkUpdate<1>(true);
+  checkUpdate<2>(true);
+  checkUpdate<6>(true);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateMixedProjection) {
+  checkUpdate<1>(false);
+  checkUpdate<2>(false);
+  checkUpdate<3>(false);
+  checkUpdate<4>(false);
+  checkUpdate<5>(false);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateWriteBack) {
+  std::mt19937 rng(23);
+  VectorMultiTrajectory traj;
+  auto indices = makeTrackStates<2>(traj, 3, true, rng);
+
+  BatchedGainMatrixUpdater::States<2> states;
+  states.resize(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    states.setTrackState(i, traj.getTrackState(indices[i]));
+  }
+  BOOST_CHECK(BatchedGainMatrixUpdater()(states).ok());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    auto ts = traj.getTrackState(indices[i]);
+    states.writeFiltered(i, ts);
+    BOOST_CHECK_EQUAL(ts.filtered(),
+                      detail::loadElements<BoundVector>(states.filtered, i));
+    BOOST_CHECK_EQUAL(ts.chi2(), states.chi2(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UpdateFailure) {
+  std::mt19937 rng(7);
+  VectorMultiTrajectory traj;
+  auto indices = makeTrackStates<2>(traj, 20, false, rng);
+
+  BatchedGainMatrixUpdater::States<2> states;
+  states.resize(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    states.setTrackState(i, traj.getTrackState(indices[i]));
+  }
+  states.calibratedCovariance(3, 0) = std::numeric_limits<double>::quiet_NaN();
+
+  auto res = BatchedGainMatrixUpdater()(states, NavigationDirection::Backward);
+  BOOST_CHECK(not res.ok());
+  BOOST_CHECK_EQUAL(res.error(),
+                    make_error_code(KalmanFitterError::BackwardUpdateFailed));
+  BOOST_CHECK(not states.ok(3));
+  BOOST_CHECK_EQUAL(states.ok.count(), 19);
+  // the other track states are still updated
+  auto ts = traj.getTrackState(indices[4]);
+  BOOST_CHECK(GainMatrixUpdater()
+                  .
+                  operator()<VectorMultiTrajectory>(tgContext, ts)
+                  .ok());
+  CHECK_CLOSE_ABS(detail::loadElements<BoundVector>(states.filtered, 4),
+                  ts.filtered(), 1e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
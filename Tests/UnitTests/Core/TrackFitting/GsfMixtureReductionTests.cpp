@@ -8,8 +8,13 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "Acts/Tests/CommonHelpers/FloatComparisons.hpp"
+#include "Acts/TrackFitting/detail/GsfUtils.hpp"
 #include "Acts/TrackFitting/detail/KLMixtureReduction.hpp"
 
+#include <random>
+#include <set>
+
 using namespace Acts;
 using namespace Acts::UnitLiterals;
 
@@ -94,6 +99,74 @@ BOOST_AUTO_TEST_CASE(test_distance_matrix_recompute_distance) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_distance_matrix_incremental_update) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> qop(-1., 1.);
+  std::uniform_real_distribution<double> var(0.01, 0.1);
+
+  std::vector<DummyComponent> cmps(30);
+  for (auto &cmp : cmps) {
+    cmp.weight = 1. / cmps.size();
+    cmp.boundPars[eBoundQOverP] = qop(rng);
+    cmp.boundCov(eBoundQOverP, eBoundQOverP) = var(rng);
+  }
+
+  const auto proj = [](auto &a) -> decltype(auto) { return a; };
+  detail::SymmetricKLDistanceMatrix mat(cmps, proj);
+
+  // Merge like the reduction does and compare with a full scan every time
+  std::set<std::size_t> removed;
+  while (removed.size() + 2 < cmps.size()) {
+    double minDistance = std::numeric_limits<double>::max();
+    std::pair<std::size_t, std::size_t> minPair;
+    for (auto i = 1ul; i < cmps.size(); ++i) {
+      for (auto j = 0ul; j < i; ++j) {
+        if (removed.count(i) != 0 || removed.count(j) != 0) {
+          continue;
+        }
+        const auto d = detail::computeSymmetricKlDivergence(cmps[i], cmps[j],
+                                                            proj);
+        CHECK_CLOSE_REL(mat.at(i, j), d, 1e-12);
+        if (d < minDistance) {
+          minDistance = d;
+          minPair = {i, j};
+        }
+      }
+    }
+
+    const auto [i, j] = mat.minDistancePair();
+    BOOST_CHECK_EQUAL(i, minPair.first);
+    BOOST_CHECK_EQUAL(j, minPair.second);
+
+    cmps[i].boundPars[eBoundQOverP] = qop(rng);
+    cmps[i].boundCov(eBoundQOverP, eBoundQOverP) = var(rng);
+    mat.recomputeAssociatedDistances(i, cmps, proj);
+    mat.maskAssociatedDistances(j);
+    removed.insert(j);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_reduce_with_max_weight) {
+  std::vector<DummyComponent> cmps = {
+      {0.1, BoundVector::Constant(0.), BoundSymMatrix::Identity()},
+      {0.4, BoundVector::Constant(1.), BoundSymMatrix::Identity()},
+      {0.2, BoundVector::Constant(2.), BoundSymMatrix::Identity()},
+      {0.3, BoundVector::Constant(3.), BoundSymMatrix::Identity()}};
+
+  const auto proj = [](auto &a) -> double & { return a.weight; };
+
+  detail::reduceWithMaxWeight(cmps, 5, proj);
+  BOOST_CHECK_EQUAL(cmps.size(), 4u);
+
+  detail::reduceWithMaxWeight(cmps, 2, proj);
+  BOOST_CHECK_EQUAL(cmps.size(), 2u);
+  std::sort(cmps.begin(), cmps.end(), [](const auto &a, const auto &b) {
+    return a.weight < b.weight;
+  });
+  BOOST_CHECK_EQUAL(cmps[0].weight, 0.3);
+  BOOST_CHECK_EQUAL(cmps[1].weight, 0.4);
+}
+
 BOOST_AUTO_TEST_CASE(test_mixture_reduction) {
   auto meanAndSumOfWeights = [](const auto &cmps) {
     const auto mean = std::accumulate(
@@ -0,0 +1,210 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Algebra.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/TrackFitting/GainMatrixSmoother.hpp"
+#include "Acts/TrackFitting/GainMatrixUpdater.hpp"
+#include "Acts/TrackFitting/KalmanFitter.hpp"
+#include "Acts/TrackFitting/TrackRefitter.hpp"
+#include "Acts/Utilities/TaskExecutor.hpp"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "FitterTestsCommon.hpp"
+
+namespace {
+
+using namespace Acts;
+using namespace Acts::Test;
+using namespace Acts::UnitLiterals;
+
+using ConstantFieldStepper = Acts::EigenStepper<>;
+using ConstantFieldPropagator =
+    Acts::Propagator<ConstantFieldStepper, Acts::Navigator>;
+using KalmanFitter =
+    Acts::KalmanFitter<ConstantFieldPropagator, VectorMultiTrajectory>;
+
+GainMatrixUpdater kfUpdater;
+GainMatrixSmoother kfSmoother;
+
+const FitterTester tester;
+
+const auto kfPropagator =
+    makeConstantFieldPropagator<ConstantFieldStepper>(tester.geometry, 0_T);
+const auto kf = KalmanFitter(kfPropagator);
+
+const auto perigee = Surface::makeShared<PerigeeSurface>(Vector3::Zero());
+
+auto makeKalmanFitterOptions() {
+  KalmanFitterExtensions<VectorMultiTrajectory> extensions;
+  extensions.calibrator
+      .connect<&testSourceLinkCalibrator<VectorMultiTrajectory>>();
+  extensions.updater.connect<&GainMatrixUpdater::operator()<
+      VectorMultiTrajectory>>(&kfUpdater);
+  extensions.smoother.connect<&GainMatrixSmoother::operator()<
+      VectorMultiTrajectory>>(&kfSmoother);
+
+  return KalmanFitterOptions(tester.geoCtx, tester.magCtx, tester.calCtx,
+                             extensions, PropagatorPlainOptions(),
+                             perigee.get());
+}
+
+/// Measurements and start parameters of a number of tracks in the transverse
+/// plane with different directions
+struct Inputs {
+  std::vector<std::vector<SourceLink>> sourceLinks;
+  std::vector<CurvilinearTrackParameters> startParameters;
+};
+
+Inputs makeInputs(std::size_t n) {
+  std::default_random_engine rng(42);
+  std::uniform_real_distribution<double> phi(-2_degree, 2_degree);
+
+  BoundVector stddev;
+  stddev[eBoundLoc0] = 100_um;
+  stddev[eBoundLoc1] = 100_um;
+  stddev[eBoundTime] = 25_ns;
+  stddev[eBoundPhi] = 2_degree;
+  stddev[eBoundTheta] = 2_degree;
+  stddev[eBoundQOverP] = 1 / 100_GeV;
+  BoundSymMatrix cov = stddev.cwiseProduct(stddev).asDiagonal();
+
+  Inputs inputs;
+  for (std::size_t i = 0; i < n; ++i) {
+    CurvilinearTrackParameters start(Vector4(-3_m, 0., 0., 42_ns), phi(rng),
+                                     90_degree, 1_GeV, 1_e, cov);
+    auto measurements =
+        createMeasurements(tester.simPropagator, tester.geoCtx, tester.magCtx,
+                           start, tester.resolutions, rng, i);
+    inputs.sourceLinks.push_back(
+        FitterTester::prepareSourceLinks(measurements.sourceLinks));
+    inputs.startParameters.push_back(start);
+  }
+  return inputs;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TrackFittingTrackRefitter)
+
+BOOST_AUTO_TEST_CASE(RefitInInputOrder) {
+  const std::size_t nTracks = 20;
+  const auto inputs = makeInputs(nTracks);
+  const auto options = makeKalmanFitterOptions();
+
+  // the test tools are not thread safe, failures are counted instead
+  std::atomic<std::size_t> nFailed{0};
+  auto fit = [&](std::size_t i, auto& tracks) {
+    const auto& sourceLinks = inputs.sourceLinks[i];
+    auto res = kf.fit(sourceLinks.begin(), sourceLinks.end(),
+                      inputs.startParameters[i], options, tracks);
+    if (not res.ok()) {
+      nFailed++;
+    }
+  };
+
+  // reference from a sequential fit
+  TrackContainer reference{VectorTrackContainer{}, VectorMultiTrajectory{}};
+  for (std::size_t i = 0; i < nTracks; ++i) {
+    fit(i, reference);
+  }
+  BOOST_REQUIRE_EQUAL(nFailed, 0u);
+
+  TrackRefitter<>::Config cfg;
+  cfg.numTasks = 6;
+  cfg.executor = ThreadTaskExecutor(3);
+  TrackRefitter<> refitter(cfg);
+
+  // the second call reuses the cached scratch containers
+  for (int call = 0; call < 2; ++call) {
+    VectorTrackContainer vtc;
+    VectorMultiTrajectory mtj;
+    TrackRefitter<>::TrackContainer tracks{vtc, mtj};
+    refitter.refit(nTracks, fit, tracks);
+
+    BOOST_CHECK_EQUAL(nFailed, 0u);
+    BOOST_REQUIRE_EQUAL(tracks.size(), nTracks);
+    BOOST_CHECK_EQUAL(mtj.size(), reference.trackStateContainer().size());
+    for (std::size_t i = 0; i < nTracks; ++i) {
+      auto track = tracks.getTrack(i);
+      auto expected = reference.getTrack(i);
+      BOOST_REQUIRE(track.hasReferenceSurface());
+      BOOST_CHECK_EQUAL(track.parameters(), expected.parameters());
+      BOOST_CHECK_EQUAL(track.covariance(), expected.covariance());
+      BOOST_CHECK_EQUAL(track.nMeasurements(), expected.nMeasurements());
+      BOOST_CHECK_EQUAL(track.nHoles(), expected.nHoles());
+
+      auto states = track.trackStates();
+      auto expectedStates = expected.trackStates();
+      BOOST_CHECK_EQUAL(std::distance(states.begin(), states.end()),
+                        std::distance(expectedStates.begin(),
+                                      expectedStates.end()));
+      auto it = expectedStates.begin();
+      for (auto state : states) {
+        BOOST_CHECK_EQUAL(state.smoothed(), (*it).smoothed());
+        ++it;
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RefitSharedPtrHolder) {
+  const auto inputs = makeInputs(5);
+  const auto options = makeKalmanFitterOptions();
+
+  TrackRefitter<std::shared_ptr>::Config cfg;
+  cfg.numTasks = 10;
+  TrackRefitter<std::shared_ptr> refitter(cfg);
+
+  TrackRefitter<std::shared_ptr>::TrackContainer tracks{
+      std::make_shared<VectorTrackContainer>(),
+      std::make_shared<VectorMultiTrajectory>()};
+  refitter.refit(
+      inputs.sourceLinks.size(),
+      [&](std::size_t i, auto& tracksOfTask) {
+        const auto& sourceLinks = inputs.sourceLinks[i];
+        BOOST_CHECK(kf.fit(sourceLinks.begin(), sourceLinks.end(),
+                           inputs.startParameters[i], options, tracksOfTask)
+                        .ok());
+      },
+      tracks);
+  BOOST_CHECK_EQUAL(tracks.size(), inputs.sourceLinks.size());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidConfig) {
+  TrackRefitter<>::Config cfg;
+  cfg.numTasks = 0;
+  BOOST_CHECK_THROW(TrackRefitter<>{cfg}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadTaskExecutorRunsAllTasks) {
+  std::vector<std::atomic<int>> counts(100);
+  ThreadTaskExecutor executor(4);
+  executor(counts.size(), [&](std::size_t i) { counts[i]++; });
+  for (const auto& count : counts) {
+    BOOST_CHECK_EQUAL(count, 1);
+  }
+
+  BOOST_CHECK_THROW(executor(10,
+                             [](std::size_t i) {
+                               if (i == 7) {
+                                 throw std::runtime_error("task failed");
+                               }
+                             }),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
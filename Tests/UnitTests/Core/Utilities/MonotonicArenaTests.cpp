@@ -0,0 +1,75 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2022 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Utilities/MonotonicArena.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace Acts {
+namespace Test {
+
+BOOST_AUTO_TEST_SUITE(Utilities)
+
+BOOST_AUTO_TEST_CASE(MonotonicArenaAlignment) {
+  MonotonicArena arena;
+  BOOST_CHECK_EQUAL(arena.capacity(), 0u);
+
+  for (std::size_t alignment : {1u, 2u, 8u, 16u, 64u, 256u}) {
+    void* p = arena.allocate(3, alignment);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+  }
+  BOOST_CHECK_GE(arena.bytes(), 6u * 3u);
+  BOOST_CHECK_EQUAL(arena.peakBytes(), arena.bytes());
+
+  // larger than the first block
+  void* p = arena.allocate(1 << 20, 32);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 32, 0u);
+  BOOST_CHECK_GE(arena.capacity(), arena.bytes());
+}
+
+BOOST_AUTO_TEST_CASE(MonotonicArenaReuse) {
+  MonotonicArena arena;
+
+  auto fill = [&]() {
+    std::pmr::vector<double> values{&arena};
+    for (int i = 0; i < 10000; ++i) {
+      values.push_back(i);
+    }
+    BOOST_CHECK_EQUAL(values.back(), 9999.);
+  };
+
+  fill();
+  auto first = arena.statistics();
+  BOOST_CHECK_GT(first.upstreamAllocations, 1u);
+  BOOST_CHECK_GE(first.bytes, 10000 * sizeof(double));
+  BOOST_CHECK_EQUAL(first.peakBytes, first.bytes);
+
+  arena.reset();
+  BOOST_CHECK_EQUAL(arena.bytes(), 0u);
+  BOOST_CHECK_EQUAL(arena.peakBytes(), first.peakBytes);
+  BOOST_CHECK_GE(arena.capacity(), first.peakBytes);
+
+  // the same event again fits into the merged block
+  fill();
+  auto second = arena.statistics();
+  BOOST_CHECK_EQUAL(second.upstreamAllocations, 0u);
+  BOOST_CHECK_EQUAL(second.bytes, first.bytes);
+  BOOST_CHECK_EQUAL(second.capacity, arena.capacity());
+
+  arena.reset();
+  BOOST_CHECK_EQUAL(arena.statistics().upstreamAllocations, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace Test
+}  // namespace Acts
@@ -0,0 +1,119 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "ActsExamples/Framework/AlgorithmContext.hpp"
+#include "ActsExamples/Framework/DataHandle.hpp"
+#include "ActsExamples/Framework/IAlgorithm.hpp"
+#include "ActsExamples/Framework/ProcessCode.hpp"
+#include "ActsExamples/Framework/Sequencer.hpp"
+#include "ActsExamples/Framework/WhiteBoard.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using namespace ActsExamples;
+
+namespace {
+
+class WriteAlgorithm final : public IAlgorithm {
+ public:
+  WriteAlgorithm(const std::string& key, int value)
+      : IAlgorithm("Write" + key), m_value(value) {
+    m_output.initialize(key);
+  }
+
+  ProcessCode execute(const AlgorithmContext& ctx) const override {
+    m_output(ctx, int(m_value));
+    return ProcessCode::SUCCESS;
+  }
+
+ private:
+  int m_value;
+  WriteDataHandle<int> m_output{this, "Output"};
+};
+
+class CheckAlgorithm final : public IAlgorithm {
+ public:
+  CheckAlgorithm(const std::string& key, int expected)
+      : IAlgorithm("Check" + key), m_expected(expected) {
+    m_input.initialize(key);
+  }
+
+  ProcessCode execute(const AlgorithmContext& ctx) const override {
+    return (m_input(ctx) == m_expected) ? ProcessCode::SUCCESS
+                                        : ProcessCode::ABORT;
+  }
+
+ private:
+  int m_expected;
+  ReadDataHandle<int> m_input{this, "Input"};
+};
+
+int runSharedAliasSequence(bool concurrentAlgorithms) {
+  Sequencer::Config cfg;
+  cfg.events = 4;
+  cfg.numThreads = concurrentAlgorithms ? 2 : 1;
+  cfg.concurrentAlgorithms = concurrentAlgorithms;
+  Sequencer sequencer(cfg);
+  sequencer.addAlgorithm(std::make_shared<WriteAlgorithm>("first", 1));
+  sequencer.addAlgorithm(std::make_shared<CheckAlgorithm>("shared", 1));
+  sequencer.addAlgorithm(std::make_shared<WriteAlgorithm>("second", 2));
+  sequencer.addAlgorithm(std::make_shared<CheckAlgorithm>("shared", 2));
+  sequencer.addAlgorithm(std::make_shared<CheckAlgorithm>("first", 1));
+  sequencer.addWhiteboardAlias("shared", "first");
+  sequencer.addWhiteboardAlias("shared", "second");
+  return sequencer.run();
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WhiteBoardTests)
+
+BOOST_AUTO_TEST_CASE(SharedAliasRefersToLastObject) {
+  const std::unordered_map<std::string, std::string> aliases = {
+      {"first", "shared"}, {"second", "shared"}};
+  const auto layout = std::make_shared<const WhiteBoard::Layout>(
+      WhiteBoard::Layout{{"first", 0}, {"second", 1}});
+
+  // objects in slots and objects stored by name
+  const std::shared_ptr<const WhiteBoard::Layout> noLayout;
+  for (const auto& boardLayout : {layout, noLayout}) {
+    WhiteBoard board(
+        Acts::getDefaultLogger("WhiteBoard", Acts::Logging::INFO), aliases,
+        boardLayout);
+    board.add("first", 1);
+    const int& first = board.get<int>("shared");
+    BOOST_CHECK_EQUAL(first, 1);
+    BOOST_CHECK_NO_THROW(board.add("second", 2));
+    BOOST_CHECK_EQUAL(board.get<int>("shared"), 2);
+    BOOST_CHECK_EQUAL(board.get<int>("first"), 1);
+    BOOST_CHECK_EQUAL(first, 1);
+    BOOST_CHECK_THROW(board.add("first", 3), std::invalid_argument);
+
+    board.clear();
+    BOOST_CHECK(not board.exists("shared"));
+  }
+}
+
+// Each reader of the alias sees the object written last before it in the
+// sequence
+BOOST_AUTO_TEST_CASE(SequencerSharedAlias) {
+  BOOST_CHECK_EQUAL(runSharedAliasSequence(false), EXIT_SUCCESS);
+}
+
+#ifndef ACTS_EXAMPLES_NO_TBB
+BOOST_AUTO_TEST_CASE(SequencerSharedAliasConcurrent) {
+  BOOST_CHECK_EQUAL(runSharedAliasSequence(true), EXIT_SUCCESS);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
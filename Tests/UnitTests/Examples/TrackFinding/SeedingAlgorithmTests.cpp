@@ -0,0 +1,168 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2023 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <boost/test/unit_test.hpp>
+
+#include "Acts/Definitions/Units.hpp"
+#include "Acts/EventData/SourceLink.hpp"
+#include "Acts/Geometry/GeometryIdentifier.hpp"
+#include "ActsExamples/EventData/IndexSourceLink.hpp"
+#include "ActsExamples/EventData/SimSeed.hpp"
+#include "ActsExamples/EventData/SimSpacePoint.hpp"
+#include "ActsExamples/Framework/AlgorithmContext.hpp"
+#include "ActsExamples/Framework/WhiteBoard.hpp"
+#include "ActsExamples/TrackFinding/SeedingAlgorithm.hpp"
+#include "ActsExamples/Utilities/tbbWrap.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <tbb/global_control.h>
+
+using namespace Acts::UnitLiterals;
+using namespace ActsExamples;
+
+namespace {
+
+/// Space points of straight tracks from the beam line on seven barrel
+/// layers, from a portable pseudo random sequence
+SimSpacePointContainer makeSpacePoints(std::uint32_t seed) {
+  auto uniform = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<double>(seed >> 8) / (1u << 24);
+  };
+
+  const std::array<double, 7> radii = {32., 50., 72., 90., 116., 135., 155.};
+  SimSpacePointContainer spacePoints;
+  for (int track = 0; track < 300; ++track) {
+    const double phi = -M_PI + 2 * M_PI * uniform();
+    const double cotTheta = -3. + 6. * uniform();
+    const double z0 = -100. + 200. * uniform();
+    for (std::size_t layer = 0; layer < radii.size(); ++layer) {
+      const double phiSmeared = phi + 1e-4 * (uniform() - 0.5);
+      const Acts::Vector3 position(radii[layer] * std::cos(phiSmeared),
+                                   radii[layer] * std::sin(phiSmeared),
+                                   z0 + radii[layer] * cotTheta);
+      Acts::SourceLink sourceLink{IndexSourceLink(
+          Acts::GeometryIdentifier().setLayer(2 * (layer + 1)),
+          static_cast<Index>(spacePoints.size()))};
+      spacePoints.emplace_back(position, 0.06, 0.06,
+                               boost::container::static_vector<
+                                   Acts::SourceLink, 2>{sourceLink});
+    }
+  }
+  return spacePoints;
+}
+
+SeedingAlgorithm::Config makeConfig(std::size_t numSeedingTasks) {
+  SeedingAlgorithm::Config cfg;
+  cfg.inputSpacePoints = {"spacepoints"};
+  cfg.outputSeeds = "seeds";
+  cfg.outputProtoTracks = "prototracks";
+  cfg.numSeedingTasks = numSeedingTasks;
+
+  auto& finder = cfg.seedFinderConfig;
+  finder.rMax = 160._mm;
+  finder.deltaRMin = 5._mm;
+  finder.deltaRMax = 160._mm;
+  finder.collisionRegionMin = -250._mm;
+  finder.collisionRegionMax = 250._mm;
+  finder.zMin = -2800._mm;
+  finder.zMax = 2800._mm;
+  finder.maxSeedsPerSpM = 5;
+  finder.cotThetaMax = 7.40627;
+  finder.sigmaScattering = 1.00000;
+  finder.minPt = 500._MeV;
+  finder.impactMax = 10._mm;
+  finder.useVariableMiddleSPRange = false;
+
+  cfg.seedFilterConfig.deltaRMin = finder.deltaRMin;
+  cfg.seedFilterConfig.maxSeedsPerSpM = finder.maxSeedsPerSpM;
+
+  cfg.gridConfig.minPt = finder.minPt;
+  cfg.gridConfig.rMax = finder.rMax;
+  cfg.gridConfig.zMax = finder.zMax;
+  cfg.gridConfig.zMin = finder.zMin;
+  cfg.gridConfig.deltaRMax = finder.deltaRMax;
+  cfg.gridConfig.cotThetaMax = finder.cotThetaMax;
+
+  cfg.seedFinderOptions.bFieldInZ = 2_T;
+  cfg.gridOptions.bFieldInZ = cfg.seedFinderOptions.bFieldInZ;
+  return cfg;
+}
+
+/// The space point indices of all seeds of an event
+std::vector<std::array<Index, 3>> seedIndices(const WhiteBoard& store) {
+  std::vector<std::array<Index, 3>> indices;
+  for (const auto& seed : store.get<SimSeedContainer>("seeds")) {
+    std::array<Index, 3>& triplet = indices.emplace_back();
+    for (std::size_t i = 0; i < 3; ++i) {
+      const auto& sourceLink = seed.sp()[i]->sourceLinks()[0];
+      triplet[i] = sourceLink.get<IndexSourceLink>().index();
+    }
+  }
+  return indices;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SeedingAlgorithmTests)
+
+// Seeding several events concurrently, each split into parallel tasks, gives
+// the seeds of the sequential seeding. This needs TBB, the serial fallback
+// of tbbWrap runs the tasks one after the other on the calling thread.
+BOOST_AUTO_TEST_CASE(ParallelTasksGiveSequentialSeeds) {
+  const std::size_t nEvents = 16;
+  std::vector<std::unique_ptr<WhiteBoard>> stores;
+  for (std::size_t event = 0; event < nEvents; ++event) {
+    stores.push_back(std::make_unique<WhiteBoard>());
+    stores.back()->add("spacepoints", makeSpacePoints(1234 + event));
+  }
+
+  // sequential reference
+  SeedingAlgorithm sequential(makeConfig(1), Acts::Logging::INFO);
+  std::vector<std::vector<std::array<Index, 3>>> expected;
+  for (std::size_t event = 0; event < nEvents; ++event) {
+    WhiteBoard store;
+    store.add("spacepoints", makeSpacePoints(1234 + event));
+    AlgorithmContext ctx(0, event, store);
+    BOOST_REQUIRE(sequential.execute(ctx) == ProcessCode::SUCCESS);
+    expected.push_back(seedIndices(store));
+    BOOST_REQUIRE(not expected.back().empty());
+  }
+
+  // allow the worker threads also on machines with fewer cores
+  tbb::global_control workers(tbb::global_control::max_allowed_parallelism,
+                              4);
+  SeedingAlgorithm parallel(makeConfig(7), Acts::Logging::INFO);
+  tbbWrap::task_arena arena(4);
+  BOOST_REQUIRE(tbbWrap::enableTBB());
+  arena.execute([&]() {
+    tbbWrap::parallel_for(
+        tbb::blocked_range<std::size_t>(0, nEvents),
+        [&](const tbb::blocked_range<std::size_t>& range) {
+          for (std::size_t event = range.begin(); event != range.end();
+               ++event) {
+            AlgorithmContext ctx(0, event, *stores[event]);
+            BOOST_REQUIRE(parallel.execute(ctx) == ProcessCode::SUCCESS);
+          }
+        });
+  });
+
+  for (std::size_t event = 0; event < nEvents; ++event) {
+    const auto seeds = seedIndices(*stores[event]);
+    BOOST_CHECK_EQUAL(seeds.size(), expected[event].size());
+    BOOST_CHECK(seeds == expected[event]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()